@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 
 #include <string>
+#include <utility>
 
 /// @brief Types of messages enum
 enum class MessageType
@@ -31,10 +32,10 @@ public:
     /// @param mD The metadata
     Message(MessageType t, nlohmann::json d, std::string mN = "", std::string mT = "", std::string mD = "")
         : type(t)
-        , data(d)
-        , moduleName(mN)
-        , moduleType(mT)
-        , metaData(mD)
+        , data(std::move(d))
+        , moduleName(std::move(mN))
+        , moduleType(std::move(mT))
+        , metaData(std::move(mD))
     {
     }
 
@@ -42,6 +42,7 @@ function(set_common_settings)
     endif()
 
     option(BUILD_TESTS "Enable tests building" OFF)
+    option(BUILD_BENCHMARKS "Enable benchmarks building" OFF)
     option(COVERAGE "Enable coverage report" OFF)
     option(ENABLE_INVENTORY "Enable Inventory module" ON)
     option(ENABLE_LOGCOLLECTOR "Enable Logcollector module" ON)
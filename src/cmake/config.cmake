@@ -34,8 +34,16 @@ set(DEFAULT_FILE_WAIT 500 CACHE STRING "Default Logcollector file reading interv
 
 set(DEFAULT_RELOAD_INTERVAL 60000 CACHE STRING "Default Logcollector reload interval (1m)")
 
+set(DEFAULT_RESCAN_INTERVAL 600000 CACHE STRING "Default Logcollector full reload interval for watched directories (10m)")
+
 set(DEFAULT_CHANNEL_REFRESH_INTERVAL 5000 CACHE STRING "Default Logcollector Windows eventchannel reconnect time (5000ms)")
 
+set(RATE_LIMIT_SUMMARY_INTERVAL 60000 CACHE STRING "Logcollector rate limit drop summary interval (1m)")
+
+set(DEFAULT_JOURNALD_MAX_AGE 86400000 CACHE STRING "Default Logcollector journald catch-up max age (1d)")
+
+set(JOURNALD_CATCHUP_BATCH_SIZE 5000 CACHE STRING "Logcollector journald catch-up batch size (5000 entries)")
+
 set(DEFAULT_INVENTORY_ENABLED true CACHE BOOL "Default inventory enabled")
 
 set(DEFAULT_INTERVAL 3600000 CACHE STRING "Default inventory interval (1h)")
@@ -48,6 +56,8 @@ set(DEFAULT_OS true CACHE BOOL "Default inventory os")
 
 set(DEFAULT_NETWORK true CACHE BOOL "Default inventory network")
 
+set(DEFAULT_NETWORKS_EVENTS false CACHE BOOL "Default inventory networks events")
+
 set(DEFAULT_PACKAGES true CACHE BOOL "Default inventory packages")
 
 set(DEFAULT_PORTS true CACHE BOOL "Default inventory ports")
@@ -56,8 +66,14 @@ set(DEFAULT_PORTS_ALL true CACHE BOOL "Default inventory ports all")
 
 set(DEFAULT_PROCESSES true CACHE BOOL "Default inventory processes")
 
+set(DEFAULT_PROCESSES_EVENTS false CACHE BOOL "Default inventory processes events")
+
 set(DEFAULT_HOTFIXES true CACHE BOOL "Default inventory hotfixes")
 
+set(DEFAULT_SCAN_THREADS 4 CACHE STRING "Default inventory concurrent category scans (4)")
+
+set(DEFAULT_CHURN_WINDOW 0 CACHE STRING "Default inventory processes and ports churn window (0, disabled)")
+
 set(QUEUE_STATUS_REFRESH_TIMER 100 CACHE STRING "Default Agent's queue refresh timer (100ms)")
 
 set(QUEUE_DEFAULT_SIZE 10000 CACHE STRING "Default Agent's queue size (10000)")
@@ -0,0 +1,284 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <boost/program_options.hpp>
+#include <proc/readproc.h>
+#include "linuxInfoHelper.h"
+#include "processes/procReaderLinux.h"
+
+namespace program_options = boost::program_options;
+
+static const auto OPT_HELP {"help"};
+static const auto OPT_ITERATIONS {"iterations"};
+static const auto OPT_SPAWN {"spawn"};
+static const auto OPT_READER {"reader"};
+
+using ProcessCallback = std::function<void(nlohmann::json&)>;
+
+struct ProcTableDeleter
+{
+    void operator()(PROCTAB* proc)
+    {
+        closeproc(proc);
+    }
+    void operator()(proc_t* proc)
+    {
+        freeproc(proc);
+    }
+};
+
+using SysInfoProcessesTable = std::unique_ptr<PROCTAB, ProcTableDeleter>;
+using SysInfoProcess        = std::unique_ptr<proc_t, ProcTableDeleter>;
+
+// Scan done through libprocps before the lean reader, kept as it was to be used as the baseline
+static void readprocScan(const ProcessCallback& callback)
+{
+    const SysInfoProcessesTable spProcTable
+    {
+        openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM)
+    };
+
+    SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
+
+    while (nullptr != spProcInfo)
+    {
+        nlohmann::json jsProcessInfo{};
+        jsProcessInfo["pid"]        = std::to_string(spProcInfo->tid);
+        jsProcessInfo["name"]       = spProcInfo->cmd;
+        jsProcessInfo["state"]      = &spProcInfo->state;
+        jsProcessInfo["ppid"]       = spProcInfo->ppid;
+        jsProcessInfo["utime"]      = spProcInfo->utime;
+        jsProcessInfo["stime"]      = spProcInfo->stime;
+        std::string commandLine;
+        std::string commandLineArgs;
+
+        if (spProcInfo->cmdline && spProcInfo->cmdline[0])
+        {
+            commandLine = spProcInfo->cmdline[0];
+
+            for (int idx = 1; spProcInfo->cmdline[idx]; ++idx)
+            {
+                if (spProcInfo->cmdline[idx][0])
+                {
+                    commandLineArgs += spProcInfo->cmdline[idx];
+
+                    if (spProcInfo->cmdline[idx + 1])
+                    {
+                        commandLineArgs += " ";
+                    }
+                }
+            }
+        }
+
+        jsProcessInfo["cmd"]        = commandLine;
+        jsProcessInfo["argvs"]      = commandLineArgs;
+        jsProcessInfo["euser"]      = spProcInfo->euser;
+        jsProcessInfo["ruser"]      = spProcInfo->ruser;
+        jsProcessInfo["suser"]      = spProcInfo->suser;
+        jsProcessInfo["egroup"]     = spProcInfo->egroup;
+        jsProcessInfo["rgroup"]     = spProcInfo->rgroup;
+        jsProcessInfo["sgroup"]     = spProcInfo->sgroup;
+        jsProcessInfo["fgroup"]     = spProcInfo->fgroup;
+        jsProcessInfo["priority"]   = spProcInfo->priority;
+        jsProcessInfo["nice"]       = spProcInfo->nice;
+        jsProcessInfo["size"]       = spProcInfo->size;
+        jsProcessInfo["vm_size"]    = spProcInfo->vm_size;
+        jsProcessInfo["resident"]   = spProcInfo->vm_rss;
+        jsProcessInfo["share"]      = spProcInfo->share;
+        jsProcessInfo["start_time"] = Utils::timeTick2unixTime(spProcInfo->start_time);
+        jsProcessInfo["pgrp"]       = spProcInfo->pgrp;
+        jsProcessInfo["session"]    = spProcInfo->session;
+        jsProcessInfo["tgid"]       = spProcInfo->tgid;
+        jsProcessInfo["tty"]        = spProcInfo->tty;
+        jsProcessInfo["processor"]  = spProcInfo->processor;
+        jsProcessInfo["nlwp"]       = spProcInfo->nlwp;
+        callback(jsProcessInfo);
+        spProcInfo.reset(readproc(spProcTable.get(), nullptr));
+    }
+}
+
+static void leanScan(const ProcessCallback& callback)
+{
+    ProcReaderLinux{}.read(callback);
+}
+
+// Idle child processes, so the scan can be measured on a host with many processes
+class SpawnedProcesses final
+{
+    public:
+        explicit SpawnedProcesses(const size_t count)
+        {
+            m_pids.reserve(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto pid {fork()};
+
+                if (pid == 0)
+                {
+                    pause();
+                    _exit(0);
+                }
+
+                if (pid < 0)
+                {
+                    std::cerr << "Unable to spawn more processes: " << std::strerror(errno) << std::endl;
+                    break;
+                }
+
+                m_pids.push_back(pid);
+            }
+        }
+
+        ~SpawnedProcesses()
+        {
+            for (const auto pid : m_pids)
+            {
+                kill(pid, SIGKILL);
+            }
+
+            for (const auto pid : m_pids)
+            {
+                waitpid(pid, nullptr, 0);
+            }
+        }
+
+        SpawnedProcesses(const SpawnedProcesses&) = delete;
+        SpawnedProcesses& operator=(const SpawnedProcesses&) = delete;
+
+        size_t size() const
+        {
+            return m_pids.size();
+        }
+
+    private:
+        std::vector<pid_t> m_pids;
+};
+
+static double processCpuMilliseconds()
+{
+    timespec ts {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1000 + static_cast<double>(ts.tv_nsec) / 1000000;
+}
+
+static void runBenchmark(const std::string& name, const std::function<void(const ProcessCallback&)>& scan, const size_t iterations)
+{
+    size_t processes {0};
+    size_t fields {0};
+    const ProcessCallback callback
+    {
+        [&processes, &fields](nlohmann::json & process)
+        {
+            ++processes;
+            fields += process.size();
+        }
+    };
+
+    // Warm up the page cache and the user and group lookups
+    scan(callback);
+
+    std::vector<double> elapsed;
+    const auto cpuStart {processCpuMilliseconds()};
+    processes = 0;
+    fields = 0;
+
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        const auto start {std::chrono::steady_clock::now()};
+        scan(callback);
+        elapsed.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    const auto cpu {(processCpuMilliseconds() - cpuStart) / static_cast<double>(iterations)};
+    const auto perScan {static_cast<double>(processes) / static_cast<double>(iterations)};
+    std::sort(elapsed.begin(), elapsed.end());
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::left << std::setw(10) << name
+              << " processes/scan: " << std::setw(8) << perScan
+              << " p50: " << std::setw(8) << elapsed[elapsed.size() / 2] << "ms"
+              << " max: " << std::setw(8) << elapsed.back() << "ms"
+              << " cpu/scan: " << std::setw(8) << cpu << "ms"
+              << " cpu/process: " << (perScan > 0 ? cpu * 1000 / perScan : 0) << "us"
+              << " fields/process: " << (processes > 0 ? static_cast<double>(fields) / static_cast<double>(processes) : 0)
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations {0};
+    size_t spawn {0};
+    std::string reader;
+
+    program_options::options_description description {"Compares the processes scan of the lean /proc reader with "
+                                                      "libprocps.\n\nOptions"};
+    description.add_options()
+    (OPT_HELP, "Show this help message")
+    (OPT_ITERATIONS, program_options::value<size_t>(&iterations)->default_value(20), "Number of scans per reader")
+    (OPT_SPAWN, program_options::value<size_t>(&spawn)->default_value(0), "Idle processes to spawn before scanning")
+    (OPT_READER, program_options::value<std::string>(&reader)->default_value("both"), "Reader: lean, readproc or both");
+
+    try
+    {
+        program_options::variables_map options;
+        program_options::store(program_options::parse_command_line(argc, argv, description), options);
+
+        if (options.count(OPT_HELP))
+        {
+            std::cout << description << std::endl;
+            return 0;
+        }
+
+        program_options::notify(options);
+
+        if (iterations == 0 || (reader != "lean" && reader != "readproc" && reader != "both"))
+        {
+            throw std::invalid_argument {"invalid value"};
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n" << description << std::endl;
+        return 1;
+    }
+
+    const SpawnedProcesses spawned {spawn};
+
+    if (spawned.size() > 0)
+    {
+        std::cout << "Spawned " << spawned.size() << " idle processes" << std::endl;
+    }
+
+    if (reader != "lean")
+    {
+        runBenchmark("readproc", readprocScan, iterations);
+    }
+
+    if (reader != "readproc")
+    {
+        runBenchmark("lean", leanScan, iterations);
+    }
+
+    return 0;
+}
@@ -35,6 +35,11 @@ class SysInfo: public ISysInfo
         void packages(std::function<void(nlohmann::json&)>);
         void processes(std::function<void(nlohmann::json&)>);
         nlohmann::json hotfixes();
+        nlohmann::json packagesFingerprints();
+        void packages(const std::set<std::string>&, std::function<void(nlohmann::json&)>);
+        void processes(const std::set<int32_t>&, std::function<void(nlohmann::json&)>);
+        std::unique_ptr<IProcessEventsListener> processEventsListener();
+        std::unique_ptr<INetworkEventsListener> networkEventsListener();
     private:
         virtual nlohmann::json getHardware() const;
         virtual nlohmann::json getPackages() const;
@@ -45,6 +50,11 @@ class SysInfo: public ISysInfo
         virtual nlohmann::json getHotfixes() const;
         virtual void getPackages(std::function<void(nlohmann::json&)>) const;
         virtual void getProcessesInfo(std::function<void(nlohmann::json&)>) const;
+        virtual nlohmann::json getPackagesFingerprints() const;
+        virtual void getPackages(const std::set<std::string>&, std::function<void(nlohmann::json&)>) const;
+        virtual void getProcessesInfo(const std::set<int32_t>&, std::function<void(nlohmann::json&)>) const;
+        virtual std::unique_ptr<IProcessEventsListener> getProcessEventsListener() const;
+        virtual std::unique_ptr<INetworkEventsListener> getNetworkEventsListener() const;
 };
 
 #endif //_SYS_INFO_HPP
@@ -13,6 +13,44 @@
 #define _SYS_INFO_INTERFACE
 
 #include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <set>
+
+class IProcessEventsListener
+{
+    public:
+        // LCOV_EXCL_START
+        virtual ~IProcessEventsListener() = default;
+        // LCOV_EXCL_STOP
+        /**
+         * @brief Waits for process events and collects the processes they affect.
+         *
+         * @param timeout Maximum time to wait for the first event.
+         * @param changed Processes created or modified. Exited ones are removed.
+         * @param exited  Processes that exited. Created ones are removed.
+         *
+         * @return false if events were lost and the collected processes are incomplete.
+         */
+        virtual bool wait(std::chrono::milliseconds timeout, std::set<int32_t>& changed, std::set<int32_t>& exited) = 0;
+};
+
+class INetworkEventsListener
+{
+    public:
+        // LCOV_EXCL_START
+        virtual ~INetworkEventsListener() = default;
+        // LCOV_EXCL_STOP
+        /**
+         * @brief Waits for changes of the network interfaces, their addresses or their routes.
+         *
+         * @param timeout Maximum time to wait for the first change.
+         *
+         * @return true if the networks changed or events were lost since the previous call.
+         */
+        virtual bool wait(std::chrono::milliseconds timeout) = 0;
+};
 
 class ISysInfo
 {
@@ -30,6 +68,11 @@ class ISysInfo
         virtual nlohmann::json hotfixes() = 0;
         virtual void packages(std::function<void(nlohmann::json&)>) = 0;
         virtual void processes(std::function<void(nlohmann::json&)>) = 0;
+        virtual nlohmann::json packagesFingerprints() = 0;
+        virtual void packages(const std::set<std::string>&, std::function<void(nlohmann::json&)>) = 0;
+        virtual void processes(const std::set<int32_t>&, std::function<void(nlohmann::json&)>) = 0;
+        virtual std::unique_ptr<IProcessEventsListener> processEventsListener() = 0;
+        virtual std::unique_ptr<INetworkEventsListener> networkEventsListener() = 0;
 
 };
 
@@ -0,0 +1,130 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "networkEventsListenerLinux.h"
+#include <cerrno>
+#include <poll.h>
+#include <system_error>
+#include <unistd.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+
+constexpr auto RTNETLINK_EVENTS_RCVBUF_SIZE {1024 * 1024};
+constexpr auto RTNETLINK_EVENTS_BUFFER_SIZE {32 * 1024};
+
+NetworkEventsListenerLinux::NetworkEventsListenerLinux()
+    : m_socket{socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE)}
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to open the rtnetlink socket"};
+    }
+
+    // Container churn creates interfaces in bursts, a bigger buffer makes it less likely to lose events
+    const int bufferSize {RTNETLINK_EVENTS_RCVBUF_SIZE};
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE;
+
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        const auto error {errno};
+        close(m_socket);
+        throw std::system_error{error, std::system_category(), "Unable to bind the rtnetlink socket"};
+    }
+}
+
+NetworkEventsListenerLinux::~NetworkEventsListenerLinux()
+{
+    close(m_socket);
+}
+
+bool NetworkEventsListenerLinux::wait(const std::chrono::milliseconds timeout)
+{
+    pollfd descriptor {m_socket, POLLIN, 0};
+    const auto ready {poll(&descriptor, 1, static_cast<int>(timeout.count()))};
+
+    if (ready < 0 && errno != EINTR)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to wait for network events"};
+    }
+
+    bool changed {false};
+    alignas(nlmsghdr) char buffer[RTNETLINK_EVENTS_BUFFER_SIZE];
+
+    // Drain everything queued so a single call returns a whole burst
+    while (ready > 0)
+    {
+        const auto size {recv(m_socket, buffer, sizeof(buffer), 0)};
+
+        if (size < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                // Events were dropped by the kernel, the caller can only rescan
+                changed = true;
+                continue;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            throw std::system_error{errno, std::system_category(), "Unable to read network events"};
+        }
+
+        changed = isRelevant(buffer, static_cast<size_t>(size)) || changed;
+    }
+
+    return changed;
+}
+
+bool NetworkEventsListenerLinux::isRelevant(const char* data, const size_t size)
+{
+    auto header {reinterpret_cast<const nlmsghdr*>(data)};
+    auto remaining {static_cast<unsigned int>(size)};
+
+    for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining))
+    {
+        switch (header->nlmsg_type)
+        {
+            case RTM_NEWLINK:
+            case RTM_DELLINK:
+            case RTM_NEWADDR:
+            case RTM_DELADDR:
+                return true;
+
+            case RTM_NEWROUTE:
+            case RTM_DELROUTE:
+                if (header->nlmsg_len >= NLMSG_LENGTH(sizeof(rtmsg)) &&
+                        reinterpret_cast<const rtmsg*>(NLMSG_DATA(header))->rtm_table == RT_TABLE_MAIN)
+                {
+                    return true;
+                }
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
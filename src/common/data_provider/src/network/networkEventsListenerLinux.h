@@ -0,0 +1,44 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _NETWORK_EVENTS_LISTENER_LINUX_H
+#define _NETWORK_EVENTS_LISTENER_LINUX_H
+
+#include "sysInfoInterface.hpp"
+
+/**
+ * @brief Listens to the interface, address and IPv4 route changes through the rtnetlink multicast groups.
+ *
+ * Only the changes that affect the network inventory are reported: routes of other tables and IPv6 routes are ignored.
+ */
+class NetworkEventsListenerLinux final : public INetworkEventsListener
+{
+    public:
+        /**
+         * @brief Subscribes to the rtnetlink groups.
+         *
+         * @throws std::system_error if the netlink socket cannot be opened or bound.
+         */
+        NetworkEventsListenerLinux();
+        ~NetworkEventsListenerLinux() override;
+
+        NetworkEventsListenerLinux(const NetworkEventsListenerLinux&) = delete;
+        NetworkEventsListenerLinux& operator=(const NetworkEventsListenerLinux&) = delete;
+
+        bool wait(std::chrono::milliseconds timeout) override;
+
+    private:
+        static bool isRelevant(const char* data, size_t size);
+
+        int m_socket;
+};
+
+#endif // _NETWORK_EVENTS_LISTENER_LINUX_H
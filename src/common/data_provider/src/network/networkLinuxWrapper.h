@@ -16,6 +16,7 @@
 #include <net/if_arp.h>
 #include <sys/socket.h>
 #include "inetworkWrapper.h"
+#include "networkRtnetlinkLinux.h"
 #include "networkHelper.h"
 #include "filesystemHelper.h"
 #include "stringHelper.h"
@@ -123,6 +124,18 @@ static const std::map<std::string, std::string> DHCP_STATUS =
     { "bootp",                  "BOOTP"             },
 };
 
+// IF_OPER_* values of linux/if.h, named as in /sys/class/net/<interface>/operstate
+static const std::map<uint8_t, std::string> OPERATIONAL_STATE =
+{
+    { 0,                        "unknown"           },
+    { 1,                        "notpresent"        },
+    { 2,                        "down"              },
+    { 3,                        "lowerlayerdown"    },
+    { 4,                        "testing"           },
+    { 5,                        "dormant"           },
+    { 6,                        "up"                },
+};
+
 namespace GatewayFileFields
 {
     enum
@@ -253,6 +266,83 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
         }
 
     public:
+        /**
+         * @brief Gets the DHCP status of an interface address from the distribution network configuration.
+         *
+         * @param interfacesFile Content of the Debian interfaces file, empty if there is none.
+         * @param family         Address family.
+         * @param ifName         Interface name.
+         * @param network        Where the status is stored.
+         */
+        static void dhcpStatus(const std::string& interfacesFile, const int family, const std::string& ifName, nlohmann::json& network)
+        {
+            network["dhcp"] = UNKNOWN_VALUE;
+
+            if (!interfacesFile.empty())
+            {
+                const auto lines { Utils::split(interfacesFile, '\n') };
+
+                for (const auto& line : lines)
+                {
+                    const auto fields { Utils::split(line, ' ') };
+
+                    if (DebianInterfaceConfig::Size == fields.size())
+                    {
+                        if (fields.at(DebianInterfaceConfig::Type).compare("iface") == 0 &&
+                                fields.at(DebianInterfaceConfig::Name).compare(ifName) == 0)
+                        {
+                            if (AF_INET == family)
+                            {
+                                network["dhcp"] = getDebianDHCPStatus("inet", fields);
+                                break;
+                            }
+                            else if (AF_INET6 == family)
+                            {
+                                network["dhcp"] = getDebianDHCPStatus("inet6", fields);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                const auto fileName { "ifcfg-" + ifName };
+                auto fileData { Utils::getFileContent(WM_SYS_IF_DIR_RH + fileName) };
+                fileData = fileData.empty() ? Utils::getFileContent(WM_SYS_IF_DIR_SUSE + fileName) : fileData;
+
+                if (!fileData.empty())
+                {
+                    const auto lines { Utils::split(fileData, '\n') };
+
+                    for (const auto& line : lines)
+                    {
+                        const auto fields { Utils::split(line, '=') };
+
+                        if (fields.size() == RHInterfaceConfig::Size)
+                        {
+                            if (AF_INET == family)
+                            {
+                                if (fields.at(RHInterfaceConfig::Key).compare("BOOTPROTO") == 0)
+                                {
+                                    network["dhcp"] = getRedHatDHCPStatus(fields);
+                                    break;
+                                }
+                            }
+                            else if (AF_INET6 == family)
+                            {
+                                if (fields.at(RHInterfaceConfig::Key).compare("DHCPV6C") == 0)
+                                {
+                                    network["dhcp"] = getRedHatDHCPStatus(fields);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         explicit NetworkLinuxInterface(ifaddrs* addrs)
             : m_interfaceAddress{ addrs }
             , m_gateway{}
@@ -377,74 +467,7 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         void dhcp(nlohmann::json& network) const override
         {
-            auto fileData { Utils::getFileContent(WM_SYS_IF_FILE) };
-            network["dhcp"] = UNKNOWN_VALUE;
-            const auto family { this->family() };
-            const auto ifName { this->name() };
-
-            if (!fileData.empty())
-            {
-                const auto lines { Utils::split(fileData, '\n') };
-
-                for (const auto& line : lines)
-                {
-                    const auto fields { Utils::split(line, ' ') };
-
-                    if (DebianInterfaceConfig::Size == fields.size())
-                    {
-                        if (fields.at(DebianInterfaceConfig::Type).compare("iface") == 0 &&
-                                fields.at(DebianInterfaceConfig::Name).compare(ifName) == 0)
-                        {
-                            if (AF_INET == family)
-                            {
-                                network["dhcp"] = getDebianDHCPStatus("inet", fields);
-                                break;
-                            }
-                            else if (AF_INET6 == family)
-                            {
-                                network["dhcp"] = getDebianDHCPStatus("inet6", fields);
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                const auto fileName { "ifcfg-" + ifName };
-                fileData = Utils::getFileContent(WM_SYS_IF_DIR_RH + fileName);
-                fileData = fileData.empty() ? Utils::getFileContent(WM_SYS_IF_DIR_SUSE + fileName) : fileData;
-
-                if (!fileData.empty())
-                {
-                    const auto lines { Utils::split(fileData, '\n') };
-
-                    for (const auto& line : lines)
-                    {
-                        const auto fields { Utils::split(line, '=') };
-
-                        if (fields.size() == RHInterfaceConfig::Size)
-                        {
-                            if (AF_INET == family)
-                            {
-                                if (fields.at(RHInterfaceConfig::Key).compare("BOOTPROTO") == 0)
-                                {
-                                    network["dhcp"] = getRedHatDHCPStatus(fields);
-                                    break;
-                                }
-                            }
-                            else if (AF_INET6 == family)
-                            {
-                                if (fields.at(RHInterfaceConfig::Key).compare("DHCPV6C") == 0)
-                                {
-                                    network["dhcp"] = getRedHatDHCPStatus(fields);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            dhcpStatus(Utils::getFileContent(WM_SYS_IF_FILE), this->family(), this->name(), network);
         }
 
         void mtu(nlohmann::json& network) const override
@@ -539,4 +562,159 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
         }
 };
 
+/**
+ * @brief Interface or address dumped through rtnetlink. Nothing is read from /sys or /proc, only the DHCP status comes
+ * from the distribution network configuration.
+ */
+class NetworkRtnetlinkInterface final : public INetworkInterfaceWrapper
+{
+        const NetworkLinkRecord& m_link;
+        const NetworkAddressRecord* m_address;
+        const std::string m_gateway;
+        const std::string m_metrics;
+        const std::string& m_interfacesFile;
+
+    public:
+        /**
+         * @param link           Interface.
+         * @param address        Address of the interface, nullptr for the interface itself.
+         * @param gateway        IPv4 gateway of the interface.
+         * @param metrics        Metric of the IPv4 route of the interface.
+         * @param interfacesFile Content of the Debian interfaces file, empty if there is none.
+         */
+        NetworkRtnetlinkInterface(const NetworkLinkRecord& link,
+                                  const NetworkAddressRecord* address,
+                                  std::string gateway,
+                                  std::string metrics,
+                                  const std::string& interfacesFile)
+            : m_link{ link }
+            , m_address{ address }
+            , m_gateway{ std::move(gateway) }
+            , m_metrics{ std::move(metrics) }
+            , m_interfacesFile{ interfacesFile }
+        {
+        }
+
+        std::string name() const override
+        {
+            return m_link.name;
+        }
+
+        void adapter(nlohmann::json& network) const override
+        {
+            network["adapter"] = EMPTY_VALUE;
+        }
+
+        int family() const override
+        {
+            return m_address ? m_address->family : AF_PACKET;
+        }
+
+        std::string address() const override
+        {
+            return m_address ? m_address->address : EMPTY_VALUE;
+        }
+
+        std::string netmask() const override
+        {
+            return m_address ? m_address->netmask : EMPTY_VALUE;
+        }
+
+        void broadcast(nlohmann::json& network) const override
+        {
+            network["broadcast"] = UNKNOWN_VALUE;
+
+            if (m_address && !m_address->broadcast.empty())
+            {
+                network["broadcast"] = m_address->broadcast;
+            }
+            else
+            {
+                const auto netmask { this->netmask() };
+                const auto address { this->address() };
+
+                if (address.size() && netmask.size())
+                {
+                    const auto broadcast { Utils::NetworkHelper::getBroadcast(address, netmask) };
+
+                    if (!broadcast.empty())
+                    {
+                        network["broadcast"] = broadcast;
+                    }
+                }
+            }
+        }
+
+        std::string addressV6() const override
+        {
+            return address();
+        }
+
+        std::string netmaskV6() const override
+        {
+            return netmask();
+        }
+
+        void broadcastV6(nlohmann::json& network) const override
+        {
+            network["broadcast"] = UNKNOWN_VALUE;
+
+            if (m_address && !m_address->broadcast.empty())
+            {
+                network["broadcast"] = m_address->broadcast;
+            }
+        }
+
+        void gateway(nlohmann::json& network) const override
+        {
+            network["gateway"] = m_gateway;
+        }
+
+        void metrics(nlohmann::json& network) const override
+        {
+            network["metric"] = m_metrics;
+        }
+
+        void metricsV6(nlohmann::json& network) const override
+        {
+            network["metric"] = UNKNOWN_VALUE;
+        }
+
+        void dhcp(nlohmann::json& network) const override
+        {
+            NetworkLinuxInterface::dhcpStatus(m_interfacesFile, this->family(), this->name(), network);
+        }
+
+        void mtu(nlohmann::json& network) const override
+        {
+            network["mtu"] = m_link.mtu;
+        }
+
+        LinkStats stats() const override
+        {
+            return m_link.stats;
+        }
+
+        void type(nlohmann::json& network) const override
+        {
+            network["type"] = Utils::NetworkHelper::getNetworkTypeStringCode(m_link.type, NETWORK_INTERFACE_TYPE);
+        }
+
+        void state(nlohmann::json& network) const override
+        {
+            network["state"] = UNKNOWN_VALUE;
+            const auto it { OPERATIONAL_STATE.find(m_link.operState) };
+
+            if (OPERATIONAL_STATE.end() != it)
+            {
+                network["state"] = it->second;
+            }
+        }
+
+        void MAC(nlohmann::json& network) const override
+        {
+            network["mac"] = m_link.mac;
+        }
+};
+
 #endif // _NETWORK_LINUX_WRAPPER_H
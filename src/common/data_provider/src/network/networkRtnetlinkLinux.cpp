@@ -0,0 +1,415 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "networkRtnetlinkLinux.h"
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "networkHelper.h"
+
+constexpr auto RTNETLINK_BUFFER_SIZE {32 * 1024};
+
+static std::string formatAddress(const int family, const void* data)
+{
+    return Utils::NetworkHelper::IAddressToBinary(family, data);
+}
+
+static std::string formatNetmask(const int family, const unsigned int prefixLength)
+{
+    uint8_t mask[sizeof(in6_addr)] {};
+    const auto size {family == AF_INET ? sizeof(in_addr) : sizeof(in6_addr)};
+
+    for (size_t i = 0; i < size && i * 8 < prefixLength; ++i)
+    {
+        const auto bits {prefixLength - i * 8};
+        mask[i] = bits >= 8 ? 0xFF : static_cast<uint8_t>(0xFF << (8 - bits));
+    }
+
+    return formatAddress(family, mask);
+}
+
+static std::string formatMAC(const uint8_t* data, const size_t size)
+{
+    static constexpr char HEX_DIGITS[] {"0123456789abcdef"};
+    std::string mac;
+    mac.reserve(size * 3);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (i)
+        {
+            mac += ':';
+        }
+
+        mac += HEX_DIGITS[data[i] >> 4];
+        mac += HEX_DIGITS[data[i] & 0x0F];
+    }
+
+    return mac;
+}
+
+// Same figures as /proc/net/dev
+template<typename T>
+static LinkStats linkStats(const T& stats)
+{
+    LinkStats retVal {};
+    retVal.rxPackets = static_cast<unsigned int>(stats.rx_packets);
+    retVal.txPackets = static_cast<unsigned int>(stats.tx_packets);
+    retVal.rxBytes = static_cast<int64_t>(stats.rx_bytes);
+    retVal.txBytes = static_cast<int64_t>(stats.tx_bytes);
+    retVal.rxErrors = static_cast<unsigned int>(stats.rx_errors);
+    retVal.txErrors = static_cast<unsigned int>(stats.tx_errors);
+    retVal.rxDropped = static_cast<unsigned int>(stats.rx_dropped + stats.rx_missed_errors);
+    retVal.txDropped = static_cast<unsigned int>(stats.tx_dropped);
+    return retVal;
+}
+
+RtnetlinkLinux::RtnetlinkLinux()
+    : m_socket{socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)}
+    , m_sequence{0}
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to open the rtnetlink socket"};
+    }
+}
+
+RtnetlinkLinux::~RtnetlinkLinux()
+{
+    close(m_socket);
+}
+
+void RtnetlinkLinux::links(std::vector<NetworkLinkRecord>& records)
+{
+    const ifinfomsg request {};
+
+    dump(RTM_GETLINK, &request, sizeof(request), [&records](const nlmsghdr * header)
+    {
+        if (header->nlmsg_type != RTM_NEWLINK || header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg)))
+        {
+            return;
+        }
+
+        const auto info {reinterpret_cast<const ifinfomsg*>(NLMSG_DATA(header))};
+        NetworkLinkRecord record {};
+        record.index = info->ifi_index;
+        record.type = info->ifi_type;
+        record.flags = info->ifi_flags;
+        bool hasStats64 {false};
+
+        auto attribute {IFLA_RTA(info)};
+        auto remaining {static_cast<int>(IFLA_PAYLOAD(header))};
+
+        for (; RTA_OK(attribute, remaining); attribute = RTA_NEXT(attribute, remaining))
+        {
+            const auto data {RTA_DATA(attribute)};
+            const auto size {RTA_PAYLOAD(attribute)};
+
+            switch (attribute->rta_type)
+            {
+                case IFLA_IFNAME:
+                    record.name.assign(static_cast<const char*>(data), strnlen(static_cast<const char*>(data), size));
+                    break;
+
+                case IFLA_ADDRESS:
+                    record.mac = formatMAC(static_cast<const uint8_t*>(data), size);
+                    break;
+
+                case IFLA_MTU:
+                    if (size >= sizeof(uint32_t))
+                    {
+                        std::memcpy(&record.mtu, data, sizeof(uint32_t));
+                    }
+
+                    break;
+
+                case IFLA_OPERSTATE:
+                    if (size >= sizeof(uint8_t))
+                    {
+                        record.operState = *static_cast<const uint8_t*>(data);
+                    }
+
+                    break;
+
+                case IFLA_STATS64:
+                    if (size >= sizeof(rtnl_link_stats64))
+                    {
+                        rtnl_link_stats64 stats;
+                        std::memcpy(&stats, data, sizeof(stats));
+                        record.stats = linkStats(stats);
+                        hasStats64 = true;
+                    }
+
+                    break;
+
+                case IFLA_STATS:
+                    if (!hasStats64 && size >= sizeof(rtnl_link_stats))
+                    {
+                        rtnl_link_stats stats;
+                        std::memcpy(&stats, data, sizeof(stats));
+                        record.stats = linkStats(stats);
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        records.push_back(std::move(record));
+    });
+}
+
+void RtnetlinkLinux::addresses(std::vector<NetworkAddressRecord>& records)
+{
+    const ifaddrmsg request {};
+
+    dump(RTM_GETADDR, &request, sizeof(request), [&records](const nlmsghdr * header)
+    {
+        if (header->nlmsg_type != RTM_NEWADDR || header->nlmsg_len < NLMSG_LENGTH(sizeof(ifaddrmsg)))
+        {
+            return;
+        }
+
+        const auto info {reinterpret_cast<const ifaddrmsg*>(NLMSG_DATA(header))};
+
+        if (info->ifa_family != AF_INET && info->ifa_family != AF_INET6)
+        {
+            return;
+        }
+
+        const auto addressSize {info->ifa_family == AF_INET ? sizeof(in_addr) : sizeof(in6_addr)};
+        const void* address {nullptr};
+        const void* local {nullptr};
+        const void* broadcast {nullptr};
+
+        auto attribute {IFA_RTA(info)};
+        auto remaining {static_cast<int>(IFA_PAYLOAD(header))};
+
+        for (; RTA_OK(attribute, remaining); attribute = RTA_NEXT(attribute, remaining))
+        {
+            if (RTA_PAYLOAD(attribute) < addressSize)
+            {
+                continue;
+            }
+
+            switch (attribute->rta_type)
+            {
+                case IFA_ADDRESS:
+                    address = RTA_DATA(attribute);
+                    break;
+
+                case IFA_LOCAL:
+                    local = RTA_DATA(attribute);
+                    break;
+
+                case IFA_BROADCAST:
+                    broadcast = RTA_DATA(attribute);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        if (!address && !local)
+        {
+            return;
+        }
+
+        // Same as getifaddrs: when both are reported IFA_LOCAL is the address and IFA_ADDRESS the peer, which is
+        // exposed as the broadcast address unless the kernel reports one
+        NetworkAddressRecord record {};
+        record.index = static_cast<int>(info->ifa_index);
+        record.family = info->ifa_family;
+        record.address = formatAddress(info->ifa_family, local ? local : address);
+        record.netmask = formatNetmask(info->ifa_family, info->ifa_prefixlen);
+
+        if (broadcast)
+        {
+            record.broadcast = formatAddress(info->ifa_family, broadcast);
+        }
+        else if (local && address)
+        {
+            record.broadcast = formatAddress(info->ifa_family, address);
+        }
+
+        records.push_back(std::move(record));
+    });
+}
+
+void RtnetlinkLinux::routes(std::vector<NetworkRouteRecord>& records)
+{
+    rtmsg request {};
+    request.rtm_family = AF_INET;
+
+    dump(RTM_GETROUTE, &request, sizeof(request), [&records](const nlmsghdr * header)
+    {
+        if (header->nlmsg_type != RTM_NEWROUTE || header->nlmsg_len < NLMSG_LENGTH(sizeof(rtmsg)))
+        {
+            return;
+        }
+
+        const auto info {reinterpret_cast<const rtmsg*>(NLMSG_DATA(header))};
+
+        // /proc/net/route only lists the main table, without broadcast and multicast routes
+        if (info->rtm_family != AF_INET || info->rtm_type == RTN_BROADCAST || info->rtm_type == RTN_MULTICAST)
+        {
+            return;
+        }
+
+        uint32_t table {info->rtm_table};
+        NetworkRouteRecord record {};
+
+        auto attribute {RTM_RTA(info)};
+        auto remaining {static_cast<int>(RTM_PAYLOAD(header))};
+
+        for (; RTA_OK(attribute, remaining); attribute = RTA_NEXT(attribute, remaining))
+        {
+            const auto data {RTA_DATA(attribute)};
+            const auto size {RTA_PAYLOAD(attribute)};
+
+            switch (attribute->rta_type)
+            {
+                case RTA_TABLE:
+                    if (size >= sizeof(uint32_t))
+                    {
+                        std::memcpy(&table, data, sizeof(uint32_t));
+                    }
+
+                    break;
+
+                case RTA_OIF:
+                    if (size >= sizeof(int))
+                    {
+                        std::memcpy(&record.index, data, sizeof(int));
+                    }
+
+                    break;
+
+                case RTA_GATEWAY:
+                    if (size >= sizeof(in_addr))
+                    {
+                        record.gateway = formatAddress(AF_INET, data);
+                    }
+
+                    break;
+
+                case RTA_PRIORITY:
+                    if (size >= sizeof(uint32_t))
+                    {
+                        std::memcpy(&record.priority, data, sizeof(uint32_t));
+                    }
+
+                    break;
+
+                case RTA_MULTIPATH:
+                    // /proc/net/route shows the first next hop of multipath routes
+                    if (size >= sizeof(rtnexthop))
+                    {
+                        const auto nextHop {static_cast<const rtnexthop*>(data)};
+                        record.index = nextHop->rtnh_ifindex;
+
+                        auto nextHopAttribute {RTNH_DATA(nextHop)};
+                        auto nextHopRemaining {static_cast<int>(nextHop->rtnh_len) - static_cast<int>(RTNH_LENGTH(0))};
+
+                        for (; RTA_OK(nextHopAttribute, nextHopRemaining); nextHopAttribute = RTA_NEXT(nextHopAttribute, nextHopRemaining))
+                        {
+                            if (nextHopAttribute->rta_type == RTA_GATEWAY && RTA_PAYLOAD(nextHopAttribute) >= sizeof(in_addr))
+                            {
+                                record.gateway = formatAddress(AF_INET, RTA_DATA(nextHopAttribute));
+                            }
+                        }
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        if (table == RT_TABLE_MAIN && record.index > 0)
+        {
+            records.push_back(std::move(record));
+        }
+    });
+}
+
+void RtnetlinkLinux::dump(const uint16_t type,
+                          const void* request,
+                          const size_t size,
+                          const std::function<void(const nlmsghdr*)>& callback)
+{
+    alignas(nlmsghdr) char message[NLMSG_SPACE(sizeof(rtmsg) > sizeof(ifinfomsg) ? sizeof(rtmsg) : sizeof(ifinfomsg))] {};
+    const auto header {reinterpret_cast<nlmsghdr*>(message)};
+    header->nlmsg_len = NLMSG_LENGTH(size);
+    header->nlmsg_type = type;
+    header->nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    header->nlmsg_seq = ++m_sequence;
+    std::memcpy(NLMSG_DATA(header), request, size);
+
+    sockaddr_nl kernel {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(m_socket, message, header->nlmsg_len, 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to request the network data"};
+    }
+
+    alignas(nlmsghdr) char buffer[RTNETLINK_BUFFER_SIZE];
+
+    for (;;)
+    {
+        const auto received {recv(m_socket, buffer, sizeof(buffer), 0)};
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::system_error{errno, std::system_category(), "Unable to read the network data"};
+        }
+
+        auto reply {reinterpret_cast<const nlmsghdr*>(buffer)};
+        auto remaining {static_cast<unsigned int>(received)};
+
+        for (; NLMSG_OK(reply, remaining); reply = NLMSG_NEXT(reply, remaining))
+        {
+            if (reply->nlmsg_seq != m_sequence)
+            {
+                continue;
+            }
+
+            if (reply->nlmsg_type == NLMSG_DONE)
+            {
+                return;
+            }
+
+            if (reply->nlmsg_type == NLMSG_ERROR)
+            {
+                const auto error {reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(reply))};
+                throw std::system_error{-error->error, std::system_category(), "Unable to dump the network data"};
+            }
+
+            callback(reply);
+        }
+    }
+}
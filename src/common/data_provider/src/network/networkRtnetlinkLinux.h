@@ -0,0 +1,105 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _NETWORK_RTNETLINK_LINUX_H
+#define _NETWORK_RTNETLINK_LINUX_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <linux/netlink.h>
+#include "inetworkInterface.h"
+
+/**
+ * @brief Network interface as reported by RTM_GETLINK.
+ */
+struct NetworkLinkRecord
+{
+    int index;
+    unsigned short type;
+    unsigned int flags;
+    uint8_t operState;
+    uint32_t mtu;
+    std::string name;
+    std::string mac;
+    LinkStats stats;
+};
+
+/**
+ * @brief Interface address as reported by RTM_GETADDR, formatted as getifaddrs does. The broadcast is empty when the
+ * kernel reports none.
+ */
+struct NetworkAddressRecord
+{
+    int index;
+    int family;
+    std::string address;
+    std::string netmask;
+    std::string broadcast;
+};
+
+/**
+ * @brief IPv4 route of the main table as reported by RTM_GETROUTE. The gateway is empty for direct routes.
+ */
+struct NetworkRouteRecord
+{
+    int index;
+    std::string gateway;
+    uint32_t priority;
+};
+
+/**
+ * @brief Dumps the interfaces, addresses and routes through NETLINK_ROUTE, one request for each of them.
+ */
+class RtnetlinkLinux final
+{
+    public:
+        /**
+         * @brief Opens the rtnetlink socket.
+         *
+         * @throws std::system_error if the socket cannot be opened.
+         */
+        RtnetlinkLinux();
+        ~RtnetlinkLinux();
+
+        RtnetlinkLinux(const RtnetlinkLinux&) = delete;
+        RtnetlinkLinux& operator=(const RtnetlinkLinux&) = delete;
+
+        /**
+         * @brief Appends every interface to the records.
+         *
+         * @throws std::system_error if the kernel cannot dump them.
+         */
+        void links(std::vector<NetworkLinkRecord>& records);
+
+        /**
+         * @brief Appends every IPv4 and IPv6 address to the records.
+         *
+         * @throws std::system_error if the kernel cannot dump them.
+         */
+        void addresses(std::vector<NetworkAddressRecord>& records);
+
+        /**
+         * @brief Appends the IPv4 routes of the main table to the records, in the order of /proc/net/route.
+         *
+         * @throws std::system_error if the kernel cannot dump them.
+         */
+        void routes(std::vector<NetworkRouteRecord>& records);
+
+    private:
+        void dump(uint16_t type, const void* request, size_t size, const std::function<void(const nlmsghdr*)>& callback);
+
+        int m_socket;
+        uint32_t m_sequence;
+};
+
+#endif // _NETWORK_RTNETLINK_LINUX_H
@@ -40,6 +40,16 @@ class ModernFactoryPackagesCreator final
         static void getPackages(const std::map<std::string, std::set<std::string>>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/)
         {
         }
+
+        static void getPackages(const std::map<std::string, std::set<std::string>>& /*paths*/,
+                                const std::set<std::string>& /*formats*/,
+                                std::function<void(nlohmann::json&)> /*callback*/)
+        {
+        }
+
+        static void getFingerprints(const std::map<std::string, std::set<std::string>>& /*paths*/, nlohmann::json& /*fingerprints*/)
+        {
+        }
 };
 
 // Standard template to extract package information in fully compatible Linux
@@ -53,6 +63,71 @@ class ModernFactoryPackagesCreator<true> final
             PYPI().getPackages(paths.at("PYPI"), callback);
             NPM().getPackages(paths.at("NPM"), callback);
         }
+
+        static void getPackages(const std::map<std::string, std::set<std::string>>& paths,
+                                const std::set<std::string>& formats,
+                                std::function<void(nlohmann::json&)> callback)
+        {
+            if (formats.count("pypi"))
+            {
+                PYPI().getPackages(paths.at("PYPI"), callback);
+            }
+
+            if (formats.count("npm"))
+            {
+                NPM().getPackages(paths.at("NPM"), callback);
+            }
+        }
+
+        /**
+         * @brief Fingerprints the package directories from their modification time
+         *
+         * Installing or removing a package adds or removes an entry in its site-packages or
+         * node_modules directory, which updates the directory modification time.
+         *
+         * @param paths        Base directories, as given to getPackages.
+         * @param fingerprints Object where the "pypi" and "npm" fingerprints are set.
+         */
+        static void getFingerprints(const std::map<std::string, std::set<std::string>>& paths, nlohmann::json& fingerprints)
+        {
+            fingerprints["pypi"] = getDirectoriesFingerprint(paths.at("PYPI"), "");
+            fingerprints["npm"] = getDirectoriesFingerprint(paths.at("NPM"), "node_modules");
+        }
+
+    private:
+        static std::string getDirectoriesFingerprint(const std::set<std::string>& osRootFolders, const std::string& subdirectory)
+        {
+            std::string fingerprint;
+
+            for (const auto& osFolder : osRootFolders)
+            {
+                std::deque<std::string> expandedPaths;
+
+                try
+                {
+                    Utils::expandAbsolutePath(osFolder, expandedPaths);
+                }
+                catch (const std::exception&)
+                {
+                    // Do nothing, continue with the next path
+                }
+
+                for (const auto& expandedPath : expandedPaths)
+                {
+                    std::error_code ec;
+                    const auto path {subdirectory.empty() ? std::filesystem::path(expandedPath)
+                                     : std::filesystem::path(expandedPath) / subdirectory};
+                    const auto lastWrite {std::filesystem::last_write_time(path, ec)};
+
+                    if (!ec)
+                    {
+                        fingerprint += path.string() + ":" + std::to_string(lastWrite.time_since_epoch().count()) + ";";
+                    }
+                }
+            }
+
+            return fingerprint;
+        }
 };
 
 #endif  // _MODERN_PACKAGE_DATA_RETRIEVER_HPP
@@ -13,6 +13,8 @@
 #define _PACKAGE_LINUX_DATA_RETRIEVER_H
 
 #include <memory>
+#include <set>
+#include <sys/stat.h>
 #include "filesystemHelper.h"
 #include <nlohmann/json.hpp>
 #include "sharedDefs.h"
@@ -43,6 +45,46 @@ void getDpkgInfo(const std::string& libPath, std::function<void(nlohmann::json&)
  */
 void getSnapInfo(std::function<void(nlohmann::json&)> callback);
 
+/**
+ * @brief Builds a cheap fingerprint of a set of files from their metadata
+ * @param paths Files to be fingerprinted, missing ones are skipped
+ * @return Device, inode, size and modification time of every existing file
+ */
+static inline std::string getFilesFingerprint(const std::set<std::string>& paths)
+{
+    std::string fingerprint;
+
+    for (const auto& path : paths)
+    {
+        struct stat info {};
+
+        if (0 == stat(path.c_str(), &info))
+        {
+            fingerprint += path + ":" + std::to_string(info.st_dev) + ":" + std::to_string(info.st_ino) + ":" +
+                           std::to_string(info.st_size) + ":" + std::to_string(info.st_mtim.tv_sec) + "." +
+                           std::to_string(info.st_mtim.tv_nsec) + ";";
+        }
+    }
+
+    return fingerprint;
+}
+
+/**
+ * @brief Gets the files whose metadata changes whenever the rpm database changes
+ * @return rpm database directory and files
+ */
+static inline std::set<std::string> getRpmDatabaseFiles()
+{
+    std::set<std::string> files {RPM_PATH};
+
+    for (const auto& file : RPM_DATABASE_FILES)
+    {
+        files.insert(std::string(RPM_PATH) + file);
+    }
+
+    return files;
+}
+
 // Exception template
 template <LinuxType linuxType>
 class FactoryPackagesCreator final
@@ -55,6 +97,18 @@ class FactoryPackagesCreator final
                 "Error creating package data retriever."
             };
         }
+
+        static void getPackages(const std::set<std::string>& /*formats*/, std::function<void(nlohmann::json&)> /*callback*/)
+        {
+            throw std::runtime_error
+            {
+                "Error creating package data retriever."
+            };
+        }
+
+        static void getFingerprints(nlohmann::json& /*fingerprints*/)
+        {
+        }
 };
 
 // Standard template to extract package information in fully compatible Linux systems
@@ -64,21 +118,44 @@ class FactoryPackagesCreator<LinuxType::STANDARD> final
     public:
         static void getPackages(std::function<void(nlohmann::json&)> callback)
         {
-            if (Utils::existsDir(DPKG_PATH))
+            getPackages({"deb", "rpm", "snap"}, callback);
+        }
+
+        static void getPackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback)
+        {
+            if (formats.count("deb") && Utils::existsDir(DPKG_PATH))
             {
                 getDpkgInfo(DPKG_STATUS_PATH, callback);
             }
 
-            if (Utils::existsDir(RPM_PATH))
+            if (formats.count("rpm") && Utils::existsDir(RPM_PATH))
             {
                 getRpmInfo(callback);
             }
 
-            if (Utils::existsDir(SNAP_PATH))
+            if (formats.count("snap") && Utils::existsDir(SNAP_PATH))
             {
                 getSnapInfo(callback);
             }
         }
+
+        static void getFingerprints(nlohmann::json& fingerprints)
+        {
+            if (Utils::existsDir(DPKG_PATH))
+            {
+                fingerprints["deb"] = getFilesFingerprint({DPKG_STATUS_PATH});
+            }
+
+            if (Utils::existsDir(RPM_PATH))
+            {
+                fingerprints["rpm"] = getFilesFingerprint(getRpmDatabaseFiles());
+            }
+
+            if (Utils::existsDir(SNAP_PATH))
+            {
+                fingerprints["snap"] = getFilesFingerprint({SNAP_STATE_PATH});
+            }
+        }
 };
 
 // Template to extract package information in partially incompatible Linux systems
@@ -88,11 +165,24 @@ class FactoryPackagesCreator<LinuxType::LEGACY> final
     public:
         static void getPackages(std::function<void(nlohmann::json&)> callback)
         {
-            if (Utils::existsDir(RPM_PATH))
+            getPackages({"rpm"}, callback);
+        }
+
+        static void getPackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback)
+        {
+            if (formats.count("rpm") && Utils::existsDir(RPM_PATH))
             {
                 getRpmInfoLegacy(callback);
             }
         }
+
+        static void getFingerprints(nlohmann::json& fingerprints)
+        {
+            if (Utils::existsDir(RPM_PATH))
+            {
+                fingerprints["rpm"] = getFilesFingerprint(getRpmDatabaseFiles());
+            }
+        }
 };
 
 #endif // _PACKAGE_LINUX_DATA_RETRIEVER_H
@@ -14,6 +14,7 @@
 
 #include <netinet/tcp.h>
 #include "iportWrapper.h"
+#include "portSockDiagLinux.h"
 #include "sharedDefs.h"
 #include "bits/stdc++.h"
 
@@ -288,4 +289,101 @@ class LinuxPortWrapper final : public IPortWrapper
         }
 };
 
+class LinuxSockDiagPortWrapper final : public IPortWrapper
+{
+        const SocketRecord* m_record;
+
+        static std::string address(const PortType type, const uint32_t (&address)[4])
+        {
+            if (IPVERSION_TYPE.at(type) == IPV4)
+            {
+                in_addr addr {};
+                addr.s_addr = address[0];
+                return Utils::NetworkHelper::IAddressToBinary(AF_INET, &addr);
+            }
+
+            in6_addr sin6 {};
+            std::memcpy(sin6.s6_addr32, address, sizeof(sin6.s6_addr32));
+            return Utils::NetworkHelper::IAddressToBinary(AF_INET6, &sin6);
+        }
+
+    public:
+        LinuxSockDiagPortWrapper()
+            : m_record { nullptr }
+        { }
+
+        ~LinuxSockDiagPortWrapper() = default;
+
+        // The wrapper is reused for every socket of a scan, so no object is allocated per socket
+        void record(const SocketRecord& record)
+        {
+            m_record = &record;
+        }
+
+        void protocol(nlohmann::json& port) const override
+        {
+            port["protocol"] = PORTS_TYPE.at(m_record->type);
+        }
+
+        void localIp(nlohmann::json& port) const override
+        {
+            port["local_ip"] = address(m_record->type, m_record->localAddress);
+        }
+
+        void localPort(nlohmann::json& port) const override
+        {
+            port["local_port"] = m_record->localPort;
+        }
+
+        void remoteIP(nlohmann::json& port) const override
+        {
+            port["remote_ip"] = address(m_record->type, m_record->remoteAddress);
+        }
+
+        void remotePort(nlohmann::json& port) const override
+        {
+            port["remote_port"] = m_record->remotePort;
+        }
+
+        void txQueue(nlohmann::json& port) const override
+        {
+            port["tx_queue"] = m_record->txQueue;
+        }
+
+        void rxQueue(nlohmann::json& port) const override
+        {
+            port["rx_queue"] = m_record->rxQueue;
+        }
+
+        void inode(nlohmann::json& port) const override
+        {
+            port["inode"] = static_cast<int64_t>(m_record->inode);
+        }
+
+        void state(nlohmann::json& port) const override
+        {
+            port["state"] = UNKNOWN_VALUE;
+
+            if (PROTOCOL_TYPE.at(m_record->type) == TCP)
+            {
+                const auto itState { STATE_TYPE.find(m_record->state) };
+
+                if (STATE_TYPE.end() != itState)
+                {
+                    port["state"] = itState->second;
+                }
+            }
+        }
+
+        void processName(nlohmann::json& port) const override
+        {
+            port["process"] = UNKNOWN_VALUE;
+        }
+
+        void pid(nlohmann::json& port) const override
+        {
+            port["pid"] = UNKNOWN_VALUE;
+        }
+};
+
 #endif //_PORT_LINUX_WRAPPER_H
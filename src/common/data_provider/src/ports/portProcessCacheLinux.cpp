@@ -0,0 +1,217 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "portProcessCacheLinux.h"
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iterator>
+#include <unistd.h>
+#include "sharedDefs.h"
+
+constexpr auto SOCKET_LINK_PREFIX {"socket:["};
+constexpr auto LINK_BUFFER_SIZE {64};
+constexpr auto STAT_BUFFER_SIZE {1024};
+
+static bool isPid(const char* name)
+{
+    if (*name == '\0')
+    {
+        return false;
+    }
+
+    for (; *name; ++name)
+    {
+        if (*name < '0' || *name > '9')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static std::string processName(const int pidFd)
+{
+    std::string name {EMPTY_VALUE};
+    const auto fd {openat(pidFd, "stat", O_RDONLY | O_CLOEXEC)};
+
+    if (fd >= 0)
+    {
+        char stat[STAT_BUFFER_SIZE];
+        const auto size {read(fd, stat, sizeof(stat) - 1)};
+        close(fd);
+
+        if (size > 0)
+        {
+            stat[size] = '\0';
+            // The command name can contain spaces and parentheses, it ends at the last ')'
+            const auto nameStart {strchr(stat, '(')};
+            const auto nameEnd {strrchr(stat, ')')};
+
+            if (nameStart && nameEnd && nameEnd > nameStart)
+            {
+                name.assign(nameStart + 1, nameEnd);
+            }
+        }
+    }
+
+    return name;
+}
+
+PortProcessCacheLinux::PortProcessCacheLinux(std::string procPath)
+    : m_procPath{std::move(procPath)}
+{
+}
+
+ProcessInfo PortProcessCacheLinux::resolve(const std::unordered_set<int64_t>& inodes)
+{
+    std::lock_guard<std::mutex> lock {m_mutex};
+    std::unordered_map<int32_t, bool> alive;
+
+    // Sockets that were closed are forgotten, and so are the owners that exited: the socket may have been inherited
+    for (auto it {m_owners.begin()}; it != m_owners.end();)
+    {
+        const auto pid {it->second.first};
+        auto itAlive {alive.find(pid)};
+
+        if (itAlive == alive.end())
+        {
+            itAlive = alive.emplace(pid, isAlive(pid)).first;
+        }
+
+        it = inodes.count(it->first) && itAlive->second ? std::next(it) : m_owners.erase(it);
+    }
+
+    for (auto it {m_unresolved.begin()}; it != m_unresolved.end();)
+    {
+        it = inodes.count(*it) ? std::next(it) : m_unresolved.erase(it);
+    }
+
+    std::unordered_set<int64_t> unknown;
+
+    for (const auto inode : inodes)
+    {
+        // Sockets in TIME_WAIT have no inode
+        if (inode != 0 && !m_owners.count(inode) && !m_unresolved.count(inode))
+        {
+            unknown.insert(inode);
+        }
+    }
+
+    if (!unknown.empty())
+    {
+        unknown.insert(m_unresolved.begin(), m_unresolved.end());
+        walk(unknown);
+        m_unresolved = std::move(unknown);
+    }
+
+    return m_owners;
+}
+
+bool PortProcessCacheLinux::isAlive(const int32_t pid) const
+{
+    return access((m_procPath + "/" + std::to_string(pid)).c_str(), F_OK) == 0;
+}
+
+void PortProcessCacheLinux::walk(std::unordered_set<int64_t>& unknown)
+{
+    const auto procDir {opendir(m_procPath.c_str())};
+
+    if (!procDir)
+    {
+        return;
+    }
+
+    const auto prefixLength {strlen(SOCKET_LINK_PREFIX)};
+
+    while (!unknown.empty())
+    {
+        const auto entry {readdir(procDir)};
+
+        if (!entry)
+        {
+            break;
+        }
+
+        if (!isPid(entry->d_name))
+        {
+            continue;
+        }
+
+        const auto pidFd {openat(dirfd(procDir), entry->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+
+        if (pidFd < 0)
+        {
+            continue;
+        }
+
+        const auto fdFd {openat(pidFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+        const auto fdDir {fdFd >= 0 ? fdopendir(fdFd) : nullptr};
+
+        if (!fdDir)
+        {
+            if (fdFd >= 0)
+            {
+                close(fdFd);
+            }
+
+            close(pidFd);
+            continue;
+        }
+
+        const auto pid {static_cast<int32_t>(std::strtol(entry->d_name, nullptr, 10))};
+        std::string name;
+
+        while (!unknown.empty())
+        {
+            const auto fdEntry {readdir(fdDir)};
+
+            if (!fdEntry)
+            {
+                break;
+            }
+
+            char link[LINK_BUFFER_SIZE];
+            const auto size {readlinkat(dirfd(fdDir), fdEntry->d_name, link, sizeof(link) - 1)};
+
+            if (size <= 0)
+            {
+                continue;
+            }
+
+            link[size] = '\0';
+
+            if (strncmp(link, SOCKET_LINK_PREFIX, prefixLength) != 0)
+            {
+                continue;
+            }
+
+            const auto inode {std::strtoll(link + prefixLength, nullptr, 10)};
+
+            if (unknown.erase(inode))
+            {
+                if (name.empty())
+                {
+                    name = processName(pidFd);
+                }
+
+                m_owners.emplace(inode, std::make_pair(pid, name));
+            }
+        }
+
+        closedir(fdDir);
+        close(pidFd);
+    }
+
+    closedir(procDir);
+}
@@ -0,0 +1,58 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PORT_PROCESS_CACHE_LINUX_H
+#define _PORT_PROCESS_CACHE_LINUX_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
+
+/**
+ * @brief Maps socket inodes to the process that owns them.
+ *
+ * The owners are kept between scans. The /proc/<pid>/fd directories are only walked when a socket is not known yet
+ * or its owner has exited, and the walk stops as soon as every unknown socket is found. Sockets without owner are
+ * remembered too, they are looked up again only when a walk is needed for other sockets.
+ */
+class PortProcessCacheLinux final
+{
+    public:
+        /**
+         * @param procPath Mount point of the proc filesystem.
+         */
+        explicit PortProcessCacheLinux(std::string procPath = "/proc");
+
+        /**
+         * @brief Gets the owners of the sockets. Sockets that are not in the list are forgotten.
+         *
+         * @param inodes Inodes of the current sockets.
+         *
+         * @return Pid and process name of each socket with a known owner.
+         */
+        ProcessInfo resolve(const std::unordered_set<int64_t>& inodes);
+
+    private:
+        bool isAlive(int32_t pid) const;
+        void walk(std::unordered_set<int64_t>& unknown);
+
+        const std::string m_procPath;
+        ProcessInfo m_owners;
+        std::unordered_set<int64_t> m_unresolved;
+        std::mutex m_mutex;
+};
+
+#endif // _PORT_PROCESS_CACHE_LINUX_H
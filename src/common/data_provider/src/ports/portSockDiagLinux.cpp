@@ -0,0 +1,127 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "portSockDiagLinux.h"
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+constexpr auto SOCK_DIAG_BUFFER_SIZE {32 * 1024};
+// Pending connections, reported as SYN_RECV in /proc/net/tcp
+constexpr uint8_t TCP_NEW_SYN_RECV_STATE {12};
+
+SockDiagLinux::SockDiagLinux()
+    : m_socket{socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG)}
+    , m_sequence{0}
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to open the sock_diag socket"};
+    }
+}
+
+SockDiagLinux::~SockDiagLinux()
+{
+    close(m_socket);
+}
+
+void SockDiagLinux::dump(const PortType type, std::vector<SocketRecord>& records)
+{
+    const auto tcp {type == TCP_IPV4 || type == TCP_IPV6};
+
+    struct
+    {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message {};
+
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.header.nlmsg_seq = ++m_sequence;
+    message.request.sdiag_family = type == TCP_IPV4 || type == UDP_IPV4 ? AF_INET : AF_INET6;
+    message.request.sdiag_protocol = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+    message.request.idiag_states = ~0U;
+
+    sockaddr_nl kernel {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(m_socket, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to request the sockets"};
+    }
+
+    alignas(nlmsghdr) char buffer[SOCK_DIAG_BUFFER_SIZE];
+
+    for (;;)
+    {
+        const auto size {recv(m_socket, buffer, sizeof(buffer), 0)};
+
+        if (size < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::system_error{errno, std::system_category(), "Unable to read the sockets"};
+        }
+
+        auto header {reinterpret_cast<const nlmsghdr*>(buffer)};
+        auto remaining {static_cast<unsigned int>(size)};
+
+        for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining))
+        {
+            if (header->nlmsg_seq != m_sequence)
+            {
+                continue;
+            }
+
+            if (header->nlmsg_type == NLMSG_DONE)
+            {
+                return;
+            }
+
+            if (header->nlmsg_type == NLMSG_ERROR)
+            {
+                const auto error {reinterpret_cast<const nlmsgerr*>(NLMSG_DATA(header))};
+                throw std::system_error{-error->error, std::system_category(), "Unable to dump the sockets"};
+            }
+
+            if (header->nlmsg_type != SOCK_DIAG_BY_FAMILY || header->nlmsg_len < NLMSG_LENGTH(sizeof(inet_diag_msg)))
+            {
+                continue;
+            }
+
+            const auto diag {reinterpret_cast<const inet_diag_msg*>(NLMSG_DATA(header))};
+            SocketRecord record {};
+            record.type = type;
+            record.state = diag->idiag_state == TCP_NEW_SYN_RECV_STATE ? static_cast<uint8_t>(TCP_SYN_RECV) : diag->idiag_state;
+            record.localPort = ntohs(diag->id.idiag_sport);
+            record.remotePort = ntohs(diag->id.idiag_dport);
+            std::memcpy(record.localAddress, diag->id.idiag_src, sizeof(record.localAddress));
+            std::memcpy(record.remoteAddress, diag->id.idiag_dst, sizeof(record.remoteAddress));
+            record.rxQueue = diag->idiag_rqueue;
+            // For listening sockets the kernel reports the backlog size, /proc/net/tcp reports nothing pending
+            record.txQueue = tcp && diag->idiag_state == TCP_LISTEN ? 0 : diag->idiag_wqueue;
+            record.inode = diag->idiag_inode;
+            records.push_back(record);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PORT_SOCK_DIAG_LINUX_H
+#define _PORT_SOCK_DIAG_LINUX_H
+
+#include <cstdint>
+#include <vector>
+#include "sharedDefs.h"
+
+/**
+ * @brief Socket as reported by the kernel. Addresses and ports are kept as in /proc/net: addresses in network order,
+ * ports in host order.
+ */
+struct SocketRecord
+{
+    PortType type;
+    uint8_t state;
+    uint16_t localPort;
+    uint16_t remotePort;
+    uint32_t localAddress[4];
+    uint32_t remoteAddress[4];
+    uint32_t txQueue;
+    uint32_t rxQueue;
+    uint64_t inode;
+};
+
+/**
+ * @brief Enumerates the TCP and UDP sockets through NETLINK_SOCK_DIAG.
+ */
+class SockDiagLinux final
+{
+    public:
+        /**
+         * @brief Opens the sock_diag netlink socket.
+         *
+         * @throws std::system_error if the socket cannot be opened.
+         */
+        SockDiagLinux();
+        ~SockDiagLinux();
+
+        SockDiagLinux(const SockDiagLinux&) = delete;
+        SockDiagLinux& operator=(const SockDiagLinux&) = delete;
+
+        /**
+         * @brief Appends the sockets of a type to the records.
+         *
+         * @param type    Protocol and IP version of the sockets.
+         * @param records Where the sockets are appended.
+         *
+         * @throws std::system_error if the kernel cannot dump the sockets, i.e. the udp_diag module is not loaded.
+         */
+        void dump(PortType type, std::vector<SocketRecord>& records);
+
+    private:
+        int m_socket;
+        uint32_t m_sequence;
+};
+
+#endif // _PORT_SOCK_DIAG_LINUX_H
@@ -0,0 +1,345 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "procReaderLinux.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <grp.h>
+#include <pwd.h>
+#include <unistd.h>
+#include "linuxInfoHelper.h"
+
+// The stat line is far shorter, even with the longest command name
+constexpr auto STAT_BUFFER_SIZE {1024};
+// Tgid, Uid and Gid are in the first lines of status, before the ones that can grow (Groups, Cpus_allowed_list...)
+constexpr auto STATUS_BUFFER_SIZE {4096};
+constexpr auto CMDLINE_BUFFER_SIZE {4096};
+constexpr auto NAME_BUFFER_SIZE {1024};
+constexpr auto NAME_BUFFER_MAX_SIZE {1024 * 1024};
+
+// Position of the stat fields, counting from the state (the first field after the command name)
+constexpr auto STAT_PPID_FIELD {1};
+constexpr auto STAT_TTY_FIELD {4};
+constexpr auto STAT_START_TIME_FIELD {19};
+
+static ssize_t readFile(const int dirFd, const char* name, char* buffer, const size_t size)
+{
+    const auto fd {openat(dirFd, name, O_RDONLY | O_CLOEXEC)};
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    size_t total {0};
+
+    while (total < size)
+    {
+        const auto bytes {::read(fd, buffer + total, size - total)};
+
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (bytes <= 0)
+        {
+            break;
+        }
+
+        total += static_cast<size_t>(bytes);
+    }
+
+    close(fd);
+    return static_cast<ssize_t>(total);
+}
+
+static bool isPid(const char* name)
+{
+    if (*name == '\0')
+    {
+        return false;
+    }
+
+    for (; *name; ++name)
+    {
+        if (*name < '0' || *name > '9')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Reads the real, effective and saved ids of an "Uid:" or "Gid:" line of status
+static bool parseIds(const char* status, const char* key, unsigned long (&ids)[3])
+{
+    const auto line {strstr(status, key)};
+
+    if (!line)
+    {
+        return false;
+    }
+
+    auto cursor {line + strlen(key)};
+
+    for (auto& id : ids)
+    {
+        char* end {};
+        id = strtoul(cursor, &end, 10);
+
+        if (end == cursor)
+        {
+            return false;
+        }
+
+        cursor = end;
+    }
+
+    return true;
+}
+
+template<typename Entry, typename Id>
+static std::string lookupName(const Id id,
+                              int (*lookup)(Id, Entry*, char*, size_t, Entry**),
+                              char* Entry::*name)
+{
+    std::vector<char> buffer(NAME_BUFFER_SIZE);
+    Entry entry {};
+    Entry* result {};
+    auto ret {lookup(id, &entry, buffer.data(), buffer.size(), &result)};
+
+    // Groups with many members need a bigger buffer
+    while (ret == ERANGE && buffer.size() < NAME_BUFFER_MAX_SIZE)
+    {
+        buffer.resize(buffer.size() * 2);
+        ret = lookup(id, &entry, buffer.data(), buffer.size(), &result);
+    }
+
+    return ret == 0 && result ? std::string{result->*name} : std::to_string(id);
+}
+
+ProcReaderLinux::ProcReaderLinux(const std::string& procPath)
+    : m_procDir{opendir(procPath.c_str())}
+    , m_cmdline(CMDLINE_BUFFER_SIZE)
+{
+    if (!m_procDir)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to open " + procPath};
+    }
+}
+
+ProcReaderLinux::~ProcReaderLinux()
+{
+    closedir(m_procDir);
+}
+
+void ProcReaderLinux::read(const std::function<void(nlohmann::json&)>& callback)
+{
+    rewinddir(m_procDir);
+
+    while (const auto entry {readdir(m_procDir)})
+    {
+        nlohmann::json process;
+
+        if (isPid(entry->d_name) && readProcess(entry->d_name, process))
+        {
+            callback(process);
+        }
+    }
+}
+
+void ProcReaderLinux::read(const std::set<int32_t>& pids, const std::function<void(nlohmann::json&)>& callback)
+{
+    for (const auto pid : pids)
+    {
+        nlohmann::json process;
+
+        if (pid > 0 && readProcess(std::to_string(pid).c_str(), process))
+        {
+            callback(process);
+        }
+    }
+}
+
+bool ProcReaderLinux::readProcess(const char* pid, nlohmann::json& process)
+{
+    // Every file is opened relative to the process directory, so the paths are resolved once
+    const auto pidFd {openat(dirfd(m_procDir), pid, O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+
+    if (pidFd < 0)
+    {
+        return false;
+    }
+
+    char stat[STAT_BUFFER_SIZE];
+    char status[STATUS_BUFFER_SIZE];
+    const auto statSize {readFile(pidFd, "stat", stat, sizeof(stat) - 1)};
+    const auto statusSize {statSize > 0 ? readFile(pidFd, "status", status, sizeof(status) - 1) : -1};
+
+    if (statusSize <= 0)
+    {
+        // The process exited while it was being read
+        close(pidFd);
+        return false;
+    }
+
+    stat[statSize] = '\0';
+    status[statusSize] = '\0';
+
+    // The command name can contain spaces and parentheses, it ends at the last ')'
+    const auto nameStart {strchr(stat, '(')};
+    const auto nameEnd {strrchr(stat, ')')};
+    const auto tgidLine {strstr(status, "\nTgid:")};
+    unsigned long uids[3] {};
+    unsigned long gids[3] {};
+
+    if (!nameStart || !nameEnd || nameEnd < nameStart || strlen(nameEnd) < 3 || !tgidLine ||
+            !parseIds(status, "\nUid:", uids) || !parseIds(status, "\nGid:", gids))
+    {
+        close(pidFd);
+        return false;
+    }
+
+    const auto tgid {strtoll(tgidLine + strlen("\nTgid:"), nullptr, 10)};
+
+    // A thread id is also reachable under /proc, only processes are reported
+    if (tgid != strtoll(pid, nullptr, 10))
+    {
+        close(pidFd);
+        return false;
+    }
+
+    long long fields[STAT_START_TIME_FIELD + 1] {};
+    // Skip the space and the state
+    auto cursor {nameEnd + 3};
+
+    for (auto field {STAT_PPID_FIELD}; field <= STAT_START_TIME_FIELD; ++field)
+    {
+        char* end {};
+        fields[field] = strtoll(cursor, &end, 10);
+
+        if (end == cursor)
+        {
+            close(pidFd);
+            return false;
+        }
+
+        cursor = end;
+    }
+
+    process["pid"]        = pid;
+    process["name"]       = std::string{nameStart + 1, nameEnd};
+    process["ppid"]       = fields[STAT_PPID_FIELD];
+    readCmdline(pidFd, process);
+    process["euser"]      = userName(static_cast<uid_t>(uids[1]));
+    process["ruser"]      = userName(static_cast<uid_t>(uids[0]));
+    process["suser"]      = userName(static_cast<uid_t>(uids[2]));
+    process["egroup"]     = groupName(static_cast<gid_t>(gids[1]));
+    process["rgroup"]     = groupName(static_cast<gid_t>(gids[0]));
+    process["sgroup"]     = groupName(static_cast<gid_t>(gids[2]));
+    process["start_time"] = Utils::timeTick2unixTime(static_cast<uint64_t>(fields[STAT_START_TIME_FIELD]));
+    process["tgid"]       = tgid;
+    process["tty"]        = fields[STAT_TTY_FIELD];
+
+    close(pidFd);
+    return true;
+}
+
+void ProcReaderLinux::readCmdline(const int pidFd, nlohmann::json& process)
+{
+    size_t size {0};
+    const auto fd {openat(pidFd, "cmdline", O_RDONLY | O_CLOEXEC)};
+
+    if (fd >= 0)
+    {
+        // The buffer is kept between processes and only grows for the longest command lines
+        for (;;)
+        {
+            if (size == m_cmdline.size())
+            {
+                m_cmdline.resize(m_cmdline.size() * 2);
+            }
+
+            const auto bytes {::read(fd, m_cmdline.data() + size, m_cmdline.size() - size)};
+
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (bytes <= 0)
+            {
+                break;
+            }
+
+            size += static_cast<size_t>(bytes);
+        }
+
+        close(fd);
+    }
+
+    // Arguments are separated by '\0', the first one is the command and the rest are joined with spaces
+    const auto begin {m_cmdline.data()};
+    const auto end {begin + (size > 0 && m_cmdline[size - 1] == '\0' ? size - 1 : size)};
+    const auto commandEnd {std::find(begin, end, '\0')};
+    std::string arguments;
+
+    for (auto argument {commandEnd}; argument != end;)
+    {
+        const auto argumentStart {argument + 1};
+        const auto argumentEnd {std::find(argumentStart, end, '\0')};
+
+        if (argumentStart != argumentEnd)
+        {
+            arguments.append(argumentStart, argumentEnd);
+
+            if (argumentEnd != end)
+            {
+                arguments += ' ';
+            }
+        }
+
+        argument = argumentEnd;
+    }
+
+    process["cmd"]   = std::string{begin, commandEnd};
+    process["argvs"] = std::move(arguments);
+}
+
+const std::string& ProcReaderLinux::userName(const uid_t uid)
+{
+    auto it {m_users.find(uid)};
+
+    if (it == m_users.end())
+    {
+        it = m_users.emplace(uid, lookupName<passwd, uid_t>(uid, getpwuid_r, &passwd::pw_name)).first;
+    }
+
+    return it->second;
+}
+
+const std::string& ProcReaderLinux::groupName(const gid_t gid)
+{
+    auto it {m_groups.find(gid)};
+
+    if (it == m_groups.end())
+    {
+        it = m_groups.emplace(gid, lookupName<group, gid_t>(gid, getgrgid_r, &group::gr_name)).first;
+    }
+
+    return it->second;
+}
@@ -0,0 +1,75 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PROC_READER_LINUX_H
+#define _PROC_READER_LINUX_H
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <dirent.h>
+#include <sys/types.h>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Reads the processes straight from /proc.
+ *
+ * Only stat, status and cmdline are read, through openat on the process directory, and only the fields stored by
+ * the processes inventory are reported: pid, name, ppid, cmd, argvs, the user and group names, start_time, tgid
+ * and tty.
+ */
+class ProcReaderLinux final
+{
+    public:
+        /**
+         * @brief Opens the proc filesystem.
+         *
+         * @param procPath Mount point of the proc filesystem.
+         *
+         * @throws std::system_error if the directory cannot be opened.
+         */
+        explicit ProcReaderLinux(const std::string& procPath = "/proc");
+        ~ProcReaderLinux();
+
+        ProcReaderLinux(const ProcReaderLinux&) = delete;
+        ProcReaderLinux& operator=(const ProcReaderLinux&) = delete;
+
+        /**
+         * @brief Reports every process.
+         *
+         * @param callback Called once per process.
+         */
+        void read(const std::function<void(nlohmann::json&)>& callback);
+
+        /**
+         * @brief Reports the given processes. Processes that no longer exist and thread ids are skipped.
+         *
+         * @param pids     Ids of the processes.
+         * @param callback Called once per process.
+         */
+        void read(const std::set<int32_t>& pids, const std::function<void(nlohmann::json&)>& callback);
+
+    private:
+        bool readProcess(const char* pid, nlohmann::json& process);
+        void readCmdline(int pidFd, nlohmann::json& process);
+        const std::string& userName(uid_t uid);
+        const std::string& groupName(gid_t gid);
+
+        DIR* m_procDir;
+        std::vector<char> m_cmdline;
+        std::unordered_map<uid_t, std::string> m_users;
+        std::unordered_map<gid_t, std::string> m_groups;
+};
+
+#endif // _PROC_READER_LINUX_H
@@ -0,0 +1,214 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "processEventsListenerLinux.h"
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <system_error>
+#include <unistd.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+constexpr auto PROC_CONNECTOR_RCVBUF_SIZE {4 * 1024 * 1024};
+constexpr auto PROC_CONNECTOR_BUFFER_SIZE {64 * 1024};
+
+ProcessEventsListenerLinux::ProcessEventsListenerLinux()
+    : m_socket{socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_CONNECTOR)}
+{
+    if (m_socket < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to open the proc connector socket"};
+    }
+
+    // Process bursts can outpace the reader, a bigger buffer makes it less likely to lose events
+    const int bufferSize {PROC_CONNECTOR_RCVBUF_SIZE};
+
+    if (setsockopt(m_socket, SOL_SOCKET, SO_RCVBUFFORCE, &bufferSize, sizeof(bufferSize)) < 0)
+    {
+        setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    }
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+
+    try
+    {
+        if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+        {
+            throw std::system_error{errno, std::system_category(), "Unable to bind the proc connector socket"};
+        }
+
+        subscribe(true);
+    }
+    catch (...)
+    {
+        close(m_socket);
+        throw;
+    }
+}
+
+ProcessEventsListenerLinux::~ProcessEventsListenerLinux()
+{
+    try
+    {
+        subscribe(false);
+    }
+    // LCOV_EXCL_START
+    catch (...)
+    {
+    }
+
+    // LCOV_EXCL_STOP
+
+    close(m_socket);
+}
+
+void ProcessEventsListenerLinux::subscribe(const bool enable)
+{
+    constexpr auto PAYLOAD_SIZE {sizeof(cn_msg) + sizeof(proc_cn_mcast_op)};
+    alignas(nlmsghdr) char request[NLMSG_SPACE(PAYLOAD_SIZE)] {};
+
+    const auto header {reinterpret_cast<nlmsghdr*>(request)};
+    header->nlmsg_len = NLMSG_LENGTH(PAYLOAD_SIZE);
+    header->nlmsg_type = NLMSG_DONE;
+
+    const auto message {reinterpret_cast<cn_msg*>(NLMSG_DATA(header))};
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(proc_cn_mcast_op);
+
+    const proc_cn_mcast_op operation {enable ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE};
+    std::memcpy(message->data, &operation, sizeof(operation));
+
+    if (send(m_socket, request, header->nlmsg_len, 0) < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to subscribe to the proc connector"};
+    }
+}
+
+bool ProcessEventsListenerLinux::wait(const std::chrono::milliseconds timeout,
+                                      std::set<int32_t>& changed,
+                                      std::set<int32_t>& exited)
+{
+    pollfd descriptor {m_socket, POLLIN, 0};
+    const auto ready {poll(&descriptor, 1, static_cast<int>(timeout.count()))};
+
+    if (ready < 0 && errno != EINTR)
+    {
+        throw std::system_error{errno, std::system_category(), "Unable to wait for process events"};
+    }
+
+    bool complete {true};
+    alignas(nlmsghdr) char buffer[PROC_CONNECTOR_BUFFER_SIZE];
+
+    // Drain everything queued so a single call returns a whole burst
+    while (ready > 0)
+    {
+        const auto size {recv(m_socket, buffer, sizeof(buffer), 0)};
+
+        if (size < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                // The socket buffer overflowed and events were dropped by the kernel
+                complete = false;
+                continue;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            throw std::system_error{errno, std::system_category(), "Unable to read process events"};
+        }
+
+        handleMessage(buffer, static_cast<size_t>(size), changed, exited);
+    }
+
+    return complete;
+}
+
+void ProcessEventsListenerLinux::handleMessage(const char* data,
+                                               size_t size,
+                                               std::set<int32_t>& changed,
+                                               std::set<int32_t>& exited)
+{
+    auto header {reinterpret_cast<const nlmsghdr*>(data)};
+    auto remaining {static_cast<unsigned int>(size)};
+
+    for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining))
+    {
+        if (header->nlmsg_type == NLMSG_NOOP || header->nlmsg_type == NLMSG_ERROR)
+        {
+            continue;
+        }
+
+        const auto message {reinterpret_cast<const cn_msg*>(NLMSG_DATA(header))};
+
+        if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC)
+        {
+            continue;
+        }
+
+        const auto event {reinterpret_cast<const proc_event*>(message->data)};
+        const auto markChanged {[&changed, &exited](const int32_t pid, const int32_t tgid)
+        {
+            // Thread events are ignored, the inventory only stores processes
+            if (pid == tgid)
+            {
+                changed.insert(pid);
+                exited.erase(pid);
+            }
+        }};
+
+        switch (event->what)
+        {
+            case proc_event::PROC_EVENT_FORK:
+                markChanged(event->event_data.fork.child_pid, event->event_data.fork.child_tgid);
+                break;
+
+            case proc_event::PROC_EVENT_EXEC:
+                markChanged(event->event_data.exec.process_pid, event->event_data.exec.process_tgid);
+                break;
+
+            case proc_event::PROC_EVENT_UID:
+            case proc_event::PROC_EVENT_GID:
+                markChanged(event->event_data.id.process_pid, event->event_data.id.process_tgid);
+                break;
+
+            case proc_event::PROC_EVENT_COMM:
+                markChanged(event->event_data.comm.process_pid, event->event_data.comm.process_tgid);
+                break;
+
+            case proc_event::PROC_EVENT_EXIT:
+                if (event->event_data.exit.process_pid == event->event_data.exit.process_tgid)
+                {
+                    exited.insert(event->event_data.exit.process_pid);
+                    changed.erase(event->event_data.exit.process_pid);
+                }
+
+                break;
+
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PROCESS_EVENTS_LISTENER_LINUX_H
+#define _PROCESS_EVENTS_LISTENER_LINUX_H
+
+#include "sysInfoInterface.hpp"
+
+/**
+ * @brief Listens to the kernel process events through the netlink proc connector.
+ *
+ * Requires CAP_NET_ADMIN. Only events of processes are reported, thread events are ignored.
+ */
+class ProcessEventsListenerLinux final : public IProcessEventsListener
+{
+    public:
+        /**
+         * @brief Subscribes to the proc connector.
+         *
+         * @throws std::system_error if the netlink socket cannot be opened or subscribed.
+         */
+        ProcessEventsListenerLinux();
+        ~ProcessEventsListenerLinux() override;
+
+        ProcessEventsListenerLinux(const ProcessEventsListenerLinux&) = delete;
+        ProcessEventsListenerLinux& operator=(const ProcessEventsListenerLinux&) = delete;
+
+        bool wait(std::chrono::milliseconds timeout, std::set<int32_t>& changed, std::set<int32_t>& exited) override;
+
+    private:
+        void subscribe(bool enable);
+        void handleMessage(const char* data, size_t size, std::set<int32_t>& changed, std::set<int32_t>& exited);
+
+        int m_socket;
+};
+
+#endif // _PROCESS_EVENTS_LISTENER_LINUX_H
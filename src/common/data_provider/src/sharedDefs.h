@@ -30,8 +30,10 @@ constexpr auto DPKG_PATH {"/var/lib/dpkg/"};
 constexpr auto DPKG_STATUS_PATH {"/var/lib/dpkg/status"};
 
 constexpr auto RPM_PATH {"/var/lib/rpm/"};
+static const std::set<std::string> RPM_DATABASE_FILES {"Packages", "Packages.db", "rpmdb.sqlite", "rpmdb.sqlite-wal"};
 
 constexpr auto SNAP_PATH {"/var/lib/snapd"};
+constexpr auto SNAP_STATE_PATH {"/var/lib/snapd/state.json"};
 
 constexpr auto UNKNOWN_VALUE {nullptr};
 constexpr auto EMPTY_VALUE {""};
@@ -57,6 +57,31 @@ nlohmann::json SysInfo::hotfixes()
     return getHotfixes();
 }
 
+nlohmann::json SysInfo::packagesFingerprints()
+{
+    return getPackagesFingerprints();
+}
+
+void SysInfo::packages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback)
+{
+    getPackages(formats, callback);
+}
+
+void SysInfo::processes(const std::set<int32_t>& pids, std::function<void(nlohmann::json&)> callback)
+{
+    getProcessesInfo(pids, callback);
+}
+
+std::unique_ptr<IProcessEventsListener> SysInfo::processEventsListener()
+{
+    return getProcessEventsListener();
+}
+
+std::unique_ptr<INetworkEventsListener> SysInfo::networkEventsListener()
+{
+    return getNetworkEventsListener();
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,34 +19,20 @@
 #include "cmdHelper.h"
 #include "osinfo/sysOsParsers.h"
 #include "sysInfo.hpp"
-#include <proc/readproc.h>
 #include "networkUnixHelper.h"
 #include "networkHelper.h"
 #include "network/networkLinuxWrapper.h"
 #include "network/networkFamilyDataAFactory.h"
+#include "network/networkEventsListenerLinux.h"
 #include "ports/portLinuxWrapper.h"
 #include "ports/portImpl.h"
+#include "ports/portProcessCacheLinux.h"
 #include "packages/berkeleyRpmDbHelper.h"
 #include "packages/packageLinuxDataRetriever.h"
+#include "processes/processEventsListenerLinux.h"
+#include "processes/procReaderLinux.h"
 #include "linuxInfoHelper.h"
 
-using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
-
-struct ProcTableDeleter
-{
-    void operator()(PROCTAB* proc)
-    {
-        closeproc(proc);
-    }
-    void operator()(proc_t* proc)
-    {
-        freeproc(proc);
-    }
-};
-
-using SysInfoProcessesTable = std::unique_ptr<PROCTAB, ProcTableDeleter>;
-using SysInfoProcess        = std::unique_ptr<proc_t, ProcTableDeleter>;
-
 static void parseLineAndFillMap(const std::string& line, const std::string& separator, std::map<std::string, std::string>& systemInfo)
 {
     const auto pos{line.find(separator)};
@@ -79,64 +65,6 @@ static bool getSystemInfo(const std::string& fileName, const std::string& separa
     return ret;
 }
 
-static nlohmann::json getProcessInfo(const SysInfoProcess& process)
-{
-    nlohmann::json jsProcessInfo{};
-    // Current process information
-    jsProcessInfo["pid"]        = std::to_string(process->tid);
-    jsProcessInfo["name"]       = process->cmd;
-    jsProcessInfo["state"]      = &process->state;
-    jsProcessInfo["ppid"]       = process->ppid;
-    jsProcessInfo["utime"]      = process->utime;
-    jsProcessInfo["stime"]      = process->stime;
-    std::string commandLine;
-    std::string commandLineArgs;
-
-    if (process->cmdline && process->cmdline[0])
-    {
-        commandLine = process->cmdline[0];
-
-        for (int idx = 1; process->cmdline[idx]; ++idx)
-        {
-            const auto cmdlineArgSize { sizeof(process->cmdline[idx]) };
-
-            if (strnlen(process->cmdline[idx], cmdlineArgSize) != 0)
-            {
-                commandLineArgs += process->cmdline[idx];
-
-                if (process->cmdline[idx + 1])
-                {
-                    commandLineArgs += " ";
-                }
-            }
-        }
-    }
-
-    jsProcessInfo["cmd"]        = commandLine;
-    jsProcessInfo["argvs"]      = commandLineArgs;
-    jsProcessInfo["euser"]      = process->euser;
-    jsProcessInfo["ruser"]      = process->ruser;
-    jsProcessInfo["suser"]      = process->suser;
-    jsProcessInfo["egroup"]     = process->egroup;
-    jsProcessInfo["rgroup"]     = process->rgroup;
-    jsProcessInfo["sgroup"]     = process->sgroup;
-    jsProcessInfo["fgroup"]     = process->fgroup;
-    jsProcessInfo["priority"]   = process->priority;
-    jsProcessInfo["nice"]       = process->nice;
-    jsProcessInfo["size"]       = process->size;
-    jsProcessInfo["vm_size"]    = process->vm_size;
-    jsProcessInfo["resident"]   = process->vm_rss;
-    jsProcessInfo["share"]      = process->share;
-    jsProcessInfo["start_time"] = Utils::timeTick2unixTime(process->start_time);
-    jsProcessInfo["pgrp"]       = process->pgrp;
-    jsProcessInfo["session"]    = process->session;
-    jsProcessInfo["tgid"]       = process->tgid;
-    jsProcessInfo["tty"]        = process->tty;
-    jsProcessInfo["processor"]  = process->processor;
-    jsProcessInfo["nlwp"]       = process->nlwp;
-    return jsProcessInfo;
-}
-
 static void getSerialNumber(nlohmann::json& info)
 {
     info["board_serial"] = EMPTY_VALUE;
@@ -375,7 +303,7 @@ nlohmann::json SysInfo::getProcessesInfo() const
     return jsProcessesList;
 }
 
-nlohmann::json SysInfo::getNetworks() const
+static nlohmann::json getIfaddrsNetworks()
 {
     nlohmann::json networks;
 
@@ -403,160 +331,200 @@ nlohmann::json SysInfo::getNetworks() const
     return networks;
 }
 
-
-ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_t>& inodes)
+static nlohmann::json getRtnetlinkNetworks()
 {
-    ProcessInfo ret;
-    auto getProcessName = [](const std::string & filePath) -> std::string
+    nlohmann::json networks;
+    std::vector<NetworkLinkRecord> links;
+    std::vector<NetworkAddressRecord> addresses;
+    std::vector<NetworkRouteRecord> routes;
+
+    RtnetlinkLinux rtnetlink;
+    rtnetlink.links(links);
+    rtnetlink.addresses(addresses);
+    rtnetlink.routes(routes);
+
+    // Same gateway and metric as taken from /proc/net/route: the first route with a gateway, otherwise the metric of
+    // the last route of the interface
+    std::unordered_map<int, std::pair<std::string, std::string>> gateways;
+
+    for (const auto& route : routes)
     {
-        // Get stat file content.
-        std::string processInfo { EMPTY_VALUE };
-        const std::string statContent {Utils::getFileContent(filePath)};
+        auto& gateway { gateways[route.index] };
 
-        const auto openParenthesisPos {statContent.find("(")};
-        const auto closeParenthesisPos {statContent.find(")")};
+        if (gateway.first.empty())
+        {
+            gateway.first = route.gateway;
+            gateway.second = std::to_string(route.priority);
+        }
+    }
 
-        if (openParenthesisPos != std::string::npos && closeParenthesisPos != std::string::npos)
+    std::unordered_map<int, std::vector<const NetworkAddressRecord*>> interfaceAddresses;
+
+    for (const auto& address : addresses)
+    {
+        interfaceAddresses[address.index].push_back(&address);
+    }
+
+    std::map<std::string, const NetworkLinkRecord*> interfaces;
+
+    for (const auto& link : links)
+    {
+        if (!(link.flags & IFF_LOOPBACK))
         {
-            processInfo = statContent.substr(openParenthesisPos + 1, closeParenthesisPos - openParenthesisPos - 1);
+            interfaces.emplace(link.name, &link);
         }
+    }
 
-        return processInfo;
-    };
+    // Read once instead of once per address
+    const auto interfacesFile { Utils::getFileContent(WM_SYS_IF_FILE) };
 
-    auto findInode = [](const std::string & filePath) -> int64_t
+    for (const auto& interface : interfaces)
     {
-        constexpr size_t MAX_LENGTH {256};
-        char buffer[MAX_LENGTH] = "";
+        const auto& link { *interface.second };
+        const auto itGateway { gateways.find(link.index) };
+        const auto gateway { itGateway != gateways.end() ? itGateway->second.first : EMPTY_VALUE };
+        const auto metrics { itGateway != gateways.end() ? itGateway->second.second : EMPTY_VALUE };
+        nlohmann::json ifaddr {};
+
+        FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, nullptr, gateway, metrics, interfacesFile))->buildNetworkData(ifaddr);
 
-        if (-1 == readlink(filePath.c_str(), buffer, MAX_LENGTH - 1))
+        const auto itAddresses { interfaceAddresses.find(link.index) };
+
+        if (itAddresses != interfaceAddresses.end())
         {
-            throw std::system_error(errno, std::system_category(), "readlink");
+            for (const auto address : itAddresses->second)
+            {
+                FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, address, gateway, metrics, interfacesFile))->buildNetworkData(ifaddr);
+            }
         }
 
-        // ret format is "socket:[<num>]".
-        const std::string bufferStr {buffer};
-        const auto openBracketPos {bufferStr.find("[")};
-        const auto closeBracketPos {bufferStr.find("]")};
-        const auto match {bufferStr.substr(openBracketPos + 1, closeBracketPos - openBracketPos - 1)};
+        networks["iface"].push_back(ifaddr);
+    }
 
-        return std::stoll(match);
-    };
+    return networks;
+}
 
-    if (Utils::existsDir(procPath))
+nlohmann::json SysInfo::getNetworks() const
+{
+    try
+    {
+        return getRtnetlinkNetworks();
+    }
+    catch (const std::system_error& e)
     {
-        std::vector<std::string> procFiles = Utils::enumerateDir(procPath);
+        std::cerr << "Error while dumping the networks through rtnetlink, falling back to getifaddrs: " << e.what() << std::endl;
+    }
 
-        // Iterate proc directory.
-        for (const auto& procFile : procFiles)
-        {
-            // Only directories that represent a PID are inspected.
-            const std::string procFilePath {procPath + "/" + procFile};
+    return getIfaddrsNetworks();
+}
 
-            if (Utils::isNumber(procFile) && Utils::existsDir(procFilePath))
-            {
-                // Only fd directory is inspected.
-                const std::string pidFilePath {procFilePath + "/fd"};
+std::unique_ptr<INetworkEventsListener> SysInfo::getNetworkEventsListener() const
+{
+    return std::make_unique<NetworkEventsListenerLinux>();
+}
 
-                if (Utils::existsDir(pidFilePath))
-                {
-                    std::vector<std::string> fdFiles = Utils::enumerateDir(pidFilePath);
 
-                    // Iterate fd directory.
-                    for (const auto& fdFile : fdFiles)
-                    {
-                        // Only sysmlinks that represent a socket are read.
-                        const std::string fdFilePath {pidFilePath + "/" + fdFile};
+static void getProcNetPorts(const PortType type, nlohmann::json& ports)
+{
+    const auto fileContent { Utils::getFileContent(WM_SYS_NET_DIR + PORTS_TYPE.at(type)) };
+    auto rows { Utils::split(fileContent, '\n') };
+    auto fileBody { false };
 
-                        if (!Utils::startsWith(fdFile, ".") && Utils::existsSocket(fdFilePath))
-                        {
-                            try
-                            {
-                                int64_t inode {findInode(fdFilePath)};
-
-                                if (std::any_of(inodes.cbegin(), inodes.cend(), [&](const auto it)
-                            {
-                                return it == inode;
-                            }))
-                                {
-                                    std::string statPath {procFilePath + "/" + "stat"};
-                                    std::string processName = getProcessName(statPath);
-                                    int32_t pid { std::stoi(procFile) };
-
-                                    ret.emplace(std::make_pair(inode, std::make_pair(pid, processName)));
-                                }
-                            }
-                            catch (const std::exception& e)
-                            {
-                                std::cerr << "Error: " << e.what() << std::endl;
-                            }
-                        }
-                    }
-                }
+    for (auto& row : rows)
+    {
+        nlohmann::json port {};
+
+        try
+        {
+            if (fileBody)
+            {
+                row = Utils::trim(row);
+                Utils::replaceAll(row, "\t", " ");
+                Utils::replaceAll(row, "  ", " ");
+                std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(type, row))->buildPortData(port);
+                ports.push_back(std::move(port));
             }
+
+            fileBody = true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error while parsing port: " << e.what() << std::endl;
         }
     }
+}
 
-    return ret;
+static void getSockDiagPorts(SockDiagLinux& sockDiag, const PortType type, nlohmann::json& ports)
+{
+    std::vector<SocketRecord> records;
+    // Nothing is reported until the whole dump succeeds, so a failure can fall back to /proc/net
+    sockDiag.dump(type, records);
+
+    const auto spWrapper { std::make_shared<LinuxSockDiagPortWrapper>() };
+    PortImpl portImpl { spWrapper };
+
+    for (const auto& record : records)
+    {
+        nlohmann::json port {};
+        spWrapper->record(record);
+        portImpl.buildPortData(port);
+        ports.push_back(std::move(port));
+    }
 }
 
 nlohmann::json SysInfo::getPorts() const
 {
+    // The socket owners are kept between scans, only new sockets require walking /proc/<pid>/fd
+    static PortProcessCacheLinux processCache { WM_SYS_PROC_DIR };
     nlohmann::json ports;
-    std::deque<int64_t> inodes;
+    std::unique_ptr<SockDiagLinux> spSockDiag;
 
-    for (const auto& portType : PORTS_TYPE)
+    try
     {
-        const auto fileContent { Utils::getFileContent(WM_SYS_NET_DIR + portType.second) };
-        auto rows { Utils::split(fileContent, '\n') };
-        auto fileBody { false };
+        spSockDiag = std::make_unique<SockDiagLinux>();
+    }
+    catch (const std::system_error& e)
+    {
+        std::cerr << "Error while opening sock_diag, falling back to /proc/net: " << e.what() << std::endl;
+    }
 
-        for (auto& row : rows)
+    for (const auto& portType : PORTS_TYPE)
+    {
+        try
         {
-            nlohmann::json port {};
-
-            try
-            {
-                if (fileBody)
-                {
-                    row = Utils::trim(row);
-                    Utils::replaceAll(row, "\t", " ");
-                    Utils::replaceAll(row, "  ", " ");
-                    std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(portType.first, row))->buildPortData(port);
-                    inodes.push_back(port.at("inode"));
-                    ports.push_back(std::move(port));
-                }
-
-                fileBody = true;
-            }
-            catch (const std::exception& e)
+            if (spSockDiag)
             {
-                std::cerr << "Error while parsing port: " << e.what() << std::endl;
+                getSockDiagPorts(*spSockDiag, portType.first, ports);
+                continue;
             }
         }
+        catch (const std::system_error& e)
+        {
+            std::cerr << "Error while dumping " << portType.second << " sockets, falling back to /proc/net: " << e.what() << std::endl;
+        }
+
+        getProcNetPorts(portType.first, ports);
     }
 
+    std::unordered_set<int64_t> inodes;
+
+    for (const auto& port : ports)
+    {
+        inodes.insert(port.at("inode").get<int64_t>());
+    }
 
     if (!inodes.empty())
     {
-        ProcessInfo ret = portProcessInfo(WM_SYS_PROC_DIR, inodes);
+        const auto ret { processCache.resolve(inodes) };
 
         for (auto& port : ports)
         {
-            try
-            {
-                auto portInode = port.at("inode");
+            const auto it { ret.find(port.at("inode").get<int64_t>()) };
 
-                if (ret.find(portInode) != ret.end())
-                {
-                    std::pair<int32_t, std::string> processInfoPair = ret.at(portInode);
-                    port["pid"] = processInfoPair.first;
-                    port["process"] = processInfoPair.second;
-                }
-            }
-            catch (const std::exception& e)
+            if (it != ret.end())
             {
-                std::cerr << "Error while parsing pid and process from ports: " << e.what() << std::endl;
+                port["pid"] = it->second.first;
+                port["process"] = it->second.second;
             }
         }
     }
@@ -566,32 +534,43 @@ nlohmann::json SysInfo::getPorts() const
 
 void SysInfo::getProcessesInfo(std::function<void(nlohmann::json&)> callback) const
 {
+    ProcReaderLinux{}.read(callback);
+}
 
-    const SysInfoProcessesTable spProcTable
-    {
-        openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM | PROC_FILLENV)
-    };
-
-    SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
+void SysInfo::getProcessesInfo(const std::set<int32_t>& pids, std::function<void(nlohmann::json&)> callback) const
+{
+    ProcReaderLinux{}.read(pids, callback);
+}
 
-    while (nullptr != spProcInfo)
-    {
-        // Get process information object and push it to the caller
-        auto processInfo = getProcessInfo(spProcInfo);
-        callback(processInfo);
-        spProcInfo.reset(readproc(spProcTable.get(), nullptr));
-    }
+std::unique_ptr<IProcessEventsListener> SysInfo::getProcessEventsListener() const
+{
+    return std::make_unique<ProcessEventsListenerLinux>();
 }
 
+static const std::map<std::string, std::set<std::string>> MODERN_PACKAGES_SEARCH_PATHS
+{
+    {"PYPI", UNIX_PYPI_DEFAULT_BASE_DIRS},
+    {"NPM", UNIX_NPM_DEFAULT_BASE_DIRS}
+};
+
 void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
 {
     FactoryPackagesCreator<LINUX_TYPE>::getPackages(callback);
-    std::map<std::string, std::set<std::string>> searchPaths =
-    {
-        {"PYPI", UNIX_PYPI_DEFAULT_BASE_DIRS},
-        {"NPM", UNIX_NPM_DEFAULT_BASE_DIRS}
-    };
-    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(MODERN_PACKAGES_SEARCH_PATHS, callback);
+}
+
+nlohmann::json SysInfo::getPackagesFingerprints() const
+{
+    nlohmann::json fingerprints = nlohmann::json::object();
+    FactoryPackagesCreator<LINUX_TYPE>::getFingerprints(fingerprints);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getFingerprints(MODERN_PACKAGES_SEARCH_PATHS, fingerprints);
+    return fingerprints;
+}
+
+void SysInfo::getPackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback) const
+{
+    FactoryPackagesCreator<LINUX_TYPE>::getPackages(formats, callback);
+    ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(MODERN_PACKAGES_SEARCH_PATHS, formats, callback);
 }
 
 nlohmann::json SysInfo::getHotfixes() const
@@ -103,6 +103,34 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> /*callback*/) con
     // TODO
 }
 
+void SysInfo::getProcessesInfo(const std::set<int32_t>& /*pids*/, std::function<void(nlohmann::json&)> /*callback*/) const
+{
+    // TODO
+}
+
+std::unique_ptr<IProcessEventsListener> SysInfo::getProcessEventsListener() const
+{
+    // Currently not supported for this OS.
+    return nullptr;
+}
+
+std::unique_ptr<INetworkEventsListener> SysInfo::getNetworkEventsListener() const
+{
+    // Currently not supported for this OS.
+    return nullptr;
+}
+
+nlohmann::json SysInfo::getPackagesFingerprints() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json::object();
+}
+
+void SysInfo::getPackages(const std::set<std::string>& /*formats*/, std::function<void(nlohmann::json&)> /*callback*/) const
+{
+    // TODO
+}
+
 nlohmann::json SysInfo::getHotfixes() const
 {
     // Currently not supported for this OS.
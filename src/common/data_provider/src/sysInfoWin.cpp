@@ -912,6 +912,46 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
 
     ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
 }
+
+void SysInfo::getProcessesInfo(const std::set<int32_t>& pids, std::function<void(nlohmann::json&)> callback) const
+{
+    getProcessesInfo([&pids, &callback](nlohmann::json & data)
+    {
+        if (data.contains("pid") && data.at("pid").is_string() && pids.count(static_cast<int32_t>(std::stoll(data.at("pid").get<std::string>()))))
+        {
+            callback(data);
+        }
+    });
+}
+
+std::unique_ptr<IProcessEventsListener> SysInfo::getProcessEventsListener() const
+{
+    // Currently not supported for this OS.
+    return nullptr;
+}
+
+std::unique_ptr<INetworkEventsListener> SysInfo::getNetworkEventsListener() const
+{
+    // Currently not supported for this OS.
+    return nullptr;
+}
+
+nlohmann::json SysInfo::getPackagesFingerprints() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json::object();
+}
+
+void SysInfo::getPackages(const std::set<std::string>& formats, std::function<void(nlohmann::json&)> callback) const
+{
+    getPackages([&formats, &callback](nlohmann::json & data)
+    {
+        if (data.contains("format") && data.at("format").is_string() && formats.count(data.at("format").get<std::string>()))
+        {
+            callback(data);
+        }
+    });
+}
 nlohmann::json SysInfo::getHotfixes() const
 {
     std::set<std::string> hotfixes;
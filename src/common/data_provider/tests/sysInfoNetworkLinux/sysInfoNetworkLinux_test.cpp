@@ -9,9 +9,11 @@
  * Foundation.
  */
 #include <ifaddrs.h>
+#include <net/if.h>
 #include "sysInfoNetworkLinux_test.h"
 #include "network/networkInterfaceLinux.h"
 #include "network/networkFamilyDataAFactory.h"
+#include "network/networkLinuxWrapper.h"
 
 void SysInfoNetworkLinuxTest::SetUp() {};
 
@@ -184,3 +186,95 @@ TEST_F(SysInfoNetworkLinuxTest, Test_Gateway_7546)
     EXPECT_EQ(1500, ifaddr.at("mtu").get<int32_t>());
     EXPECT_EQ("A12BA8C0", ifaddr.at("gateway").get_ref<const std::string&>());
 }
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Rtnetlink_AF_PACKET)
+{
+    const NetworkLinkRecord link { 2, ARPHRD_ETHER, 0, 6, 1500, "eth0", "00:a0:c9:14:c8:29", LinkStats{0, 1, 2, 3, 4, 5, 6, 7} };
+    const std::string interfacesFile {};
+    nlohmann::json ifaddr {};
+
+    EXPECT_NO_THROW(FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, nullptr, "10.2.2.50", "100", interfacesFile))->buildNetworkData(ifaddr));
+
+    EXPECT_EQ("eth0", ifaddr.at("name").get_ref<const std::string&>());
+    EXPECT_EQ("", ifaddr.at("adapter").get_ref<const std::string&>());
+    EXPECT_EQ("ethernet", ifaddr.at("type").get_ref<const std::string&>());
+    EXPECT_EQ("up", ifaddr.at("state").get_ref<const std::string&>());
+    EXPECT_EQ("00:a0:c9:14:c8:29", ifaddr.at("mac").get_ref<const std::string&>());
+    EXPECT_EQ(1, ifaddr.at("tx_packets").get<int32_t>());
+    EXPECT_EQ(0, ifaddr.at("rx_packets").get<int32_t>());
+    EXPECT_EQ(3, ifaddr.at("tx_bytes").get<int32_t>());
+    EXPECT_EQ(2, ifaddr.at("rx_bytes").get<int32_t>());
+    EXPECT_EQ(7, ifaddr.at("tx_dropped").get<int32_t>());
+    EXPECT_EQ(6, ifaddr.at("rx_dropped").get<int32_t>());
+    EXPECT_EQ(1500, ifaddr.at("mtu").get<int32_t>());
+    EXPECT_EQ("10.2.2.50", ifaddr.at("gateway").get_ref<const std::string&>());
+}
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Rtnetlink_AF_INET)
+{
+    const NetworkLinkRecord link { 2, ARPHRD_ETHER, 0, 6, 1500, "eth0", "00:a0:c9:14:c8:29", LinkStats{} };
+    const NetworkAddressRecord withBroadcast { 2, AF_INET, "192.168.0.1", "255.255.255.0", "192.168.0.255" };
+    const NetworkAddressRecord withoutBroadcast { 2, AF_INET, "10.0.0.1", "255.255.0.0", "" };
+    const std::string interfacesFile { "auto eth0\niface eth0 inet dhcp\n" };
+    nlohmann::json ifaddr {};
+
+    EXPECT_NO_THROW(FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, &withBroadcast, "", "100", interfacesFile))->buildNetworkData(ifaddr));
+    EXPECT_NO_THROW(FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, &withoutBroadcast, "", "100", interfacesFile))->buildNetworkData(ifaddr));
+
+    ASSERT_EQ(2u, ifaddr.at("IPv4").size());
+    EXPECT_EQ("192.168.0.1", ifaddr.at("IPv4").at(0).at("address").get_ref<const std::string&>());
+    EXPECT_EQ("255.255.255.0", ifaddr.at("IPv4").at(0).at("netmask").get_ref<const std::string&>());
+    EXPECT_EQ("192.168.0.255", ifaddr.at("IPv4").at(0).at("broadcast").get_ref<const std::string&>());
+    EXPECT_EQ("enabled", ifaddr.at("IPv4").at(0).at("dhcp").get_ref<const std::string&>());
+    EXPECT_EQ("100", ifaddr.at("IPv4").at(0).at("metric").get_ref<const std::string&>());
+    EXPECT_EQ("10.0.255.255", ifaddr.at("IPv4").at(1).at("broadcast").get_ref<const std::string&>());
+}
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Rtnetlink_AF_INET6)
+{
+    const NetworkLinkRecord link { 2, ARPHRD_ETHER, 0, 2, 1500, "eth0", "00:a0:c9:14:c8:29", LinkStats{} };
+    const NetworkAddressRecord address { 2, AF_INET6, "fe80::2a0:c9ff:fe14:c829", "ffff:ffff:ffff:ffff::", "" };
+    const std::string interfacesFile {};
+    nlohmann::json ifaddr {};
+
+    EXPECT_NO_THROW(FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkRtnetlinkInterface>(link, &address, "", "100", interfacesFile))->buildNetworkData(ifaddr));
+
+    ASSERT_EQ(1u, ifaddr.at("IPv6").size());
+    EXPECT_EQ("fe80::2a0:c9ff:fe14:c829", ifaddr.at("IPv6").at(0).at("address").get_ref<const std::string&>());
+    EXPECT_EQ("ffff:ffff:ffff:ffff::", ifaddr.at("IPv6").at(0).at("netmask").get_ref<const std::string&>());
+    EXPECT_TRUE(ifaddr.at("IPv6").at(0).at("broadcast").is_null());
+    EXPECT_TRUE(ifaddr.at("IPv6").at(0).at("metric").is_null());
+}
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Rtnetlink_Dump)
+{
+    std::vector<NetworkLinkRecord> links;
+    std::vector<NetworkAddressRecord> addresses;
+    std::vector<NetworkRouteRecord> routes;
+    RtnetlinkLinux rtnetlink;
+
+    EXPECT_NO_THROW(rtnetlink.links(links));
+    EXPECT_NO_THROW(rtnetlink.addresses(addresses));
+    EXPECT_NO_THROW(rtnetlink.routes(routes));
+
+    const auto loopback { std::find_if(links.begin(), links.end(), [](const NetworkLinkRecord & link)
+    {
+        return link.name == "lo";
+    }) };
+
+    ASSERT_NE(links.end(), loopback);
+    EXPECT_TRUE(loopback->flags & IFF_LOOPBACK);
+    EXPECT_EQ(ARPHRD_LOOPBACK, loopback->type);
+    EXPECT_EQ("00:00:00:00:00:00", loopback->mac);
+
+    const auto address { std::find_if(addresses.begin(), addresses.end(), [&loopback](const NetworkAddressRecord & record)
+    {
+        return record.index == loopback->index && record.family == AF_INET;
+    }) };
+
+    if (address != addresses.end())
+    {
+        EXPECT_EQ("127.0.0.1", address->address);
+        EXPECT_EQ("255.0.0.0", address->netmask);
+    }
+}
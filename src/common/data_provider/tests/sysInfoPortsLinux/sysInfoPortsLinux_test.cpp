@@ -0,0 +1,154 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <fstream>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "sysInfoPortsLinux_test.h"
+#include "stringHelper.h"
+#include "networkHelper.h"
+#include "ports/portLinuxWrapper.h"
+#include "ports/portImpl.h"
+#include "ports/portProcessCacheLinux.h"
+
+void SysInfoPortsLinuxTest::SetUp()
+{
+    m_procPath = std::filesystem::temp_directory_path() / ("port_process_cache_test_" + std::to_string(getpid()));
+    std::filesystem::create_directories(m_procPath);
+}
+
+void SysInfoPortsLinuxTest::TearDown()
+{
+    std::filesystem::remove_all(m_procPath);
+}
+
+void SysInfoPortsLinuxTest::addProcess(const std::string& pid,
+                                       const std::string& name,
+                                       const std::vector<std::string>& links)
+{
+    const auto fdPath {m_procPath / pid / "fd"};
+    std::filesystem::create_directories(fdPath);
+    std::ofstream{m_procPath / pid / "stat"} << pid << " (" << name << ") S 1 1 1 0 -1\n";
+
+    for (const auto& link : links)
+    {
+        std::filesystem::create_symlink(link, fdPath / std::to_string(std::distance(std::filesystem::directory_iterator{fdPath}, {})));
+    }
+}
+
+static nlohmann::json buildPort(const SocketRecord& record)
+{
+    nlohmann::json port {};
+    const auto spWrapper { std::make_shared<LinuxSockDiagPortWrapper>() };
+    spWrapper->record(record);
+    PortImpl{spWrapper}.buildPortData(port);
+    return port;
+}
+
+TEST_F(SysInfoPortsLinuxTest, sockDiagTcpIPv4)
+{
+    SocketRecord record {};
+    record.type = TCP_IPV4;
+    record.state = TCP_LISTEN;
+    record.localPort = 443;
+    record.localAddress[0] = htonl(INADDR_LOOPBACK);
+    record.rxQueue = 3;
+    record.inode = 4274126910;
+
+    const auto port = buildPort(record);
+    EXPECT_EQ(port.at("protocol"), "tcp");
+    EXPECT_EQ(port.at("local_ip"), "127.0.0.1");
+    EXPECT_EQ(port.at("local_port"), 443);
+    EXPECT_EQ(port.at("remote_ip"), "0.0.0.0");
+    EXPECT_EQ(port.at("remote_port"), 0);
+    EXPECT_EQ(port.at("tx_queue"), 0);
+    EXPECT_EQ(port.at("rx_queue"), 3);
+    EXPECT_EQ(port.at("inode"), 4274126910);
+    EXPECT_EQ(port.at("state"), "listening");
+    EXPECT_EQ(port.at("pid"), UNKNOWN_VALUE);
+    EXPECT_EQ(port.at("process"), UNKNOWN_VALUE);
+}
+
+TEST_F(SysInfoPortsLinuxTest, sockDiagUdpIPv6)
+{
+    SocketRecord record {};
+    record.type = UDP_IPV6;
+    record.state = TCP_CLOSE;
+    record.localPort = 53;
+    inet_pton(AF_INET6, "fe80::1", record.localAddress);
+    inet_pton(AF_INET6, "::1", record.remoteAddress);
+    record.remotePort = 5353;
+    record.txQueue = 7;
+
+    const auto port = buildPort(record);
+    EXPECT_EQ(port.at("protocol"), "udp6");
+    EXPECT_EQ(port.at("local_ip"), "fe80::1");
+    EXPECT_EQ(port.at("local_port"), 53);
+    EXPECT_EQ(port.at("remote_ip"), "::1");
+    EXPECT_EQ(port.at("remote_port"), 5353);
+    EXPECT_EQ(port.at("tx_queue"), 7);
+    EXPECT_EQ(port.at("state"), UNKNOWN_VALUE);
+}
+
+TEST_F(SysInfoPortsLinuxTest, processCacheResolve)
+{
+    addProcess("100", "my (odd) name", {"socket:[1000]", "pipe:[5]", "socket:[1001]"});
+    addProcess("200", "sshd", {"socket:[2000]", "/dev/null"});
+    std::filesystem::create_directories(m_procPath / "self");
+
+    PortProcessCacheLinux cache {m_procPath.string()};
+    const auto owners {cache.resolve({1000, 1001, 2000, 3000, 0})};
+
+    EXPECT_EQ(owners.size(), 3u);
+    EXPECT_EQ(owners.at(1000), std::make_pair(100, std::string{"my (odd) name"}));
+    EXPECT_EQ(owners.at(1001), std::make_pair(100, std::string{"my (odd) name"}));
+    EXPECT_EQ(owners.at(2000), std::make_pair(200, std::string{"sshd"}));
+}
+
+TEST_F(SysInfoPortsLinuxTest, processCacheOnlyWalksForUnknownInodes)
+{
+    addProcess("100", "nginx", {"socket:[1000]"});
+
+    PortProcessCacheLinux cache {m_procPath.string()};
+    EXPECT_EQ(cache.resolve({1000, 3000}).size(), 1u);
+
+    // Known and unresolved sockets do not trigger a walk
+    addProcess("300", "late", {"socket:[3000]"});
+    std::ofstream{m_procPath / "100" / "stat"} << "100 (renamed) S 1 1 1 0 -1\n";
+    auto owners {cache.resolve({1000, 3000})};
+    EXPECT_EQ(owners.size(), 1u);
+    EXPECT_EQ(owners.at(1000).second, "nginx");
+
+    // A new socket triggers a walk, which retries the unresolved ones too
+    addProcess("400", "new", {"socket:[4000]"});
+    owners = cache.resolve({1000, 3000, 4000});
+    EXPECT_EQ(owners.size(), 3u);
+    EXPECT_EQ(owners.at(1000).second, "nginx");
+    EXPECT_EQ(owners.at(3000), std::make_pair(300, std::string{"late"}));
+    EXPECT_EQ(owners.at(4000), std::make_pair(400, std::string{"new"}));
+
+    // Closed sockets are forgotten
+    owners = cache.resolve({4000});
+    EXPECT_EQ(owners.size(), 1u);
+    EXPECT_EQ(owners.count(4000), 1u);
+}
+
+TEST_F(SysInfoPortsLinuxTest, processCacheOwnerExited)
+{
+    addProcess("100", "parent", {"socket:[1000]"});
+
+    PortProcessCacheLinux cache {m_procPath.string()};
+    EXPECT_EQ(cache.resolve({1000}).at(1000).first, 100);
+
+    // The socket was inherited by a child that outlived its parent
+    std::filesystem::remove_all(m_procPath / "100");
+    addProcess("101", "child", {"socket:[1000]"});
+    EXPECT_EQ(cache.resolve({1000}).at(1000), std::make_pair(101, std::string{"child"}));
+}
@@ -0,0 +1,159 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <fstream>
+#include <system_error>
+#include <unistd.h>
+#include "sysInfoProcessesLinux_test.h"
+#include "processes/procReaderLinux.h"
+#include "linuxInfoHelper.h"
+
+static std::string buildStat(const std::string& pid, const std::string& name, const std::string& ppid, const std::string& tty)
+{
+    return pid + " (" + name + ") S " + ppid + " " + pid + " " + pid + " " + tty +
+           " -1 4194560 100 0 0 0 5 3 0 0 20 0 1 0 12345 1000 100 18446744073709551615\n";
+}
+
+static std::string buildStatus(const std::string& pid, const std::string& tgid, const std::string& uid, const std::string& gid)
+{
+    return "Name:\tprocess\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t" + tgid + "\nNgid:\t0\nPid:\t" + pid +
+           "\nPPid:\t1\nTracerPid:\t0\nUid:\t" + uid + "\nGid:\t" + gid + "\nFDSize:\t64\nGroups:\t\n";
+}
+
+void SysInfoProcessesLinuxTest::SetUp()
+{
+    m_procPath = std::filesystem::temp_directory_path() / ("proc_reader_test_" + std::to_string(getpid()));
+    std::filesystem::create_directories(m_procPath);
+}
+
+void SysInfoProcessesLinuxTest::TearDown()
+{
+    std::filesystem::remove_all(m_procPath);
+}
+
+void SysInfoProcessesLinuxTest::addProcess(const std::string& pid,
+                                           const std::string& stat,
+                                           const std::string& status,
+                                           const std::string& cmdline)
+{
+    const auto directory {m_procPath / pid};
+    std::filesystem::create_directories(directory);
+    std::ofstream{directory / "stat"} << stat;
+    std::ofstream{directory / "status"} << status;
+    std::ofstream{directory / "cmdline", std::ios::binary} << cmdline;
+}
+
+TEST_F(SysInfoProcessesLinuxTest, readProcess)
+{
+    using namespace std::string_literals;
+    addProcess("42",
+               buildStat("42", "my (odd) name", "1", "34816"),
+               buildStatus("42", "42", "0\t4000000\t4000001\t0", "4000002\t0\t4000003\t0"),
+               "/usr/bin/app\0--flag\0value\0"s);
+
+    std::vector<nlohmann::json> processes;
+    ProcReaderLinux{m_procPath.string()}.read([&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    const auto& process {processes.front()};
+    EXPECT_EQ(process.size(), 14u);
+    EXPECT_EQ(process.at("pid"), "42");
+    EXPECT_EQ(process.at("name"), "my (odd) name");
+    EXPECT_EQ(process.at("ppid"), 1);
+    EXPECT_EQ(process.at("cmd"), "/usr/bin/app");
+    EXPECT_EQ(process.at("argvs"), "--flag value");
+    EXPECT_EQ(process.at("ruser"), "root");
+    EXPECT_EQ(process.at("euser"), "4000000");
+    EXPECT_EQ(process.at("suser"), "4000001");
+    EXPECT_EQ(process.at("rgroup"), "4000002");
+    EXPECT_EQ(process.at("egroup"), "root");
+    EXPECT_EQ(process.at("sgroup"), "4000003");
+    EXPECT_EQ(process.at("start_time"), Utils::timeTick2unixTime(12345));
+    EXPECT_EQ(process.at("tgid"), 42);
+    EXPECT_EQ(process.at("tty"), 34816);
+}
+
+TEST_F(SysInfoProcessesLinuxTest, readProcessWithoutCommandLine)
+{
+    addProcess("2", buildStat("2", "kthreadd", "0", "0"), buildStatus("2", "2", "0\t0\t0\t0", "0\t0\t0\t0"), "");
+
+    std::vector<nlohmann::json> processes;
+    ProcReaderLinux{m_procPath.string()}.read([&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    EXPECT_EQ(processes.front().at("name"), "kthreadd");
+    EXPECT_EQ(processes.front().at("cmd"), "");
+    EXPECT_EQ(processes.front().at("argvs"), "");
+}
+
+TEST_F(SysInfoProcessesLinuxTest, readLongCommandLine)
+{
+    const std::string argument(10000, 'a');
+    addProcess("42",
+               buildStat("42", "app", "1", "0"),
+               buildStatus("42", "42", "0\t0\t0\t0", "0\t0\t0\t0"),
+               "app" + std::string(1, '\0') + argument + std::string(1, '\0') + "last");
+
+    std::vector<nlohmann::json> processes;
+    ProcReaderLinux{m_procPath.string()}.read([&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    EXPECT_EQ(processes.front().at("cmd"), "app");
+    EXPECT_EQ(processes.front().at("argvs"), argument + " last");
+}
+
+TEST_F(SysInfoProcessesLinuxTest, skipThreadsAndInvalidEntries)
+{
+    addProcess("42", buildStat("42", "app", "1", "0"), buildStatus("42", "42", "0\t0\t0\t0", "0\t0\t0\t0"), "app");
+    // Thread of process 42
+    addProcess("43", buildStat("43", "app", "1", "0"), buildStatus("43", "42", "0\t0\t0\t0", "0\t0\t0\t0"), "app");
+    addProcess("44", "44 (truncated", buildStatus("44", "44", "0\t0\t0\t0", "0\t0\t0\t0"), "app");
+    addProcess("45", buildStat("45", "app", "1", "0"), "Name:\tapp\n", "app");
+    std::filesystem::create_directories(m_procPath / "self");
+
+    std::vector<nlohmann::json> processes;
+    ProcReaderLinux{m_procPath.string()}.read([&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    EXPECT_EQ(processes.front().at("pid"), "42");
+}
+
+TEST_F(SysInfoProcessesLinuxTest, readPids)
+{
+    addProcess("42", buildStat("42", "app", "1", "0"), buildStatus("42", "42", "0\t0\t0\t0", "0\t0\t0\t0"), "app");
+    addProcess("43", buildStat("43", "app", "1", "0"), buildStatus("43", "42", "0\t0\t0\t0", "0\t0\t0\t0"), "app");
+    addProcess("50", buildStat("50", "other", "1", "0"), buildStatus("50", "50", "0\t0\t0\t0", "0\t0\t0\t0"), "other");
+
+    std::vector<nlohmann::json> processes;
+    ProcReaderLinux{m_procPath.string()}.read({42, 43, 60}, [&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    EXPECT_EQ(processes.front().at("pid"), "42");
+}
+
+TEST_F(SysInfoProcessesLinuxTest, missingProcDirectory)
+{
+    EXPECT_THROW(ProcReaderLinux{(m_procPath / "missing").string()}, std::system_error);
+}
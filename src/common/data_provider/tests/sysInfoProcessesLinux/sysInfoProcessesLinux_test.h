@@ -0,0 +1,37 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#ifndef _SYSINFO_PROCESSES_LINUX_TEST_H
+#define _SYSINFO_PROCESSES_LINUX_TEST_H
+
+#include <filesystem>
+#include <string>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+class SysInfoProcessesLinuxTest : public ::testing::Test
+{
+    protected:
+
+        SysInfoProcessesLinuxTest() = default;
+        virtual ~SysInfoProcessesLinuxTest() = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        void addProcess(const std::string& pid,
+                        const std::string& stat,
+                        const std::string& status,
+                        const std::string& cmdline);
+
+        std::filesystem::path m_procPath;
+};
+
+#endif //_SYSINFO_PROCESSES_LINUX_TEST_H
@@ -40,6 +40,10 @@ DBSyncExceptionType DELETE_OLD_DB_ERROR            { std::make_pair(20, "Error d
 DBSyncExceptionType MIN_ROW_LIMIT_BELOW_ZERO       { std::make_pair(21, "Invalid row limit, values below 0 not allowed.")       };
 DBSyncExceptionType ERROR_COUNT_MAX_ROWS           { std::make_pair(22, "Count is less than 0.")                                };
 DBSyncExceptionType STEP_ERROR_UPDATE_STMT         { std::make_pair(23, "Error upgrading DB.")                                  };
+DBSyncExceptionType STEP_ERROR_ADD_HASH_FIELD      { std::make_pair(24, "Error adding hash field.")                             };
+DBSyncExceptionType DUPLICATED_PK_DATA             { std::make_pair(25, "Primary key already exists.")                          };
+DBSyncExceptionType OPERATION_NOT_SUPPORTED        { std::make_pair(26, "Operation not supported by the engine.")               };
+DBSyncExceptionType CHECKSUM_INDEX_NOT_ENABLED     { std::make_pair(27, "Checksum index not enabled for the table.")            };
 
 namespace DbSync
 {
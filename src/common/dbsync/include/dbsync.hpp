@@ -13,13 +13,27 @@
 #define _DBSYNC_HPP_
 
 #include <functional>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include "db_exception.h"
 #include "commonDefs.h"
+#include "dbsync_row.hpp"
 #include "builder.hpp"
 
 using ResultCallbackData = const std::function<void(ReturnTypeCallback, const nlohmann::json&) >;
 
+namespace DbSync
+{
+    class IDbCursor;
+}
+
+constexpr auto DBSYNC_CURSOR_FETCH_SIZE
+{
+    256ull
+};
+
+class DBSyncCursor;
+
 class DBSync
 {
     public:
@@ -87,6 +101,56 @@ class DBSync
         virtual void setTableMaxRow(const std::string& table,
                                     const long long    maxRows);
 
+        /**
+         * @brief Keeps a hash of the values of each row of the \p table table.
+         *
+         * @param table Table name to hash its rows.
+         *
+         * @details syncRow hashes the received columns and compares the hash with the stored one,
+         *          so unchanged rows aren't read. The stored values are only read for rows without
+         *          a valid hash, with ignored columns or when the old data is requested. The rows
+         *          are expected to be synced with the same columns every time. The hash is kept in
+         *          the database, so a persistent table keeps it after a restart.
+         */
+        virtual void enableTableRowHash(const std::string& table);
+
+        /**
+         * @brief Returns the counters of the prepared statements cache.
+         *
+         * @return JSON object with the cache "hits", "misses", "evictions", current "size" and "capacity",
+         *         and the number of statements "executed" since the first call.
+         */
+        virtual nlohmann::json getStatementCacheStats();
+
+        /**
+         * @brief Keeps a checksum index of the \p table table in primary key order.
+         *
+         * @param table Table name to index its rows.
+         *
+         * @details Every row change updates the index in logarithmic time, so the checksums
+         *          of the table and of primary key ranges are available without reading the
+         *          rows. The index is kept in memory and rebuilt from the table when enabled.
+         */
+        virtual void enableTableChecksumIndex(const std::string& table);
+
+        /**
+         * @brief Returns the checksum of the rows of \p table between two primary keys.
+         *
+         * @param table Table name with an enabled checksum index.
+         * @param begin First primary key of the range (included), null for the first row.
+         * @param end   Last primary key of the range (included), null for the last row.
+         *
+         * @return JSON object with the "checksum" (hexadecimal) and the "count" of rows of the range.
+         *
+         * @details The bounds are objects with every primary key column, or the bare value when
+         *          the table has a single primary key. The checksum doesn't depend on the order
+         *          of the changes nor on the engine, so two databases with the same rows in a
+         *          range get the same checksum for it.
+         */
+        virtual nlohmann::json getRangeChecksum(const std::string& table,
+                                                const nlohmann::json& begin = nullptr,
+                                                const nlohmann::json& end = nullptr);
+
         /**
          * @brief Inserts (or modifies) a database record.
          *
@@ -97,6 +161,18 @@ class DBSync
         virtual void syncRow(const nlohmann::json& jsInput,
                              ResultCallbackData    callbackData);
 
+        /**
+         * @brief Inserts (or modifies) the \p rows database records.
+         *
+         * @param rows      Table, columns and values of the records, bound by the position of their columns.
+         * @param callback  Result callback(std::function) will be called for each result.
+         *
+         * @details Typed counterpart of the JSON syncRow, the values are bound and compared without
+         *          converting them to JSON. The ignored columns and the old data are taken from \p rows.
+         */
+        virtual void syncRow(const DbSync::RowBatch&    rows,
+                             const DbSync::RowCallback& callback);
+
         /**
          * @brief Select data, based in \p jsInput data, from the database table.
          *
@@ -115,6 +191,16 @@ class DBSync
          */
         virtual void deleteRows(const nlohmann::json& jsInput);
 
+        /**
+         * @brief Deletes database table records based on \p jsInput value, reporting them.
+         *
+         * @param jsInput        JSON information to be applied/deleted in the database.
+         * @param callbackData   Result callback(std::function) will be called with the stored values of each deleted record.
+         *
+         */
+        virtual void deleteRows(const nlohmann::json& jsInput,
+                                ResultCallbackData    callbackData);
+
         /**
          * @brief Updates data table with \p jsInput information. \p jsResult value will
          *  hold/contain the results of this operation (rows insertion, modification and/or deletion).
@@ -199,6 +285,18 @@ class DBSyncTxn
          */
         virtual void syncTxnRow(const nlohmann::json& jsInput);
 
+        /**
+         * @brief Synchronizes the \p rows data.
+         *
+         * @param rows      Table, columns and values of the records, bound by the position of their columns.
+         * @param callback  Result callback(std::function) will be called for each result.
+         *
+         * @details Unlike the JSON rows, the typed rows aren't queued: the results are reported to
+         *          \p callback before returning and the errors are thrown.
+         */
+        virtual void syncTxnRow(const DbSync::RowBatch&    rows,
+                                const DbSync::RowCallback& callback);
+
         /**
          * @brief Gets the deleted rows (diff) from the database.
          *
@@ -207,6 +305,28 @@ class DBSyncTxn
          */
         virtual void getDeletedRows(ResultCallbackData callbackData);
 
+        /**
+         * @brief Opens a cursor on the rows of \p table that will be deleted (diff) when the transaction is closed.
+         *
+         * @param table      Table of the transaction.
+         * @param fetchSize  Max number of rows returned by each fetch.
+         *
+         * @return Cursor on the rows, typed counterpart of getDeletedRows.
+         */
+        virtual DBSyncCursor deletedRowsCursor(const std::string& table,
+                                               const size_t       fetchSize = DBSYNC_CURSOR_FETCH_SIZE);
+
+        /**
+         * @brief Keeps the rows that match the \p jsInput condition, as if they had been synchronized.
+         *
+         * @param jsInput JSON information with the table and the condition, e.g.
+         *                {"table":"packages","query":{"where_filter_opt":"format NOT IN (?,?)","values":["deb","rpm"]}}.
+         *
+         * @details The rows aren't compared nor reported, they're only left out of getDeletedRows. The
+         *          values are bound to the "?" parameters of the condition in order.
+         */
+        virtual void keepTxnRows(const nlohmann::json& jsInput);
+
         /**
          * @brief Get current dbsync transaction handle in the instance.
          *
@@ -222,6 +342,78 @@ class DBSyncTxn
         bool m_shouldBeRemoved;
 };
 
+class DBSyncCursor final
+{
+    public:
+        /**
+         * @brief Opens a cursor on the rows selected by \p jsInput.
+         *
+         * @param handle     Handle obtained from the \ref DBSync instance.
+         * @param jsInput    JSON with table name, fields and filters to apply in the query, as selectRows takes it.
+         * @param fetchSize  Max number of rows returned by each fetch.
+         *
+         * @details The rows are read from the database as they are fetched and they are returned
+         *          as typed values, so the memory used doesn't grow with the number of selected rows.
+         *          The database isn't locked between fetches, the rows changed meanwhile may or may
+         *          not be returned.
+         */
+        DBSyncCursor(const DBSYNC_HANDLE    handle,
+                     const nlohmann::json&  jsInput,
+                     const size_t           fetchSize = DBSYNC_CURSOR_FETCH_SIZE);
+
+        DBSyncCursor(DBSyncCursor&& other) noexcept;
+        DBSyncCursor& operator=(DBSyncCursor&& other) noexcept;
+        DBSyncCursor(const DBSyncCursor&) = delete;
+        DBSyncCursor& operator=(const DBSyncCursor&) = delete;
+
+        /**
+         * @brief Destructor closes the cursor.
+         */
+        ~DBSyncCursor();
+
+        /**
+         * @brief Returns the column names of the rows, in the order of their values.
+         */
+        const std::vector<std::string>& columns() const
+        {
+            return m_columns;
+        }
+
+        /**
+         * @brief Returns the position of the \p name column in the rows.
+         *
+         * @details The values are converted to the wanted type with DbSync::fromRowValue, or mapped
+         *          to a struct with a DbSync::RowAdaptor of the same columns.
+         */
+        size_t columnIndex(const std::string& name) const;
+
+        /**
+         * @brief Fetches the next rows.
+         *
+         * @param rows  Fetched rows, they replace the ones of the previous fetch reusing their storage.
+         *
+         * @return Number of rows fetched, 0 once every row was fetched.
+         */
+        size_t next(std::vector<DbSync::RowValues>& rows);
+
+        /**
+         * @brief Closes the cursor, the rows not fetched yet are discarded.
+         */
+        void close();
+
+    private:
+        friend class DBSyncTxn;
+
+        DBSyncCursor(const DBSYNC_HANDLE                    handle,
+                     std::unique_ptr<DbSync::IDbCursor>     cursor,
+                     const size_t                           fetchSize);
+
+        DBSYNC_HANDLE m_handle;
+        std::unique_ptr<DbSync::IDbCursor> m_cursor;
+        std::vector<std::string> m_columns;
+        size_t m_fetchSize;
+};
+
 template <typename T>
 class Query : public Utils::Builder<T>
 {
@@ -380,6 +572,11 @@ class SyncRowQuery final : public Query<SyncRowQuery>
          */
         SyncRowQuery& returnOldData();
 
+        /**
+         * @brief Make this query compare the rows one by one instead of staging them in bulk.
+         */
+        SyncRowQuery& disableBulkSync();
+
         /**
          * @brief Reset all data to be inserted.
          *
@@ -0,0 +1,228 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _DBSYNC_ROW_HPP_
+#define _DBSYNC_ROW_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "commonDefs.h"
+
+namespace DbSync
+{
+    /**
+     * @brief Value of a column, std::monostate is the NULL value.
+     */
+    using Value = std::variant<std::monostate, int64_t, uint64_t, double, std::string>;
+
+    /**
+     * @brief Values of a row, in the order of the columns of its \ref RowBatch.
+     */
+    using RowValues = std::vector<Value>;
+
+    /**
+     * @brief Rows to be synchronized with the typed syncRow.
+     *
+     * @details Every row holds a value for each column of \p columns, in the same order. The primary
+     *          keys of the table must be part of the columns.
+     */
+    struct RowBatch final
+    {
+        std::string table;
+        std::vector<std::string> columns;
+        std::vector<RowValues> rows;
+        bool returnOldData { false };
+        std::vector<std::string> ignore;
+    };
+
+    /**
+     * @brief Result callback of the typed syncRow.
+     *
+     * @param result  Type of the result (INSERTED or MODIFIED).
+     * @param row     Synchronized row, in the order of the columns of the batch.
+     * @param oldRow  Stored values of the modified row when the old data is requested, empty otherwise.
+     */
+    using RowCallback = std::function<void(ReturnTypeCallback, const RowValues&, const RowValues&)>;
+
+    template <typename T>
+    struct IsOptional : std::false_type {};
+
+    template <typename T>
+    struct IsOptional<std::optional<T>> : std::true_type {};
+
+    /**
+     * @brief Converts the value of a column of a result row to the \p M type.
+     *
+     * @details Numbers are cast to arithmetic types, NULL values are the empty or zero value and
+     *          std::optional types are empty when the value is NULL.
+     */
+    template <typename M>
+    M fromRowValue(const Value& value)
+    {
+        if constexpr (IsOptional<M>::value)
+        {
+            return std::holds_alternative<std::monostate>(value)
+                   ? M {}
+                   : M { fromRowValue<typename M::value_type>(value) };
+        }
+        else if constexpr (std::is_arithmetic_v<M>)
+        {
+            return std::visit([](const auto & data) -> M
+            {
+                using V = std::decay_t<decltype(data)>;
+
+                if constexpr (std::is_arithmetic_v<V>)
+                {
+                    return static_cast<M>(data);
+                }
+                else
+                {
+                    return M {};
+                }
+            }, value);
+        }
+        else
+        {
+            const auto data { std::get_if<std::string>(&value) };
+            return data ? M { *data } : M {};
+        }
+    }
+
+    /**
+     * @brief Maps the members of a struct to the columns of a table.
+     *
+     * @details Integral members are stored as int64_t/uint64_t, floating point members as double and
+     *          std::optional members as NULL when empty.
+     */
+    template <typename T>
+    class RowAdaptor final
+    {
+        public:
+            explicit RowAdaptor(std::string table)
+                : m_table { std::move(table) }
+            {}
+
+            /**
+             * @brief Adds the \p name column, mapped to the \p member member.
+             *
+             * @param name    Column name.
+             * @param member  Member holding the column value.
+             *
+             * @return Reference to the adaptor, to chain the columns.
+             */
+            template <typename M>
+            RowAdaptor& column(std::string name, M T::* member)
+            {
+                m_columns.push_back(std::move(name));
+                m_getters.push_back([member](const T & item)
+                {
+                    return toValue(item.*member);
+                });
+                m_setters.push_back([member](const Value & value, T & item)
+                {
+                    item.*member = fromRowValue<M>(value);
+                });
+                return *this;
+            }
+
+            /**
+             * @brief Builds the batch to synchronize \p items.
+             */
+            RowBatch batch(const std::vector<T>& items) const
+            {
+                RowBatch ret { m_table, m_columns, {}, false, {} };
+                ret.rows.reserve(items.size());
+
+                for (const auto& item : items)
+                {
+                    ret.rows.push_back(values(item));
+                }
+
+                return ret;
+            }
+
+            /**
+             * @brief Returns the values of \p item, in the order of the columns.
+             */
+            RowValues values(const T& item) const
+            {
+                RowValues ret;
+                ret.reserve(m_getters.size());
+
+                for (const auto& getter : m_getters)
+                {
+                    ret.push_back(getter(item));
+                }
+
+                return ret;
+            }
+
+            /**
+             * @brief Builds an item from the \p values of a result row.
+             */
+            T item(const RowValues& values) const
+            {
+                T ret {};
+
+                for (size_t i = 0; i < m_setters.size() && i < values.size(); ++i)
+                {
+                    m_setters[i](values[i], ret);
+                }
+
+                return ret;
+            }
+
+        private:
+            template <typename M>
+            static Value toValue(const M& member)
+            {
+                if constexpr (std::is_same_v<M, bool>)
+                {
+                    return Value { static_cast<int64_t>(member) };
+                }
+                else if constexpr (std::is_integral_v<M> && std::is_signed_v<M>)
+                {
+                    return Value { static_cast<int64_t>(member) };
+                }
+                else if constexpr (std::is_integral_v<M>)
+                {
+                    return Value { static_cast<uint64_t>(member) };
+                }
+                else if constexpr (std::is_floating_point_v<M>)
+                {
+                    return Value { static_cast<double>(member) };
+                }
+                else
+                {
+                    return Value { std::string { member } };
+                }
+            }
+
+            template <typename M>
+            static Value toValue(const std::optional<M>& member)
+            {
+                return member.has_value() ? toValue(member.value()) : Value {};
+            }
+
+            std::string m_table;
+            std::vector<std::string> m_columns;
+            std::vector<std::function<Value(const T&)>> m_getters;
+            std::vector<std::function<void(const Value&, T&)>> m_setters;
+    };
+}// namespace DbSync
+
+#endif // _DBSYNC_ROW_HPP_
@@ -0,0 +1,433 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include "checksum_index.h"
+#include "dbengine.h"
+
+using namespace DbSync;
+
+static uint64_t mixChecksum(uint64_t hash)
+{
+    // The checksums are added, so their bits are spread first to keep the sums of similar rows apart.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+struct ChecksumIndex::Node final
+{
+    RowValues key;
+    uint64_t checksum;
+    uint64_t priority;
+    uint64_t sum;
+    uint64_t count;
+    std::unique_ptr<Node> left;
+    std::unique_ptr<Node> right;
+};
+
+ChecksumIndex::ChecksumIndex(std::vector<size_t> primaryKeys,
+                             std::vector<std::string> primaryKeyNames)
+    : m_primaryKeys { std::move(primaryKeys) }
+    , m_primaryKeyNames { std::move(primaryKeyNames) }
+{}
+
+ChecksumIndex::~ChecksumIndex() = default;
+
+void ChecksumIndex::upsert(const RowValues& row)
+{
+    auto rowKey { key(row) };
+    const auto checksum { rowChecksum(row) };
+
+    if (!replace(m_root.get(), rowKey, checksum))
+    {
+        // The priority comes from the key, so the shape of the tree doesn't depend on the order of the changes.
+        auto node { std::make_unique<Node>() };
+        node->priority = mixChecksum(rowChecksum(rowKey) + 0x9e3779b97f4a7c15ull);
+        node->key = std::move(rowKey);
+        node->checksum = checksum;
+        update(node.get());
+
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;
+        split(std::move(m_root), node->key, left, right);
+        m_root = merge(merge(std::move(left), std::move(node)), std::move(right));
+    }
+}
+
+void ChecksumIndex::erase(const RowValues& row)
+{
+    erase(m_root, key(row));
+}
+
+void ChecksumIndex::clear()
+{
+    m_root.reset();
+}
+
+uint64_t ChecksumIndex::size() const
+{
+    return m_root ? m_root->count : 0;
+}
+
+RangeChecksum ChecksumIndex::checksum() const
+{
+    return m_root ? RangeChecksum { m_root->sum, m_root->count } : RangeChecksum { 0, 0 };
+}
+
+RangeChecksum ChecksumIndex::rangeChecksum(const RowValues* begin,
+                                           const RowValues* end) const
+{
+    auto ret { end ? prefix(*end, true) : checksum() };
+
+    if (begin)
+    {
+        const auto lower { prefix(*begin, false) };
+
+        if (ret.count <= lower.count)
+        {
+            return RangeChecksum { 0, 0 };
+        }
+
+        ret.checksum -= lower.checksum;
+        ret.count -= lower.count;
+    }
+
+    return ret;
+}
+
+uint64_t ChecksumIndex::rowChecksum(const RowValues& row)
+{
+    // 64-bit FNV-1a of the tagged values, it doesn't depend on the process nor on the engine.
+    constexpr auto FNV_OFFSET_BASIS { 14695981039346656037ull };
+    constexpr auto FNV_PRIME { 1099511628211ull };
+    uint64_t hash { FNV_OFFSET_BASIS };
+
+    const auto append
+    {
+        [&hash](const void* bytes, const size_t size)
+        {
+            const auto begin { static_cast<const uint8_t*>(bytes) };
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= begin[i];
+                hash *= FNV_PRIME;
+            }
+        }
+    };
+
+    for (const auto& value : row)
+    {
+        std::visit([&append](const auto & data)
+        {
+            using V = std::decay_t<decltype(data)>;
+
+            if constexpr (std::is_same_v<V, std::monostate>)
+            {
+                append("n", 1);
+            }
+            else if constexpr (std::is_same_v<V, std::string>)
+            {
+                const uint64_t size { data.size() };
+                append("s", 1);
+                append(&size, sizeof(size));
+                append(data.data(), data.size());
+            }
+            else if constexpr (std::is_same_v<V, double>)
+            {
+                append("d", 1);
+                append(&data, sizeof(data));
+            }
+            else if (std::cmp_less_equal(data, std::numeric_limits<int64_t>::max()))
+            {
+                // Signed and unsigned numbers with the same value hash the same.
+                const auto number { static_cast<int64_t>(data) };
+                append("i", 1);
+                append(&number, sizeof(number));
+            }
+            else
+            {
+                append("u", 1);
+                append(&data, sizeof(data));
+            }
+        }, value);
+    }
+
+    return mixChecksum(hash);
+}
+
+nlohmann::json ChecksumIndex::rangeChecksum(const nlohmann::json& begin,
+                                             const nlohmann::json& end) const
+{
+    const auto beginKey { begin.is_null() ? RowValues {} : boundKey(begin) };
+    const auto endKey { end.is_null() ? RowValues {} : boundKey(end) };
+    const auto range { rangeChecksum(begin.is_null() ? nullptr : &beginKey, end.is_null() ? nullptr : &endKey) };
+
+    std::stringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << range.checksum;
+
+    nlohmann::json ret;
+    ret["checksum"] = stream.str();
+    ret["count"] = range.count;
+    return ret;
+}
+
+RowValues ChecksumIndex::key(const RowValues& row) const
+{
+    RowValues ret;
+    ret.reserve(m_primaryKeys.size());
+
+    for (const auto primaryKey : m_primaryKeys)
+    {
+        ret.push_back(primaryKey < row.size() ? row[primaryKey] : Value {});
+    }
+
+    return ret;
+}
+
+RowValues ChecksumIndex::boundKey(const nlohmann::json& bound) const
+{
+    RowValues ret;
+
+    if (!bound.is_object())
+    {
+        if (1 != m_primaryKeyNames.size())
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+
+        ret.push_back(jsonValue(bound));
+    }
+    else
+    {
+        // Every primary key is needed, a partial key would sort before the rows that start with it.
+        for (const auto& name : m_primaryKeyNames)
+        {
+            const auto it { bound.find(name) };
+
+            if (bound.end() == it)
+            {
+                throw dbengine_error { INVALID_PK_DATA };
+            }
+
+            ret.push_back(jsonValue(*it));
+        }
+    }
+
+    return ret;
+}
+
+Value ChecksumIndex::jsonValue(const nlohmann::json& value)
+{
+    if (value.is_string())
+    {
+        return Value { value.get<std::string>() };
+    }
+    else if (value.is_number_unsigned())
+    {
+        return Value { value.get<uint64_t>() };
+    }
+    else if (value.is_number_integer() || value.is_boolean())
+    {
+        return Value { value.get<int64_t>() };
+    }
+    else if (value.is_number_float())
+    {
+        return Value { value.get<double>() };
+    }
+
+    return Value {};
+}
+
+bool ChecksumIndex::lessKeys(const RowValues& lhs,
+                             const RowValues& rhs)
+{
+    // The primary keys are compared in order, as ORDER BY pk1, pk2... does.
+    for (size_t i = 0; i < lhs.size() && i < rhs.size(); ++i)
+    {
+        if (lessRowValues(lhs[i], rhs[i]))
+        {
+            return true;
+        }
+
+        if (lessRowValues(rhs[i], lhs[i]))
+        {
+            return false;
+        }
+    }
+
+    return lhs.size() < rhs.size();
+}
+
+void ChecksumIndex::update(Node* node)
+{
+    node->sum = node->checksum;
+    node->count = 1;
+
+    for (const auto child : { node->left.get(), node->right.get() })
+    {
+        if (child)
+        {
+            node->sum += child->sum;
+            node->count += child->count;
+        }
+    }
+}
+
+std::unique_ptr<ChecksumIndex::Node> ChecksumIndex::merge(std::unique_ptr<Node> left,
+                                                          std::unique_ptr<Node> right)
+{
+    if (!left || !right)
+    {
+        return left ? std::move(left) : std::move(right);
+    }
+
+    if (left->priority > right->priority)
+    {
+        left->right = merge(std::move(left->right), std::move(right));
+        update(left.get());
+        return left;
+    }
+
+    right->left = merge(std::move(left), std::move(right->left));
+    update(right.get());
+    return right;
+}
+
+void ChecksumIndex::split(std::unique_ptr<Node> node,
+                          const RowValues& key,
+                          std::unique_ptr<Node>& left,
+                          std::unique_ptr<Node>& right)
+{
+    // Keys lower than \p key go to the left tree, the rest to the right one.
+    if (!node)
+    {
+        left.reset();
+        right.reset();
+    }
+    else if (lessKeys(node->key, key))
+    {
+        auto nodeRight { std::move(node->right) };
+        split(std::move(nodeRight), key, node->right, right);
+        update(node.get());
+        left = std::move(node);
+    }
+    else
+    {
+        auto nodeLeft { std::move(node->left) };
+        split(std::move(nodeLeft), key, left, node->left);
+        update(node.get());
+        right = std::move(node);
+    }
+}
+
+bool ChecksumIndex::replace(Node* node,
+                            const RowValues& key,
+                            const uint64_t checksum)
+{
+    if (!node)
+    {
+        return false;
+    }
+
+    auto found { false };
+
+    if (lessKeys(key, node->key))
+    {
+        found = replace(node->left.get(), key, checksum);
+    }
+    else if (lessKeys(node->key, key))
+    {
+        found = replace(node->right.get(), key, checksum);
+    }
+    else
+    {
+        node->checksum = checksum;
+        found = true;
+    }
+
+    if (found)
+    {
+        update(node);
+    }
+
+    return found;
+}
+
+bool ChecksumIndex::erase(std::unique_ptr<Node>& node,
+                          const RowValues& key)
+{
+    if (!node)
+    {
+        return false;
+    }
+
+    auto found { false };
+
+    if (lessKeys(key, node->key))
+    {
+        found = erase(node->left, key);
+    }
+    else if (lessKeys(node->key, key))
+    {
+        found = erase(node->right, key);
+    }
+    else
+    {
+        node = merge(std::move(node->left), std::move(node->right));
+        return true;
+    }
+
+    if (found)
+    {
+        update(node.get());
+    }
+
+    return found;
+}
+
+RangeChecksum ChecksumIndex::prefix(const RowValues& key,
+                                    const bool inclusive) const
+{
+    RangeChecksum ret { 0, 0 };
+
+    for (auto node { m_root.get() }; node;)
+    {
+        const auto included { inclusive ? !lessKeys(key, node->key) : lessKeys(node->key, key) };
+
+        if (included)
+        {
+            // The node and its left subtree are in the prefix.
+            ret.checksum += node->checksum;
+            ret.count += 1;
+
+            if (node->left)
+            {
+                ret.checksum += node->left->sum;
+                ret.count += node->left->count;
+            }
+
+            node = node->right.get();
+        }
+        else
+        {
+            node = node->left.get();
+        }
+    }
+
+    return ret;
+}
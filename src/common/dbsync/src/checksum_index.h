@@ -0,0 +1,109 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CHECKSUM_INDEX_H
+#define _CHECKSUM_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "dbsync_row.hpp"
+
+namespace DbSync
+{
+    struct RangeChecksum final
+    {
+        uint64_t checksum;
+        uint64_t count;
+    };
+
+    // Checksums of the rows of a table, kept in primary key order. Each node of the tree (a treap) holds the
+    // checksum of its row and the aggregate of its subtree, so a row change updates the aggregates of its path only.
+    // The aggregate is the sum of the row checksums, so the checksum of the whole table is the one of the root and
+    // the one of any range is the difference of two prefixes.
+    class ChecksumIndex final
+    {
+        public:
+            // The rows are given with the content columns of the table, \p primaryKeys are the positions of the
+            // primary keys and \p primaryKeyNames their names.
+            ChecksumIndex(std::vector<size_t> primaryKeys,
+                          std::vector<std::string> primaryKeyNames);
+            ~ChecksumIndex();
+
+            const std::vector<size_t>& primaryKeys() const
+            {
+                return m_primaryKeys;
+            }
+
+            void upsert(const RowValues& row);
+
+            void erase(const RowValues& row);
+
+            void clear();
+
+            uint64_t size() const;
+
+            RangeChecksum checksum() const;
+
+            // Checksum of the rows whose primary keys are between \p begin and \p end, both included. A missing
+            // bound leaves the range open on its side.
+            RangeChecksum rangeChecksum(const RowValues* begin,
+                                        const RowValues* end) const;
+
+            // JSON counterpart, the bounds are objects with the primary keys (or their value for a single primary
+            // key) and null for an open side. Returns the "checksum" as hexadecimal text and the "count" of rows.
+            nlohmann::json rangeChecksum(const nlohmann::json& begin,
+                                         const nlohmann::json& end) const;
+
+            static uint64_t rowChecksum(const RowValues& row);
+
+        private:
+            struct Node;
+
+            RowValues key(const RowValues& row) const;
+
+            RowValues boundKey(const nlohmann::json& bound) const;
+
+            static Value jsonValue(const nlohmann::json& value);
+
+            static bool lessKeys(const RowValues& lhs,
+                                 const RowValues& rhs);
+
+            static void update(Node* node);
+
+            static std::unique_ptr<Node> merge(std::unique_ptr<Node> left,
+                                               std::unique_ptr<Node> right);
+
+            static void split(std::unique_ptr<Node> node,
+                              const RowValues& key,
+                              std::unique_ptr<Node>& left,
+                              std::unique_ptr<Node>& right);
+
+            static bool replace(Node* node,
+                                const RowValues& key,
+                                const uint64_t checksum);
+
+            static bool erase(std::unique_ptr<Node>& node,
+                              const RowValues& key);
+
+            // Aggregate of the rows with keys lower than \p key, or lower or equal when \p inclusive.
+            RangeChecksum prefix(const RowValues& key,
+                                 const bool inclusive) const;
+
+            std::vector<size_t> m_primaryKeys;
+            std::vector<std::string> m_primaryKeyNames;
+            std::unique_ptr<Node> m_root;
+    };
+}// namespace DbSync
+
+#endif // _CHECKSUM_INDEX_H
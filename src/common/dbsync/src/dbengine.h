@@ -12,19 +12,153 @@
 #ifndef _DBENGINE_H
 #define _DBENGINE_H
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 #include <functional>
 #include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <nlohmann/json.hpp>
 #include "commonDefs.h"
+#include "db_exception.h"
 #include "abstractLocking.hpp"
+#include "dbsync_row.hpp"
+
+class dbengine_error : public DbSync::dbsync_error
+{
+    public:
+        explicit dbengine_error(const std::pair<int, std::string>& exceptionInfo)
+            : DbSync::dbsync_error
+        {
+            exceptionInfo.first, "dbEngine: " + exceptionInfo.second
+        }
+        {}
+};
 
 namespace DbSync
 {
     using ResultCallback = std::function<void(ReturnTypeCallback, const nlohmann::json&)>;
 
+    template <typename T>
+    T numericRowValue(const Value& value)
+    {
+        return std::visit([](const auto & data) -> T
+        {
+            using V = std::decay_t<decltype(data)>;
+
+            if constexpr (std::is_arithmetic_v<V>)
+            {
+                return static_cast<T>(data);
+            }
+            else if constexpr (std::is_same_v<V, std::string>)
+            {
+                // Text values of numeric columns are converted as the JSON API does.
+                if (data.empty())
+                {
+                    return T {};
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    return static_cast<T>(std::stod(data));
+                }
+                else if constexpr (std::is_unsigned_v<T>)
+                {
+                    return static_cast<T>(std::stoull(data));
+                }
+                else
+                {
+                    return static_cast<T>(std::stoll(data));
+                }
+            }
+            else
+            {
+                return T {};
+            }
+        }, value);
+    }
+
+    inline bool equalRowValues(const Value& lhs,
+                               const Value& rhs)
+    {
+        // Numbers are compared by value whatever their type, as the JSON values are.
+        return std::visit([](const auto & left, const auto & right)
+        {
+            using L = std::decay_t<decltype(left)>;
+            using R = std::decay_t<decltype(right)>;
+
+            if constexpr (std::is_integral_v<L> && std::is_integral_v<R>)
+            {
+                return std::cmp_equal(left, right);
+            }
+            else if constexpr (std::is_arithmetic_v<L> && std::is_arithmetic_v<R>)
+            {
+                return static_cast<double>(left) == static_cast<double>(right);
+            }
+            else if constexpr (std::is_same_v<L, R>)
+            {
+                return left == right;
+            }
+            else
+            {
+                return false;
+            }
+        }, lhs, rhs);
+    }
+
+    inline bool lessRowValues(const Value& lhs,
+                              const Value& rhs)
+    {
+        // As SQLite sorts them: NULL values first, then the numbers and the text at the end.
+        return std::visit([](const auto & left, const auto & right)
+        {
+            using L = std::decay_t<decltype(left)>;
+            using R = std::decay_t<decltype(right)>;
+            constexpr auto leftRank { std::is_same_v<L, std::monostate> ? 0 : std::is_same_v<L, std::string> ? 2 : 1 };
+            constexpr auto rightRank { std::is_same_v<R, std::monostate> ? 0 : std::is_same_v<R, std::string> ? 2 : 1 };
+
+            if constexpr (leftRank != rightRank)
+            {
+                return leftRank < rightRank;
+            }
+            else if constexpr (std::is_integral_v<L> && std::is_integral_v<R>)
+            {
+                return std::cmp_less(left, right);
+            }
+            else if constexpr (std::is_arithmetic_v<L> && std::is_arithmetic_v<R>)
+            {
+                return static_cast<double>(left) < static_cast<double>(right);
+            }
+            else if constexpr (std::is_same_v<L, std::string>)
+            {
+                return left < right;
+            }
+            else
+            {
+                return false;
+            }
+        }, lhs, rhs);
+    }
+
+    // Rows of an open query, read one at a time so only the current row is kept in memory.
+    class IDbCursor
+    {
+        public:
+            // LCOV_EXCL_START
+            virtual ~IDbCursor() = default;
+            // LCOV_EXCL_STOP
+
+            virtual const std::vector<std::string>& columns() const = 0;
+
+            // Reads the next row into \p row, in the order of the columns. Returns false once every row was read.
+            virtual bool next(RowValues& row) = 0;
+
+        protected:
+            IDbCursor() = default;
+    };
+
     class IDbEngine
     {
         public:
@@ -44,9 +178,22 @@ namespace DbSync
                                           const bool inTransaction,
                                           Utils::ILocking& mutex) = 0;
 
+            virtual void syncTableRowValues(const RowBatch& rows,
+                                           const RowCallback callback,
+                                           const bool inTransaction,
+                                           Utils::ILocking& mutex) = 0;
+
             virtual void setMaxRows(const std::string& table,
                                     const int64_t maxRows) = 0;
 
+            virtual void enableRowHash(const std::string& table) = 0;
+
+            virtual void enableChecksumIndex(const std::string& table) = 0;
+
+            virtual nlohmann::json getRangeChecksum(const std::string& table,
+                                                    const nlohmann::json& begin,
+                                                    const nlohmann::json& end) = 0;
+
             virtual void initializeStatusField(const nlohmann::json& tableNames) = 0;
 
             virtual void deleteRowsByStatusField(const nlohmann::json& tableNames) = 0;
@@ -60,11 +207,23 @@ namespace DbSync
                                     const ResultCallback& callback,
                                     std::unique_lock<std::shared_timed_mutex>& lock) = 0;
 
+            virtual std::unique_ptr<IDbCursor> openCursor(const std::string& table,
+                                                          const nlohmann::json& query) = 0;
+
+            virtual std::unique_ptr<IDbCursor> openDeletedRowsCursor(const std::string& table) = 0;
+
             virtual void deleteTableRowsData(const std::string& table,
-                                             const nlohmann::json& jsDeletionData) = 0;
+                                             const nlohmann::json& jsDeletionData,
+                                             const DbSync::ResultCallback callback,
+                                             std::unique_lock<std::shared_timed_mutex>& lock) = 0;
+
+            virtual void keepTableRowsData(const std::string& table,
+                                           const nlohmann::json& jsKeepData) = 0;
 
             virtual void addTableRelationship(const nlohmann::json& data) = 0;
 
+            virtual nlohmann::json getStatementCacheStats() = 0;
+
         protected:
             IDbEngine() = default;
     };
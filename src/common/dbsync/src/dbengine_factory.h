@@ -13,6 +13,7 @@
 #define _DBENGINE_FACTORY_H
 
 #include "db_exception.h"
+#include "memory/memory_dbengine.h"
 #include "sqlite/sqlite_dbengine.h"
 #include "sqlite/sqlite_wrapper_factory.h"
 #include "commonDefs.h"
@@ -34,6 +35,12 @@ namespace DbSync
                     return std::make_unique<SQLiteDBEngine>(std::make_shared<SQLiteFactory>(), path, sqlStatement, dbManagement, upgradeStatements);
                 }
 
+                // The memory engine has no file to keep nor to upgrade.
+                if (MEMORY == dbType && DbManagement::VOLATILE == dbManagement && upgradeStatements.empty())
+                {
+                    return std::make_unique<MemoryDBEngine>(sqlStatement);
+                }
+
                 throw dbsync_error
                 {
                     FACTORY_INSTANTATION
@@ -9,6 +9,7 @@
  * Foundation.
  */
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include "dbsync.h"
@@ -462,7 +463,7 @@ int dbsync_delete_rows(const DBSYNC_HANDLE handle,
         try
         {
             const std::unique_ptr<char, CJsonSmartFree> spJsonBytes{ cJSON_PrintUnformatted(js_key_values) };
-            DBSyncImplementation::instance().deleteRowsData(handle, nlohmann::json::parse(spJsonBytes.get()));
+            DBSyncImplementation::instance().deleteRowsData(handle, nlohmann::json::parse(spJsonBytes.get()), nullptr);
             retVal = 0;
         }
         catch (const nlohmann::detail::exception& ex)
@@ -713,6 +714,28 @@ void DBSync::setTableMaxRow(const std::string& table,
     DBSyncImplementation::instance().setMaxRows(m_dbsyncHandle, table, maxRows);
 }
 
+void DBSync::enableTableRowHash(const std::string& table)
+{
+    DBSyncImplementation::instance().enableRowHash(m_dbsyncHandle, table);
+}
+
+nlohmann::json DBSync::getStatementCacheStats()
+{
+    return DBSyncImplementation::instance().getStatementCacheStats(m_dbsyncHandle);
+}
+
+void DBSync::enableTableChecksumIndex(const std::string& table)
+{
+    DBSyncImplementation::instance().enableChecksumIndex(m_dbsyncHandle, table);
+}
+
+nlohmann::json DBSync::getRangeChecksum(const std::string& table,
+                                        const nlohmann::json& begin,
+                                        const nlohmann::json& end)
+{
+    return DBSyncImplementation::instance().getRangeChecksum(m_dbsyncHandle, table, begin, end);
+}
+
 void DBSync::syncRow(const nlohmann::json& jsInput,
                      ResultCallbackData    callbackData)
 {
@@ -726,6 +749,12 @@ void DBSync::syncRow(const nlohmann::json& jsInput,
     DBSyncImplementation::instance().syncRowData(m_dbsyncHandle, jsInput, callbackWrapper);
 }
 
+void DBSync::syncRow(const DbSync::RowBatch&    rows,
+                     const DbSync::RowCallback& callback)
+{
+    DBSyncImplementation::instance().syncRowData(m_dbsyncHandle, rows, callback);
+}
+
 void DBSync::selectRows(const nlohmann::json& jsInput,
                         ResultCallbackData    callbackData)
 {
@@ -741,7 +770,20 @@ void DBSync::selectRows(const nlohmann::json& jsInput,
 
 void DBSync::deleteRows(const nlohmann::json& jsInput)
 {
-    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput);
+    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput, nullptr);
+}
+
+void DBSync::deleteRows(const nlohmann::json& jsInput,
+                        ResultCallbackData    callbackData)
+{
+    const auto callbackWrapper
+    {
+        [callbackData](ReturnTypeCallback result, const nlohmann::json & jsonResult)
+        {
+            callbackData(result, jsonResult);
+        }
+    };
+    DBSyncImplementation::instance().deleteRowsData(m_dbsyncHandle, jsInput, callbackWrapper);
 }
 
 void DBSync::updateWithSnapshot(const nlohmann::json& jsInput,
@@ -821,6 +863,12 @@ void DBSyncTxn::syncTxnRow(const nlohmann::json& jsInput)
     PipelineFactory::instance().pipeline(m_txn)->syncRow(jsInput);
 }
 
+void DBSyncTxn::syncTxnRow(const DbSync::RowBatch&    rows,
+                           const DbSync::RowCallback& callback)
+{
+    PipelineFactory::instance().pipeline(m_txn)->syncRow(rows, callback);
+}
+
 void DBSyncTxn::getDeletedRows(ResultCallbackData  callbackData)
 {
     const auto callbackWrapper
@@ -833,6 +881,113 @@ void DBSyncTxn::getDeletedRows(ResultCallbackData  callbackData)
     PipelineFactory::instance().pipeline(m_txn)->getDeleted(callbackWrapper);
 }
 
+void DBSyncTxn::keepTxnRows(const nlohmann::json& jsInput)
+{
+    PipelineFactory::instance().pipeline(m_txn)->keepRows(jsInput);
+}
+
+DBSyncCursor DBSyncTxn::deletedRowsCursor(const std::string& table,
+                                          const size_t       fetchSize)
+{
+    const auto& pipeline { PipelineFactory::instance().pipeline(m_txn) };
+    return DBSyncCursor { pipeline->handle(), pipeline->openDeletedRowsCursor(table), fetchSize };
+}
+
+DBSyncCursor::DBSyncCursor(const DBSYNC_HANDLE    handle,
+                           const nlohmann::json&  jsInput,
+                           const size_t           fetchSize)
+    : DBSyncCursor { handle, DBSyncImplementation::instance().openCursor(handle, jsInput), fetchSize }
+{ }
+
+DBSyncCursor::DBSyncCursor(const DBSYNC_HANDLE                    handle,
+                           std::unique_ptr<DbSync::IDbCursor>     cursor,
+                           const size_t                           fetchSize)
+    : m_handle { handle }
+    , m_cursor { std::move(cursor) }
+    , m_columns { m_cursor->columns() }
+    , m_fetchSize { fetchSize }
+{
+    if (0 == m_fetchSize)
+    {
+        throw dbsync_error
+        {
+            INVALID_PARAMETERS
+        };
+    }
+}
+
+DBSyncCursor::DBSyncCursor(DBSyncCursor&& other) noexcept = default;
+
+DBSyncCursor& DBSyncCursor::operator=(DBSyncCursor&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_handle = other.m_handle;
+        m_cursor = std::move(other.m_cursor);
+        m_columns = std::move(other.m_columns);
+        m_fetchSize = other.m_fetchSize;
+    }
+
+    return *this;
+}
+
+DBSyncCursor::~DBSyncCursor()
+{
+    close();
+}
+
+size_t DBSyncCursor::columnIndex(const std::string& name) const
+{
+    const auto it { std::find(m_columns.begin(), m_columns.end(), name) };
+
+    if (m_columns.end() == it)
+    {
+        throw dbsync_error
+        {
+            INVALID_PARAMETERS
+        };
+    }
+
+    return static_cast<size_t>(std::distance(m_columns.begin(), it));
+}
+
+size_t DBSyncCursor::next(std::vector<DbSync::RowValues>& rows)
+{
+    if (!m_cursor)
+    {
+        rows.clear();
+        return 0;
+    }
+
+    const auto ret { DBSyncImplementation::instance().fetchCursor(m_handle, *m_cursor, rows, m_fetchSize) };
+
+    if (ret < m_fetchSize)
+    {
+        // The last rows were fetched, the statement is released without waiting for the destructor.
+        close();
+    }
+
+    return ret;
+}
+
+void DBSyncCursor::close()
+{
+    if (m_cursor)
+    {
+        try
+        {
+            DBSyncImplementation::instance().closeCursor(m_handle, m_cursor);
+        }
+        catch (const DbSync::dbsync_error& ex)
+        {
+            // The database was already released, the cursor is closed on its own.
+            log_message(ex.what());
+            m_cursor.reset();
+        }
+    }
+}
+
 SelectQuery& SelectQuery::columnList(const std::vector<std::string>& fields)
 {
     m_jsQuery["query"]["column_list"] = fields;
@@ -911,6 +1066,12 @@ SyncRowQuery& SyncRowQuery::returnOldData()
     return *this;
 }
 
+SyncRowQuery& SyncRowQuery::disableBulkSync()
+{
+    m_jsQuery["options"]["bulk_sync"] = false;
+    return *this;
+}
+
 SyncRowQuery& SyncRowQuery::reset()
 {
     m_jsQuery["data"].clear();
@@ -87,6 +87,11 @@ namespace DbSync
                     pushResult(result);
                 }
             }
+            void syncRow(const RowBatch& rows, const RowCallback& callback) override
+            {
+                // The typed rows aren't queued, their results are reported before returning.
+                DBSyncImplementation::instance().syncRowData(m_handle, m_txnContext, rows, callback);
+            }
             void getDeleted(ResultCallback callback) override
             {
                 if (m_spDispatchNode)
@@ -96,6 +101,23 @@ namespace DbSync
 
                 DBSyncImplementation::instance().getDeleted(m_handle, m_txnContext, callback);
             }
+            std::unique_ptr<IDbCursor> openDeletedRowsCursor(const std::string& table) override
+            {
+                if (m_spDispatchNode)
+                {
+                    m_spDispatchNode->rundown();
+                }
+
+                return DBSyncImplementation::instance().openDeletedRowsCursor(m_handle, m_txnContext, table);
+            }
+            void keepRows(const nlohmann::json& json) override
+            {
+                DBSyncImplementation::instance().keepRowsData(m_handle, m_txnContext, json);
+            }
+            DBSYNC_HANDLE handle() const override
+            {
+                return m_handle;
+            }
         private:
             using SyncResult = std::pair<ReturnTypeCallback, nlohmann::json>;
             using DispatchCallbackNode = Utils::ReadNode<SyncResult>;
@@ -27,7 +27,11 @@ namespace DbSync
         virtual ~IPipeline() = default;
         // LCOV_EXCL_STOP
         virtual void syncRow(const nlohmann::json& syncJson) = 0;
+        virtual void syncRow(const RowBatch& rows, const RowCallback& callback) = 0;
         virtual void getDeleted(const ResultCallback callback) = 0;
+        virtual std::unique_ptr<IDbCursor> openDeletedRowsCursor(const std::string& table) = 0;
+        virtual void keepRows(const nlohmann::json& json) = 0;
+        virtual DBSYNC_HANDLE handle() const = 0;
     };
 
     class PipelineFactory final
@@ -9,6 +9,7 @@
  * Foundation.
  */
 
+#include <algorithm>
 #include <iostream>
 #include "abstractLocking.hpp"
 #include "dbsync_implementation.h"
@@ -85,15 +86,49 @@ void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
                                       true,
                                       lock);
 }
+void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
+                                       const RowBatch&          rows,
+                                       const RowCallback        callback)
+{
+    const auto ctx{ dbEngineContext(handle) };
+    Utils::ExclusiveLocking lock{ ctx->m_syncMutex };
+
+    ctx->m_dbEngine->syncTableRowValues(rows,
+                                        callback,
+                                        false,
+                                        lock);
+}
+void DBSyncImplementation::syncRowData(const DBSYNC_HANDLE      handle,
+                                       const TXN_HANDLE         txn,
+                                       const RowBatch&          rows,
+                                       const RowCallback        callback)
+{
+    const auto& ctx{ dbEngineContext(handle) };
+    const auto& tnxCtx { ctx->transactionContext(txn) };
+
+    if (std::find(tnxCtx->m_tables.begin(), tnxCtx->m_tables.end(), rows.table) == tnxCtx->m_tables.end())
+    {
+        throw dbsync_error{INVALID_TABLE};
+    }
+
+    Utils::SharedLocking lock{ ctx->m_syncMutex };
+    ctx->m_dbEngine->syncTableRowValues(rows,
+                                        callback,
+                                        true,
+                                        lock);
+}
 
 void DBSyncImplementation::deleteRowsData(const DBSYNC_HANDLE   handle,
-                                          const nlohmann::json& json)
+                                          const nlohmann::json& json,
+                                          const ResultCallback  callback)
 {
     const auto ctx{ dbEngineContext(handle) };
-    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    std::unique_lock<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
 
     ctx->m_dbEngine->deleteTableRowsData(json.at("table"),
-                                         json.at("query"));
+                                         json.at("query"),
+                                         callback,
+                                         lock);
 }
 
 void DBSyncImplementation::updateSnapshotData(const DBSYNC_HANDLE   handle,
@@ -129,6 +164,42 @@ void DBSyncImplementation::setMaxRows(const DBSYNC_HANDLE handle,
     ctx->m_dbEngine->setMaxRows(table, maxRows);
 }
 
+void DBSyncImplementation::enableRowHash(const DBSYNC_HANDLE handle,
+                                         const std::string& table)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    ctx->m_dbEngine->enableRowHash(table);
+}
+
+nlohmann::json DBSyncImplementation::getStatementCacheStats(const DBSYNC_HANDLE handle)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    return ctx->m_dbEngine->getStatementCacheStats();
+}
+
+void DBSyncImplementation::enableChecksumIndex(const DBSYNC_HANDLE handle,
+                                               const std::string& table)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    ctx->m_dbEngine->enableChecksumIndex(table);
+}
+
+nlohmann::json DBSyncImplementation::getRangeChecksum(const DBSYNC_HANDLE handle,
+                                                      const std::string& table,
+                                                      const nlohmann::json& begin,
+                                                      const nlohmann::json& end)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    return ctx->m_dbEngine->getRangeChecksum(table, begin, end);
+}
+
 TXN_HANDLE DBSyncImplementation::createTransaction(const DBSYNC_HANDLE      handle,
                                                    const nlohmann::json&    json)
 {
@@ -180,6 +251,99 @@ void DBSyncImplementation::selectData(const DBSYNC_HANDLE   handle,
                                 lock);
 }
 
+std::unique_ptr<IDbCursor> DBSyncImplementation::openCursor(const DBSYNC_HANDLE   handle,
+                                                            const nlohmann::json& json)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    return ctx->m_dbEngine->openCursor(json.at("table"), json.at("query"));
+}
+
+std::unique_ptr<IDbCursor> DBSyncImplementation::openDeletedRowsCursor(const DBSYNC_HANDLE handle,
+                                                                       const TXN_HANDLE    txnHandle,
+                                                                       const std::string&  table)
+{
+    const auto& ctx{ dbEngineContext(handle) };
+    const auto& tnxCtx { ctx->transactionContext(txnHandle) };
+
+    // Only the tables of the transaction have rows marked for deletion.
+    const auto txnTable
+    {
+        std::any_of(tnxCtx->m_tables.begin(), tnxCtx->m_tables.end(), [&table](const nlohmann::json & value)
+        {
+            return value.is_string() && 0 == value.get_ref<const std::string&>().compare(table);
+        })
+    };
+
+    if (!txnTable)
+    {
+        throw dbsync_error { INVALID_TABLE };
+    }
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    return ctx->m_dbEngine->openDeletedRowsCursor(table);
+}
+
+void DBSyncImplementation::keepRowsData(const DBSYNC_HANDLE   handle,
+                                        const TXN_HANDLE      txnHandle,
+                                        const nlohmann::json& json)
+{
+    const auto& ctx{ dbEngineContext(handle) };
+    const auto& tnxCtx { ctx->transactionContext(txnHandle) };
+    const auto& table { json.at("table").get_ref<const std::string&>() };
+
+    // Only the rows of the transaction tables are deleted when it's closed.
+    const auto txnTable
+    {
+        std::any_of(tnxCtx->m_tables.begin(), tnxCtx->m_tables.end(), [&table](const nlohmann::json & value)
+        {
+            return value.is_string() && 0 == value.get_ref<const std::string&>().compare(table);
+        })
+    };
+
+    if (!txnTable)
+    {
+        throw dbsync_error { INVALID_TABLE };
+    }
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    ctx->m_dbEngine->keepTableRowsData(table, json.at("query"));
+}
+
+size_t DBSyncImplementation::fetchCursor(const DBSYNC_HANDLE      handle,
+                                         IDbCursor&               cursor,
+                                         std::vector<RowValues>&  rows,
+                                         const size_t             fetchSize)
+{
+    const auto ctx{ dbEngineContext(handle) };
+    size_t ret { 0 };
+
+    // The rows of the previous fetch are overwritten, so their storage is reused.
+    rows.resize(fetchSize);
+
+    {
+        std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+
+        while (ret < fetchSize && cursor.next(rows[ret]))
+        {
+            ++ret;
+        }
+    }
+
+    rows.resize(ret);
+    return ret;
+}
+
+void DBSyncImplementation::closeCursor(const DBSYNC_HANDLE            handle,
+                                       std::unique_ptr<IDbCursor>&    cursor)
+{
+    const auto ctx{ dbEngineContext(handle) };
+
+    std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
+    cursor.reset();
+}
+
 void DBSyncImplementation::addTableRelationship(const DBSYNC_HANDLE   handle,
                                                 const nlohmann::json& json)
 {
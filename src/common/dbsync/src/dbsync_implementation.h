@@ -43,8 +43,18 @@ namespace DbSync
                              const nlohmann::json&  json,
                              const ResultCallback   callback);
 
+            void syncRowData(const DBSYNC_HANDLE    handle,
+                             const RowBatch&        rows,
+                             const RowCallback      callback);
+
+            void syncRowData(const DBSYNC_HANDLE    handle,
+                             const TXN_HANDLE       txnHandle,
+                             const RowBatch&        rows,
+                             const RowCallback      callback);
+
             void deleteRowsData(const DBSYNC_HANDLE     handle,
-                                const nlohmann::json&   json);
+                                const nlohmann::json&   json,
+                                const ResultCallback    callback);
 
             void updateSnapshotData(const DBSYNC_HANDLE     handle,
                                     const nlohmann::json&   json,
@@ -61,6 +71,19 @@ namespace DbSync
                             const std::string& table,
                             const long long maxRows);
 
+            void enableRowHash(const DBSYNC_HANDLE handle,
+                               const std::string& table);
+
+            nlohmann::json getStatementCacheStats(const DBSYNC_HANDLE handle);
+
+            void enableChecksumIndex(const DBSYNC_HANDLE handle,
+                                     const std::string& table);
+
+            nlohmann::json getRangeChecksum(const DBSYNC_HANDLE handle,
+                                            const std::string& table,
+                                            const nlohmann::json& begin,
+                                            const nlohmann::json& end);
+
             TXN_HANDLE createTransaction(const DBSYNC_HANDLE    handle,
                                          const nlohmann::json&  json);
 
@@ -75,6 +98,25 @@ namespace DbSync
                             const nlohmann::json&  json,
                             const ResultCallback&  callback);
 
+            std::unique_ptr<IDbCursor> openCursor(const DBSYNC_HANDLE   handle,
+                                                  const nlohmann::json& json);
+
+            std::unique_ptr<IDbCursor> openDeletedRowsCursor(const DBSYNC_HANDLE handle,
+                                                             const TXN_HANDLE    txnHandle,
+                                                             const std::string&  table);
+
+            void keepRowsData(const DBSYNC_HANDLE   handle,
+                              const TXN_HANDLE      txnHandle,
+                              const nlohmann::json& json);
+
+            size_t fetchCursor(const DBSYNC_HANDLE      handle,
+                               IDbCursor&               cursor,
+                               std::vector<RowValues>&  rows,
+                               const size_t             fetchSize);
+
+            void closeCursor(const DBSYNC_HANDLE            handle,
+                             std::unique_ptr<IDbCursor>&    cursor);
+
             void addTableRelationship(const DBSYNC_HANDLE   handle,
                                       const nlohmann::json& json);
 
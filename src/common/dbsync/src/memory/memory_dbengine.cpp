@@ -0,0 +1,1435 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "db_exception.h"
+#include "stringHelper.h"
+#include "memory_dbengine.h"
+
+constexpr auto MEMORY_SQL_BLANKS {" \t\r\n"};
+
+constexpr auto MEMORY_SQL_QUOTES {" \t\r\n`\"'[]"};
+
+static std::vector<std::string> splitColumnDefinitions(const std::string& definitions)
+{
+    // Commas inside parentheses (e.g. PRIMARY KEY (a, b)) don't split the definitions.
+    std::vector<std::string> ret;
+    std::string current;
+    auto depth { 0 };
+
+    for (const auto character : definitions)
+    {
+        if ('(' == character)
+        {
+            ++depth;
+        }
+        else if (')' == character)
+        {
+            --depth;
+        }
+
+        if (',' == character && 0 == depth)
+        {
+            ret.push_back(Utils::trim(current, MEMORY_SQL_BLANKS));
+            current.clear();
+        }
+        else
+        {
+            current.push_back(character);
+        }
+    }
+
+    ret.push_back(Utils::trim(current, MEMORY_SQL_BLANKS));
+    return ret;
+}
+
+static std::vector<std::string> getPrimaryKeyClause(const std::string& definition)
+{
+    std::vector<std::string> ret;
+    const auto open { definition.find('(') };
+    const auto close { definition.rfind(')') };
+
+    if (std::string::npos == open || std::string::npos == close || close < open)
+    {
+        throw dbengine_error { SQL_STMT_ERROR };
+    }
+
+    for (const auto& name : Utils::split(definition.substr(open + 1, close - open - 1), ','))
+    {
+        ret.push_back(Utils::trim(name, MEMORY_SQL_QUOTES));
+    }
+
+    return ret;
+}
+
+static uint64_t mixHash(uint64_t hash)
+{
+    // std::hash is the identity for the integers on most implementations, the bits are mixed before they are used
+    // to place the row in the index.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+MemoryTable::MemoryTable(std::vector<MemoryColumn> columns)
+    : m_columns { std::move(columns) }
+    , m_slots(MEMORY_INDEX_MIN_SLOTS, Slot { 0u, 0u })
+{
+    for (size_t i = 0; i < m_columns.size(); ++i)
+    {
+        if (m_columns[i].primaryKey)
+        {
+            m_primaryKeys.push_back(i);
+        }
+    }
+}
+
+uint64_t MemoryTable::keyHash(const DbSync::RowValues& key)
+{
+    uint64_t hash { 0xcbf29ce484222325ull };
+
+    for (const auto& value : key)
+    {
+        hash ^= std::hash<DbSync::Value> {}(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+
+    return mixHash(hash);
+}
+
+size_t MemoryTable::find(const DbSync::RowValues& key,
+                         const uint64_t hash) const
+{
+    const auto mask { m_slots.size() - 1 };
+    const auto tag { static_cast<uint32_t>(hash >> 32) };
+
+    for (auto slot { hash & mask }; ; slot = (slot + 1) & mask)
+    {
+        const auto& current { m_slots[slot] };
+
+        if (0 == current.row)
+        {
+            return npos;
+        }
+
+        if (tag == current.tag && matches(m_rows[current.row - 1], key))
+        {
+            return current.row - 1;
+        }
+    }
+}
+
+size_t MemoryTable::insert(MemoryRow row)
+{
+    if ((m_rows.size() + 1) * MEMORY_INDEX_MAX_LOAD_DEN > m_slots.size() * MEMORY_INDEX_MAX_LOAD_NUM)
+    {
+        rehash(m_slots.size() * 2);
+    }
+
+    const auto mask { m_slots.size() - 1 };
+    auto slot { row.hash & mask };
+
+    while (0 != m_slots[slot].row)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    m_slots[slot] = Slot { static_cast<uint32_t>(m_rows.size() + 1), static_cast<uint32_t>(row.hash >> 32) };
+    m_rows.push_back(std::move(row));
+    updated(m_rows.size() - 1);
+    return m_rows.size() - 1;
+}
+
+void MemoryTable::erase(const size_t index)
+{
+    if (m_checksumIndex)
+    {
+        m_checksumIndex->erase(m_rows[index].values);
+    }
+
+    const auto mask { m_slots.size() - 1 };
+    auto hole { slotOf(index) };
+
+    // Backward shift deletion: the following slots of the cluster are moved to the hole when their home slot allows
+    // it, so the probing sequences stay unbroken without tombstones.
+    for (auto next { (hole + 1) & mask }; 0 != m_slots[next].row; next = (next + 1) & mask)
+    {
+        const auto home { m_rows[m_slots[next].row - 1].hash & mask };
+
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+        }
+    }
+
+    m_slots[hole] = Slot { 0u, 0u };
+
+    // The last row is moved to the erased position to keep the rows contiguous.
+    const auto last { m_rows.size() - 1 };
+
+    if (index != last)
+    {
+        m_slots[slotOf(last)].row = static_cast<uint32_t>(index + 1);
+        m_rows[index] = std::move(m_rows[last]);
+    }
+
+    m_rows.pop_back();
+}
+
+void MemoryTable::updated(const size_t index)
+{
+    if (m_checksumIndex)
+    {
+        m_checksumIndex->upsert(m_rows[index].values);
+    }
+}
+
+void MemoryTable::enableChecksumIndex()
+{
+    if (!m_checksumIndex)
+    {
+        std::vector<std::string> primaryKeyNames;
+
+        for (const auto primaryKey : m_primaryKeys)
+        {
+            primaryKeyNames.push_back(m_columns[primaryKey].name);
+        }
+
+        m_checksumIndex = std::make_unique<DbSync::ChecksumIndex>(m_primaryKeys, std::move(primaryKeyNames));
+
+        for (const auto& row : m_rows)
+        {
+            m_checksumIndex->upsert(row.values);
+        }
+    }
+}
+
+bool MemoryTable::matches(const MemoryRow& row,
+                          const DbSync::RowValues& key) const
+{
+    for (size_t i = 0; i < m_primaryKeys.size(); ++i)
+    {
+        if (row.values[m_primaryKeys[i]] != key[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t MemoryTable::slotOf(const size_t index) const
+{
+    const auto mask { m_slots.size() - 1 };
+    auto slot { m_rows[index].hash & mask };
+
+    while (index + 1 != m_slots[slot].row)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void MemoryTable::rehash(const size_t slots)
+{
+    m_slots.assign(slots, Slot { 0u, 0u });
+    const auto mask { slots - 1 };
+
+    for (size_t i = 0; i < m_rows.size(); ++i)
+    {
+        auto slot { m_rows[i].hash & mask };
+
+        while (0 != m_slots[slot].row)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        m_slots[slot] = Slot { static_cast<uint32_t>(i + 1), static_cast<uint32_t>(m_rows[i].hash >> 32) };
+    }
+}
+
+MemoryDBEngine::MemoryDBEngine(const std::string& tableStmtCreation)
+{
+    createTables(tableStmtCreation);
+}
+
+void MemoryDBEngine::bulkInsert(const std::string& table,
+                                const nlohmann::json& data)
+{
+    auto& memoryTable { getTable(table) };
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& element : data)
+    {
+        auto row { getRow(memoryTable, element) };
+
+        if (MemoryTable::npos != memoryTable.find(getKey(memoryTable, row), row.hash))
+        {
+            throw dbengine_error { DUPLICATED_PK_DATA };
+        }
+
+        insertRow(table, memoryTable, std::move(row));
+    }
+}
+
+void MemoryDBEngine::refreshTableData(const nlohmann::json& data,
+                                      const DbSync::ResultCallback callback,
+                                      std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    const std::string table { data.at("table").is_string() ? data.at("table").get_ref<const std::string&>() : "" };
+    auto& memoryTable { getTable(table) };
+    std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        MemoryTable snapshot { memoryTable.columns() };
+
+        for (const auto& element : data.at("data"))
+        {
+            auto row { getRow(snapshot, element) };
+
+            if (MemoryTable::npos != snapshot.find(getKey(snapshot, row), row.hash))
+            {
+                throw dbengine_error { DUPLICATED_PK_DATA };
+            }
+
+            snapshot.insert(std::move(row));
+        }
+
+        const auto& columns { memoryTable.columns() };
+        const auto& primaryKeys { memoryTable.primaryKeys() };
+
+        // The rows missing in the snapshot are removed, only their primary keys are reported. The rows are erased
+        // from the end, so the row moved to the erased position was already checked.
+        for (auto i { memoryTable.size() }; i-- > 0;)
+        {
+            const auto& row { memoryTable.rows()[i] };
+
+            if (MemoryTable::npos == snapshot.find(getKey(memoryTable, row), row.hash))
+            {
+                nlohmann::json object;
+
+                for (const auto primaryKey : primaryKeys)
+                {
+                    object[columns[primaryKey].name] = getJson(row.values[primaryKey]);
+                }
+
+                results.emplace_back(DELETED, std::move(object));
+                memoryTable.erase(i);
+            }
+        }
+
+        // The modified rows report their primary keys and the columns whose values changed, a NULL value doesn't
+        // replace the stored one.
+        for (const auto& row : snapshot.rows())
+        {
+            const auto index { memoryTable.find(getKey(snapshot, row), row.hash) };
+
+            if (MemoryTable::npos != index)
+            {
+                auto& current { memoryTable.row(index) };
+                nlohmann::json object;
+                auto modified { false };
+
+                for (const auto primaryKey : primaryKeys)
+                {
+                    object["PK_" + columns[primaryKey].name] = getJson(row.values[primaryKey]);
+                }
+
+                for (size_t i = 0; i < columns.size(); ++i)
+                {
+                    if (!std::holds_alternative<std::monostate>(row.values[i])
+                            && !std::holds_alternative<std::monostate>(current.values[i])
+                            && !DbSync::equalRowValues(row.values[i], current.values[i]))
+                    {
+                        modified = true;
+                        object[columns[i].name] = getJson(row.values[i]);
+                        current.values[i] = row.values[i];
+                    }
+                }
+
+                if (modified)
+                {
+                    memoryTable.updated(index);
+                    results.emplace_back(MODIFIED, std::move(object));
+                }
+            }
+            else
+            {
+                results.emplace_back(INSERTED, getRowJson(memoryTable, row));
+                insertRow(table, memoryTable, row);
+            }
+        }
+    }
+
+    // The results are reported in the same order as the SQLite engine does: deleted, modified and inserted rows.
+    for (const auto type : { DELETED, MODIFIED, INSERTED })
+    {
+        for (const auto& result : results)
+        {
+            if (callback && type == result.first)
+            {
+                lock.unlock();
+                callback(result.first, result.second);
+                lock.lock();
+            }
+        }
+    }
+}
+
+void MemoryDBEngine::syncTableRowData(const nlohmann::json& jsInput,
+                                      const DbSync::ResultCallback callback,
+                                      const bool inTransaction,
+                                      Utils::ILocking& lock)
+{
+    const auto& table { jsInput.at("table").get_ref<const std::string&>() };
+    const auto& data { jsInput.at("data") };
+
+    auto it { jsInput.find("options") };
+    auto returnOldData { false };
+    nlohmann::json ignoredColumns { };
+
+    // The bulk_sync option only changes how the SQLite engine looks the rows up, it's ignored here.
+    if (jsInput.end() != it)
+    {
+        auto itOldData { it->find("return_old_data") };
+
+        if (it->end() != itOldData)
+        {
+            returnOldData = itOldData->is_boolean() ? itOldData.value().get<bool>() : returnOldData;
+        }
+
+        auto itIgnoredFields { it->find("ignore") };
+
+        if (it->end() != itIgnoredFields)
+        {
+            ignoredColumns = itIgnoredFields->is_array() ? itIgnoredFields.value() : ignoredColumns;
+        }
+    }
+
+    auto& memoryTable { getTable(table) };
+    const auto& columns { memoryTable.columns() };
+    DbSync::RowValues key;
+
+    for (const auto& entry : data)
+    {
+        std::unique_lock<std::mutex> guard(m_mutex);
+
+        if (!getKey(memoryTable, entry, key))
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+
+        const auto hash { MemoryTable::keyHash(key) };
+        const auto index { memoryTable.find(key, hash) };
+
+        if (MemoryTable::npos != index)
+        {
+            auto& row { memoryTable.row(index) };
+            nlohmann::json updated;
+            nlohmann::json oldData;
+            auto modified { false };
+            auto modifiedNotIgnored { false };
+
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                const auto& itValue { entry.find(columns[i].name) };
+
+                if (entry.end() != itValue)
+                {
+                    if (columns[i].primaryKey)
+                    {
+                        oldData[columns[i].name] = *itValue;
+                    }
+                    else if (!equalJsonValue(*itValue, row.values[i]))
+                    {
+                        modified = true;
+                        modifiedNotIgnored = modifiedNotIgnored
+                                             || ignoredColumns.end() == std::find(ignoredColumns.begin(), ignoredColumns.end(), columns[i].name);
+                        oldData[columns[i].name] = getJson(row.values[i]);
+                    }
+
+                    updated[columns[i].name] = *itValue;
+                }
+            }
+
+            // The row is only modified when a column out of the ignored ones changed.
+            if (modified && modifiedNotIgnored)
+            {
+                for (size_t i = 0; i < columns.size(); ++i)
+                {
+                    const auto& itValue { entry.find(columns[i].name) };
+
+                    if (entry.end() != itValue && !columns[i].primaryKey)
+                    {
+                        row.values[i] = getValue(columns[i], *itValue);
+                    }
+                }
+
+                memoryTable.updated(index);
+                row.status = row.status || inTransaction;
+                guard.unlock();
+
+                if (callback)
+                {
+                    lock.unlock();
+
+                    if (returnOldData)
+                    {
+                        nlohmann::json diff;
+                        diff["old"] = oldData;
+                        diff["new"] = updated;
+                        callback(MODIFIED, diff);
+                    }
+                    else
+                    {
+                        callback(MODIFIED, updated);
+                    }
+
+                    lock.lock();
+                }
+            }
+            else if (inTransaction)
+            {
+                // No changes detected, only update the status field to avoid row deletion during the txn close.
+                row.status = true;
+            }
+        }
+        else
+        {
+            insertRow(table, memoryTable, getRow(memoryTable, entry));
+            guard.unlock();
+
+            if (callback)
+            {
+                lock.unlock();
+                callback(INSERTED, entry);
+                lock.lock();
+            }
+        }
+    }
+}
+
+void MemoryDBEngine::syncTableRowValues(const DbSync::RowBatch& rows,
+                                        const DbSync::RowCallback callback,
+                                        const bool inTransaction,
+                                        Utils::ILocking& lock)
+{
+    auto& memoryTable { getTable(rows.table) };
+    const auto& columns { memoryTable.columns() };
+
+    // The columns are resolved once for the whole batch, the values of each row are then read by position.
+    std::vector<size_t> columnIndexes;
+    std::vector<size_t> keyIndexes;
+    std::vector<size_t> compareIndexes;
+
+    for (const auto& name : rows.columns)
+    {
+        const auto it
+        {
+            std::find_if(columns.begin(), columns.end(), [&name](const MemoryColumn & column)
+            {
+                return 0 == column.name.compare(name);
+            })
+        };
+
+        if (columns.end() == it)
+        {
+            throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+        }
+
+        const auto index { columnIndexes.size() };
+        columnIndexes.push_back(static_cast<size_t>(std::distance(columns.begin(), it)));
+
+        if (!it->primaryKey && rows.ignore.end() == std::find(rows.ignore.begin(), rows.ignore.end(), name))
+        {
+            compareIndexes.push_back(index);
+        }
+    }
+
+    for (const auto primaryKey : memoryTable.primaryKeys())
+    {
+        const auto it { std::find(columnIndexes.begin(), columnIndexes.end(), primaryKey) };
+
+        if (columnIndexes.end() == it)
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+
+        keyIndexes.push_back(static_cast<size_t>(std::distance(columnIndexes.begin(), it)));
+    }
+
+    DbSync::RowValues key(keyIndexes.size());
+
+    for (const auto& row : rows.rows)
+    {
+        if (row.size() != columnIndexes.size())
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        for (size_t i = 0; i < keyIndexes.size(); ++i)
+        {
+            key[i] = getValue(columns[columnIndexes[keyIndexes[i]]], row[keyIndexes[i]]);
+        }
+
+        const auto hash { MemoryTable::keyHash(key) };
+        std::unique_lock<std::mutex> guard(m_mutex);
+        const auto index { memoryTable.find(key, hash) };
+
+        if (MemoryTable::npos != index)
+        {
+            auto& stored { memoryTable.row(index) };
+            DbSync::RowValues oldRow;
+
+            if (rows.returnOldData)
+            {
+                oldRow.reserve(columnIndexes.size());
+
+                for (const auto columnIndex : columnIndexes)
+                {
+                    oldRow.push_back(stored.values[columnIndex]);
+                }
+            }
+
+            const auto modified
+            {
+                std::any_of(compareIndexes.begin(), compareIndexes.end(), [&](const size_t valueIndex)
+                {
+                    return !DbSync::equalRowValues(row[valueIndex], stored.values[columnIndexes[valueIndex]]);
+                })
+            };
+
+            if (modified)
+            {
+                for (size_t i = 0; i < columnIndexes.size(); ++i)
+                {
+                    if (!columns[columnIndexes[i]].primaryKey)
+                    {
+                        stored.values[columnIndexes[i]] = getValue(columns[columnIndexes[i]], row[i]);
+                    }
+                }
+
+                memoryTable.updated(index);
+                stored.status = stored.status || inTransaction;
+                guard.unlock();
+
+                if (callback)
+                {
+                    lock.unlock();
+                    callback(MODIFIED, row, oldRow);
+                    lock.lock();
+                }
+            }
+            else if (inTransaction)
+            {
+                // No changes detected, only update the status field to avoid row deletion during the txn close.
+                stored.status = true;
+            }
+        }
+        else
+        {
+            MemoryRow newRow { DbSync::RowValues(columns.size()), hash, true };
+
+            for (size_t i = 0; i < columnIndexes.size(); ++i)
+            {
+                newRow.values[columnIndexes[i]] = getValue(columns[columnIndexes[i]], row[i]);
+            }
+
+            insertRow(rows.table, memoryTable, std::move(newRow));
+            guard.unlock();
+
+            if (callback)
+            {
+                lock.unlock();
+                callback(INSERTED, row, {});
+                lock.lock();
+            }
+        }
+    }
+}
+
+void MemoryDBEngine::setMaxRows(const std::string& table,
+                                const int64_t maxRows)
+{
+    // Only checks that the table exists.
+    getTable(table);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (maxRows < 0)
+    {
+        throw dbengine_error { MIN_ROW_LIMIT_BELOW_ZERO };
+    }
+    else if (0 == maxRows)
+    {
+        m_maxRows.erase(table);
+    }
+    else
+    {
+        // As the SQLite engine does, the rows already stored are kept even when they exceed the limit.
+        m_maxRows[table] = maxRows;
+    }
+}
+
+void MemoryDBEngine::enableRowHash(const std::string& table)
+{
+    // Rows are always looked up by their primary keys and compared in memory, so there is no stored hash to enable.
+    // The received values are compared once converted to the column types, as they are without the row hash.
+    if (getTable(table).primaryKeys().empty())
+    {
+        throw dbengine_error { INVALID_PK_DATA };
+    }
+}
+
+void MemoryDBEngine::enableChecksumIndex(const std::string& table)
+{
+    auto& memoryTable { getTable(table) };
+
+    if (memoryTable.primaryKeys().empty())
+    {
+        throw dbengine_error { INVALID_PK_DATA };
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    memoryTable.enableChecksumIndex();
+}
+
+nlohmann::json MemoryDBEngine::getRangeChecksum(const std::string& table,
+                                                const nlohmann::json& begin,
+                                                const nlohmann::json& end)
+{
+    const auto& memoryTable { getTable(table) };
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto checksumIndex { memoryTable.checksumIndex() };
+
+    if (!checksumIndex)
+    {
+        throw dbengine_error { CHECKSUM_INDEX_NOT_ENABLED };
+    }
+
+    return checksumIndex->rangeChecksum(begin, end);
+}
+
+void MemoryDBEngine::initializeStatusField(const nlohmann::json& tableNames)
+{
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memoryTable { getTable(tableValue.get<std::string>()) };
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (size_t i = 0; i < memoryTable.size(); ++i)
+        {
+            memoryTable.row(i).status = false;
+        }
+    }
+}
+
+void MemoryDBEngine::deleteRowsByStatusField(const nlohmann::json& tableNames)
+{
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memoryTable { getTable(tableValue.get<std::string>()) };
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto i { memoryTable.size() }; i-- > 0;)
+        {
+            if (!memoryTable.rows()[i].status)
+            {
+                memoryTable.erase(i);
+            }
+        }
+    }
+}
+
+void MemoryDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
+                                               const DbSync::ResultCallback callback,
+                                               std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    for (const auto& tableValue : tableNames)
+    {
+        auto& memoryTable { getTable(tableValue.get<std::string>()) };
+        std::vector<nlohmann::json> results;
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+
+            for (const auto& row : memoryTable.rows())
+            {
+                if (!row.status)
+                {
+                    results.push_back(getRowJson(memoryTable, row));
+                }
+            }
+        }
+
+        for (const auto& result : results)
+        {
+            lock.unlock();
+            callback(ReturnTypeCallback::DELETED, result);
+            lock.lock();
+        }
+    }
+}
+
+void MemoryDBEngine::selectData(const std::string& table,
+                                const nlohmann::json& query,
+                                const DbSync::ResultCallback& callback,
+                                std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::vector<std::string> names;
+    const auto rows { selectRows(getTable(table), query, names) };
+    std::vector<nlohmann::json> results;
+
+    for (const auto& values : rows)
+    {
+        nlohmann::json object;
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (!std::holds_alternative<std::monostate>(values[i]))
+            {
+                object[names[i]] = getJson(values[i]);
+            }
+        }
+
+        results.push_back(std::move(object));
+    }
+
+    for (const auto& result : results)
+    {
+        if (callback && !result.empty())
+        {
+            lock.unlock();
+            callback(SELECTED, result);
+            lock.lock();
+        }
+    }
+}
+
+std::unique_ptr<DbSync::IDbCursor> MemoryDBEngine::openCursor(const std::string& table,
+                                                              const nlohmann::json& query)
+{
+    std::vector<std::string> names;
+    auto rows { selectRows(getTable(table), query, names) };
+    return std::make_unique<MemoryCursor>(std::move(names), std::move(rows));
+}
+
+std::unique_ptr<DbSync::IDbCursor> MemoryDBEngine::openDeletedRowsCursor(const std::string& table)
+{
+    const auto& memoryTable { getTable(table) };
+    std::vector<std::string> names;
+    std::vector<DbSync::RowValues> rows;
+
+    for (const auto& column : memoryTable.columns())
+    {
+        names.push_back(column.name);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        for (const auto& row : memoryTable.rows())
+        {
+            if (!row.status)
+            {
+                rows.push_back(row.values);
+            }
+        }
+    }
+
+    return std::make_unique<MemoryCursor>(std::move(names), std::move(rows));
+}
+
+std::vector<DbSync::RowValues> MemoryDBEngine::selectRows(const MemoryTable& memoryTable,
+                                                          const nlohmann::json& query,
+                                                          std::vector<std::string>& names)
+{
+    const auto& columns { memoryTable.columns() };
+    const auto& itFilter { query.find("row_filter") };
+    const auto& itDistinct { query.find("distinct_opt") };
+    const auto& itOrderBy { query.find("order_by_opt") };
+    const auto& itCount { query.find("count_opt") };
+
+    const auto columnIndex
+    {
+        [&columns](const std::string & name)
+        {
+            const auto it
+            {
+                std::find_if(columns.begin(), columns.end(), [&name](const MemoryColumn & column)
+                {
+                    return 0 == column.name.compare(name);
+                })
+            };
+
+            // Expressions, functions or aliases need the SQL engine.
+            if (columns.end() == it)
+            {
+                throw dbengine_error { OPERATION_NOT_SUPPORTED };
+            }
+
+            return static_cast<size_t>(std::distance(columns.begin(), it));
+        }
+    };
+
+    if (query.end() != itFilter && !itFilter->get<std::string>().empty())
+    {
+        throw dbengine_error { OPERATION_NOT_SUPPORTED };
+    }
+
+    std::vector<size_t> selectIndexes;
+
+    for (const auto& column : query.at("column_list"))
+    {
+        const auto name { Utils::trim(column.get<std::string>(), MEMORY_SQL_BLANKS) };
+
+        if (0 == name.compare("*"))
+        {
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                selectIndexes.push_back(i);
+            }
+        }
+        else
+        {
+            selectIndexes.push_back(columnIndex(name));
+        }
+    }
+
+    // The rows are sorted by the primary keys when there is no order, as a WITHOUT ROWID table returns them.
+    std::vector<std::pair<size_t, bool>> orderIndexes;
+
+    if (query.end() != itOrderBy && !itOrderBy->get<std::string>().empty())
+    {
+        for (const auto& order : Utils::split(itOrderBy->get<std::string>(), ','))
+        {
+            const auto tokens { Utils::split(Utils::trim(order, MEMORY_SQL_BLANKS), ' ') };
+            const auto descending { tokens.size() > 1 && 0 == Utils::toUpperCase(tokens.back()).compare("DESC") };
+
+            if (tokens.empty() || tokens.size() > 2
+                    || (tokens.size() == 2 && !descending && 0 != Utils::toUpperCase(tokens.back()).compare("ASC")))
+            {
+                throw dbengine_error { OPERATION_NOT_SUPPORTED };
+            }
+
+            orderIndexes.emplace_back(columnIndex(tokens.front()), descending);
+        }
+    }
+    else
+    {
+        for (const auto primaryKey : memoryTable.primaryKeys())
+        {
+            orderIndexes.emplace_back(primaryKey, false);
+        }
+    }
+
+    const auto distinct { query.end() != itDistinct && itDistinct->get<bool>() };
+    const auto limit { query.end() != itCount ? itCount->get<unsigned int>() : std::numeric_limits<unsigned int>::max() };
+    std::vector<DbSync::RowValues> results;
+
+    for (const auto selectIndex : selectIndexes)
+    {
+        names.push_back(columns[selectIndex].name);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        const auto& rows { memoryTable.rows() };
+        std::vector<size_t> order(rows.size());
+
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+
+        std::sort(order.begin(), order.end(), [&](const size_t lhs, const size_t rhs)
+        {
+            for (const auto& [index, descending] : orderIndexes)
+            {
+                const auto& left { rows[descending ? rhs : lhs].values[index] };
+                const auto& right { rows[descending ? lhs : rhs].values[index] };
+
+                if (DbSync::lessRowValues(left, right))
+                {
+                    return true;
+                }
+                else if (DbSync::lessRowValues(right, left))
+                {
+                    return false;
+                }
+            }
+
+            return false;
+        });
+
+        std::set<DbSync::RowValues> selected;
+
+        for (const auto rowIndex : order)
+        {
+            if (results.size() >= limit)
+            {
+                break;
+            }
+
+            DbSync::RowValues values;
+            values.reserve(selectIndexes.size());
+
+            for (const auto selectIndex : selectIndexes)
+            {
+                values.push_back(rows[rowIndex].values[selectIndex]);
+            }
+
+            if (distinct && !selected.insert(values).second)
+            {
+                continue;
+            }
+
+            results.push_back(std::move(values));
+        }
+    }
+
+    return results;
+}
+
+void MemoryDBEngine::deleteTableRowsData(const std::string& table,
+                                         const nlohmann::json& jsDeletionData,
+                                         const DbSync::ResultCallback callback,
+                                         std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    auto& memoryTable { getTable(table) };
+    const auto& itData { jsDeletionData.find("data") };
+    const auto& itFilter { jsDeletionData.find("where_filter_opt") };
+
+    if (itData != jsDeletionData.end() && itData->size() > 0)
+    {
+        // Deletion via primary keys on "data" json field.
+        std::vector<nlohmann::json> results;
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            DbSync::RowValues key;
+
+            for (const auto& jsRow : itData.value())
+            {
+                if (!getKey(memoryTable, jsRow, key))
+                {
+                    throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+                }
+
+                const auto index { memoryTable.find(key, MemoryTable::keyHash(key)) };
+
+                if (MemoryTable::npos != index)
+                {
+                    if (callback)
+                    {
+                        results.push_back(getRowJson(memoryTable, memoryTable.row(index)));
+                    }
+
+                    memoryTable.erase(index);
+                }
+            }
+        }
+
+        for (const auto& result : results)
+        {
+            lock.unlock();
+            callback(ReturnTypeCallback::DELETED, result);
+            lock.lock();
+        }
+    }
+    else if (itFilter != jsDeletionData.end() && !itFilter->get<std::string>().empty())
+    {
+        throw dbengine_error { OPERATION_NOT_SUPPORTED };
+    }
+    else
+    {
+        throw dbengine_error { INVALID_DELETE_INFO };
+    }
+}
+
+void MemoryDBEngine::keepTableRowsData(const std::string& /*table*/,
+                                       const nlohmann::json& /*jsKeepData*/)
+{
+    // The rows are kept by a SQL condition.
+    throw dbengine_error { OPERATION_NOT_SUPPORTED };
+}
+
+void MemoryDBEngine::addTableRelationship(const nlohmann::json& /*data*/)
+{
+    // Relationships are implemented with SQL triggers.
+    throw dbengine_error { OPERATION_NOT_SUPPORTED };
+}
+
+nlohmann::json MemoryDBEngine::getStatementCacheStats()
+{
+    // There are no statements to cache.
+    nlohmann::json stats;
+    stats["hits"] = 0;
+    stats["misses"] = 0;
+    stats["evictions"] = 0;
+    stats["size"] = 0;
+    stats["capacity"] = 0;
+    stats["executed"] = 0;
+    return stats;
+}
+
+///
+/// Private functions section
+///
+
+void MemoryDBEngine::createTables(const std::string& tableStmtCreation)
+{
+    //
+    // Only the table definitions are needed, the statements are parsed as the following:
+    //  CREATE TABLE [IF NOT EXISTS] table (column1 TYPE [PRIMARY KEY], ..., [PRIMARY KEY (column1, ...)]) [...];
+    // The indexes are skipped, the rows are always indexed by their primary keys.
+    //
+    for (const auto& statement : Utils::split(tableStmtCreation, ';'))
+    {
+        const auto sql { Utils::trim(statement, MEMORY_SQL_BLANKS) };
+        const auto upperSql { Utils::toUpperCase(sql) };
+
+        if (sql.empty() || Utils::startsWith(upperSql, "CREATE INDEX") || Utils::startsWith(upperSql, "CREATE UNIQUE INDEX"))
+        {
+            continue;
+        }
+
+        const auto open { sql.find('(') };
+        const auto close { sql.rfind(')') };
+
+        if (!Utils::startsWith(upperSql, "CREATE TABLE") || std::string::npos == open || std::string::npos == close || close < open)
+        {
+            throw dbengine_error { SQL_STMT_ERROR };
+        }
+
+        auto table { Utils::trim(sql.substr(12, open - 12), MEMORY_SQL_BLANKS) };
+
+        if (Utils::startsWith(Utils::toUpperCase(table), "IF NOT EXISTS"))
+        {
+            table = table.substr(13);
+        }
+
+        table = Utils::trim(table, MEMORY_SQL_QUOTES);
+
+        std::vector<MemoryColumn> columns;
+        std::vector<std::string> primaryKeys;
+
+        for (const auto& definition : splitColumnDefinitions(sql.substr(open + 1, close - open - 1)))
+        {
+            const auto upperDefinition { Utils::toUpperCase(definition) };
+            // The whole first word is compared, a column may be named as the start of a keyword (e.g. checksum).
+            const auto keyword { upperDefinition.substr(0, upperDefinition.find_first_of(std::string { MEMORY_SQL_BLANKS } + "(")) };
+
+            if (Utils::startsWith(upperDefinition, "PRIMARY KEY"))
+            {
+                primaryKeys = getPrimaryKeyClause(definition);
+            }
+            else if (0 != keyword.compare("UNIQUE")
+                     && 0 != keyword.compare("CONSTRAINT")
+                     && 0 != keyword.compare("CHECK")
+                     && 0 != keyword.compare("FOREIGN"))
+            {
+                const auto nameEnd { definition.find_first_of(MEMORY_SQL_BLANKS, 1) };
+                const auto type { Utils::toUpperCase(Utils::trim(std::string::npos == nameEnd ? "" : definition.substr(nameEnd), MEMORY_SQL_BLANKS)) };
+
+                columns.push_back(MemoryColumn
+                {
+                    Utils::trim(definition.substr(0, nameEnd), MEMORY_SQL_QUOTES),
+                    columnType(type),
+                    std::string::npos != type.find("PRIMARY KEY")
+                });
+            }
+        }
+
+        for (const auto& primaryKey : primaryKeys)
+        {
+            const auto it
+            {
+                std::find_if(columns.begin(), columns.end(), [&primaryKey](const MemoryColumn & column)
+                {
+                    return 0 == column.name.compare(primaryKey);
+                })
+            };
+
+            if (columns.end() == it)
+            {
+                throw dbengine_error { SQL_STMT_ERROR };
+            }
+
+            it->primaryKey = true;
+        }
+
+        const auto hasPrimaryKey
+        {
+            std::any_of(columns.begin(), columns.end(), [](const MemoryColumn & column)
+            {
+                return column.primaryKey;
+            })
+        };
+
+        // The primary keys are the index of the table.
+        if (table.empty() || !hasPrimaryKey)
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+
+        m_tables.emplace(table, MemoryTable { std::move(columns) });
+    }
+}
+
+MemoryTable& MemoryDBEngine::getTable(const std::string& table)
+{
+    // The tables are only created by the constructor, so they can be looked up without locking.
+    const auto it { m_tables.find(table) };
+
+    if (m_tables.end() == it)
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    return it->second;
+}
+
+MemoryColumnType MemoryDBEngine::columnType(const std::string& type)
+{
+    const auto unsignedType { Utils::startsWith(type, "UNSIGNED BIGINT") };
+    const auto it { MemoryColumnTypeNames.find(unsignedType ? "UNSIGNED BIGINT" : type.substr(0, type.find(' '))) };
+
+    return MemoryColumnTypeNames.end() != it ? it->second : MemoryColumnType::Unknown;
+}
+
+DbSync::Value MemoryDBEngine::getValue(const MemoryColumn& column,
+                                       const nlohmann::json& data)
+{
+    // The values are stored as the SQLite engine binds them.
+    if (data.is_null())
+    {
+        if (column.primaryKey)
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        return {};
+    }
+
+    const auto text { data.is_string() && !data.get_ref<const std::string&>().empty() };
+
+    switch (column.type)
+    {
+        case MemoryColumnType::Text:
+            return DbSync::Value { data.is_string() ? data.get<std::string>() : std::string {} };
+
+        case MemoryColumnType::Integer:
+            return DbSync::Value { static_cast<int64_t>(data.is_number() ? data.get<int32_t>() : text ? std::stoi(data.get_ref<const std::string&>()) : 0) };
+
+        case MemoryColumnType::BigInt:
+            return DbSync::Value { static_cast<int64_t>(data.is_number() ? data.get<int64_t>() : text ? std::stoll(data.get_ref<const std::string&>()) : 0ll) };
+
+        case MemoryColumnType::UnsignedBigInt:
+            return DbSync::Value { static_cast<uint64_t>(data.is_number_unsigned() ? data.get<uint64_t>() : text ? std::stoull(data.get_ref<const std::string&>()) : 0ull) };
+
+        case MemoryColumnType::Double:
+            return DbSync::Value { data.is_number() ? data.get<double>() : text ? std::stod(data.get_ref<const std::string&>()) : .0 };
+
+        default:
+            throw dbengine_error { INVALID_COLUMN_TYPE };
+    }
+}
+
+DbSync::Value MemoryDBEngine::getValue(const MemoryColumn& column,
+                                       const DbSync::Value& value)
+{
+    if (std::holds_alternative<std::monostate>(value))
+    {
+        if (column.primaryKey)
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        return {};
+    }
+
+    switch (column.type)
+    {
+        case MemoryColumnType::Text:
+        {
+            const auto data { std::get_if<std::string>(&value) };
+            return DbSync::Value { data ? *data : std::string {} };
+        }
+
+        case MemoryColumnType::Integer:
+            return DbSync::Value { static_cast<int64_t>(DbSync::numericRowValue<int32_t>(value)) };
+
+        case MemoryColumnType::BigInt:
+            return DbSync::Value { DbSync::numericRowValue<int64_t>(value) };
+
+        case MemoryColumnType::UnsignedBigInt:
+            return DbSync::Value { DbSync::numericRowValue<uint64_t>(value) };
+
+        case MemoryColumnType::Double:
+            return DbSync::Value { DbSync::numericRowValue<double>(value) };
+
+        default:
+            throw dbengine_error { INVALID_COLUMN_TYPE };
+    }
+}
+
+nlohmann::json MemoryDBEngine::getJson(const DbSync::Value& value)
+{
+    return std::visit([](const auto & data) -> nlohmann::json
+    {
+        using V = std::decay_t<decltype(data)>;
+
+        if constexpr (std::is_same_v<V, std::monostate>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return data;
+        }
+    }, value);
+}
+
+bool MemoryDBEngine::equalJsonValue(const nlohmann::json& data,
+                                    const DbSync::Value& value)
+{
+    // Same result as comparing the JSON values, without building the JSON value of the stored one.
+    return std::visit([&data](const auto & stored)
+    {
+        using V = std::decay_t<decltype(stored)>;
+
+        if constexpr (std::is_same_v<V, std::monostate>)
+        {
+            return data.is_null();
+        }
+        else if constexpr (std::is_same_v<V, std::string>)
+        {
+            return data.is_string() && data.get_ref<const std::string&>() == stored;
+        }
+        else
+        {
+            if (data.is_number_float() || std::is_floating_point_v<V>)
+            {
+                return data.is_number() && data.get<double>() == static_cast<double>(stored);
+            }
+            else if constexpr (std::is_integral_v<V>)
+            {
+                return data.is_number_unsigned()
+                       ? std::cmp_equal(data.get<uint64_t>(), stored)
+                       : data.is_number_integer() && std::cmp_equal(data.get<int64_t>(), stored);
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }, value);
+}
+
+bool MemoryDBEngine::getKey(const MemoryTable& table,
+                            const nlohmann::json& data,
+                            DbSync::RowValues& key)
+{
+    const auto& columns { table.columns() };
+    const auto& primaryKeys { table.primaryKeys() };
+    key.resize(primaryKeys.size());
+
+    for (size_t i = 0; i < primaryKeys.size(); ++i)
+    {
+        const auto& it { data.find(columns[primaryKeys[i]].name) };
+
+        if (data.end() == it)
+        {
+            return false;
+        }
+
+        key[i] = getValue(columns[primaryKeys[i]], *it);
+    }
+
+    return true;
+}
+
+DbSync::RowValues MemoryDBEngine::getKey(const MemoryTable& table,
+                                         const MemoryRow& row)
+{
+    DbSync::RowValues key;
+    key.reserve(table.primaryKeys().size());
+
+    for (const auto primaryKey : table.primaryKeys())
+    {
+        key.push_back(row.values[primaryKey]);
+    }
+
+    return key;
+}
+
+MemoryRow MemoryDBEngine::getRow(const MemoryTable& table,
+                                 const nlohmann::json& data)
+{
+    const auto& columns { table.columns() };
+    MemoryRow row { DbSync::RowValues(columns.size()), 0ull, true };
+
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        const auto& it { data.find(columns[i].name) };
+
+        if (data.end() != it)
+        {
+            row.values[i] = getValue(columns[i], *it);
+        }
+        else if (columns[i].primaryKey)
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+    }
+
+    row.hash = MemoryTable::keyHash(getKey(table, row));
+    return row;
+}
+
+nlohmann::json MemoryDBEngine::getRowJson(const MemoryTable& table,
+                                          const MemoryRow& row)
+{
+    const auto& columns { table.columns() };
+    nlohmann::json object;
+
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        object[columns[i].name] = getJson(row.values[i]);
+    }
+
+    return object;
+}
+
+void MemoryDBEngine::insertRow(const std::string& name,
+                               MemoryTable& table,
+                               MemoryRow row)
+{
+    const auto it { m_maxRows.find(name) };
+
+    if (m_maxRows.end() != it && static_cast<int64_t>(table.size()) >= it->second)
+    {
+        throw DbSync::max_rows_error { MEMORY_MAX_ROWS_ERROR_STRING };
+    }
+
+    table.insert(std::move(row));
+}
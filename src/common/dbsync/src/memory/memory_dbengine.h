@@ -0,0 +1,293 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _MEMORY_DBENGINE_H
+#define _MEMORY_DBENGINE_H
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include "dbengine.h"
+#include "checksum_index.h"
+
+constexpr auto MEMORY_MAX_ROWS_ERROR_STRING {"Too Many Rows."};
+
+// Max load factor of the primary key index, as a fraction of its slots.
+constexpr auto MEMORY_INDEX_MAX_LOAD_NUM
+{
+    1ull
+};
+
+constexpr auto MEMORY_INDEX_MAX_LOAD_DEN
+{
+    2ull
+};
+
+constexpr auto MEMORY_INDEX_MIN_SLOTS
+{
+    16ull
+};
+
+enum class MemoryColumnType
+{
+    Unknown = 0,
+    Text,
+    Integer,
+    BigInt,
+    UnsignedBigInt,
+    Double
+};
+
+const std::map<std::string, MemoryColumnType> MemoryColumnTypeNames =
+{
+    { "TEXT", MemoryColumnType::Text                     },
+    { "INTEGER", MemoryColumnType::Integer               },
+    { "BIGINT", MemoryColumnType::BigInt                 },
+    { "UNSIGNED BIGINT", MemoryColumnType::UnsignedBigInt },
+    { "DOUBLE", MemoryColumnType::Double                 },
+};
+
+struct MemoryColumn final
+{
+    std::string name;
+    MemoryColumnType type;
+    bool primaryKey;
+};
+
+struct MemoryRow final
+{
+    DbSync::RowValues values;
+    uint64_t hash;
+    bool status;
+};
+
+// Rows of a table, stored contiguously and indexed by their primary key with an open addressing hash table. The index
+// slots only hold the position of the row and the upper bits of its hash, so a lookup touches a single row. Linear
+// probing keeps the collisions in the same cache lines and the deletions shift the following slots back, so there
+// are no tombstones.
+class MemoryTable final
+{
+    public:
+        explicit MemoryTable(std::vector<MemoryColumn> columns);
+
+        const std::vector<MemoryColumn>& columns() const
+        {
+            return m_columns;
+        }
+
+        const std::vector<size_t>& primaryKeys() const
+        {
+            return m_primaryKeys;
+        }
+
+        const std::vector<MemoryRow>& rows() const
+        {
+            return m_rows;
+        }
+
+        MemoryRow& row(const size_t index)
+        {
+            return m_rows[index];
+        }
+
+        const DbSync::ChecksumIndex* checksumIndex() const
+        {
+            return m_checksumIndex.get();
+        }
+
+        size_t size() const
+        {
+            return m_rows.size();
+        }
+
+        static uint64_t keyHash(const DbSync::RowValues& key);
+
+        size_t find(const DbSync::RowValues& key,
+                    const uint64_t hash) const;
+
+        size_t insert(MemoryRow row);
+
+        void erase(const size_t index);
+
+        // Keeps the checksum index up to date with the values of the row at \p index, after they are modified.
+        void updated(const size_t index);
+
+        void enableChecksumIndex();
+
+        static constexpr size_t npos { static_cast<size_t>(-1) };
+
+    private:
+        struct Slot final
+        {
+            uint32_t row;
+            uint32_t tag;
+        };
+
+        bool matches(const MemoryRow& row,
+                     const DbSync::RowValues& key) const;
+
+        size_t slotOf(const size_t index) const;
+
+        void rehash(const size_t slots);
+
+        std::vector<MemoryColumn> m_columns;
+        std::vector<size_t> m_primaryKeys;
+        std::vector<MemoryRow> m_rows;
+        std::vector<Slot> m_slots;
+        std::unique_ptr<DbSync::ChecksumIndex> m_checksumIndex;
+};
+
+// The rows of the memory engine can't be read after the table changes, so they are copied when the cursor is opened.
+class MemoryCursor final : public DbSync::IDbCursor
+{
+    public:
+        MemoryCursor(std::vector<std::string> columns,
+                     std::vector<DbSync::RowValues> rows)
+            : m_columns { std::move(columns) }
+            , m_rows { std::move(rows) }
+            , m_position { 0 }
+        {}
+
+        const std::vector<std::string>& columns() const override
+        {
+            return m_columns;
+        }
+
+        bool next(DbSync::RowValues& row) override
+        {
+            if (m_position >= m_rows.size())
+            {
+                return false;
+            }
+
+            row = std::move(m_rows[m_position++]);
+            return true;
+        }
+
+    private:
+        std::vector<std::string> m_columns;
+        std::vector<DbSync::RowValues> m_rows;
+        size_t m_position;
+};
+
+class MemoryDBEngine final : public DbSync::IDbEngine
+{
+    public:
+        explicit MemoryDBEngine(const std::string& tableStmtCreation);
+        ~MemoryDBEngine() = default;
+
+        void bulkInsert(const std::string& table,
+                        const nlohmann::json& data) override;
+
+        void refreshTableData(const nlohmann::json& data,
+                              const DbSync::ResultCallback callback,
+                              std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void syncTableRowData(const nlohmann::json& jsInput,
+                              const DbSync::ResultCallback callback,
+                              const bool inTransaction,
+                              Utils::ILocking& mutex) override;
+
+        void syncTableRowValues(const DbSync::RowBatch& rows,
+                                const DbSync::RowCallback callback,
+                                const bool inTransaction,
+                                Utils::ILocking& mutex) override;
+
+        void setMaxRows(const std::string& table,
+                        const int64_t maxRows) override;
+
+        void enableRowHash(const std::string& table) override;
+
+        void enableChecksumIndex(const std::string& table) override;
+
+        nlohmann::json getRangeChecksum(const std::string& table,
+                                        const nlohmann::json& begin,
+                                        const nlohmann::json& end) override;
+
+        void initializeStatusField(const nlohmann::json& tableNames) override;
+
+        void deleteRowsByStatusField(const nlohmann::json& tableNames) override;
+
+        void returnRowsMarkedForDelete(const nlohmann::json& tableNames,
+                                       const DbSync::ResultCallback callback,
+                                       std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void selectData(const std::string& table,
+                        const nlohmann::json& query,
+                        const DbSync::ResultCallback& callback,
+                        std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        std::unique_ptr<DbSync::IDbCursor> openCursor(const std::string& table,
+                                                      const nlohmann::json& query) override;
+
+        std::unique_ptr<DbSync::IDbCursor> openDeletedRowsCursor(const std::string& table) override;
+
+        void deleteTableRowsData(const std::string& table,
+                                 const nlohmann::json& jsDeletionData,
+                                 const DbSync::ResultCallback callback,
+                                 std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void keepTableRowsData(const std::string& table,
+                               const nlohmann::json& jsKeepData) override;
+
+        void addTableRelationship(const nlohmann::json& data) override;
+
+        nlohmann::json getStatementCacheStats() override;
+
+    private:
+        MemoryDBEngine(const MemoryDBEngine&) = delete;
+        MemoryDBEngine& operator=(const MemoryDBEngine&) = delete;
+
+        void createTables(const std::string& tableStmtCreation);
+
+        MemoryTable& getTable(const std::string& table);
+
+        static MemoryColumnType columnType(const std::string& type);
+
+        static DbSync::Value getValue(const MemoryColumn& column,
+                                      const nlohmann::json& data);
+
+        static DbSync::Value getValue(const MemoryColumn& column,
+                                      const DbSync::Value& value);
+
+        static nlohmann::json getJson(const DbSync::Value& value);
+
+        static bool equalJsonValue(const nlohmann::json& data,
+                                   const DbSync::Value& value);
+
+        static bool getKey(const MemoryTable& table,
+                           const nlohmann::json& data,
+                           DbSync::RowValues& key);
+
+        static DbSync::RowValues getKey(const MemoryTable& table,
+                                        const MemoryRow& row);
+
+        static MemoryRow getRow(const MemoryTable& table,
+                                const nlohmann::json& data);
+
+        static nlohmann::json getRowJson(const MemoryTable& table,
+                                         const MemoryRow& row);
+
+        // Values of the rows selected by \p query, \p names gets the names of their columns.
+        std::vector<DbSync::RowValues> selectRows(const MemoryTable& memoryTable,
+                                                  const nlohmann::json& query,
+                                                  std::vector<std::string>& names);
+
+        void insertRow(const std::string& name,
+                       MemoryTable& table,
+                       MemoryRow row);
+
+        std::unordered_map<std::string, MemoryTable> m_tables;
+        std::map<std::string, int64_t> m_maxRows;
+        std::mutex m_mutex;
+};
+
+#endif // _MEMORY_DBENGINE_H
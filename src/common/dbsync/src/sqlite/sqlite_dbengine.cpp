@@ -9,8 +9,14 @@
  * Foundation.
  */
 
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include "db_exception.h"
 #include "mapWrapperSafe.h"
 #include "sqlite/isqlite_wrapper.h"
@@ -34,12 +40,23 @@ SQLiteDBEngine::SQLiteDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFact
 SQLiteDBEngine::~SQLiteDBEngine()
 {
     std::lock_guard<std::mutex> lock(m_stmtMutex);
+    m_statementsIndex.clear();
     m_statementsCache.clear();
 
     if (m_transaction)
     {
         m_transaction->commit();
     }
+
+    if (m_checksumRegistered)
+    {
+        sqlite3_rollback_hook(m_sqliteConnection->db().get(), nullptr, nullptr);
+    }
+
+    if (m_statementsTraced)
+    {
+        sqlite3_trace_v2(m_sqliteConnection->db().get(), 0, nullptr, nullptr);
+    }
 }
 
 void SQLiteDBEngine::setMaxRows(const std::string& table,
@@ -85,9 +102,138 @@ void SQLiteDBEngine::setMaxRows(const std::string& table,
     }
 }
 
+void SQLiteDBEngine::enableRowHash(const std::string& table)
+{
+    std::vector<std::string> primaryKeyList;
+
+    if (0 != loadTableData(table))
+    {
+        // Rows are looked up by their primary keys to compare the hash.
+        if (!getPrimaryKeysFromTable(table, primaryKeyList) || primaryKeyList.empty())
+        {
+            throw dbengine_error { INVALID_PK_DATA };
+        }
+
+        if (!hasRowHash(table))
+        {
+            m_tableFields.erase(table);
+            const auto stmtAdd { getStatement("ALTER TABLE " +
+                                              table +
+                                              " ADD COLUMN " +
+                                              HASH_FIELD_NAME +
+                                              " " +
+                                              HASH_FIELD_TYPE +
+                                              ";")};
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtAdd->step())
+            {
+                throw dbengine_error{ STEP_ERROR_ADD_HASH_FIELD };
+            }
+
+            // LCOV_EXCL_STOP
+            loadTableData(table);
+        }
+
+        m_sqliteConnection->execute(buildRowHashTrigger(table, primaryKeyList));
+
+        // The staging table is created with the columns of the table, so it's rebuilt with the hash column.
+        std::lock_guard<std::mutex> bulkLock(m_bulkMutex);
+        m_sqliteConnection->execute("DROP TABLE IF EXISTS temp." + table + BULK_TABLE_SUBFIX + ";");
+    }
+    else
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+}
+
+void SQLiteDBEngine::enableChecksumIndex(const std::string& table)
+{
+    if (0 == loadTableData(table))
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    // LCOV_EXCL_START
+    if (!m_checksumRegistered)
+    {
+        throw dbengine_error { SQLITE_CONNECTION_ERROR };
+    }
+
+    // LCOV_EXCL_STOP
+
+    // The internal columns aren't part of the rows, so the checksums are the same as the ones of the memory engine.
+    TableColumns columns;
+    std::vector<size_t> primaryKeys;
+    std::vector<std::string> primaryKeyNames;
+
+    for (const auto& field : m_tableFields[table])
+    {
+        if (!std::get<TableHeader::TXNStatusField>(field))
+        {
+            if (std::get<TableHeader::PK>(field))
+            {
+                primaryKeys.push_back(columns.size());
+                primaryKeyNames.push_back(std::get<TableHeader::Name>(field));
+            }
+
+            columns.push_back(field);
+        }
+    }
+
+    if (primaryKeys.empty())
+    {
+        throw dbengine_error { INVALID_PK_DATA };
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_checksumMutex);
+        m_checksumIndexes[table] = ChecksumTable { columns, std::make_unique<DbSync::ChecksumIndex>(primaryKeys, primaryKeyNames) };
+    }
+
+    m_sqliteConnection->execute(buildChecksumTriggers(table, columns));
+    loadChecksumIndex(table);
+}
+
+nlohmann::json SQLiteDBEngine::getRangeChecksum(const std::string& table,
+                                                const nlohmann::json& begin,
+                                                const nlohmann::json& end)
+{
+    std::unique_lock<std::mutex> lock(m_checksumMutex);
+
+    if (m_checksumIndexes.end() == m_checksumIndexes.find(table))
+    {
+        throw dbengine_error { CHECKSUM_INDEX_NOT_ENABLED };
+    }
+
+    if (m_checksumStale)
+    {
+        // A rolled back transaction or a failed statement undoes changes that were already applied to the indexes.
+        std::vector<std::string> tables;
+        m_checksumStale = false;
+
+        for (const auto& entry : m_checksumIndexes)
+        {
+            tables.push_back(entry.first);
+        }
+
+        lock.unlock();
+
+        for (const auto& name : tables)
+        {
+            loadChecksumIndex(name);
+        }
+
+        lock.lock();
+    }
+
+    return m_checksumIndexes.at(table).index->rangeChecksum(begin, end);
+}
+
 void SQLiteDBEngine::bulkInsert(const std::string& table,
                                 const nlohmann::json& data)
 {
+    const ChecksumIndexGuard checksumGuard { *this };
     if (0 != loadTableData(table))
     {
         const auto& tableFieldsMetaData { m_tableFields[table] };
@@ -107,6 +253,7 @@ void SQLiteDBEngine::refreshTableData(const nlohmann::json& data,
                                       const DbSync::ResultCallback callback,
                                       std::unique_lock<std::shared_timed_mutex>& lock)
 {
+    const ChecksumIndexGuard checksumGuard { *this };
     const std::string table { data.at("table").is_string() ? data.at("table").get_ref<const std::string&>() : "" };
 
     if (createCopyTempTable(table))
@@ -156,11 +303,13 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
                                       const bool inTransaction,
                                       Utils::ILocking& lock)
 {
+    const ChecksumIndexGuard checksumGuard { *this };
     const auto& table { jsInput.at("table") };
     const auto& data { jsInput.at("data") };
 
     auto it { jsInput.find("options") };
     auto returnOldData { false };
+    auto bulkSync { true };
     nlohmann::json ignoredColumns { };
 
     if (jsInput.end() != it)
@@ -172,6 +321,13 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
             returnOldData = itOldData->is_boolean() ? itOldData.value().get<bool>() : returnOldData;
         }
 
+        auto itBulkSync { it->find("bulk_sync") };
+
+        if (it->end() != itBulkSync)
+        {
+            bulkSync = itBulkSync->is_boolean() ? itBulkSync.value().get<bool>() : bulkSync;
+        }
+
         auto itIgnoredFields { it->find("ignore") };
 
         if (it->end() != itIgnoredFields)
@@ -223,17 +379,40 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
 
     if (0 != loadTableData(table))
     {
-        if (getPrimaryKeysFromTable(table, primaryKeyList))
+        if (getPrimaryKeysFromTable(table, primaryKeyList)
+                && !(bulkSync && syncTableRowDataBulk(table, data, primaryKeyList, ignoredColumns, callback, inTransaction, returnOldData, lock)))
         {
+            const auto rowHashEnabled { hasRowHash(table) };
+            const auto tableFields { m_tableFields[table] };
+
             for (const auto& entry : data)
             {
                 nlohmann::json updated;
                 nlohmann::json oldData;
-                const bool diffExist { getRowDiff(primaryKeyList, ignoredColumns, table, entry, updated, oldData) };
+                auto hashOutdated { false };
+                const auto rowHash { rowHashEnabled ? getRowHash(tableFields, entry) : std::nullopt };
+                const bool diffExist
+                {
+                    rowHashEnabled
+                    ? getRowHashDiff(primaryKeyList, ignoredColumns, table, entry, rowHash, returnOldData, updated, oldData, hashOutdated)
+                    : getRowDiff(primaryKeyList, ignoredColumns, table, entry, updated, oldData)
+                };
 
                 if (diffExist)
                 {
-                    const auto& jsDataToUpdate{getDataToUpdate(primaryKeyList, updated, entry, inTransaction)};
+                    auto jsDataToUpdate = getDataToUpdate(primaryKeyList, updated, entry, inTransaction);
+
+                    if (hashOutdated)
+                    {
+                        if (updated.empty())
+                        {
+                            updateRowHash(table, primaryKeyList, entry, *rowHash);
+                        }
+                        else
+                        {
+                            jsDataToUpdate[HASH_FIELD_NAME] = *rowHash;
+                        }
+                    }
 
                     if (!jsDataToUpdate.empty())
                     {
@@ -262,19 +441,33 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
                 }
                 else
                 {
-                    insertElement(table, m_tableFields[table], entry,
-                                  [&]()
+                    const auto insertCallback
                     {
-                        // LCOV_EXCL_START
-                        if (callback)
+                        [&]()
                         {
-                            lock.unlock();
-                            callback(INSERTED, entry);
-                            lock.lock();
+                            // LCOV_EXCL_START
+                            if (callback)
+                            {
+                                lock.unlock();
+                                callback(INSERTED, entry);
+                                lock.lock();
+                            }
+
+                            // LCOV_EXCL_STOP
                         }
+                    };
 
-                        // LCOV_EXCL_STOP
-                    });
+                    if (rowHash)
+                    {
+                        // The hash is stored with the row, the callback still reports the received data.
+                        auto hashedEntry = entry;
+                        hashedEntry[HASH_FIELD_NAME] = *rowHash;
+                        insertElement(table, tableFields, hashedEntry, insertCallback);
+                    }
+                    else
+                    {
+                        insertElement(table, tableFields, entry, insertCallback);
+                    }
                 }
             }
         }
@@ -285,6 +478,252 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
     }
 }
 
+void SQLiteDBEngine::syncTableRowValues(const DbSync::RowBatch& rows,
+                                       const DbSync::RowCallback callback,
+                                       const bool inTransaction,
+                                       Utils::ILocking& lock)
+{
+    const ChecksumIndexGuard checksumGuard { *this };
+    const auto& table { rows.table };
+
+    if (0 == loadTableData(table))
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    const auto tableFields { m_tableFields[table] };
+    std::vector<std::string> primaryKeyList;
+    getPrimaryKeysFromTable(table, primaryKeyList);
+
+    if (primaryKeyList.empty())
+    {
+        throw dbengine_error { INVALID_PK_DATA };
+    }
+
+    // The columns are resolved once for the whole batch, the values of each row are then bound by position.
+    TableColumns rowColumns;
+
+    for (const auto& name : rows.columns)
+    {
+        const auto it
+        {
+            std::find_if(tableFields.begin(), tableFields.end(), [&name](const ColumnData & column)
+            {
+                return !std::get<TableHeader::TXNStatusField>(column) && 0 == std::get<TableHeader::Name>(column).compare(name);
+            })
+        };
+
+        if (tableFields.end() == it)
+        {
+            throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+        }
+
+        rowColumns.push_back(*it);
+    }
+
+    // Positions of the values in the order of the table columns, so the statements are the same for any batch with
+    // the same columns. The status field of a transaction has no value, it's always set to 1.
+    const auto noValue { rows.columns.size() };
+    TableColumns insertColumns;
+    TableColumns updateColumns;
+    TableColumns statusColumns;
+    std::vector<size_t> insertIndexes;
+    std::vector<size_t> updateIndexes;
+    std::vector<size_t> keyIndexes;
+    std::vector<size_t> compareIndexes;
+
+    for (const auto& field : tableFields)
+    {
+        const auto& name { std::get<TableHeader::Name>(field) };
+
+        if (std::get<TableHeader::TXNStatusField>(field))
+        {
+            if (inTransaction && 0 == name.compare(STATUS_FIELD_NAME))
+            {
+                updateColumns.push_back(field);
+                updateIndexes.push_back(noValue);
+                statusColumns.push_back(field);
+            }
+
+            continue;
+        }
+
+        const auto it { std::find(rows.columns.begin(), rows.columns.end(), name) };
+
+        if (rows.columns.end() == it)
+        {
+            if (std::get<TableHeader::PK>(field))
+            {
+                throw dbengine_error { INVALID_PK_DATA };
+            }
+
+            continue;
+        }
+
+        const auto index { static_cast<size_t>(std::distance(rows.columns.begin(), it)) };
+        insertColumns.push_back(field);
+        insertIndexes.push_back(index);
+
+        if (std::get<TableHeader::PK>(field))
+        {
+            keyIndexes.push_back(index);
+        }
+        else
+        {
+            updateColumns.push_back(field);
+            updateIndexes.push_back(index);
+
+            if (rows.ignore.end() == std::find(rows.ignore.begin(), rows.ignore.end(), name))
+            {
+                compareIndexes.push_back(index);
+            }
+        }
+    }
+
+    const auto bindValues
+    {
+        [&](const std::shared_ptr<SQLiteLegacy::IStatement>& stmt,
+            const TableColumns & columns,
+            const std::vector<size_t>& indexes,
+            const DbSync::RowValues & row,
+            int32_t& index)
+        {
+            for (size_t i = 0; i < columns.size(); ++i, ++index)
+            {
+                if (noValue == indexes[i])
+                {
+                    stmt->bind(index, int32_t { 1 });
+                }
+                else
+                {
+                    bindRowValue(stmt, columns[i], row[indexes[i]], index);
+                }
+            }
+        }
+    };
+
+    const auto updateRow
+    {
+        [&](const TableColumns & columns, const std::vector<size_t>& indexes, const DbSync::RowValues & row)
+        {
+            const auto stmt
+            {
+                getStatement(getColumnsQueryId(QueryKind::UpdateRowValues, table, tableFields, columns), [&]()
+                {
+                    return buildUpdateRowValuesQuery(table, columns, primaryKeyList);
+                })
+            };
+            int32_t index { 1l };
+            bindValues(stmt, columns, indexes, row, index);
+
+            for (const auto keyIndex : keyIndexes)
+            {
+                bindRowValue(stmt, rowColumns[keyIndex], row[keyIndex], index++);
+            }
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmt->step())
+            {
+                throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+        }
+    };
+
+    for (const auto& row : rows.rows)
+    {
+        if (row.size() != rowColumns.size())
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        const auto stmt
+        {
+            getStatement(QueryId { QueryKind::SelectMatchingPKs, table, 0ull, 0ull }, [&]()
+            {
+                return buildSelectMatchingPKsSqlQuery(table, primaryKeyList);
+            })
+        };
+        int32_t index { 1l };
+
+        for (const auto keyIndex : keyIndexes)
+        {
+            bindRowValue(stmt, rowColumns[keyIndex], row[keyIndex], index++);
+        }
+
+        if (SQLITE_ROW == stmt->step())
+        {
+            DbSync::RowValues oldRow;
+
+            if (rows.returnOldData)
+            {
+                oldRow.reserve(rowColumns.size());
+
+                for (const auto& column : rowColumns)
+                {
+                    oldRow.push_back(getRowValue(stmt, column));
+                }
+            }
+
+            const auto modified
+            {
+                std::any_of(compareIndexes.begin(), compareIndexes.end(), [&](const size_t valueIndex)
+                {
+                    return !DbSync::equalRowValues(row[valueIndex],
+                                                   rows.returnOldData ? oldRow[valueIndex] : getRowValue(stmt, rowColumns[valueIndex]));
+                })
+            };
+
+            if (modified)
+            {
+                updateRow(updateColumns, updateIndexes, row);
+
+                if (callback)
+                {
+                    lock.unlock();
+                    callback(MODIFIED, row, oldRow);
+                    lock.lock();
+                }
+            }
+            else if (inTransaction)
+            {
+                // No changes detected, only update the status field to avoid row deletion during the txn close.
+                updateRow(statusColumns, std::vector<size_t>(statusColumns.size(), noValue), row);
+            }
+        }
+        else
+        {
+            const auto stmtInsert
+            {
+                getStatement(getColumnsQueryId(QueryKind::InsertData, table, tableFields, insertColumns), [&]()
+                {
+                    return buildInsertRowValuesQuery(table, insertColumns);
+                })
+            };
+            index = 1l;
+            bindValues(stmtInsert, insertColumns, insertIndexes, row, index);
+
+            updateTableRowCounter(table, 1ll);
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtInsert->step())
+            {
+                updateTableRowCounter(table, -1ll);
+                throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+            if (callback)
+            {
+                lock.unlock();
+                callback(INSERTED, row, {});
+                lock.lock();
+            }
+        }
+    }
+}
+
 void SQLiteDBEngine::initializeStatusField(const nlohmann::json& tableNames)
 {
     for (const auto& tableValue : tableNames)
@@ -344,6 +783,7 @@ void SQLiteDBEngine::initializeStatusField(const nlohmann::json& tableNames)
 
 void SQLiteDBEngine::deleteRowsByStatusField(const nlohmann::json& tableNames)
 {
+    const ChecksumIndexGuard checksumGuard { *this };
     for (const auto& tableValue : tableNames)
     {
         const auto table { tableValue.get<std::string>() };
@@ -448,7 +888,8 @@ void SQLiteDBEngine::selectData(const std::string& table,
                 const auto& column{ stmt->column(i) };
                 const auto& name{ column->name() };
 
-                if (column->hasValue() && name != STATUS_FIELD_NAME)
+                if (column->hasValue()
+                        && InternalColumnNames.end() == std::find(InternalColumnNames.begin(), InternalColumnNames.end(), name))
                 {
                     switch (column->type())
                     {
@@ -486,34 +927,173 @@ void SQLiteDBEngine::selectData(const std::string& table,
     }
 }
 
-void SQLiteDBEngine::deleteTableRowsData(const std::string&    table,
-                                         const nlohmann::json& jsDeletionData)
+std::unique_ptr<DbSync::IDbCursor> SQLiteDBEngine::openCursor(const std::string& table,
+                                                              const nlohmann::json& query)
 {
     if (0 != loadTableData(table))
     {
-        const auto& itData{ jsDeletionData.find("data")};
-        const auto& itFilter{ jsDeletionData.find("where_filter_opt")};
+        // The statement isn't cached, it's stepped until the cursor is closed.
+        return std::make_unique<SQLiteCursor>(m_sqliteFactory->createStatement(m_sqliteConnection, buildSelectQuery(table, query)),
+                                              m_tableFields[table]);
+    }
 
-        if (itData != jsDeletionData.end() && itData->size() > 0)
-        {
-            // Deletion via primary keys on "data" json field.
-            deleteRowsbyPK(table, itData.value());
-        }
-        else if (itFilter != jsDeletionData.end() && !itFilter->get<std::string>().empty())
+    throw dbengine_error { EMPTY_TABLE_METADATA };
+}
+
+std::unique_ptr<DbSync::IDbCursor> SQLiteDBEngine::openDeletedRowsCursor(const std::string& table)
+{
+    if (0 != loadTableData(table))
+    {
+        // As returnRowsMarkedForDelete does, the rows synced so far are committed before they are read.
+        if (m_transaction)
         {
-            // Deletion via condition on "where_filter_opt" json field.
-            m_sqliteConnection->execute("DELETE FROM " + table + " WHERE " + itFilter->get<std::string>());
-            updateTableRowCounter(table, m_sqliteConnection->changes() * -1ll);
+            m_transaction->commit();
         }
-        else
+
+        m_transaction = m_sqliteFactory->createTransaction(m_sqliteConnection);
+
+        const auto tableFields { m_tableFields[table] };
+        return std::make_unique<SQLiteCursor>(m_sqliteFactory->createStatement(m_sqliteConnection, getSelectAllQuery(table, tableFields)),
+                                              tableFields);
+    }
+
+    throw dbengine_error { EMPTY_TABLE_METADATA };
+}
+
+void SQLiteDBEngine::deleteTableRowsData(const std::string&    table,
+                                         const nlohmann::json& jsDeletionData,
+                                         const DbSync::ResultCallback callback,
+                                         std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    // The stored values are only read when the deleted rows are reported.
+    std::vector<nlohmann::json> deletedRows;
+
+    {
+        const ChecksumIndexGuard checksumGuard { *this };
+
+        if (0 != loadTableData(table))
+        {
+            const auto& itData{ jsDeletionData.find("data")};
+            const auto& itFilter{ jsDeletionData.find("where_filter_opt")};
+
+            if (itData != jsDeletionData.end() && itData->size() > 0)
+            {
+                // Deletion via primary keys on "data" json field.
+                deleteRowsbyPK(table, itData.value(), callback ? &deletedRows : nullptr);
+            }
+            else if (itFilter != jsDeletionData.end() && !itFilter->get<std::string>().empty())
+            {
+                // Deletion via condition on "where_filter_opt" json field.
+                if (callback)
+                {
+                    const auto& tableFields { m_tableFields[table] };
+                    std::string sql { "SELECT " };
+
+                    for (const auto& field : tableFields)
+                    {
+                        if (!std::get<TableHeader::TXNStatusField>(field))
+                        {
+                            sql.append(std::get<TableHeader::Name>(field) + ",");
+                        }
+                    }
+
+                    sql = sql.substr(0, sql.size() - 1);
+                    sql.append(" FROM " + table + " WHERE " + itFilter->get<std::string>());
+
+                    const std::shared_ptr<SQLiteLegacy::IStatement> stmt { m_sqliteFactory->createStatement(m_sqliteConnection, sql) };
+
+                    while (SQLITE_ROW == stmt->step())
+                    {
+                        deletedRows.push_back(getStoredRow(stmt, tableFields, false));
+                    }
+                }
+
+                m_sqliteConnection->execute("DELETE FROM " + table + " WHERE " + itFilter->get<std::string>());
+                updateTableRowCounter(table, m_sqliteConnection->changes() * -1ll);
+            }
+            else
+            {
+                throw dbengine_error{ INVALID_DELETE_INFO };
+            }
+        }
+        else
         {
-            throw dbengine_error{ INVALID_DELETE_INFO };
+            throw dbengine_error { EMPTY_TABLE_METADATA };
         }
     }
-    else
+
+    for (const auto& row : deletedRows)
+    {
+        lock.unlock();
+        callback(ReturnTypeCallback::DELETED, row);
+        lock.lock();
+    }
+}
+
+void SQLiteDBEngine::keepTableRowsData(const std::string&    table,
+                                       const nlohmann::json& jsKeepData)
+{
+    if (0 == loadTableData(table))
     {
         throw dbengine_error { EMPTY_TABLE_METADATA };
     }
+
+    const auto& itFilter { jsKeepData.find("where_filter_opt") };
+
+    if (itFilter == jsKeepData.end() || itFilter->get<std::string>().empty())
+    {
+        throw dbengine_error { INVALID_PARAMETERS };
+    }
+
+    // Only the status field is updated, the content triggers (hash and checksum) aren't fired.
+    const auto stmt
+    {
+        getStatement("UPDATE " + table + " SET " + STATUS_FIELD_NAME + "=1 WHERE " + itFilter->get<std::string>() + ";")
+    };
+    const auto& itValues { jsKeepData.find("values") };
+
+    if (itValues != jsKeepData.end())
+    {
+        int32_t index { 1 };
+
+        for (const auto& value : *itValues)
+        {
+            if (value.is_string())
+            {
+                stmt->bind(index, value.get<std::string>());
+            }
+            else if (value.is_number_unsigned())
+            {
+                stmt->bind(index, value.get<uint64_t>());
+            }
+            else if (value.is_number_integer())
+            {
+                stmt->bind(index, value.get<int64_t>());
+            }
+            else if (value.is_number_float())
+            {
+                stmt->bind(index, value.get<double_t>());
+            }
+            else if (value.is_null())
+            {
+                stmt->bind(index);
+            }
+            else
+            {
+                throw dbengine_error { INVALID_DATA_BIND };
+            }
+
+            ++index;
+        }
+    }
+
+    // LCOV_EXCL_START
+    if (SQLITE_ERROR == stmt->step())
+    {
+        throw dbengine_error { STEP_ERROR_UPDATE_STATUS_FIELD };
+    }
+
+    // LCOV_EXCL_STOP
 }
 
 void SQLiteDBEngine::addTableRelationship(const nlohmann::json& data)
@@ -536,6 +1116,27 @@ void SQLiteDBEngine::addTableRelationship(const nlohmann::json& data)
     }
 }
 
+nlohmann::json SQLiteDBEngine::getStatementCacheStats()
+{
+    std::lock_guard<std::mutex> lock(m_stmtMutex);
+
+    if (!m_statementsTraced)
+    {
+        // The statements are counted from the first request on, so the engines that don't ask pay nothing.
+        sqlite3_trace_v2(m_sqliteConnection->db().get(), SQLITE_TRACE_STMT, &SQLiteDBEngine::statementTrace, this);
+        m_statementsTraced = true;
+    }
+
+    nlohmann::json stats;
+    stats["hits"] = m_statementsCacheHits;
+    stats["misses"] = m_statementsCacheMisses;
+    stats["evictions"] = m_statementsCacheEvictions;
+    stats["size"] = m_statementsCache.size();
+    stats["capacity"] = CACHE_STMT_LIMIT;
+    stats["executed"] = m_statementsExecuted.load();
+    return stats;
+}
+
 ///
 /// Private functions section
 ///
@@ -560,6 +1161,7 @@ void SQLiteDBEngine::initialize(const std::string&              path,
         }
 
         m_sqliteConnection = m_sqliteFactory->createConnection(path);
+        registerChecksumFunction();
         const auto createDBQueryList {Utils::split(tableStmtCreation, ';')};
         m_sqliteConnection->execute("PRAGMA temp_store = memory;");
         m_sqliteConnection->execute("PRAGMA journal_mode = truncate;");
@@ -584,6 +1186,7 @@ void SQLiteDBEngine::initialize(const std::string&              path,
     if (DbManagement::PERSISTENT == dbManagement)
     {
         m_sqliteConnection = m_sqliteFactory->createConnection(path);
+        registerChecksumFunction();
         dbVersion = getDbVersion();
 
         if (0 == dbVersion)
@@ -664,7 +1267,13 @@ void SQLiteDBEngine::insertElement(const std::string& table,
                                    const nlohmann::json& element,
                                    const std::function<void()> callback)
 {
-    const auto stmt { getStatement(buildInsertDataSqlQuery(table, element)) };
+    const auto stmt
+    {
+        getStatement(getColumnsQueryId(QueryKind::InsertData, table, tableFieldsMetaData, element), [&]()
+        {
+            return buildInsertDataSqlQuery(table, element);
+        })
+    };
     int32_t index { 1l };
 
     for (const auto& field : tableFieldsMetaData)
@@ -1196,7 +1805,8 @@ bool SQLiteDBEngine::deleteRows(const std::string& table,
 }
 
 void SQLiteDBEngine::deleteRowsbyPK(const std::string& table,
-                                    const nlohmann::json& data)
+                                    const nlohmann::json& data,
+                                    std::vector<nlohmann::json>* deletedRows)
 {
     std::vector<std::string> primaryKeyList;
 
@@ -1205,13 +1815,36 @@ void SQLiteDBEngine::deleteRowsbyPK(const std::string& table,
         const auto& tableFields { m_tableFields[table] };
         const auto stmt
         {
-            getStatement(buildDeleteBulkDataSqlQuery(table, primaryKeyList))
+            getStatement(QueryId { QueryKind::DeleteBulkData, table, 0ull, 0ull }, [&]()
+            {
+                return buildDeleteBulkDataSqlQuery(table, primaryKeyList);
+            })
         };
 
         for (const auto& jsRow : data)
         {
             int32_t index { 1l };
 
+            if (deletedRows)
+            {
+                const auto stmtSelect
+                {
+                    getStatement(QueryId { QueryKind::SelectMatchingPKs, table, 0ull, 0ull }, [&]()
+                    {
+                        return buildSelectMatchingPKsSqlQuery(table, primaryKeyList);
+                    })
+                };
+
+                bindPrimaryKeyData(stmtSelect, tableFields, primaryKeyList, jsRow);
+
+                if (SQLITE_ROW == stmtSelect->step())
+                {
+                    deletedRows->push_back(getStoredRow(stmtSelect, tableFields, true));
+                }
+
+                stmtSelect->reset();
+            }
+
             for (const auto& pkValue : primaryKeyList)
             {
                 const auto& it
@@ -1246,6 +1879,37 @@ void SQLiteDBEngine::deleteRowsbyPK(const std::string& table,
     }
 }
 
+nlohmann::json SQLiteDBEngine::getStoredRow(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                            const TableColumns& tableFields,
+                                            const bool allColumns)
+{
+    // The statement selects every column, or only the ones that aren't transaction status fields.
+    Row registerFields;
+    int32_t index { 0l };
+
+    for (const auto& field : tableFields)
+    {
+        if (!std::get<TableHeader::TXNStatusField>(field))
+        {
+            getTableData(stmt,
+                         allColumns ? std::get<TableHeader::CID>(field) : index,
+                         std::get<TableHeader::Type>(field),
+                         std::get<TableHeader::Name>(field),
+                         registerFields);
+            ++index;
+        }
+    }
+
+    nlohmann::json object {};
+
+    for (const auto& value : registerFields)
+    {
+        getFieldValueFromTuple(value, object);
+    }
+
+    return object;
+}
+
 void SQLiteDBEngine::bindFieldData(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
                                    const int32_t index,
                                    const TableField& fieldData)
@@ -1312,219 +1976,1566 @@ void SQLiteDBEngine::bindFieldData(const std::shared_ptr<SQLiteLegacy::IStatemen
             stmt->bind(index);
         }
     }
-    else
+    else
+    {
+        throw dbengine_error { INVALID_DATA_BIND };
+    }
+}
+
+std::string SQLiteDBEngine::buildSelectQuery(const std::string& table,
+                                             const nlohmann::json& jsQuery)
+{
+    const auto& columns{ jsQuery.at("column_list")};
+    const auto& itFilter{ jsQuery.find("row_filter")};
+    /*optional fields*/
+    const auto& itDistinct{ jsQuery.find("distinct_opt") };
+    const auto& itOrderBy{ jsQuery.find("order_by_opt") };
+    const auto& itCount{ jsQuery.find("count_opt") };
+
+    std::string sql{ "SELECT "};
+
+    if (itDistinct != jsQuery.end() && itDistinct->get<bool>())
+    {
+        sql += "DISTINCT ";
+    }
+
+    for (const auto& column : columns)
+    {
+        sql += column.get_ref<const std::string&>();
+        sql += ",";
+    }
+
+    sql = sql.substr(0, sql.size() - 1);
+
+    sql += " FROM " + table;
+
+    if (itFilter != jsQuery.end() && !itFilter->get<std::string>().empty())
+    {
+        sql += " ";
+        sql += itFilter->get<std::string>();
+    }
+
+    if (itOrderBy != jsQuery.end() && !itOrderBy->get<std::string>().empty())
+    {
+        sql += " ORDER BY " + itOrderBy->get<std::string>();
+    }
+
+    if (itCount != jsQuery.end())
+    {
+        const unsigned int limit{*itCount};
+        sql += " LIMIT " + std::to_string(limit);
+    }
+
+    sql += ";";
+    return sql;
+}
+
+std::string SQLiteDBEngine::buildLeftOnlyQuery(const std::string& t1,
+                                               const std::string& t2,
+                                               const std::vector<std::string>& primaryKeyList,
+                                               const bool returnOnlyPKFields)
+{
+    std::string fieldsList;
+    std::string onMatchList;
+    std::string nullFilterList;
+
+    for (const auto& value : primaryKeyList)
+    {
+        if (returnOnlyPKFields)
+        {
+            fieldsList.append("t1." + value + ",");
+        }
+
+        onMatchList.append("t1." + value + "= t2." + value + " AND ");
+        nullFilterList.append("t2." + value + " IS NULL AND ");
+    }
+
+    if (returnOnlyPKFields)
+    {
+        fieldsList = fieldsList.substr(0, fieldsList.size() - 1);
+    }
+    else
+    {
+        fieldsList.append("*");
+    }
+
+    onMatchList = onMatchList.substr(0, onMatchList.size() - 5);
+    nullFilterList = nullFilterList.substr(0, nullFilterList.size() - 5);
+
+    return "SELECT " + fieldsList + " FROM " + t1 + " t1 LEFT JOIN " + t2 + " t2 ON " + onMatchList + " WHERE " + nullFilterList + ";";
+}
+
+bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
+                                const nlohmann::json& ignoredColumns,
+                                const std::string& table,
+                                const nlohmann::json& data,
+                                nlohmann::json& updatedData,
+                                nlohmann::json& oldData)
+{
+    const auto stmt
+    {
+        getStatement(QueryId { QueryKind::SelectMatchingPKs, table, 0ull, 0ull }, [&]()
+        {
+            return buildSelectMatchingPKsSqlQuery(table, primaryKeyList);
+        })
+    };
+
+    const auto& tableFields { m_tableFields[table] };
+    bindPrimaryKeyData(stmt, tableFields, primaryKeyList, data);
+
+    const bool diffExist { SQLITE_ROW == stmt->step() };
+    Row registryFields;
+
+    if (diffExist)
+    {
+        // The row exists, so let's generate the diff
+        for (const auto& field : tableFields)
+        {
+            getTableData(stmt,
+                         std::get<TableHeader::CID>(field),
+                         std::get<TableHeader::Type>(field),
+                         std::get<TableHeader::Name>(field),
+                         registryFields);
+        }
+    }
+
+    compareRowData(primaryKeyList, ignoredColumns, data, registryFields, updatedData, oldData);
+
+    return diffExist;
+}
+
+void SQLiteDBEngine::compareRowData(const std::vector<std::string>& primaryKeyList,
+                                    const nlohmann::json& ignoredColumns,
+                                    const nlohmann::json& data,
+                                    const Row& registryFields,
+                                    nlohmann::json& updatedData,
+                                    nlohmann::json& oldData)
+{
+    bool isModified { false };
+
+    // Always include primary keys
+    for (const auto& pkValue : primaryKeyList)
+    {
+        updatedData[pkValue] = data.at(pkValue);
+        oldData[pkValue] = data.at(pkValue);
+    }
+
+    for (const auto& value : registryFields)
+    {
+        nlohmann::json object;
+        getFieldValueFromTuple(value, object);
+        const auto& it
+        {
+            data.find(value.first)
+        };
+
+        if (data.end() != it)
+        {
+            // Only compare if not in ignore set
+            if (*it != object.at(value.first))
+            {
+                // Diff found
+                isModified = true;
+                oldData[value.first] = object[value.first];
+            }
+
+            updatedData[value.first] = *it;
+        }
+    }
+
+    // If the row is not modified, we clear the result to update the status field value only.
+    if (!isModified)
+    {
+        updatedData.clear();
+        oldData.clear();
+    }
+    else
+    {
+        if (!ignoredColumns.empty())
+        {
+            auto haveDiffOnNonIgnored
+            {
+                [&ignoredColumns, primaryKeyList](const nlohmann::json & rowToBeUpdated) -> bool
+                {
+                    bool haveDiff { false };
+
+                    for (const auto& fieldToBeUpdated : rowToBeUpdated.items())
+                    {
+                        if (std::find(ignoredColumns.begin(), ignoredColumns.end(),
+                                      fieldToBeUpdated.key()) == ignoredColumns.end())
+                        {
+                            if (std::find(primaryKeyList.begin(), primaryKeyList.end(),
+                                          fieldToBeUpdated.key()) == primaryKeyList.end())
+                            {
+                                haveDiff = true;
+                                break;
+                            }
+                        }
+                    }
+
+                    return haveDiff;
+                }
+            };
+
+            if (!haveDiffOnNonIgnored(oldData))
+            {
+                updatedData.clear();
+                oldData.clear();
+            }
+        }
+    }
+}
+
+void SQLiteDBEngine::bindPrimaryKeyData(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                        const TableColumns& tableFields,
+                                        const std::vector<std::string>& primaryKeyList,
+                                        const nlohmann::json& data)
+{
+    int32_t index { 1l };
+
+    for (const auto& pkValue : primaryKeyList)
+    {
+        const auto& it
+        {
+            std::find_if(tableFields.begin(), tableFields.end(),
+                         [&pkValue](const ColumnData & column)
+            {
+                return 0 == std::get<Name>(column).compare(pkValue);
+            })
+        };
+
+        if (it != tableFields.end())
+        {
+            bindJsonData(stmt, *it, data, index);
+            ++index;
+        }
+    }
+}
+
+bool SQLiteDBEngine::hasRowHash(const std::string& table)
+{
+    const auto tableFields { m_tableFields[table] };
+
+    return std::any_of(tableFields.begin(), tableFields.end(), [](const ColumnData & column)
+    {
+        return 0 == std::get<TableHeader::Name>(column).compare(HASH_FIELD_NAME);
+    });
+}
+
+std::optional<int64_t> SQLiteDBEngine::getRowHash(const TableColumns& tableFields,
+                                                  const nlohmann::json& data)
+{
+    // 64-bit FNV-1a, the hash is stored with the row so it can't depend on the process.
+    constexpr auto FNV_OFFSET_BASIS { 14695981039346656037ull };
+    constexpr auto FNV_PRIME { 1099511628211ull };
+    uint64_t hash { FNV_OFFSET_BASIS };
+
+    const auto append
+    {
+        [&hash](const void* bytes, const size_t size)
+        {
+            const auto begin { static_cast<const uint8_t*>(bytes) };
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= begin[i];
+                hash *= FNV_PRIME;
+            }
+        }
+    };
+
+    // The primary keys are matched by the lookup, so only the other columns are hashed. The ignored ones are hashed
+    // too, so the hash doesn't depend on the options of each sync. The hash describes the whole row, so the rows that
+    // leave columns out don't have one.
+    for (const auto& field : tableFields)
+    {
+        const auto& name { std::get<TableHeader::Name>(field) };
+
+        if (std::get<TableHeader::PK>(field) || std::get<TableHeader::TXNStatusField>(field))
+        {
+            continue;
+        }
+
+        const auto it { data.find(name) };
+
+        if (data.end() == it)
+        {
+            return std::nullopt;
+        }
+
+        // The terminator splits the name from the tagged value.
+        append(name.c_str(), name.size() + 1);
+
+        if (it->is_string())
+        {
+            const auto& value { it->get_ref<const std::string&>() };
+            const uint64_t size { value.size() };
+            append("s", 1);
+            append(&size, sizeof(size));
+            append(value.data(), value.size());
+        }
+        else if (it->is_number_integer()
+                 && (!it->is_number_unsigned() || it->get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())))
+        {
+            // Signed and unsigned numbers with the same value hash the same.
+            const auto value { it->get<int64_t>() };
+            append("i", 1);
+            append(&value, sizeof(value));
+        }
+        else if (it->is_number_unsigned())
+        {
+            const auto value { it->get<uint64_t>() };
+            append("u", 1);
+            append(&value, sizeof(value));
+        }
+        else if (it->is_number_float())
+        {
+            const auto value { it->get<double>() };
+            append("d", 1);
+            append(&value, sizeof(value));
+        }
+        else if (it->is_boolean())
+        {
+            const uint8_t value { it->get<bool>() };
+            append("b", 1);
+            append(&value, sizeof(value));
+        }
+        else if (it->is_null())
+        {
+            append("n", 1);
+        }
+        else
+        {
+            const auto value { it->dump() };
+            append("j", 1);
+            append(value.data(), value.size());
+        }
+    }
+
+    return static_cast<int64_t>(hash);
+}
+
+bool SQLiteDBEngine::getRowHashDiff(const std::vector<std::string>& primaryKeyList,
+                                    const nlohmann::json& ignoredColumns,
+                                    const std::string& table,
+                                    const nlohmann::json& data,
+                                    const std::optional<int64_t>& rowHash,
+                                    const bool returnOldData,
+                                    nlohmann::json& updatedData,
+                                    nlohmann::json& oldData,
+                                    bool& hashOutdated)
+{
+    const auto stmt
+    {
+        getStatement(QueryId { QueryKind::SelectRowHash, table, 0ull, 0ull }, [&]()
+        {
+            return buildSelectRowHashQuery(table, primaryKeyList);
+        })
+    };
+
+    bindPrimaryKeyData(stmt, m_tableFields[table], primaryKeyList, data);
+
+    const bool rowExist { SQLITE_ROW == stmt->step() };
+
+    if (rowExist)
+    {
+        const auto column { stmt->column(0) };
+        const auto storedHash { column->hasValue() ? std::optional<int64_t> { column->value(int64_t{}) } : std::nullopt };
+
+        hashOutdated = compareRowHash(primaryKeyList, ignoredColumns, table, data, storedHash, rowHash, returnOldData, updatedData, oldData);
+    }
+
+    return rowExist;
+}
+
+bool SQLiteDBEngine::compareRowHash(const std::vector<std::string>& primaryKeyList,
+                                    const nlohmann::json& ignoredColumns,
+                                    const std::string& table,
+                                    const nlohmann::json& data,
+                                    const std::optional<int64_t>& storedHash,
+                                    const std::optional<int64_t>& rowHash,
+                                    const bool returnOldData,
+                                    nlohmann::json& updatedData,
+                                    nlohmann::json& oldData)
+{
+    // Same hash, same values: the row is unchanged and the stored one isn't read.
+    auto hashOutdated { false };
+
+    if (!rowHash || storedHash != rowHash)
+    {
+        if (rowHash && storedHash && !returnOldData && ignoredColumns.empty())
+        {
+            // The row changed, and without the old data to report the stored values aren't needed.
+            hashOutdated = true;
+
+            for (const auto& pkValue : primaryKeyList)
+            {
+                updatedData[pkValue] = data.at(pkValue);
+            }
+
+            for (const auto& field : m_tableFields[table])
+            {
+                const auto it { data.find(std::get<TableHeader::Name>(field)) };
+
+                if (data.end() != it && !std::get<TableHeader::TXNStatusField>(field))
+                {
+                    updatedData[it.key()] = *it;
+                }
+            }
+        }
+        else
+        {
+            // Rows without a valid hash, with ignored or missing columns or whose old values are reported, are compared
+            // column by column. The changed ones are written with every column received, while the unchanged ones only
+            // get the hash if no column was left out of the comparison. The partial rows don't write it, the hash reset
+            // trigger clears it when they change the row.
+            getRowDiff(primaryKeyList, ignoredColumns, table, data, updatedData, oldData);
+            hashOutdated = rowHash && (!updatedData.empty() || ignoredColumns.empty());
+        }
+    }
+
+    return hashOutdated;
+}
+
+void SQLiteDBEngine::updateRowHash(const std::string& table,
+                                   const std::vector<std::string>& primaryKeyList,
+                                   const nlohmann::json& data,
+                                   const int64_t rowHash)
+{
+    nlohmann::json jsData;
+
+    for (const auto& pkValue : primaryKeyList)
+    {
+        jsData[pkValue] = data.at(pkValue);
+    }
+
+    jsData[HASH_FIELD_NAME] = rowHash;
+    updateSingleRow(table, jsData);
+}
+
+std::string SQLiteDBEngine::buildSelectRowHashQuery(const std::string& table,
+                                                    const std::vector<std::string>& primaryKeyList)
+{
+    //
+    // Only the hash of the stored row is read to know if it changed:
+    //  SELECT db_hash_field_dm FROM table WHERE pk1=? AND ...;
+    //
+    std::string sql { "SELECT " };
+    sql.append(HASH_FIELD_NAME);
+    sql.append(" FROM " + table + " WHERE ");
+
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append(value + "=? AND ");
+    }
+
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append(";");
+    return sql;
+}
+
+std::string SQLiteDBEngine::buildRowHashTrigger(const std::string& table,
+                                                const std::vector<std::string>& primaryKeyList)
+{
+    //
+    // Any other update of the columns (snapshots, relationships...) doesn't write the hash, so it's reset and the next
+    // sync of the row compares the values:
+    //  CREATE TRIGGER IF NOT EXISTS table_hash_reset AFTER UPDATE OF column1, ... ON table
+    //  WHEN NEW.db_hash_field_dm IS OLD.db_hash_field_dm AND NEW.db_hash_field_dm IS NOT NULL
+    //  BEGIN UPDATE table SET db_hash_field_dm=NULL WHERE pk1=NEW.pk1 AND ...; END;
+    //
+    const std::string hashField { HASH_FIELD_NAME };
+    std::string sql { "CREATE TRIGGER IF NOT EXISTS " + table + HASH_TRIGGER_SUBFIX + " AFTER UPDATE OF " };
+
+    for (const auto& field : m_tableFields[table])
+    {
+        if (!std::get<TableHeader::TXNStatusField>(field))
+        {
+            sql.append(std::get<TableHeader::Name>(field) + ",");
+        }
+    }
+
+    sql = sql.substr(0, sql.size() - 1);
+    sql.append(" ON " + table + " WHEN NEW." + hashField + " IS OLD." + hashField + " AND NEW." + hashField + " IS NOT NULL");
+    sql.append(" BEGIN UPDATE " + table + " SET " + hashField + "=NULL WHERE ");
+
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append(value + "=NEW." + value + " AND ");
+    }
+
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append("; END;");
+    return sql;
+}
+
+SQLiteCursor::SQLiteCursor(const std::shared_ptr<SQLiteLegacy::IStatement>& stmt,
+                           const TableColumns& tableFields)
+    : m_stmt { stmt }
+{
+    for (int32_t i = 0; i < m_stmt->columnsCount(); ++i)
+    {
+        const auto name { m_stmt->column(i)->name() };
+
+        if (InternalColumnNames.end() == std::find(InternalColumnNames.begin(), InternalColumnNames.end(), name))
+        {
+            const auto it
+            {
+                std::find_if(tableFields.begin(), tableFields.end(), [&name](const ColumnData & column)
+                {
+                    return 0 == std::get<TableHeader::Name>(column).compare(name);
+                })
+            };
+
+            m_columns.push_back(name);
+            m_indexes.push_back(i);
+            m_types.push_back(tableFields.end() != it ? std::get<TableHeader::Type>(*it) : ColumnType::Unknown);
+        }
+    }
+}
+
+bool SQLiteCursor::next(DbSync::RowValues& row)
+{
+    if (!m_stmt || SQLITE_ROW != m_stmt->step())
+    {
+        // The statement is released with the last row, it no longer holds the table.
+        m_stmt.reset();
+        return false;
+    }
+
+    row.resize(m_indexes.size());
+
+    for (size_t i = 0; i < m_indexes.size(); ++i)
+    {
+        const auto column { m_stmt->column(m_indexes[i]) };
+
+        if (!column->hasValue())
+        {
+            row[i] = std::monostate {};
+        }
+        else if (ColumnType::UnsignedBigInt == m_types[i])
+        {
+            row[i] = column->value(uint64_t {});
+        }
+        else
+        {
+            switch (column->type())
+            {
+                case SQLITE_INTEGER:
+                    row[i] = column->value(int64_t {});
+                    break;
+
+                case SQLITE_FLOAT:
+                    row[i] = column->value(double_t {});
+                    break;
+
+                case SQLITE_TEXT:
+                    row[i] = column->value(std::string {});
+                    break;
+
+                // LCOV_EXCL_START
+                default:
+                    throw dbengine_error { INVALID_COLUMN_TYPE };
+                    // LCOV_EXCL_STOP
+            }
+        }
+    }
+
+    return true;
+}
+
+std::string SQLiteDBEngine::buildChecksumFunctionCall(const std::string& table,
+                                                      const TableColumns& columns,
+                                                      const std::string& prefix,
+                                                      const bool upsert)
+{
+    //
+    // The table, the operation (1 upsert, 0 erase) and the content columns:
+    //  dbsync_checksum_index('table',1,NEW.column1,NEW.column2,...)
+    //
+    std::string sql { std::string { CHECKSUM_FUNCTION_NAME } + "('" + table + "'," + (upsert ? "1" : "0") };
+
+    for (const auto& column : columns)
+    {
+        sql.append("," + prefix + std::get<TableHeader::Name>(column));
+    }
+
+    sql.append(")");
+    return sql;
+}
+
+std::string SQLiteDBEngine::buildChecksumTriggers(const std::string& table,
+                                                  const TableColumns& columns)
+{
+    //
+    // Every change of the rows goes through a trigger, whatever the statement that does it. The triggers are
+    // temporary, as the function they call only exists in this connection:
+    //  CREATE TEMP TRIGGER IF NOT EXISTS table_checksum_insert AFTER INSERT ON table BEGIN SELECT f(NEW...); END;
+    //  CREATE TEMP TRIGGER IF NOT EXISTS table_checksum_delete AFTER DELETE ON table BEGIN SELECT f(OLD...); END;
+    //  CREATE TEMP TRIGGER IF NOT EXISTS table_checksum_update AFTER UPDATE OF column1, ... ON table
+    //  BEGIN SELECT f(OLD...); SELECT f(NEW...); END;
+    //
+    const auto trigger { "CREATE TEMP TRIGGER IF NOT EXISTS " + table + CHECKSUM_TRIGGER_SUBFIX };
+    std::string sql;
+
+    sql.append(trigger + "_insert AFTER INSERT ON " + table);
+    sql.append(" BEGIN SELECT " + buildChecksumFunctionCall(table, columns, "NEW.", true) + "; END;");
+    sql.append(trigger + "_delete AFTER DELETE ON " + table);
+    sql.append(" BEGIN SELECT " + buildChecksumFunctionCall(table, columns, "OLD.", false) + "; END;");
+    sql.append(trigger + "_update AFTER UPDATE OF ");
+
+    for (const auto& column : columns)
+    {
+        sql.append(std::get<TableHeader::Name>(column) + ",");
+    }
+
+    sql.back() = ' ';
+    sql.append("ON " + table + " BEGIN SELECT " + buildChecksumFunctionCall(table, columns, "OLD.", false) + ";");
+    sql.append(" SELECT " + buildChecksumFunctionCall(table, columns, "NEW.", true) + "; END;");
+    return sql;
+}
+
+void SQLiteDBEngine::loadChecksumIndex(const std::string& table)
+{
+    TableColumns columns;
+
+    {
+        std::lock_guard<std::mutex> lock(m_checksumMutex);
+        auto& checksumTable { m_checksumIndexes.at(table) };
+        checksumTable.index->clear();
+        columns = checksumTable.columns;
+    }
+
+    // The stored rows go through the same function as the triggers, so their values are converted the same way.
+    const auto stmt
+    {
+        m_sqliteFactory->createStatement(m_sqliteConnection,
+                                         "SELECT " + buildChecksumFunctionCall(table, columns, "", true) + " FROM " + table + ";")
+    };
+
+    while (SQLITE_ROW == stmt->step());
+}
+
+DbSync::Value SQLiteDBEngine::getChecksumValue(sqlite3_value* value,
+                                               const ColumnData& cd)
+{
+    // Same values as getRowValue reads from the table.
+    const auto type { std::get<TableHeader::Type>(cd) };
+
+    if (SQLITE_NULL == sqlite3_value_type(value))
+    {
+        return {};
+    }
+    else if (ColumnType::BigInt == type || ColumnType::Integer == type)
+    {
+        return static_cast<int64_t>(sqlite3_value_int64(value));
+    }
+    else if (ColumnType::UnsignedBigInt == type)
+    {
+        return static_cast<uint64_t>(sqlite3_value_int64(value));
+    }
+    else if (ColumnType::Double == type)
+    {
+        return sqlite3_value_double(value);
+    }
+
+    const auto text { reinterpret_cast<const char*>(sqlite3_value_text(value)) };
+    return std::string { text ? text : "", static_cast<size_t>(sqlite3_value_bytes(value)) };
+}
+
+void SQLiteDBEngine::checksumIndexFunction(sqlite3_context* context,
+                                           int argc,
+                                           sqlite3_value** argv)
+{
+    const auto engine { static_cast<SQLiteDBEngine*>(sqlite3_user_data(context)) };
+
+    try
+    {
+        const auto table { argc > 1 ? reinterpret_cast<const char*>(sqlite3_value_text(argv[0])) : nullptr };
+
+        if (table)
+        {
+            std::lock_guard<std::mutex> lock(engine->m_checksumMutex);
+            const auto it { engine->m_checksumIndexes.find(table) };
+
+            if (engine->m_checksumIndexes.end() != it && it->second.columns.size() == static_cast<size_t>(argc - 2))
+            {
+                DbSync::RowValues row;
+                row.reserve(it->second.columns.size());
+
+                for (size_t i = 0; i < it->second.columns.size(); ++i)
+                {
+                    row.push_back(getChecksumValue(argv[i + 2], it->second.columns[i]));
+                }
+
+                if (sqlite3_value_int(argv[1]))
+                {
+                    it->second.index->upsert(row);
+                }
+                else
+                {
+                    it->second.index->erase(row);
+                }
+            }
+        }
+
+        sqlite3_result_null(context);
+    }
+    // LCOV_EXCL_START
+    catch (const std::exception& ex)
+    {
+        sqlite3_result_error(context, ex.what(), -1);
+    }
+
+    // LCOV_EXCL_STOP
+}
+
+void SQLiteDBEngine::checksumIndexRollback(void* data)
+{
+    const auto engine { static_cast<SQLiteDBEngine*>(data) };
+    std::lock_guard<std::mutex> lock(engine->m_checksumMutex);
+    engine->m_checksumStale = true;
+}
+
+void SQLiteDBEngine::registerChecksumFunction()
+{
+    // SQLite doesn't register functions while there are statements in progress, so it's done when the
+    // connection is opened instead of when an index is enabled.
+    const auto& db { m_sqliteConnection->db() };
+
+    if (db)
+    {
+        // LCOV_EXCL_START
+        if (SQLITE_OK != sqlite3_create_function_v2(db.get(),
+                                                    CHECKSUM_FUNCTION_NAME,
+                                                    -1,
+                                                    SQLITE_UTF8,
+                                                    this,
+                                                    &SQLiteDBEngine::checksumIndexFunction,
+                                                    nullptr,
+                                                    nullptr,
+                                                    nullptr))
+        {
+            throw dbengine_error { SQL_STMT_ERROR };
+        }
+
+        // LCOV_EXCL_STOP
+        sqlite3_rollback_hook(db.get(), &SQLiteDBEngine::checksumIndexRollback, this);
+        m_checksumRegistered = true;
+    }
+}
+
+int SQLiteDBEngine::statementTrace(unsigned int /*type*/,
+                                   void* data,
+                                   void* /*stmt*/,
+                                   void* sql)
+{
+    // The statements run by the triggers are reported with their name as a comment, they aren't counted.
+    const auto text { static_cast<const char*>(sql) };
+
+    if (text && 0 != std::strncmp(text, "--", 2))
+    {
+        ++static_cast<SQLiteDBEngine*>(data)->m_statementsExecuted;
+    }
+
+    return 0;
+}
+
+void SQLiteDBEngine::bindRowValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                  const ColumnData& cd,
+                                  const DbSync::Value& value,
+                                  const int32_t index)
+{
+    const auto type { std::get<TableHeader::Type>(cd) };
+
+    if (std::holds_alternative<std::monostate>(value))
+    {
+        if (std::get<TableHeader::PK>(cd))
+        {
+            throw dbengine_error { INVALID_DATA_BIND };
+        }
+
+        stmt->bind(index);
+    }
+    else if (ColumnType::BigInt == type)
+    {
+        stmt->bind(index, DbSync::numericRowValue<int64_t>(value));
+    }
+    else if (ColumnType::UnsignedBigInt == type)
+    {
+        stmt->bind(index, DbSync::numericRowValue<uint64_t>(value));
+    }
+    else if (ColumnType::Integer == type)
+    {
+        stmt->bind(index, DbSync::numericRowValue<int32_t>(value));
+    }
+    else if (ColumnType::Text == type)
+    {
+        const auto data { std::get_if<std::string>(&value) };
+        stmt->bind(index, data ? *data : std::string {});
+    }
+    else if (ColumnType::Double == type)
+    {
+        stmt->bind(index, DbSync::numericRowValue<double_t>(value));
+    }
+    else
+    {
+        throw dbengine_error { INVALID_COLUMN_TYPE };
+    }
+}
+
+DbSync::Value SQLiteDBEngine::getRowValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                          const ColumnData& cd)
+{
+    const auto type { std::get<TableHeader::Type>(cd) };
+    const auto column { stmt->column(std::get<TableHeader::CID>(cd)) };
+
+    if (!column->hasValue())
+    {
+        return {};
+    }
+    else if (ColumnType::BigInt == type || ColumnType::Integer == type)
+    {
+        return column->value(int64_t {});
+    }
+    else if (ColumnType::UnsignedBigInt == type)
+    {
+        return column->value(uint64_t {});
+    }
+    else if (ColumnType::Text == type)
+    {
+        return column->value(std::string {});
+    }
+    else if (ColumnType::Double == type)
+    {
+        return column->value(double_t {});
+    }
+
+    throw dbengine_error { INVALID_COLUMN_TYPE };
+}
+
+std::string SQLiteDBEngine::buildInsertRowValuesQuery(const std::string& table,
+                                                      const TableColumns& columns)
+{
+    //
+    // Same statement as buildInsertDataSqlQuery for the same columns, in the order of the table:
+    //  INSERT INTO table (column1, column2, ...) VALUES (?, ?, ...);
+    //
+    std::string sql   {"INSERT INTO " + table + " ("};
+    std::string binds {") VALUES ("};
+
+    for (const auto& column : columns)
+    {
+        sql.append(std::get<TableHeader::Name>(column) + ",");
+        binds.append("?,");
+    }
+
+    binds.back() = ')';
+    sql.pop_back();
+    return sql + binds + ";";
+}
+
+std::string SQLiteDBEngine::buildUpdateRowValuesQuery(const std::string& table,
+                                                      const TableColumns& columns,
+                                                      const std::vector<std::string>& primaryKeyList)
+{
+    //
+    // The columns are set in the order of the table:
+    //  UPDATE table SET column1=?, column2=?, ... WHERE pk1=? AND pk2=? ...;
+    //
+    std::string sql { "UPDATE " + table + " SET " };
+
+    for (const auto& column : columns)
+    {
+        sql.append(std::get<TableHeader::Name>(column) + "=?,");
+    }
+
+    sql.back() = ' ';
+    sql.append("WHERE ");
+
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append(value + "=? AND ");
+    }
+
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append(";");
+    return sql;
+}
+
+bool SQLiteDBEngine::syncTableRowDataBulk(const std::string& table,
+                                          const nlohmann::json& data,
+                                          const std::vector<std::string>& primaryKeyList,
+                                          const nlohmann::json& ignoredColumns,
+                                          const DbSync::ResultCallback callback,
+                                          const bool inTransaction,
+                                          const bool returnOldData,
+                                          Utils::ILocking& lock)
+{
+    TableColumns bulkColumns;
+
+    if (data.size() < BULK_SYNC_MIN_ROWS || !getBulkColumns(table, data, primaryKeyList, bulkColumns))
+    {
+        return false;
+    }
+
+    {
+        // The row path reports the rows inserted before reaching the limit.
+        std::lock_guard<std::mutex> maxRowsLock(m_maxRowsMutex);
+
+        if (m_maxRows.end() != m_maxRows.find(table))
+        {
+            return false;
+        }
+    }
+
+    const auto tableFields { m_tableFields[table] };
+    std::vector<std::optional<int64_t>> rowHashes;
+    TableColumns matchColumns;
+
+    if (hasRowHash(table))
+    {
+        // The hash is staged as one more column, and it's the only one read from the stored rows.
+        std::copy_if(tableFields.begin(), tableFields.end(), std::back_inserter(matchColumns), [](const ColumnData & column)
+        {
+            return 0 == std::get<TableHeader::Name>(column).compare(HASH_FIELD_NAME);
+        });
+        bulkColumns.push_back(matchColumns.front());
+        rowHashes.reserve(data.size());
+
+        for (const auto& row : data)
+        {
+            rowHashes.push_back(getRowHash(tableFields, row));
+        }
+    }
+    else
+    {
+        matchColumns = tableFields;
+    }
+
+    // Without the hash every received column is compared, the ignored ones are filtered out after the diff.
+    const auto& compareColumns { rowHashes.empty() ? bulkColumns : matchColumns };
+    std::vector<bool> newRows(data.size(), false);
+    std::vector<nlohmann::json> modifiedRows(data.size());
+    std::vector<size_t> updatedRows;
+    std::vector<size_t> outdatedHashRows;
+    auto hasNewRows { false };
+
+    {
+        std::lock_guard<std::mutex> bulkLock(m_bulkMutex);
+
+        if (!loadBulkTable(table, bulkColumns, primaryKeyList, data, rowHashes))
+        {
+            return false;
+        }
+
+        // SQLite skips the rows whose values are already stored. The diff of the remaining ones is computed against
+        // the input, as the row path does, to report the same results.
+        const auto stmtMatch
+        {
+            getStatement(getColumnsQueryId(QueryKind::BulkMatch, table, tableFields, compareColumns), [&]()
+            {
+                return buildBulkMatchQuery(table, matchColumns, compareColumns, primaryKeyList);
+            })
+        };
+
+        while (SQLITE_ROW == stmtMatch->step())
+        {
+            const auto rowIndex { static_cast<size_t>(stmtMatch->column(0)->value(int64_t{})) };
+
+            if (0 != stmtMatch->column(1)->value(int32_t{}))
+            {
+                newRows[rowIndex] = true;
+                hasNewRows = true;
+                continue;
+            }
+
+            Row registryFields;
+            int32_t index { 2l };
+
+            for (const auto& field : matchColumns)
+            {
+                getTableData(stmtMatch,
+                             index,
+                             std::get<TableHeader::Type>(field),
+                             std::get<TableHeader::Name>(field),
+                             registryFields);
+                ++index;
+            }
+
+            nlohmann::json updated;
+            nlohmann::json oldData;
+
+            if (rowHashes.empty())
+            {
+                compareRowData(primaryKeyList, ignoredColumns, data[rowIndex], registryFields, updated, oldData);
+            }
+            else if (compareRowHash(primaryKeyList,
+                                    ignoredColumns,
+                                    table,
+                                    data[rowIndex],
+                                    std::get<GenericTupleIndex::GenBigInt>(registryFields[HASH_FIELD_NAME]),
+                                    rowHashes[rowIndex],
+                                    returnOldData,
+                                    updated,
+                                    oldData)
+                     && updated.empty())
+            {
+                // Same values with an outdated hash, only the hash is written as the row path does.
+                outdatedHashRows.push_back(rowIndex);
+            }
+
+            if (!updated.empty())
+            {
+                updatedRows.push_back(rowIndex);
+
+                if (returnOldData)
+                {
+                    modifiedRows[rowIndex]["old"] = std::move(oldData);
+                    modifiedRows[rowIndex]["new"] = std::move(updated);
+                }
+                else
+                {
+                    modifiedRows[rowIndex] = std::move(updated);
+                }
+            }
+        }
+
+        if (inTransaction)
+        {
+            const auto stmtStatus
+            {
+                getStatement(QueryId { QueryKind::BulkStatus, table, 0ull, 0ull }, [&]()
+                {
+                    return buildBulkStatusQuery(table, primaryKeyList);
+                })
+            };
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtStatus->step())
+            {
+                throw dbengine_error{ STEP_ERROR_UPDATE_STATUS_FIELD };
+            }
+
+            // LCOV_EXCL_STOP
+        }
+
+        if (!updatedRows.empty())
+        {
+            const auto stmtMark
+            {
+                getStatement(QueryId { QueryKind::BulkMark, table, 0ull, 0ull }, [&table]()
+                {
+                    return "UPDATE " + table + BULK_TABLE_SUBFIX + " SET " + BULK_UPDATE_FIELD_NAME + "=1 WHERE " + BULK_INDEX_FIELD_NAME + "=?;";
+                })
+            };
+
+            for (const auto rowIndex : updatedRows)
+            {
+                stmtMark->reset();
+                stmtMark->bind(1, static_cast<int64_t>(rowIndex));
+
+                // LCOV_EXCL_START
+                if (SQLITE_ERROR == stmtMark->step())
+                {
+                    throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+                }
+
+                // LCOV_EXCL_STOP
+            }
+
+            const auto stmtUpdate
+            {
+                getStatement(getColumnsQueryId(QueryKind::BulkUpdate, table, tableFields, bulkColumns), [&]()
+                {
+                    return buildBulkUpdateQuery(table, bulkColumns, primaryKeyList);
+                })
+            };
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtUpdate->step())
+            {
+                throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+        }
+
+        for (const auto rowIndex : outdatedHashRows)
+        {
+            updateRowHash(table, primaryKeyList, data[rowIndex], *rowHashes[rowIndex]);
+        }
+
+        if (hasNewRows)
+        {
+            const auto stmtInsert
+            {
+                getStatement(getColumnsQueryId(QueryKind::BulkInsertNewRows, table, tableFields, bulkColumns), [&]()
+                {
+                    return buildBulkInsertNewRowsQuery(table, bulkColumns, primaryKeyList);
+                })
+            };
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmtInsert->step())
+            {
+                throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+        }
+
+        getStatement(QueryId { QueryKind::BulkClear, table, 0ull, 0ull }, [&table]()
+        {
+            return "DELETE FROM " + table + BULK_TABLE_SUBFIX + ";";
+        })->step();
+    }
+
+    if (callback)
+    {
+        lock.unlock();
+
+        for (size_t rowIndex = 0; rowIndex < data.size(); ++rowIndex)
+        {
+            if (newRows[rowIndex])
+            {
+                callback(INSERTED, data[rowIndex]);
+            }
+            else if (!modifiedRows[rowIndex].empty())
+            {
+                callback(MODIFIED, modifiedRows[rowIndex]);
+            }
+        }
+
+        lock.lock();
+    }
+
+    return true;
+}
+
+bool SQLiteDBEngine::getBulkColumns(const std::string& table,
+                                    const nlohmann::json& data,
+                                    const std::vector<std::string>& primaryKeyList,
+                                    TableColumns& bulkColumns)
+{
+    const auto& tableFields { m_tableFields[table] };
+    if (!data.is_array() || !data.front().is_object())
+    {
+        return false;
+    }
+
+    const auto& firstRow { data.front() };
+
+    for (const auto& field : tableFields)
+    {
+        if (firstRow.end() != firstRow.find(std::get<TableHeader::Name>(field)))
+        {
+            if (std::get<TableHeader::TXNStatusField>(field))
+            {
+                return false;
+            }
+
+            bulkColumns.push_back(field);
+        }
+    }
+
+    const auto pkCount
+    {
+        std::count_if(bulkColumns.begin(), bulkColumns.end(), [](const ColumnData & column)
+        {
+            return std::get<TableHeader::PK>(column);
+        })
+    };
+
+    if (static_cast<size_t>(pkCount) != primaryKeyList.size())
+    {
+        return false;
+    }
+
+    // Every row has to fill the same columns to be staged with the same statement.
+    return std::all_of(data.begin(), data.end(), [&tableFields, &bulkColumns](const nlohmann::json & row)
+    {
+        if (!row.is_object())
+        {
+            return false;
+        }
+
+        size_t presentColumns { 0ull };
+
+        for (const auto& field : tableFields)
+        {
+            if (row.end() != row.find(std::get<TableHeader::Name>(field)))
+            {
+                ++presentColumns;
+            }
+        }
+
+        return presentColumns == bulkColumns.size()
+               && std::all_of(bulkColumns.begin(), bulkColumns.end(), [&row](const ColumnData & column)
+        {
+            return row.end() != row.find(std::get<TableHeader::Name>(column));
+        });
+    });
+}
+
+bool SQLiteDBEngine::isExactJsonData(const ColumnData& cd,
+                                     const nlohmann::json& row)
+{
+    // True if bindJsonData stores the value as it was received, so reading it back gives the same JSON. The values
+    // converted on bind (booleans, numbers in text columns, strings in numeric ones...) differ from the stored ones.
+    const auto& value { row.at(std::get<TableHeader::Name>(cd)) };
+    const auto type { std::get<TableHeader::Type>(cd) };
+    auto ret { value.is_null() };
+
+    if (ColumnType::BigInt == type)
+    {
+        ret = ret || (value.is_number_integer()
+                      && (!value.is_number_unsigned() || value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())));
+    }
+    else if (ColumnType::UnsignedBigInt == type)
+    {
+        ret = ret || value.is_number_unsigned();
+    }
+    else if (ColumnType::Integer == type)
+    {
+        ret = ret || (value.is_number_unsigned() && value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()))
+              || (value.is_number_integer() && !value.is_number_unsigned()
+                  && value.get<int64_t>() >= std::numeric_limits<int32_t>::min()
+                  && value.get<int64_t>() <= std::numeric_limits<int32_t>::max());
+    }
+    else if (ColumnType::Text == type)
+    {
+        ret = ret || value.is_string();
+    }
+    else if (ColumnType::Double == type)
+    {
+        ret = ret || (value.is_number_float() && !std::isnan(value.get<double>()));
+    }
+
+    return ret;
+}
+
+bool SQLiteDBEngine::loadBulkTable(const std::string& table,
+                                   const TableColumns& bulkColumns,
+                                   const std::vector<std::string>& primaryKeyList,
+                                   const nlohmann::json& data,
+                                   const std::vector<std::optional<int64_t>>& rowHashes)
+{
+    auto ret { true };
+    const auto bulkTable { table + BULK_TABLE_SUBFIX };
+    const auto tableFields { m_tableFields[table] };
+    const auto clearBulkTable
+    {
+        [&]()
+        {
+            getStatement(QueryId { QueryKind::BulkClear, table, 0ull, 0ull }, [&bulkTable]()
+            {
+                return "DELETE FROM " + bulkTable + ";";
+            })->step();
+        }
+    };
+
+    m_sqliteConnection->execute(buildCreateBulkTableQuery(table, primaryKeyList));
+    clearBulkTable();
+
+    try
+    {
+        const auto rowsPerStmt { std::max<size_t>(1ull, BULK_SYNC_MAX_BINDS / (bulkColumns.size() + 2)) };
+        size_t offset { 0ull };
+
+        while (offset < data.size())
+        {
+            const auto rows { std::min(rowsPerStmt, data.size() - offset) };
+            const auto stmt
+            {
+                getStatement(getColumnsQueryId(QueryKind::BulkInsert, table, tableFields, bulkColumns, rows), [&]()
+                {
+                    return buildBulkInsertQuery(bulkTable, bulkColumns, rows);
+                })
+            };
+            int32_t index { 1l };
+
+            for (auto rowIndex = offset; rowIndex < offset + rows; ++rowIndex)
+            {
+                const auto& row { data[rowIndex] };
+
+                stmt->bind(index, static_cast<int64_t>(rowIndex));
+                ++index;
+                stmt->bind(index, std::all_of(bulkColumns.begin(), bulkColumns.end(), [&row](const ColumnData & column)
+                {
+                    return isExactJsonData(column, row);
+                }) ? 1 : 0);
+                ++index;
+
+                for (const auto& column : bulkColumns)
+                {
+                    if (std::get<TableHeader::TXNStatusField>(column))
+                    {
+                        if (rowHashes[rowIndex])
+                        {
+                            stmt->bind(index, *rowHashes[rowIndex]);
+                        }
+                        else
+                        {
+                            // The rows that leave columns out don't have a hash.
+                            stmt->bind(index);
+                        }
+                    }
+                    else
+                    {
+                        bindJsonData(stmt, column, row, index);
+                    }
+
+                    ++index;
+                }
+            }
+
+            // LCOV_EXCL_START
+            if (SQLITE_ERROR == stmt->step())
+            {
+                throw dbengine_error{ BIND_FIELDS_DOES_NOT_MATCH };
+            }
+
+            // LCOV_EXCL_STOP
+            offset += rows;
+        }
+    }
+    catch (const std::exception&)
     {
-        throw dbengine_error { INVALID_DATA_BIND };
+        // Repeated keys or values that can't be bound, nothing was applied yet so the row path handles them.
+        clearBulkTable();
+        ret = false;
     }
+
+    return ret;
 }
 
-std::string SQLiteDBEngine::buildSelectQuery(const std::string& table,
-                                             const nlohmann::json& jsQuery)
+std::string SQLiteDBEngine::buildCreateBulkTableQuery(const std::string& table,
+                                                      const std::vector<std::string>& primaryKeyList)
 {
-    const auto& columns{ jsQuery.at("column_list")};
-    const auto& itFilter{ jsQuery.find("row_filter")};
-    /*optional fields*/
-    const auto& itDistinct{ jsQuery.find("distinct_opt") };
-    const auto& itOrderBy{ jsQuery.find("order_by_opt") };
-    const auto& itCount{ jsQuery.find("count_opt") };
-
-    std::string sql{ "SELECT "};
-
-    if (itDistinct != jsQuery.end() && itDistinct->get<bool>())
+    //
+    // The staging table keeps the column types of the table, so the values are bound and compared the same way:
+    //  CREATE TEMP TABLE IF NOT EXISTS table_BULK (dbsync_bulk_index INTEGER PRIMARY KEY, dbsync_bulk_exact INTEGER,
+    //                                              dbsync_bulk_update INTEGER DEFAULT 0, column1 TYPE, ...,
+    //                                              [db_hash_field_dm BIGINT,] UNIQUE (pk1, ...));
+    //
+    std::string sql { "CREATE TEMP TABLE IF NOT EXISTS " + table + BULK_TABLE_SUBFIX + " (" };
+    sql.append(BULK_INDEX_FIELD_NAME);
+    sql.append(" INTEGER PRIMARY KEY,");
+    sql.append(BULK_EXACT_FIELD_NAME);
+    sql.append(" INTEGER,");
+    sql.append(BULK_UPDATE_FIELD_NAME);
+    sql.append(" INTEGER DEFAULT 0,");
+
+    for (const auto& field : m_tableFields[table])
     {
-        sql += "DISTINCT ";
+        if (!std::get<TableHeader::TXNStatusField>(field) || 0 == std::get<TableHeader::Name>(field).compare(HASH_FIELD_NAME))
+        {
+            const auto& it
+            {
+                std::find_if(ColumnTypeNames.begin(), ColumnTypeNames.end(), [&field](const std::pair<const std::string, ColumnType>& type)
+                {
+                    return type.second == std::get<TableHeader::Type>(field);
+                })
+            };
+
+            sql.append(std::get<TableHeader::Name>(field) + " " + it->first + ",");
+        }
     }
 
-    for (const auto& column : columns)
+    sql.append("UNIQUE (");
+
+    for (const auto& value : primaryKeyList)
     {
-        sql += column.get_ref<const std::string&>();
-        sql += ",";
+        sql.append(value + ",");
     }
 
     sql = sql.substr(0, sql.size() - 1);
+    sql.append("));");
+    return sql;
+}
 
-    sql += " FROM " + table;
+std::string SQLiteDBEngine::buildBulkInsertQuery(const std::string& table,
+                                                 const TableColumns& bulkColumns,
+                                                 const size_t rows)
+{
+    //
+    // A single statement loads as many rows as binds are allowed:
+    //  INSERT INTO table_BULK (dbsync_bulk_index, dbsync_bulk_exact, column1, ...) VALUES (?, ?, ?, ...), (?, ?, ?, ...), ...;
+    //
+    std::string sql { "INSERT INTO " + table + " (" + BULK_INDEX_FIELD_NAME + "," + BULK_EXACT_FIELD_NAME };
+    std::string binds { "(?,?" };
 
-    if (itFilter != jsQuery.end() && !itFilter->get<std::string>().empty())
+    for (const auto& column : bulkColumns)
     {
-        sql += " ";
-        sql += itFilter->get<std::string>();
+        sql.append("," + std::get<TableHeader::Name>(column));
+        binds.append(",?");
     }
 
-    if (itOrderBy != jsQuery.end() && !itOrderBy->get<std::string>().empty())
-    {
-        sql += " ORDER BY " + itOrderBy->get<std::string>();
-    }
+    binds.append("),");
+    sql.append(") VALUES ");
+    sql.reserve(sql.size() + binds.size() * rows);
 
-    if (itCount != jsQuery.end())
+    for (size_t i = 0; i < rows; ++i)
     {
-        const unsigned int limit{*itCount};
-        sql += " LIMIT " + std::to_string(limit);
+        sql.append(binds);
     }
 
-    sql += ";";
+    sql = sql.substr(0, sql.size() - 1);
+    sql.append(";");
     return sql;
 }
 
-std::string SQLiteDBEngine::buildLeftOnlyQuery(const std::string& t1,
-                                               const std::string& t2,
-                                               const std::vector<std::string>& primaryKeyList,
-                                               const bool returnOnlyPKFields)
+std::string SQLiteDBEngine::buildBulkMatchQuery(const std::string& table,
+                                                const TableColumns& tableFields,
+                                                const TableColumns& compareColumns,
+                                                const std::vector<std::string>& primaryKeyList)
 {
-    std::string fieldsList;
-    std::string onMatchList;
-    std::string nullFilterList;
+    //
+    // New rows, and current values of the stored rows that may have changed. The rows whose values can't be staged
+    // exactly are always returned, to be compared as the row path does. The staged column goes first, so the
+    // comparison uses its collation and not the one of the table:
+    //  SELECT b.dbsync_bulk_index, t.pk1 IS NULL, t.column1, ... FROM table_BULK b LEFT JOIN table t ON t.pk1=b.pk1 AND ...
+    //  WHERE t.pk1 IS NULL OR b.dbsync_bulk_exact=0 OR b.column1 IS NOT t.column1 OR ...;
+    // With the row hash only the hash is compared:
+    //  WHERE t.pk1 IS NULL OR b.db_hash_field_dm IS NULL OR b.db_hash_field_dm IS NOT t.db_hash_field_dm;
+    //
+    const auto& firstKey { primaryKeyList.front() };
+    const auto hashOnly
+    {
+        1 == compareColumns.size() && 0 == std::get<TableHeader::Name>(compareColumns.front()).compare(HASH_FIELD_NAME)
+    };
+    std::string sql { "SELECT b." };
+    sql.append(BULK_INDEX_FIELD_NAME);
+    sql.append(",t." + firstKey + " IS NULL");
 
-    for (const auto& value : primaryKeyList)
+    for (const auto& field : tableFields)
     {
-        if (returnOnlyPKFields)
-        {
-            fieldsList.append("t1." + value + ",");
-        }
+        sql.append(",t." + std::get<TableHeader::Name>(field));
+    }
 
-        onMatchList.append("t1." + value + "= t2." + value + " AND ");
-        nullFilterList.append("t2." + value + " IS NULL AND ");
+    sql.append(" FROM " + table + BULK_TABLE_SUBFIX + " b LEFT JOIN " + table + " t ON ");
+
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append("t." + value + "=b." + value + " AND ");
     }
 
-    if (returnOnlyPKFields)
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append(" WHERE t." + firstKey + " IS NULL OR b.");
+
+    if (hashOnly)
     {
-        fieldsList = fieldsList.substr(0, fieldsList.size() - 1);
+        sql.append(HASH_FIELD_NAME);
+        sql.append(" IS NULL");
     }
     else
     {
-        fieldsList.append("*");
+        sql.append(BULK_EXACT_FIELD_NAME);
+        sql.append("=0");
     }
 
-    onMatchList = onMatchList.substr(0, onMatchList.size() - 5);
-    nullFilterList = nullFilterList.substr(0, nullFilterList.size() - 5);
+    for (const auto& column : compareColumns)
+    {
+        if (!std::get<TableHeader::PK>(column))
+        {
+            const auto& name { std::get<TableHeader::Name>(column) };
+            sql.append(" OR b." + name + " IS NOT t." + name);
+        }
+    }
 
-    return "SELECT " + fieldsList + " FROM " + t1 + " t1 LEFT JOIN " + t2 + " t2 ON " + onMatchList + " WHERE " + nullFilterList + ";";
+    sql.append(";");
+    return sql;
 }
 
-bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
-                                const nlohmann::json& ignoredColumns,
-                                const std::string& table,
-                                const nlohmann::json& data,
-                                nlohmann::json& updatedData,
-                                nlohmann::json& oldData)
+std::string SQLiteDBEngine::buildBulkStatusQuery(const std::string& table,
+                                                 const std::vector<std::string>& primaryKeyList)
 {
-    bool diffExist { false };
-    bool isModified { false };
-    const auto stmt
+    //
+    // Keeps the rows already stored from being deleted when the transaction is closed:
+    //  UPDATE table SET db_status_field_dm=1 WHERE EXISTS (SELECT 1 FROM table_BULK b WHERE b.pk1=table.pk1 AND ...);
+    //
+    std::string sql { "UPDATE " + table + " SET " + STATUS_FIELD_NAME + "=1 WHERE EXISTS (SELECT 1 FROM " + table + BULK_TABLE_SUBFIX + " b WHERE " };
+
+    for (const auto& value : primaryKeyList)
     {
-        getStatement(buildSelectMatchingPKsSqlQuery(table, primaryKeyList))
-    };
+        sql.append("b." + value + "=" + table + "." + value + " AND ");
+    }
 
-    const auto& tableFields { m_tableFields[table] };
-    int32_t index { 1l };
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append(");");
+    return sql;
+}
 
-    // Always include primary keys
-    for (const auto& pkValue : primaryKeyList)
-    {
-        const auto& it
-        {
-            std::find_if(tableFields.begin(), tableFields.end(),
-                         [&pkValue](const ColumnData & column)
-            {
-                return 0 == std::get<Name>(column).compare(pkValue);
-            })
-        };
+std::string SQLiteDBEngine::buildBulkUpdateQuery(const std::string& table,
+                                                 const TableColumns& bulkColumns,
+                                                 const std::vector<std::string>& primaryKeyList)
+{
+    //
+    // The rows reported as modified are updated with every column received, as the row path does:
+    //  UPDATE table SET (column1, ...) = (SELECT b.column1, ... FROM table_BULK b WHERE b.pk1=table.pk1 AND ...)
+    //  WHERE EXISTS (SELECT 1 FROM table_BULK b WHERE b.pk1=table.pk1 AND ... AND b.dbsync_bulk_update=1);
+    //
+    std::string match;
 
-        if (it != tableFields.end())
-        {
-            updatedData[pkValue] = data.at(pkValue);
-            oldData[pkValue] = data.at(pkValue);
-            bindJsonData(stmt, *it, data, index);
-            ++index;
-        }
+    for (const auto& value : primaryKeyList)
+    {
+        match.append("b." + value + "=" + table + "." + value + " AND ");
     }
 
-    diffExist = SQLITE_ROW == stmt->step();
+    match = match.substr(0, match.size() - 5);
 
-    if (diffExist)
-    {
-        // The row exists, so let's generate the diff
-        Row registryFields;
+    std::string fields;
+    std::string values;
 
-        for (const auto& field : tableFields)
+    for (const auto& column : bulkColumns)
+    {
+        if (!std::get<TableHeader::PK>(column))
         {
-            getTableData(stmt,
-                         std::get<TableHeader::CID>(field),
-                         std::get<TableHeader::Type>(field),
-                         std::get<TableHeader::Name>(field),
-                         registryFields);
+            fields.append(std::get<TableHeader::Name>(column) + ",");
+            values.append("b." + std::get<TableHeader::Name>(column) + ",");
         }
+    }
 
-        if (!registryFields.empty())
-        {
-            for (const auto& value : registryFields)
-            {
-                nlohmann::json object;
-                getFieldValueFromTuple(value, object);
-                const auto& it
-                {
-                    data.find(value.first)
-                };
-
-                if (data.end() != it)
-                {
-                    // Only compare if not in ignore set
-                    if (*it != object.at(value.first))
-                    {
-                        // Diff found
-                        isModified = true;
-                        oldData[value.first] = object[value.first];
-                    }
+    std::string sql { "UPDATE " + table + " SET (" + fields.substr(0, fields.size() - 1) + ")=(SELECT " + values.substr(0, values.size() - 1) };
+    sql.append(" FROM " + table + BULK_TABLE_SUBFIX + " b WHERE " + match + ")");
+    sql.append(" WHERE EXISTS (SELECT 1 FROM " + table + BULK_TABLE_SUBFIX + " b WHERE " + match + " AND b.");
+    sql.append(BULK_UPDATE_FIELD_NAME);
+    sql.append("=1);");
+    return sql;
+}
 
-                    updatedData[value.first] = *it;
-                }
-            }
-        }
-    }
+std::string SQLiteDBEngine::buildBulkInsertNewRowsQuery(const std::string& table,
+                                                        const TableColumns& bulkColumns,
+                                                        const std::vector<std::string>& primaryKeyList)
+{
+    //
+    // The rows not stored yet are inserted in the order they were received:
+    //  INSERT INTO table (column1, ...) SELECT column1, ... FROM table_BULK b
+    //  WHERE NOT EXISTS (SELECT 1 FROM table t WHERE t.pk1=b.pk1 AND ...) ORDER BY b.dbsync_bulk_index;
+    //
+    std::string fields;
 
-    // If the row is not modified, we clear the result to update the status field value only.
-    if (!isModified)
+    for (const auto& column : bulkColumns)
     {
-        updatedData.clear();
-        oldData.clear();
+        fields.append(std::get<TableHeader::Name>(column) + ",");
     }
-    else
-    {
-        if (!ignoredColumns.empty())
-        {
-            auto haveDiffOnNonIgnored
-            {
-                [&ignoredColumns, primaryKeyList](const nlohmann::json & rowToBeUpdated) -> bool
-                {
-                    bool haveDiff { false };
 
-                    for (const auto& fieldToBeUpdated : rowToBeUpdated.items())
-                    {
-                        if (std::find(ignoredColumns.begin(), ignoredColumns.end(),
-                                      fieldToBeUpdated.key()) == ignoredColumns.end())
-                        {
-                            if (std::find(primaryKeyList.begin(), primaryKeyList.end(),
-                                          fieldToBeUpdated.key()) == primaryKeyList.end())
-                            {
-                                haveDiff = true;
-                                break;
-                            }
-                        }
-                    }
+    fields = fields.substr(0, fields.size() - 1);
 
-                    return haveDiff;
-                }
-            };
+    std::string sql { "INSERT INTO " + table + " (" + fields + ") SELECT " + fields + " FROM " + table + BULK_TABLE_SUBFIX };
+    sql.append(" b WHERE NOT EXISTS (SELECT 1 FROM " + table + " t WHERE ");
 
-            if (!haveDiffOnNonIgnored(oldData))
-            {
-                updatedData.clear();
-                oldData.clear();
-            }
-        }
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append("t." + value + "=b." + value + " AND ");
     }
 
-    return diffExist;
+    sql = sql.substr(0, sql.size() - 5);
+    sql.append(") ORDER BY b.");
+    sql.append(BULK_INDEX_FIELD_NAME);
+    sql.append(";");
+    return sql;
 }
 
 bool SQLiteDBEngine::insertNewRows(const std::string& table,
@@ -1887,7 +3898,13 @@ void SQLiteDBEngine::updateSingleRow(const std::string& table,
     if (getPrimaryKeysFromTable(table, primaryKeyList))
     {
         const auto& tableFields { m_tableFields[table] };
-        const auto stmt { getStatement(buildUpdatePartialDataSqlQuery(table, jsData, primaryKeyList)) };
+        const auto stmt
+        {
+            getStatement(getColumnsQueryId(QueryKind::UpdatePartialData, table, tableFields, jsData), [&]()
+            {
+                return buildUpdatePartialDataSqlQuery(table, jsData, primaryKeyList);
+            })
+        };
         int32_t index { 1l };
 
         for (auto it = jsData.begin(); it != jsData.end(); ++it)
@@ -2054,33 +4071,94 @@ void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
 
 std::shared_ptr<SQLiteLegacy::IStatement>const SQLiteDBEngine::getStatement(const std::string& sql)
 {
-    std::lock_guard<std::mutex> lock(m_stmtMutex);
-    const auto it
+    return getStatement(QueryId { QueryKind::Sql, sql, 0ull, 0ull }, [&sql]()
+    {
+        return sql;
+    });
+}
+
+std::shared_ptr<SQLiteLegacy::IStatement>const SQLiteDBEngine::getStatement(const QueryId& id,
+                                                                            const std::function<std::string()>& buildQuery)
+{
+    // Statements of tables too wide for a columns mask are identified by their SQL.
+    if (QueryKind::Sql == id.kind && id.name.empty())
     {
-        std::find_if(m_statementsCache.begin(),
-                     m_statementsCache.end(),
-                     [sql](const std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>& pair)
+        const auto sql { buildQuery() };
+
+        if (!sql.empty())
         {
-            return 0 == pair.first.compare(sql);
-        })
-    };
+            return getStatement(sql);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_stmtMutex);
+    const auto it { m_statementsIndex.find(id) };
 
-    if (m_statementsCache.end() != it)
+    if (m_statementsIndex.end() != it)
     {
-        it->second->reset();
-        return it->second;
+        ++m_statementsCacheHits;
+        m_statementsCache.splice(m_statementsCache.begin(), m_statementsCache, it->second);
+        it->second->second->reset();
+        return it->second->second;
     }
-    else
+
+    ++m_statementsCacheMisses;
+    m_statementsCache.emplace_front(id, m_sqliteFactory->createStatement(m_sqliteConnection, buildQuery()));
+    m_statementsIndex.emplace(id, m_statementsCache.begin());
+
+    if (CACHE_STMT_LIMIT < m_statementsCache.size())
+    {
+        ++m_statementsCacheEvictions;
+        m_statementsIndex.erase(m_statementsCache.back().first);
+        m_statementsCache.pop_back();
+    }
+
+    return m_statementsCache.front().second;
+}
+
+QueryId SQLiteDBEngine::getColumnsQueryId(const QueryKind kind,
+                                          const std::string& table,
+                                          const TableColumns& tableFields,
+                                          const nlohmann::json& data,
+                                          const uint64_t rows)
+{
+    QueryId id { QueryKind::Sql, "", 0ull, 0ull };
+
+    if (QUERY_ID_MAX_COLUMNS >= tableFields.size())
     {
-        m_statementsCache.emplace_back(sql, m_sqliteFactory->createStatement(m_sqliteConnection, sql));
+        id = { kind, table, 0ull, rows };
 
-        if (CACHE_STMT_LIMIT <= m_statementsCache.size())
+        for (const auto& field : tableFields)
         {
-            m_statementsCache.pop_front();
+            if (data.end() != data.find(std::get<TableHeader::Name>(field)))
+            {
+                id.columns |= 1ull << std::get<TableHeader::CID>(field);
+            }
         }
+    }
+
+    return id;
+}
+
+QueryId SQLiteDBEngine::getColumnsQueryId(const QueryKind kind,
+                                          const std::string& table,
+                                          const TableColumns& tableFields,
+                                          const TableColumns& columns,
+                                          const uint64_t rows)
+{
+    QueryId id { QueryKind::Sql, "", 0ull, 0ull };
+
+    if (QUERY_ID_MAX_COLUMNS >= tableFields.size())
+    {
+        id = { kind, table, 0ull, rows };
 
-        return m_statementsCache.back().second;
+        for (const auto& column : columns)
+        {
+            id.columns |= 1ull << std::get<TableHeader::CID>(column);
+        }
     }
+
+    return id;
 }
 
 std::string SQLiteDBEngine::getSelectAllQuery(const std::string& table,
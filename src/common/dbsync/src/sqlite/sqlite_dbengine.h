@@ -12,28 +12,64 @@
 #ifndef _SQLITE_DBENGINE_H
 #define _SQLITE_DBENGINE_H
 
+#include <atomic>
+#include <exception>
 #include <tuple>
 #include <iostream>
+#include <list>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <unordered_map>
 #include "dbengine.h"
+#include "checksum_index.h"
 #include "sqlite_wrapper_factory.h"
 #include "isqlite_wrapper.h"
 #include "mapWrapperSafe.h"
 
 constexpr auto TEMP_TABLE_SUBFIX {"_TEMP"};
+constexpr auto BULK_TABLE_SUBFIX {"_BULK"};
+constexpr auto BULK_INDEX_FIELD_NAME {"dbsync_bulk_index"};
+constexpr auto BULK_UPDATE_FIELD_NAME {"dbsync_bulk_update"};
+constexpr auto BULK_EXACT_FIELD_NAME {"dbsync_bulk_exact"};
 
 constexpr auto STATUS_FIELD_NAME {"db_status_field_dm"};
 constexpr auto STATUS_FIELD_TYPE {"INTEGER"};
 
+constexpr auto HASH_FIELD_NAME {"db_hash_field_dm"};
+constexpr auto HASH_FIELD_TYPE {"BIGINT"};
+constexpr auto HASH_TRIGGER_SUBFIX {"_hash_reset"};
+
+constexpr auto CHECKSUM_FUNCTION_NAME {"dbsync_checksum_index"};
+constexpr auto CHECKSUM_TRIGGER_SUBFIX {"_checksum"};
+
 constexpr auto CACHE_STMT_LIMIT
 {
     30ull
 };
 
+// Widest table whose statements are identified by a mask of their columns.
+constexpr auto QUERY_ID_MAX_COLUMNS
+{
+    64ull
+};
+
+// Smaller batches are cheaper to diff row by row than to stage in the bulk table.
+constexpr auto BULK_SYNC_MIN_ROWS
+{
+    32ull
+};
+
+// Lowest SQLITE_MAX_VARIABLE_NUMBER among the supported SQLite versions.
+constexpr auto BULK_SYNC_MAX_BINDS
+{
+    999ull
+};
+
 const std::vector<std::string> InternalColumnNames =
 {
-    { STATUS_FIELD_NAME }
+    { STATUS_FIELD_NAME },
+    { HASH_FIELD_NAME }
 };
 
 enum ColumnType
@@ -100,23 +136,88 @@ enum ResponseType
     RTCallback
 };
 
-class dbengine_error : public DbSync::dbsync_error
+enum class QueryKind
 {
-    public:
-        explicit dbengine_error(const std::pair<int, std::string>& exceptionInfo)
-            : DbSync::dbsync_error
+    Sql = 0,
+    InsertData,
+    UpdatePartialData,
+    SelectMatchingPKs,
+    SelectRowHash,
+    DeleteBulkData,
+    BulkInsert,
+    BulkMatch,
+    BulkStatus,
+    BulkMark,
+    BulkUpdate,
+    BulkInsertNewRows,
+    BulkClear,
+    UpdateRowValues
+};
+
+// Identifies a cached statement without building its SQL. The statements built from the received columns carry them
+// as a mask of their position in the table, and the ones without a kind are identified by their SQL.
+struct QueryId final
+{
+    QueryKind kind;
+    std::string name;
+    uint64_t columns;
+    uint64_t rows;
+
+    bool operator==(const QueryId& other) const = default;
+};
+
+struct QueryIdHash final
+{
+    size_t operator()(const QueryId& id) const
+    {
+        auto hash { std::hash<std::string> {}(id.name) };
+
+        for (const auto value : { static_cast<uint64_t>(id.kind), id.columns, id.rows })
         {
-            exceptionInfo.first, "dbEngine: " + exceptionInfo.second
+            hash ^= std::hash<uint64_t> {}(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
         }
-        {}
+
+        return hash;
+    }
 };
 
+using StatementCacheEntry = std::pair<QueryId, std::shared_ptr<SQLiteLegacy::IStatement>>;
+
 struct MaxRows final
 {
     int64_t maxRows;
     int64_t currentRows;
 };
 
+// Checksum index of a table and its content columns, in the order they are given to the checksum function.
+struct ChecksumTable final
+{
+    TableColumns columns;
+    std::unique_ptr<DbSync::ChecksumIndex> index;
+};
+
+// Steps a statement of its own, so the rows are read from the database as they are fetched. The table columns keep
+// their declared type, the other ones (expressions, aggregates...) the type of their values.
+class SQLiteCursor final : public DbSync::IDbCursor
+{
+    public:
+        SQLiteCursor(const std::shared_ptr<SQLiteLegacy::IStatement>& stmt,
+                     const TableColumns& tableFields);
+
+        const std::vector<std::string>& columns() const override
+        {
+            return m_columns;
+        }
+
+        bool next(DbSync::RowValues& row) override;
+
+    private:
+        std::shared_ptr<SQLiteLegacy::IStatement> m_stmt;
+        std::vector<std::string> m_columns;
+        std::vector<int32_t> m_indexes;
+        std::vector<ColumnType> m_types;
+};
+
 class SQLiteDBEngine final : public DbSync::IDbEngine
 {
     public:
@@ -139,9 +240,22 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                               const bool inTransaction,
                               Utils::ILocking& mutex) override;
 
+        void syncTableRowValues(const DbSync::RowBatch& rows,
+                               const DbSync::RowCallback callback,
+                               const bool inTransaction,
+                               Utils::ILocking& mutex) override;
+
         void setMaxRows(const std::string& table,
                         const int64_t maxRows) override;
 
+        void enableRowHash(const std::string& table) override;
+
+        void enableChecksumIndex(const std::string& table) override;
+
+        nlohmann::json getRangeChecksum(const std::string& table,
+                                        const nlohmann::json& begin,
+                                        const nlohmann::json& end) override;
+
         void initializeStatusField(const nlohmann::json& tableNames) override;
 
         void deleteRowsByStatusField(const nlohmann::json& tableNames) override;
@@ -155,11 +269,23 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                         const DbSync::ResultCallback& callback,
                         std::unique_lock<std::shared_timed_mutex>& lock) override;
 
+        std::unique_ptr<DbSync::IDbCursor> openCursor(const std::string& table,
+                                                      const nlohmann::json& query) override;
+
+        std::unique_ptr<DbSync::IDbCursor> openDeletedRowsCursor(const std::string& table) override;
+
         void deleteTableRowsData(const std::string& table,
-                                 const nlohmann::json& jsDeletionData) override;
+                                 const nlohmann::json& jsDeletionData,
+                                 const DbSync::ResultCallback callback,
+                                 std::unique_lock<std::shared_timed_mutex>& lock) override;
+
+        void keepTableRowsData(const std::string& table,
+                               const nlohmann::json& jsKeepData) override;
 
         void addTableRelationship(const nlohmann::json& data) override;
 
+        nlohmann::json getStatementCacheStats() override;
+
     private:
         void initialize(const std::string&              path,
                         const std::string&              tableStmtCreation,
@@ -210,6 +336,168 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                         nlohmann::json& updatedData,
                         nlohmann::json& oldData);
 
+        void compareRowData(const std::vector<std::string>& primaryKeyList,
+                            const nlohmann::json& ignoredColumns,
+                            const nlohmann::json& data,
+                            const Row& registryFields,
+                            nlohmann::json& updatedData,
+                            nlohmann::json& oldData);
+
+        void bindPrimaryKeyData(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                const TableColumns& tableFields,
+                                const std::vector<std::string>& primaryKeyList,
+                                const nlohmann::json& data);
+
+        bool hasRowHash(const std::string& table);
+
+        static std::optional<int64_t> getRowHash(const TableColumns& tableFields,
+                                                 const nlohmann::json& data);
+
+        bool getRowHashDiff(const std::vector<std::string>& primaryKeyList,
+                            const nlohmann::json& ignoredColumns,
+                            const std::string& table,
+                            const nlohmann::json& data,
+                            const std::optional<int64_t>& rowHash,
+                            const bool returnOldData,
+                            nlohmann::json& updatedData,
+                            nlohmann::json& oldData,
+                            bool& hashOutdated);
+
+        bool compareRowHash(const std::vector<std::string>& primaryKeyList,
+                            const nlohmann::json& ignoredColumns,
+                            const std::string& table,
+                            const nlohmann::json& data,
+                            const std::optional<int64_t>& storedHash,
+                            const std::optional<int64_t>& rowHash,
+                            const bool returnOldData,
+                            nlohmann::json& updatedData,
+                            nlohmann::json& oldData);
+
+        void updateRowHash(const std::string& table,
+                           const std::vector<std::string>& primaryKeyList,
+                           const nlohmann::json& data,
+                           const int64_t rowHash);
+
+        std::string buildSelectRowHashQuery(const std::string& table,
+                                            const std::vector<std::string>& primaryKeyList);
+
+        std::string buildRowHashTrigger(const std::string& table,
+                                        const std::vector<std::string>& primaryKeyList);
+
+        std::string buildChecksumFunctionCall(const std::string& table,
+                                              const TableColumns& columns,
+                                              const std::string& prefix,
+                                              const bool upsert);
+
+        std::string buildChecksumTriggers(const std::string& table,
+                                          const TableColumns& columns);
+
+        void loadChecksumIndex(const std::string& table);
+
+        static DbSync::Value getChecksumValue(sqlite3_value* value,
+                                              const ColumnData& cd);
+
+        static void checksumIndexFunction(sqlite3_context* context,
+                                          int argc,
+                                          sqlite3_value** argv);
+
+        static void checksumIndexRollback(void* data);
+
+        void registerChecksumFunction();
+
+        // Marks the checksum indexes stale when the engine call it guards throws. SQLite undoes the changes of
+        // the failing statement, while the triggers already applied them to the indexes.
+        class ChecksumIndexGuard final
+        {
+            public:
+                explicit ChecksumIndexGuard(SQLiteDBEngine& engine)
+                    : m_engine { engine }
+                    , m_exceptions { std::uncaught_exceptions() }
+                {
+                }
+
+                ~ChecksumIndexGuard()
+                {
+                    if (std::uncaught_exceptions() > m_exceptions)
+                    {
+                        checksumIndexRollback(&m_engine);
+                    }
+                }
+
+                ChecksumIndexGuard(const ChecksumIndexGuard&) = delete;
+                ChecksumIndexGuard& operator=(const ChecksumIndexGuard&) = delete;
+
+            private:
+                SQLiteDBEngine& m_engine;
+                const int m_exceptions;
+        };
+
+        static int statementTrace(unsigned int type,
+                                  void* data,
+                                  void* stmt,
+                                  void* sql);
+
+        bool syncTableRowDataBulk(const std::string& table,
+                                  const nlohmann::json& data,
+                                  const std::vector<std::string>& primaryKeyList,
+                                  const nlohmann::json& ignoredColumns,
+                                  const DbSync::ResultCallback callback,
+                                  const bool inTransaction,
+                                  const bool returnOldData,
+                                  Utils::ILocking& lock);
+
+        void bindRowValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                          const ColumnData& cd,
+                          const DbSync::Value& value,
+                          const int32_t index);
+
+        static DbSync::Value getRowValue(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                         const ColumnData& cd);
+
+        std::string buildInsertRowValuesQuery(const std::string& table,
+                                              const TableColumns& columns);
+
+        std::string buildUpdateRowValuesQuery(const std::string& table,
+                                              const TableColumns& columns,
+                                              const std::vector<std::string>& primaryKeyList);
+
+        bool getBulkColumns(const std::string& table,
+                            const nlohmann::json& data,
+                            const std::vector<std::string>& primaryKeyList,
+                            TableColumns& bulkColumns);
+
+        static bool isExactJsonData(const ColumnData& cd,
+                                    const nlohmann::json& row);
+
+        bool loadBulkTable(const std::string& table,
+                           const TableColumns& bulkColumns,
+                           const std::vector<std::string>& primaryKeyList,
+                           const nlohmann::json& data,
+                           const std::vector<std::optional<int64_t>>& rowHashes);
+
+        std::string buildCreateBulkTableQuery(const std::string& table,
+                                              const std::vector<std::string>& primaryKeyList);
+
+        std::string buildBulkInsertQuery(const std::string& table,
+                                         const TableColumns& bulkColumns,
+                                         const size_t rows);
+
+        std::string buildBulkMatchQuery(const std::string& table,
+                                        const TableColumns& tableFields,
+                                        const TableColumns& compareColumns,
+                                        const std::vector<std::string>& primaryKeyList);
+
+        std::string buildBulkStatusQuery(const std::string& table,
+                                         const std::vector<std::string>& primaryKeyList);
+
+        std::string buildBulkUpdateQuery(const std::string& table,
+                                         const TableColumns& bulkColumns,
+                                         const std::vector<std::string>& primaryKeyList);
+
+        std::string buildBulkInsertNewRowsQuery(const std::string& table,
+                                                const TableColumns& bulkColumns,
+                                                const std::vector<std::string>& primaryKeyList);
+
         bool insertNewRows(const std::string& table,
                            const std::vector<std::string>& primaryKeyList,
                            const DbSync::ResultCallback callback,
@@ -224,7 +512,12 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                         const std::vector<std::string>& primaryKeyList);
 
         void deleteRowsbyPK(const std::string& table,
-                            const nlohmann::json& data);
+                            const nlohmann::json& data,
+                            std::vector<nlohmann::json>* deletedRows);
+
+        nlohmann::json getStoredRow(const std::shared_ptr<SQLiteLegacy::IStatement> stmt,
+                                    const TableColumns& tableFields,
+                                    const bool allColumns);
 
         void getTableData(std::shared_ptr<SQLiteLegacy::IStatement>const stmt,
                           const int32_t index,
@@ -301,6 +594,21 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         std::shared_ptr<SQLiteLegacy::IStatement>const getStatement(const std::string& sql);
 
+        std::shared_ptr<SQLiteLegacy::IStatement>const getStatement(const QueryId& id,
+                                                                    const std::function<std::string()>& buildQuery);
+
+        static QueryId getColumnsQueryId(const QueryKind kind,
+                                         const std::string& table,
+                                         const TableColumns& tableFields,
+                                         const nlohmann::json& data,
+                                         const uint64_t rows = 0ull);
+
+        static QueryId getColumnsQueryId(const QueryKind kind,
+                                         const std::string& table,
+                                         const TableColumns& tableFields,
+                                         const TableColumns& columns,
+                                         const uint64_t rows = 0ull);
+
         std::string getSelectAllQuery(const std::string& table,
                                       const TableColumns& tableFields) const;
 
@@ -320,13 +628,25 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                            const std::function<void()> callback = {});
 
         Utils::MapWrapperSafe<std::string, TableColumns> m_tableFields;
-        std::deque<std::pair<std::string, std::shared_ptr<SQLiteLegacy::IStatement>>> m_statementsCache;
+        // Most recently used first, indexed by their id.
+        std::list<StatementCacheEntry> m_statementsCache;
+        std::unordered_map<QueryId, std::list<StatementCacheEntry>::iterator, QueryIdHash> m_statementsIndex;
+        uint64_t m_statementsCacheHits { 0ull };
+        uint64_t m_statementsCacheMisses { 0ull };
+        uint64_t m_statementsCacheEvictions { 0ull };
+        std::atomic<uint64_t> m_statementsExecuted { 0ull };
+        bool m_statementsTraced { false };
         const std::shared_ptr<ISQLiteFactory> m_sqliteFactory;
         std::shared_ptr<SQLiteLegacy::IConnection> m_sqliteConnection;
         std::mutex m_stmtMutex;
         std::unique_ptr<SQLiteLegacy::ITransaction> m_transaction;
         std::mutex m_maxRowsMutex;
         std::map<std::string, MaxRows> m_maxRows;
+        std::mutex m_bulkMutex;
+        std::mutex m_checksumMutex;
+        std::map<std::string, ChecksumTable> m_checksumIndexes;
+        bool m_checksumStale { false };
+        bool m_checksumRegistered { false };
 };
 
 #endif // _SQLITE_DBENGINE_H
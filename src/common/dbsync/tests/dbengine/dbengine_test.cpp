@@ -639,10 +639,12 @@ TEST_F(DBEngineTest, syncTableRowDataWithoutMetadataShouldThrow)
 TEST_F(DBEngineTest, deleteTableRowsDataWithoutMetadataShouldThrow)
 {
     std::unique_ptr<SQLiteDBEngine> spEngine;
+    std::shared_timed_mutex mutex;
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
     initNoMetaDataMocks(spEngine);
 
     // Due to the no metadata this should throw
-    EXPECT_THROW(spEngine->deleteTableRowsData("dummy", {}), dbengine_error);
+    EXPECT_THROW(spEngine->deleteTableRowsData("dummy", {}, nullptr, lock), dbengine_error);
 }
 
 TEST_F(DBEngineTest, selectDataWithoutMetadataShouldThrow)
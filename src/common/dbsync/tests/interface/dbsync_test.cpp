@@ -2434,3 +2434,957 @@ TEST_F(DBSyncTest, TestUpgrade)
 
     EXPECT_NO_THROW(dbSync->selectRows(selectQuery.query(), selectCallbackData));
 }
+
+static std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> syncRowsScenario(const bool bulkSync,
+                                                                                    const bool rowHash = false,
+                                                                                    const DbEngineType dbEngine = DbEngineType::SQLITE3)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, `active` INTEGER, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table": "processes"})" };
+    std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+    DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+
+    if (rowHash)
+    {
+        dbSync.enableTableRowHash("processes");
+    }
+
+    ResultCallbackData callbackData
+    {
+        [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            results.emplace_back(type, jsonResult);
+        }
+    };
+
+    const auto buildQuery
+    {
+        [bulkSync](const int first, const int last, const std::function<void(const int, nlohmann::json&)>& change)
+        {
+            auto query { SyncRowQuery::builder().table("processes") };
+
+            for (auto pid = first; pid < last; ++pid)
+            {
+                // A boolean on an INTEGER column is always reported as modified
+                nlohmann::json row {{"pid", pid}, {"name", "proc" + std::to_string(pid)}, {"tid", pid}, {"active", pid % 2 ? nlohmann::json(true) : nlohmann::json(1)}};
+                change(pid, row);
+                query.data(row);
+            }
+
+            if (!bulkSync)
+            {
+                query.disableBulkSync();
+            }
+
+            return query;
+        }
+    };
+
+    const auto noChange { [](const int, nlohmann::json&) {} };
+
+    // Inserts
+    dbSync.syncRow(buildQuery(0, 64, noChange).query(), callbackData);
+
+    // Changes on the name and on the ignored tid column
+    dbSync.syncRow(buildQuery(0, 64, [](const int pid, nlohmann::json & row)
+    {
+        if (0 == pid % 4)
+        {
+            row["name"] = "renamed";
+        }
+        else if (1 == pid % 4)
+        {
+            row["tid"] = pid + 1000;
+        }
+    }).ignoreColumn("tid").returnOldData().query(), callbackData);
+
+    // Repeated keys are diffed row by row
+    dbSync.syncRow(buildQuery(60, 100, [](const int pid, nlohmann::json & row)
+    {
+        row["pid"] = 50 + pid % 20;
+    }).query(), callbackData);
+
+    {
+        DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(tables), 0, 0, callbackData };
+        dbSyncTxn.syncTxnRow(buildQuery(16, 80, [](const int pid, nlohmann::json & row)
+        {
+            row["tid"] = 0 == pid % 3 ? pid + 2000 : pid;
+        }).query());
+        dbSyncTxn.getDeletedRows(callbackData);
+    }
+
+    dbSync.selectRows(SelectQuery::builder()
+                      .table("processes")
+                      .columnList({"pid", "name", "tid", "active"})
+                      .orderByOpt("pid")
+                      .distinctOpt(false)
+                      .countOpt(1000)
+                      .build()
+                      .query(), callbackData);
+
+    return results;
+}
+
+TEST_F(DBSyncTest, syncRowBulkSameResultsAsRowByRowCPP)
+{
+    const auto rowByRow { syncRowsScenario(false) };
+    const auto bulk { syncRowsScenario(true) };
+
+    EXPECT_EQ(64, std::count_if(bulk.begin(), bulk.end(), [](const auto & result)
+    {
+        return SELECTED == result.first;
+    }));
+    EXPECT_EQ(16, std::count_if(bulk.begin(), bulk.end(), [](const auto & result)
+    {
+        return DELETED == result.first;
+    }));
+    EXPECT_EQ(rowByRow, bulk);
+}
+
+TEST_F(DBSyncTest, syncRowHashBulkSameResultsAsRowByRowCPP)
+{
+    const auto countModified
+    {
+        [](const std::vector<std::pair<ReturnTypeCallback, nlohmann::json>>& results)
+        {
+            return std::count_if(results.begin(), results.end(), [](const auto & result)
+            {
+                return MODIFIED == result.first;
+            });
+        }
+    };
+
+    const auto rowByRow { syncRowsScenario(false, true) };
+    const auto bulk { syncRowsScenario(true, true) };
+
+    EXPECT_EQ(rowByRow, bulk);
+    // The booleans stored on the INTEGER column keep their hash, so they aren't reported as modified.
+    EXPECT_LT(countModified(bulk), countModified(syncRowsScenario(true)));
+}
+
+TEST_F(DBSyncTest, syncRowBulkCollationCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT COLLATE NOCASE, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto syncRows
+    {
+        [&sql](const bool bulkSync)
+        {
+            std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+            DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_MEMORY, sql };
+            ResultCallbackData callbackData
+            {
+                [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+                {
+                    results.emplace_back(type, jsonResult);
+                }
+            };
+
+            for (const auto& name : { "proc", "PROC" })
+            {
+                auto query { SyncRowQuery::builder().table("processes") };
+
+                for (auto pid = 0; pid < 40; ++pid)
+                {
+                    query.data({{"pid", pid}, {"name", pid % 8 ? "proc" : name}});
+                }
+
+                if (!bulkSync)
+                {
+                    query.disableBulkSync();
+                }
+
+                dbSync.syncRow(query.query(), callbackData);
+            }
+
+            return results;
+        }
+    };
+
+    const auto bulk { syncRows(true) };
+
+    // The case changes are reported although the column ignores the case.
+    EXPECT_EQ(5, std::count_if(bulk.begin(), bulk.end(), [](const auto & result)
+    {
+        return MODIFIED == result.first;
+    }));
+    EXPECT_EQ(syncRows(false), bulk);
+}
+
+TEST_F(DBSyncTest, syncRowHashCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"Test","tid":101}]})"};
+    const auto updateSqlStmt1{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":100},{"pid":5,"name":"Test2","tid":101}],"options":{"return_old_data":true}})"};
+    const auto updateSqlStmt2{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":102},{"pid":5,"name":"Test2","tid":101}]})"};
+    const auto snapshotSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"Other","tid":102},{"pid":5,"name":"Test2","tid":101}]})"};
+    const auto selectSqlStmt{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"pid","count_opt":100}})"};
+
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+
+    EXPECT_ANY_THROW(dbSync.enableTableRowHash("dummy"));
+    EXPECT_NO_THROW(dbSync.enableTableRowHash("processes"));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":100})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"pid":5,"name":"Test","tid":101})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"old":{"pid":5,"name":"Test"},"new":{"pid":5,"name":"Test2","tid":101}})"))).Times(1);
+    // Once for the tid change, and once more after the snapshot changed the name without the hash.
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":102})"))).Times(2);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","tid":102})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"Test2","tid":101})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(updateSqlStmt1), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(updateSqlStmt2), callbackData));
+
+    nlohmann::json snapshotResponse;
+    EXPECT_NO_THROW(dbSync.updateWithSnapshot(nlohmann::json::parse(snapshotSqlStmt), snapshotResponse));
+
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(updateSqlStmt2), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(updateSqlStmt2), callbackData));
+    EXPECT_NO_THROW(dbSync.selectRows(nlohmann::json::parse(selectSqlStmt), callbackData));
+}
+
+TEST_F(DBSyncTest, syncRowHashColumnSubsetCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto fullRowStmt{ R"({"table":"processes","data":[{"pid":4,"name":"A","tid":1}]})"};
+    const auto partialRowStmt{ R"({"table":"processes","data":[{"pid":4,"name":"A"}]})"};
+    const auto partialChangeStmt{ R"({"table":"processes","data":[{"pid":4,"tid":2}]})"};
+
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+    dbSync.enableTableRowHash("processes");
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(fullRowStmt).at("data").at(0))).Times(1);
+    // The rows are only reported when they change, whatever columns the previous syncs received.
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"pid":4,"tid":2})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(fullRowStmt).at("data").at(0))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(fullRowStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(partialRowStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(fullRowStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(partialChangeStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(fullRowStmt), callbackData));
+    EXPECT_NO_THROW(dbSync.syncRow(nlohmann::json::parse(fullRowStmt), callbackData));
+}
+
+TEST_F(DBSyncTest, statementCacheStatsCPP)
+{
+    std::string sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+
+    for (auto i = 0; i < 40; ++i)
+    {
+        sql.append("CREATE TABLE table" + std::to_string(i) + "(`id` BIGINT, PRIMARY KEY (`id`)) WITHOUT ROWID;");
+    }
+
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System"}]})"};
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+    ResultCallbackData callbackData
+    {
+        [](ReturnTypeCallback, const nlohmann::json&) {}
+    };
+
+    dbSync.syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData);
+    const auto first = dbSync.getStatementCacheStats();
+
+    EXPECT_LT(0u, first.at("misses").get<uint64_t>());
+    EXPECT_LE(first.at("size").get<uint64_t>(), first.at("capacity").get<uint64_t>());
+
+    // The statements of the synced table are kept while the one-off ones are evicted.
+    for (auto i = 0; i < 40; ++i)
+    {
+        dbSync.setTableMaxRow("table" + std::to_string(i), 10);
+        dbSync.syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData);
+    }
+
+    const auto before = dbSync.getStatementCacheStats();
+    dbSync.syncRow(nlohmann::json::parse(insertionSqlStmt), callbackData);
+    const auto after = dbSync.getStatementCacheStats();
+
+    EXPECT_EQ(first.at("misses").get<uint64_t>() + 40, before.at("misses").get<uint64_t>());
+    EXPECT_LT(0u, before.at("evictions").get<uint64_t>());
+    EXPECT_EQ(before.at("capacity"), before.at("size"));
+    EXPECT_EQ(before.at("misses"), after.at("misses"));
+    EXPECT_LT(before.at("hits").get<uint64_t>(), after.at("hits").get<uint64_t>());
+
+    // The statements are counted from the first request on.
+    EXPECT_EQ(0u, first.at("executed").get<uint64_t>());
+    EXPECT_LT(first.at("executed").get<uint64_t>(), before.at("executed").get<uint64_t>());
+    EXPECT_LT(before.at("executed").get<uint64_t>(), after.at("executed").get<uint64_t>());
+}
+
+TEST_F(DBSyncTest, syncRowTypedCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, `size` UNSIGNED BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto selectSqlStmt{ R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"pid","count_opt":100}})"};
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+    std::vector<std::tuple<ReturnTypeCallback, DbSync::RowValues, DbSync::RowValues>> results;
+    const DbSync::RowCallback callback
+    {
+        [&results](ReturnTypeCallback type, const DbSync::RowValues & row, const DbSync::RowValues & oldRow)
+        {
+            results.emplace_back(type, row, oldRow);
+        }
+    };
+
+    // The columns are bound by position, in any order and with a subset of the table columns.
+    DbSync::RowBatch rows { "processes", { "name", "pid", "size" }, {}, false, {} };
+    rows.rows.push_back({ std::string { "System" }, int64_t { 4 }, uint64_t { 1024 } });
+    rows.rows.push_back({ std::string { "Test" }, int64_t { 5 }, DbSync::Value {} });
+
+    EXPECT_NO_THROW(dbSync.syncRow(rows, callback));
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(INSERTED, std::get<0>(results[0]));
+    EXPECT_EQ(rows.rows[0], std::get<1>(results[0]));
+    EXPECT_TRUE(std::get<2>(results[0]).empty());
+
+    // Unchanged rows aren't reported, numbers are compared by value.
+    results.clear();
+    rows.rows[0][2] = int64_t { 1024 };
+    EXPECT_NO_THROW(dbSync.syncRow(rows, callback));
+    EXPECT_TRUE(results.empty());
+
+    rows.returnOldData = true;
+    rows.rows[1][0] = std::string { "Test2" };
+    EXPECT_NO_THROW(dbSync.syncRow(rows, callback));
+    ASSERT_EQ(1u, results.size());
+    EXPECT_EQ(MODIFIED, std::get<0>(results[0]));
+    EXPECT_EQ(rows.rows[1], std::get<1>(results[0]));
+    EXPECT_EQ((DbSync::RowValues { std::string { "Test" }, int64_t { 5 }, DbSync::Value {} }), std::get<2>(results[0]));
+
+    // Changes in the ignored columns are not reported.
+    results.clear();
+    rows.ignore = { "size" };
+    rows.rows[0][2] = uint64_t { 2048 };
+    EXPECT_NO_THROW(dbSync.syncRow(rows, callback));
+    EXPECT_TRUE(results.empty());
+
+    // The JSON API sees the same rows.
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":4,"name":"System","size":1024})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"pid":5,"name":"Test2"})"))).Times(1);
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+    EXPECT_NO_THROW(dbSync.selectRows(nlohmann::json::parse(selectSqlStmt), callbackData));
+
+    DbSync::RowBatch invalidColumn { "processes", { "pid", "dummy" }, { { int64_t { 4 }, int64_t { 1 } } }, false, {} };
+    EXPECT_ANY_THROW(dbSync.syncRow(invalidColumn, callback));
+    DbSync::RowBatch missingPK { "processes", { "name" }, { { std::string { "System" } } }, false, {} };
+    EXPECT_ANY_THROW(dbSync.syncRow(missingPK, callback));
+    DbSync::RowBatch invalidRow { "processes", { "pid", "name" }, { { int64_t { 4 } } }, false, {} };
+    EXPECT_ANY_THROW(dbSync.syncRow(invalidRow, callback));
+}
+
+TEST_F(DBSyncTest, syncTxnRowTypedCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table": "processes"})" };
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+    std::vector<std::pair<ReturnTypeCallback, DbSync::RowValues>> results;
+    const DbSync::RowCallback callback
+    {
+        [&results](ReturnTypeCallback type, const DbSync::RowValues & row, const DbSync::RowValues&)
+        {
+            results.emplace_back(type, row);
+        }
+    };
+    const DbSync::RowBatch rows
+    {
+        "processes", { "pid", "name" }, { { int64_t { 4 }, std::string { "System" } }, { int64_t { 5 }, std::string { "Test" } } }, false, {}
+    };
+
+    EXPECT_NO_THROW(dbSync.syncRow(rows, callback));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":5,"name":"Test"})"))).Times(1);
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    results.clear();
+    DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(tables), 0, 100, callbackData };
+    const DbSync::RowBatch txnRows
+    {
+        "processes", { "pid", "name" }, { { int64_t { 4 }, std::string { "System" } }, { int64_t { 6 }, std::string { "New" } } }, false, {}
+    };
+    EXPECT_NO_THROW(dbSyncTxn.syncTxnRow(txnRows, callback));
+
+    // The results are reported before returning, the unchanged row only keeps its status.
+    ASSERT_EQ(1u, results.size());
+    EXPECT_EQ(INSERTED, results[0].first);
+    EXPECT_EQ(txnRows.rows[1], results[0].second);
+
+    const DbSync::RowBatch otherTable { "dummy", { "pid" }, { { int64_t { 4 } } }, false, {} };
+    EXPECT_ANY_THROW(dbSyncTxn.syncTxnRow(otherTable, callback));
+
+    EXPECT_NO_THROW(dbSyncTxn.getDeletedRows(callbackData));
+}
+
+TEST_F(DBSyncTest, rowAdaptorCPP)
+{
+    struct Process
+    {
+        int32_t pid;
+        std::string name;
+        std::optional<uint64_t> size;
+        double cpu;
+    };
+
+    const auto adaptor
+    {
+        DbSync::RowAdaptor<Process> { "processes" }
+        .column("pid", &Process::pid)
+        .column("name", &Process::name)
+        .column("size", &Process::size)
+        .column("cpu", &Process::cpu)
+    };
+    const auto batch { adaptor.batch({ { 4, "System", 1024, 0.5 }, { 5, "Test", std::nullopt, 0 } }) };
+
+    EXPECT_EQ("processes", batch.table);
+    EXPECT_EQ((std::vector<std::string> { "pid", "name", "size", "cpu" }), batch.columns);
+    ASSERT_EQ(2u, batch.rows.size());
+    EXPECT_EQ((DbSync::RowValues { int64_t { 4 }, std::string { "System" }, uint64_t { 1024 }, 0.5 }), batch.rows[0]);
+    EXPECT_EQ((DbSync::RowValues { int64_t { 5 }, std::string { "Test" }, DbSync::Value {}, 0.0 }), batch.rows[1]);
+
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `size` UNSIGNED BIGINT, `cpu` DOUBLE, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql };
+    std::vector<Process> inserted;
+
+    EXPECT_NO_THROW(dbSync.syncRow(batch, [&](ReturnTypeCallback, const DbSync::RowValues & row, const DbSync::RowValues&)
+    {
+        inserted.push_back(adaptor.item(row));
+    }));
+
+    ASSERT_EQ(2u, inserted.size());
+    EXPECT_EQ(4, inserted[0].pid);
+    EXPECT_EQ("System", inserted[0].name);
+    EXPECT_EQ(1024u, inserted[0].size);
+    EXPECT_DOUBLE_EQ(0.5, inserted[0].cpu);
+    EXPECT_FALSE(inserted[1].size.has_value());
+}
+
+TEST_F(DBSyncTest, memoryEngineSameResultsAsSQLiteCPP)
+{
+    EXPECT_EQ(syncRowsScenario(false), syncRowsScenario(false, false, DbEngineType::MEMORY));
+    EXPECT_EQ(syncRowsScenario(true), syncRowsScenario(true, false, DbEngineType::MEMORY));
+}
+
+static std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> snapshotScenario(const DbEngineType dbEngine)
+{
+    const auto sql
+    {
+        "CREATE TABLE IF NOT EXISTS packages(`name` TEXT, `version` TEXT, `size` UNSIGNED BIGINT, `priority` DOUBLE, `arch` TEXT,"
+        " PRIMARY KEY (`name`)) WITHOUT ROWID;"
+        "CREATE INDEX packages_name ON packages(name);"
+    };
+    std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+    DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+    ResultCallbackData callbackData
+    {
+        [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            results.emplace_back(type, jsonResult);
+        }
+    };
+
+    dbSync.insertData(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"a","version":"1","size":10,"priority":0.5,"arch":"x86"},
+                                                {"name":"b","version":"1","size":20,"arch":"x86"},
+                                                {"name":"c","version":"2","size":30,"priority":1.5}]})"));
+    dbSync.updateWithSnapshot(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"a","version":"1","size":11,"priority":0.5,"arch":"x86"},
+                                                       {"name":"c","version":"2","size":30,"priority":2.5,"arch":"arm"},
+                                                       {"name":"d","version":"3","size":"40"}]})"), callbackData);
+    dbSync.deleteRows(nlohmann::json::parse(R"({"table":"packages","query":{"data":[{"name":"d"},{"name":"e"}]}})"));
+    dbSync.selectRows(SelectQuery::builder()
+                      .table("packages")
+                      .columnList({"*"})
+                      .rowFilter("")
+                      .orderByOpt("size DESC, name")
+                      .distinctOpt(false)
+                      .countOpt(10)
+                      .build()
+                      .query(), callbackData);
+    dbSync.selectRows(SelectQuery::builder()
+                      .table("packages")
+                      .columnList({"version"})
+                      .rowFilter("")
+                      .orderByOpt("")
+                      .distinctOpt(true)
+                      .countOpt(10)
+                      .build()
+                      .query(), callbackData);
+
+    return results;
+}
+
+TEST_F(DBSyncTest, memoryEngineSnapshotCPP)
+{
+    const auto results { snapshotScenario(DbEngineType::MEMORY) };
+
+    ASSERT_EQ(8u, results.size());
+    EXPECT_EQ(DELETED, results[0].first);
+    EXPECT_EQ(nlohmann::json::parse(R"({"name":"b"})"), results[0].second);
+    EXPECT_EQ(MODIFIED, results[1].first);
+    EXPECT_EQ(nlohmann::json::parse(R"({"PK_name":"a","size":11})"), results[1].second);
+    EXPECT_EQ(MODIFIED, results[2].first);
+    EXPECT_EQ(nlohmann::json::parse(R"({"PK_name":"c","priority":2.5})"), results[2].second);
+    EXPECT_EQ(INSERTED, results[3].first);
+    EXPECT_EQ(nlohmann::json::parse(R"({"name":"d","version":"3","size":40,"priority":null,"arch":null})"), results[3].second);
+    EXPECT_EQ(SELECTED, results[4].first);
+    EXPECT_EQ(nlohmann::json::parse(R"({"name":"c","version":"2","size":30,"priority":2.5})"), results[4].second);
+    EXPECT_EQ(snapshotScenario(DbEngineType::SQLITE3), results);
+}
+
+TEST_F(DBSyncTest, memoryEngineTxnCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT PRIMARY KEY, `name` TEXT, `tid` BIGINT);"};
+    const auto tables { R"({"table": "processes"})" };
+    DBSync dbSync { HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, sql };
+    std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+    ResultCallbackData callbackData
+    {
+        [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            results.emplace_back(type, jsonResult);
+        }
+    };
+
+    dbSync.syncRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":5,"name":"Test","tid":1},{"pid":6}]})"),
+                   callbackData);
+    results.clear();
+
+    {
+        DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(tables), 0, 0, callbackData };
+        dbSyncTxn.syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":7,"name":"New"}]})"));
+        dbSyncTxn.syncTxnRow(DbSync::RowBatch { "processes", { "pid", "tid" }, { { int64_t { 6 }, int64_t { 2 } } }, false, {} },
+                             [&results](ReturnTypeCallback type, const DbSync::RowValues&, const DbSync::RowValues&)
+        {
+            results.emplace_back(type, nullptr);
+        });
+        dbSyncTxn.getDeletedRows(callbackData);
+    }
+
+    ASSERT_EQ(3u, results.size());
+    EXPECT_EQ(std::make_pair(INSERTED, nlohmann::json::parse(R"({"pid":7,"name":"New"})")), results[0]);
+    EXPECT_EQ(MODIFIED, results[1].first);
+    EXPECT_EQ(std::make_pair(DELETED, nlohmann::json::parse(R"({"pid":5,"name":"Test","tid":1})")), results[2]);
+
+    results.clear();
+    dbSync.selectRows(SelectQuery::builder()
+                      .table("processes")
+                      .columnList({"pid", "tid"})
+                      .rowFilter("")
+                      .orderByOpt("pid DESC")
+                      .distinctOpt(false)
+                      .countOpt(2)
+                      .build()
+                      .query(), callbackData);
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(nlohmann::json::parse(R"({"pid":7})"), results[0].second);
+    EXPECT_EQ(nlohmann::json::parse(R"({"pid":6,"tid":2})"), results[1].second);
+}
+
+TEST_F(DBSyncTest, memoryEngineLimitsCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System"}, {"pid":3,"name":"cmd"}]})"};
+    DBSync dbSync { HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, sql };
+
+    EXPECT_NO_THROW(dbSync.insertData(nlohmann::json::parse(insertionSqlStmt)));
+    EXPECT_THROW(dbSync.insertData(nlohmann::json::parse(insertionSqlStmt)), DbSync::dbsync_error);
+    EXPECT_ANY_THROW(dbSync.setTableMaxRow("processes", -1));
+    EXPECT_NO_THROW(dbSync.setTableMaxRow("processes", 3));
+    EXPECT_NO_THROW(dbSync.insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":5}]})")));
+    EXPECT_THROW(dbSync.insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":6}]})")), DbSync::max_rows_error);
+    EXPECT_NO_THROW(dbSync.setTableMaxRow("processes", 0));
+    EXPECT_NO_THROW(dbSync.insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":6}]})")));
+
+    // Rows of composite keys only match when every key column does.
+    const auto compositeSql{ "CREATE TABLE ports(`port` BIGINT, `protocol` TEXT, `pid` BIGINT, PRIMARY KEY (`port`, `protocol`)) WITHOUT ROWID;"};
+    DBSync ports { HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, compositeSql };
+    size_t inserted { 0 };
+    ResultCallbackData countCallback
+    {
+        [&inserted](ReturnTypeCallback type, const nlohmann::json&)
+        {
+            inserted += INSERTED == type ? 1 : 0;
+        }
+    };
+    const auto portsData = nlohmann::json::parse(R"({"table":"ports","data":[{"port":53,"protocol":"udp","pid":1},{"port":53,"protocol":"tcp","pid":1}]})");
+    EXPECT_NO_THROW(ports.syncRow(portsData, countCallback));
+    EXPECT_NO_THROW(ports.syncRow(portsData, countCallback));
+    EXPECT_EQ(2u, inserted);
+
+    // Only the whole first word of a definition is taken as a constraint keyword.
+    const auto keywordSql{ "CREATE TABLE files(`path` TEXT, checksum TEXT, CHECK (path <> ''), PRIMARY KEY (`path`)) WITHOUT ROWID;"};
+    DBSync files { HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, keywordSql };
+    EXPECT_NO_THROW(files.insertData(nlohmann::json::parse(R"({"table":"files","data":[{"path":"/etc/hosts","checksum":"abc"}]})")));
+    std::vector<nlohmann::json> selected;
+    EXPECT_NO_THROW(files.selectRows(nlohmann::json::parse(R"({"table":"files","query":{"column_list":["checksum"],"row_filter":""}})"),
+                                     [&selected](ReturnTypeCallback, const nlohmann::json & json)
+    {
+        selected.push_back(json);
+    }));
+    ASSERT_EQ(1u, selected.size());
+    EXPECT_EQ(nlohmann::json::parse(R"({"checksum":"abc"})"), selected[0]);
+
+    // SQL filters, expressions and triggers need the SQLite engine.
+    const auto deleteFilter = nlohmann::json::parse(R"({"table":"processes","query":{"where_filter_opt":"pid=4"}})");
+    const auto selectFilter = nlohmann::json::parse(R"({"table":"processes","query":{"column_list":["*"],"row_filter":"WHERE pid=4"}})");
+    const auto selectCount = nlohmann::json::parse("{\"table\":\"processes\",\"query\":{\"column_list\":[\"count(*)\"],\"row_filter\":\"\"}}");
+    const auto relationship = nlohmann::json::parse(R"({"base_table":"processes","relationed_tables":[]})");
+    const auto unknownTable = nlohmann::json::parse(R"({"table":"dummy","data":[{"pid":6}]})");
+
+    EXPECT_THROW(dbSync.deleteRows(deleteFilter), DbSync::dbsync_error);
+    EXPECT_THROW(dbSync.selectRows(selectFilter, nullptr), DbSync::dbsync_error);
+    EXPECT_THROW(dbSync.selectRows(selectCount, nullptr), DbSync::dbsync_error);
+    EXPECT_THROW(dbSync.addTableRelationship(relationship), DbSync::dbsync_error);
+    EXPECT_THROW(dbSync.insertData(unknownTable), DbSync::dbsync_error);
+
+    // Only volatile databases of known tables with primary keys are supported.
+    const auto noPKSql { "CREATE TABLE processes(`pid` BIGINT, `name` TEXT);" };
+    const auto viewSql { "CREATE VIEW processes AS SELECT 1;" };
+    EXPECT_ANY_THROW(DBSync(HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, noPKSql));
+    EXPECT_ANY_THROW(DBSync(HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, viewSql));
+    EXPECT_ANY_THROW(DBSync(HostType::AGENT, DbEngineType::MEMORY, DATABASE_MEMORY, sql, DbManagement::PERSISTENT));
+}
+
+static std::vector<nlohmann::json> checksumScenario(const DbEngineType dbEngine)
+{
+    const auto sql{ "CREATE TABLE packages(`name` TEXT, `version` TEXT, `size` UNSIGNED BIGINT, PRIMARY KEY (`name`)) WITHOUT ROWID;"};
+    DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+    std::vector<nlohmann::json> results;
+    ResultCallbackData callbackData
+    {
+        [](ReturnTypeCallback, const nlohmann::json&) {}
+    };
+
+    dbSync.insertData(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"a","version":"1","size":10},{"name":"b","version":"1"},
+                                                {"name":"c","version":"2","size":18446744073709551615}]})"));
+    dbSync.enableTableChecksumIndex("packages");
+    results.push_back(dbSync.getRangeChecksum("packages"));
+
+    dbSync.syncRow(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"b","version":"2"},{"name":"d","version":"3","size":40}]})"),
+                   callbackData);
+    results.push_back(dbSync.getRangeChecksum("packages"));
+    results.push_back(dbSync.getRangeChecksum("packages", "b", "c"));
+    results.push_back(dbSync.getRangeChecksum("packages", nlohmann::json::parse(R"({"name":"d"})")));
+    results.push_back(dbSync.getRangeChecksum("packages", nullptr, "a"));
+    results.push_back(dbSync.getRangeChecksum("packages", "e"));
+
+    {
+        // The rows left out of the transaction are deleted by the status field.
+        DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(R"({"table":"packages"})"), 0, 0, callbackData };
+        dbSyncTxn.syncTxnRow(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"a","version":"1","size":10},{"name":"b","version":"1"},
+                                                   {"name":"c","version":"2","size":18446744073709551615}]})"));
+        dbSyncTxn.getDeletedRows(callbackData);
+    }
+
+    results.push_back(dbSync.getRangeChecksum("packages"));
+
+    return results;
+}
+
+TEST_F(DBSyncTest, checksumIndexCPP)
+{
+    const auto results = checksumScenario(DbEngineType::SQLITE3);
+    const auto checksum
+    {
+        [](const nlohmann::json & range)
+        {
+            return std::stoull(range.at("checksum").get<std::string>(), nullptr, 16);
+        }
+    };
+
+    ASSERT_EQ(7u, results.size());
+    EXPECT_EQ(3u, results[0].at("count").get<uint64_t>());
+    EXPECT_EQ(4u, results[1].at("count").get<uint64_t>());
+    EXPECT_NE(results[0], results[1]);
+    EXPECT_EQ(2u, results[2].at("count").get<uint64_t>());
+    EXPECT_EQ(1u, results[3].at("count").get<uint64_t>());
+    EXPECT_EQ(1u, results[4].at("count").get<uint64_t>());
+    EXPECT_EQ(nlohmann::json::parse(R"({"checksum":"0000000000000000","count":0})"), results[5]);
+    // The ranges add up to the table and the checksum doesn't depend on the order of the changes.
+    EXPECT_EQ(checksum(results[1]), checksum(results[4]) + checksum(results[2]) + checksum(results[3]));
+    EXPECT_EQ(results[0], results[6]);
+}
+
+TEST_F(DBSyncTest, checksumIndexErrorsCPP)
+{
+    const auto sql{ "CREATE TABLE packages(`name` TEXT, `version` TEXT, `arch` TEXT, PRIMARY KEY (`name`, `arch`)) WITHOUT ROWID;"};
+
+    for (const auto dbEngine : { DbEngineType::SQLITE3, DbEngineType::MEMORY })
+    {
+        DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+
+        EXPECT_THROW(dbSync.getRangeChecksum("packages"), DbSync::dbsync_error);
+        EXPECT_ANY_THROW(dbSync.enableTableChecksumIndex("dummy"));
+        EXPECT_NO_THROW(dbSync.enableTableChecksumIndex("packages"));
+        EXPECT_NO_THROW(dbSync.insertData(nlohmann::json::parse(R"({"table":"packages","data":[{"name":"a","version":"1","arch":"x86"}]})")));
+        EXPECT_EQ(1u, dbSync.getRangeChecksum("packages", nlohmann::json::parse(R"({"name":"a","arch":"x86"})")).at("count").get<uint64_t>());
+        // Composite keys need every key column on the bounds.
+        EXPECT_THROW(dbSync.getRangeChecksum("packages", "a"), DbSync::dbsync_error);
+        EXPECT_THROW(dbSync.getRangeChecksum("packages", nlohmann::json::parse(R"({"name":"a"})")), DbSync::dbsync_error);
+    }
+}
+
+TEST_F(DBSyncTest, checksumIndexFailedStatementCPP)
+{
+    const auto sql{ "CREATE TABLE packages(`name` TEXT, `version` TEXT NOT NULL, PRIMARY KEY (`name`)) WITHOUT ROWID;"};
+    DBSync dbSync { HostType::AGENT, DbEngineType::SQLITE3, DATABASE_MEMORY, sql };
+    ResultCallbackData callbackData
+    {
+        [](ReturnTypeCallback, const nlohmann::json&) {}
+    };
+    auto input = nlohmann::json::parse(R"({"table":"packages","data":[]})");
+
+    for (auto i = 0; i < 40; ++i)
+    {
+        input["data"].push_back({{"name", "package" + std::to_string(i)}, {"version", "1"}});
+    }
+
+    // The last row breaks the NOT NULL constraint, so the bulk insert fails after the triggers saw the other rows.
+    input["data"].back()["version"] = nullptr;
+
+    dbSync.enableTableChecksumIndex("packages");
+    EXPECT_ANY_THROW(dbSync.syncRow(input, callbackData));
+
+    nlohmann::json selected = nlohmann::json::array();
+    ResultCallbackData selectCallback
+    {
+        [&selected](ReturnTypeCallback, const nlohmann::json & data)
+        {
+            selected.push_back(data);
+        }
+    };
+    dbSync.selectRows(nlohmann::json::parse(R"({"table":"packages","query":{"column_list":["name"],"row_filter":""}})"),
+                      selectCallback);
+
+    EXPECT_TRUE(selected.empty());
+    EXPECT_EQ(nlohmann::json::parse(R"({"checksum":"0000000000000000","count":0})"), dbSync.getRangeChecksum("packages"));
+}
+
+TEST_F(DBSyncTest, memoryEngineChecksumIndexCPP)
+{
+    EXPECT_EQ(checksumScenario(DbEngineType::SQLITE3), checksumScenario(DbEngineType::MEMORY));
+}
+
+static std::vector<DbSync::RowValues> cursorScenario(const DbEngineType dbEngine)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `size` UNSIGNED BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+    auto data = nlohmann::json::array();
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        data.push_back({ { "pid", i }, { "name", "process" + std::to_string(i) }, { "size", 18446744073709551615ull - i } });
+    }
+
+    dbSync.insertData({ { "table", "processes" }, { "data", data } });
+
+    DBSyncCursor cursor
+    {
+        dbSync.handle(), SelectQuery::builder()
+        .table("processes")
+        .columnList({"pid", "size"})
+        .rowFilter("")
+        .orderByOpt("pid DESC")
+        .distinctOpt(false)
+        .countOpt(1000)
+        .build()
+        .query(), 30
+    };
+    std::vector<DbSync::RowValues> ret;
+    std::vector<DbSync::RowValues> rows;
+
+    EXPECT_EQ(std::vector<std::string>({ "pid", "size" }), cursor.columns());
+    EXPECT_EQ(1u, cursor.columnIndex("size"));
+    EXPECT_THROW(cursor.columnIndex("name"), DbSync::dbsync_error);
+
+    while (const auto fetched { cursor.next(rows) })
+    {
+        EXPECT_LE(fetched, 30u);
+        EXPECT_EQ(fetched, rows.size());
+        ret.insert(ret.end(), rows.begin(), rows.end());
+    }
+
+    EXPECT_EQ(0u, cursor.next(rows));
+    EXPECT_TRUE(rows.empty());
+    return ret;
+}
+
+TEST_F(DBSyncTest, cursorCPP)
+{
+    const auto rows { cursorScenario(DbEngineType::SQLITE3) };
+
+    ASSERT_EQ(100u, rows.size());
+    EXPECT_EQ(99, DbSync::fromRowValue<int64_t>(rows.front()[0]));
+    EXPECT_EQ(18446744073709551615ull - 99, DbSync::fromRowValue<uint64_t>(rows.front()[1]));
+    EXPECT_EQ(0, DbSync::fromRowValue<int64_t>(rows.back()[0]));
+    EXPECT_EQ(DbSync::Value { 18446744073709551615ull }, rows.back()[1]);
+    EXPECT_EQ(rows, cursorScenario(DbEngineType::MEMORY));
+}
+
+TEST_F(DBSyncTest, deleteRowsWithCallbackCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1},{"pid":5,"name":"Test","tid":2},{"pid":6,"name":"Other","tid":3}]})"};
+    const auto deleteByPKStmt{ R"({"table":"processes","query":{"data":[{"pid":4},{"pid":7}],"where_filter_opt":""}})"};
+    const auto deleteByFilterStmt{ R"({"table":"processes","query":{"data":[],"where_filter_opt":"tid > 2"}})"};
+
+    for (const auto dbEngine : { DbEngineType::SQLITE3, DbEngineType::MEMORY })
+    {
+        DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+        std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+        ResultCallbackData callbackData
+        {
+            [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+            {
+                results.emplace_back(type, jsonResult);
+            }
+        };
+
+        dbSync.insertData(nlohmann::json::parse(insertionSqlStmt));
+
+        // Only the stored rows are reported, with their stored values.
+        EXPECT_NO_THROW(dbSync.deleteRows(nlohmann::json::parse(deleteByPKStmt), callbackData));
+        ASSERT_EQ(1u, results.size());
+        EXPECT_EQ(DELETED, results.front().first);
+        EXPECT_EQ(nlohmann::json::parse(R"({"pid":4,"name":"System","tid":1})"), results.front().second);
+
+        if (DbEngineType::SQLITE3 == dbEngine)
+        {
+            results.clear();
+            EXPECT_NO_THROW(dbSync.deleteRows(nlohmann::json::parse(deleteByFilterStmt), callbackData));
+            ASSERT_EQ(1u, results.size());
+            EXPECT_EQ(DELETED, results.front().first);
+            EXPECT_EQ(nlohmann::json::parse(R"({"pid":6,"name":"Other","tid":3})"), results.front().second);
+        }
+    }
+}
+
+TEST_F(DBSyncTest, keepTxnRowsCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table": "processes"})" };
+    const auto keepStmt{ R"({"table":"processes","query":{"where_filter_opt":"tid > ? AND name <> ?","values":[1,"Dummy"]}})"};
+    const auto selectAll = nlohmann::json::parse(R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":100}})");
+
+    for (const auto dbEngine : { DbEngineType::SQLITE3, DbEngineType::MEMORY })
+    {
+        DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+        std::vector<std::pair<ReturnTypeCallback, nlohmann::json>> results;
+        ResultCallbackData callbackData
+        {
+            [&results](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+            {
+                results.emplace_back(type, jsonResult);
+            }
+        };
+
+        dbSync.insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1},{"pid":5,"name":"Test","tid":2},{"pid":6,"name":"Other","tid":3},{"pid":7,"name":"Dummy","tid":4}]})"));
+
+        {
+            DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(tables), 0, 0, callbackData };
+            dbSyncTxn.syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1}]})"));
+
+            EXPECT_THROW(dbSyncTxn.keepTxnRows(nlohmann::json::parse(R"({"table":"dummy","query":{"where_filter_opt":"pid > 0"}})")),
+                         DbSync::dbsync_error);
+
+            if (DbEngineType::MEMORY == dbEngine)
+            {
+                EXPECT_ANY_THROW(dbSyncTxn.keepTxnRows(nlohmann::json::parse(keepStmt)));
+                continue;
+            }
+
+            EXPECT_ANY_THROW(dbSyncTxn.keepTxnRows(nlohmann::json::parse(R"({"table":"processes","query":{"where_filter_opt":""}})")));
+            EXPECT_NO_THROW(dbSyncTxn.keepTxnRows(nlohmann::json::parse(keepStmt)));
+
+            // The kept rows aren't reported, only the ones neither synced nor kept are deleted.
+            results.clear();
+            EXPECT_NO_THROW(dbSyncTxn.getDeletedRows(callbackData));
+            ASSERT_EQ(1u, results.size());
+            EXPECT_EQ(DELETED, results.front().first);
+            EXPECT_EQ(nlohmann::json::parse(R"({"pid":7,"name":"Dummy","tid":4})"), results.front().second);
+        }
+
+        DBSyncCursor cursor { dbSync.handle(), selectAll };
+        std::vector<DbSync::RowValues> rows;
+        EXPECT_EQ(3u, cursor.next(rows));
+    }
+}
+
+TEST_F(DBSyncTest, deletedRowsCursorCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto tables { R"({"table": "processes"})" };
+    const auto selectAll = nlohmann::json::parse(R"({"table":"processes","query":{"column_list":["*"],"row_filter":"","distinct_opt":false,"order_by_opt":"","count_opt":100}})");
+
+    for (const auto dbEngine : { DbEngineType::SQLITE3, DbEngineType::MEMORY })
+    {
+        DBSync dbSync { HostType::AGENT, dbEngine, DATABASE_MEMORY, sql };
+        ResultCallbackData callbackData
+        {
+            [](ReturnTypeCallback, const nlohmann::json&) {}
+        };
+
+        dbSync.insertData(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1},{"pid":5,"name":"Test"},{"pid":6,"name":"Other","tid":3}]})"));
+
+        std::vector<DbSync::RowValues> deleted;
+
+        {
+            DBSyncTxn dbSyncTxn { dbSync.handle(), nlohmann::json::parse(tables), 0, 0, callbackData };
+            dbSyncTxn.syncTxnRow(nlohmann::json::parse(R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1}]})"));
+
+            EXPECT_THROW(dbSyncTxn.deletedRowsCursor("dummy"), DbSync::dbsync_error);
+            auto cursor { dbSyncTxn.deletedRowsCursor("processes", 1) };
+            std::vector<DbSync::RowValues> rows;
+
+            EXPECT_EQ(std::vector<std::string>({ "pid", "name", "tid" }), cursor.columns());
+
+            while (cursor.next(rows))
+            {
+                ASSERT_EQ(1u, rows.size());
+                deleted.push_back(rows.front());
+            }
+        }
+
+        const std::vector<DbSync::RowValues> expected
+        {
+            { int64_t { 5 }, std::string { "Test" }, std::monostate {} },
+            { int64_t { 6 }, std::string { "Other" }, int64_t { 3 } }
+        };
+        EXPECT_EQ(expected, deleted);
+
+        // The rows are deleted when the transaction is closed, as with getDeletedRows.
+        DBSyncCursor cursor { dbSync.handle(), selectAll };
+        std::vector<DbSync::RowValues> rows;
+        EXPECT_EQ(1u, cursor.next(rows));
+    }
+}
@@ -19,7 +19,11 @@
 class MockConnection : public SQLiteLegacy::IConnection
 {
     public:
-        MockConnection() = default;
+        MockConnection()
+        {
+            // No real database behind the mock, the engine skips what needs the SQLite handle.
+            ON_CALL(*this, db()).WillByDefault(::testing::ReturnRef(m_db));
+        }
         virtual ~MockConnection() = default;
         MOCK_METHOD(void,
                     close,
@@ -38,6 +42,8 @@ class MockConnection : public SQLiteLegacy::IConnection
                     (),
                     (const override));
 
+    private:
+        std::shared_ptr<sqlite3> m_db;
 };
 
 class MockTransaction : public SQLiteLegacy::ITransaction
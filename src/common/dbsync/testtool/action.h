@@ -10,9 +10,14 @@
  */
 #pragma once
 #include <nlohmann/json.hpp>
+#include <chrono>
 #include <mutex>
 #include "dbsync.h"
 #include "cjsonSmartDeleter.hpp"
+#include "workloadGenerator.h"
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 namespace TestDeleters
 {
@@ -826,3 +831,362 @@ struct SelectRowsActionCPP final : public IAction
     }
 };
 
+struct SyncRowBenchmarkActionCPP final : public IAction
+{
+    void execute(std::unique_ptr<TestContext>& ctx,
+                 const nlohmann::json& value) override
+    {
+        nlohmann::json jsonResult;
+
+        try
+        {
+            const auto& body { value.at("body") };
+            const auto& table { body.at("table").get_ref<const std::string&>() };
+            const auto& key { body.at("key").get_ref<const std::string&>() };
+            const auto rows { body.at("rows").get<size_t>() };
+            const auto iterations { body.value("iterations", 1ull) };
+            const auto& rowTemplate { body.at("data").at(0) };
+
+            // Every row is a copy of the template with a different key, the second pass changes half of them.
+            auto data = nlohmann::json::array();
+            auto changedData = nlohmann::json::array();
+            auto keys = nlohmann::json::array();
+
+            for (size_t i = 0; i < rows; ++i)
+            {
+                auto row = rowTemplate;
+                row[key] = i;
+                data.push_back(row);
+
+                if (0 == i % 2)
+                {
+                    for (auto it = row.begin(); it != row.end(); ++it)
+                    {
+                        if (it.key() != key && it->is_string())
+                        {
+                            *it = it->get<std::string>() + "_changed";
+                        }
+                    }
+                }
+
+                changedData.push_back(row);
+                keys.push_back(nlohmann::json::object({{key, i}}));
+            }
+
+            const nlohmann::json tables { {"table", table} };
+            const nlohmann::json deleteQuery { {"table", table}, {"query", {{"data", keys}}} };
+            std::unique_ptr<DBSync> dbSync { std::make_unique<DBSync>(ctx->handle) };
+
+            for (const auto bulkSync : { false, true })
+            {
+                size_t events { 0ull };
+                ResultCallbackData callbackData
+                {
+                    [&events](ReturnTypeCallback /*result_type*/, const nlohmann::json & /*json*/)
+                    {
+                        ++events;
+                    }
+                };
+
+                const auto buildQuery
+                {
+                    [&table, bulkSync](const nlohmann::json & rowsData)
+                    {
+                        nlohmann::json query { {"table", table}, {"data", rowsData} };
+
+                        if (!bulkSync)
+                        {
+                            query["options"]["bulk_sync"] = false;
+                        }
+
+                        return query;
+                    }
+                };
+
+                const auto insertQuery = buildQuery(data);
+                const auto changeQuery = buildQuery(changedData);
+                std::chrono::duration<double, std::milli> insertTime {};
+                std::chrono::duration<double, std::milli> changeTime {};
+                std::chrono::duration<double, std::milli> txnTime {};
+
+                for (size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    auto start { std::chrono::steady_clock::now() };
+                    dbSync->syncRow(insertQuery, callbackData);
+                    insertTime += std::chrono::steady_clock::now() - start;
+
+                    start = std::chrono::steady_clock::now();
+                    dbSync->syncRow(changeQuery, callbackData);
+                    changeTime += std::chrono::steady_clock::now() - start;
+
+                    start = std::chrono::steady_clock::now();
+                    {
+                        DBSyncTxn dbSyncTxn { dbSync->handle(), tables, 0, 0, callbackData };
+                        dbSyncTxn.syncTxnRow(insertQuery);
+                        dbSyncTxn.getDeletedRows(callbackData);
+                    }
+                    txnTime += std::chrono::steady_clock::now() - start;
+
+                    dbSync->deleteRows(deleteQuery);
+                }
+
+                jsonResult[bulkSync ? "bulk" : "row"] =
+                {
+                    {"insert_ms", insertTime.count() / iterations},
+                    {"modify_ms", changeTime.count() / iterations},
+                    {"txn_ms", txnTime.count() / iterations},
+                    {"events", events}
+                };
+            }
+
+            jsonResult["rows"] = rows;
+            jsonResult["iterations"] = iterations;
+            std::cout << "syncRowBenchmark: " << jsonResult.dump() << std::endl;
+        }
+        catch (const nlohmann::detail::exception& ex)
+        {
+            jsonResult = ex.id;
+        }
+        catch (const DbSync::dbsync_error& ex)
+        {
+            jsonResult = ex.id();
+        }
+        catch (...)
+        {
+            jsonResult = -1;
+        }
+
+        std::stringstream oFileName;
+        oFileName << "action_" << ctx->currentId << ".json";
+        std::ofstream outputFile{ ctx->outputPath + "/" + oFileName.str() };
+        const nlohmann::json jsonOutput = { {"syncRowBenchmark", jsonResult } };
+        outputFile << jsonOutput.dump() << std::endl;
+    }
+};
+
+struct WorkloadBenchmarkActionCPP final : public IAction
+{
+    void execute(std::unique_ptr<TestContext>& ctx,
+                 const nlohmann::json& value) override
+    {
+        nlohmann::json jsonResult;
+
+        try
+        {
+            const auto& body { value.at("body") };
+            const auto rows { body.at("rows").get<size_t>() };
+            const auto iterations { std::max(body.value("iterations", 1ull), 1ull) };
+            const auto fetchSize { body.value("fetch_size", DBSYNC_CURSOR_FETCH_SIZE) };
+            const auto checksumIndex { body.value("checksum_index", false) };
+            const auto engine { body.value("db_type", std::string{"1"}) == "2" ? DbEngineType::MEMORY : DbEngineType::SQLITE3 };
+            WorkloadGenerator generator { body.at("workload").get<std::string>(), rows, body.value("change_rate", 0.1) };
+            const std::string table { generator.table() };
+
+            // The workload gets its own database, the one of the config file keeps the tables of the other actions.
+            DBSync dbSync { HostType::AGENT, engine, body.value("db_name", std::string{"workload.db"}), generator.sqlStatement() };
+
+            if (checksumIndex)
+            {
+                dbSync.enableTableChecksumIndex(table);
+            }
+
+            size_t events { 0ull };
+            ResultCallbackData callbackData
+            {
+                [&events](ReturnTypeCallback /*result_type*/, const nlohmann::json & /*json*/)
+                {
+                    ++events;
+                }
+            };
+
+            const auto executedStatements
+            {
+                [&dbSync]()
+                {
+                    return dbSync.getStatementCacheStats().at("executed").get<uint64_t>();
+                }
+            };
+
+            nlohmann::json phases;
+            const auto measure
+            {
+                [&phases, &executedStatements](const std::string & phase, const size_t phaseRows, const std::function<void()>& operation)
+                {
+                    const auto statements { executedStatements() };
+                    const auto start { std::chrono::steady_clock::now() };
+                    operation();
+                    const std::chrono::duration<double, std::milli> elapsed { std::chrono::steady_clock::now() - start };
+                    auto& result { phases[phase] };
+
+                    if (result.is_null())
+                    {
+                        result = { {"ms", 0.0}, {"rows", 0ull}, {"statements", 0ull} };
+                    }
+
+                    result["ms"] = result["ms"].get<double>() + elapsed.count();
+                    result["rows"] = result["rows"].get<uint64_t>() + phaseRows;
+                    result["statements"] = result["statements"].get<uint64_t>() + executedStatements() - statements;
+                }
+            };
+
+            const nlohmann::json tables { {"table", table} };
+            auto selectAll = SelectQuery::builder().table(table).columnList({"*"}).rowFilter("").distinctOpt(false).build().query();
+            auto integrityColumns { generator.primaryKeys() };
+            integrityColumns.push_back("checksum");
+            auto integrityOrder { generator.primaryKeys().front() };
+
+            for (const auto& primaryKey : generator.primaryKeys())
+            {
+                if (primaryKey != integrityOrder)
+                {
+                    integrityOrder += "," + primaryKey;
+                }
+            }
+
+            // The integrity check of the inventory reads the checksums in primary key order.
+            auto integritySelect = SelectQuery::builder()
+                                   .table(table)
+                                   .columnList(integrityColumns)
+                                   .rowFilter("")
+                                   .distinctOpt(false)
+                                   .orderByOpt(integrityOrder)
+                                   .build()
+                                   .query();
+
+            nlohmann::json populateQuery { {"table", table} };
+            populateQuery["data"] = generator.snapshot();
+            measure("populate", rows, [&]()
+            {
+                DBSyncTxn dbSyncTxn { dbSync.handle(), tables, 0, 0, callbackData };
+                dbSyncTxn.syncTxnRow(populateQuery);
+                dbSyncTxn.getDeletedRows(callbackData);
+            });
+
+            for (size_t iteration = 0; iteration < iterations; ++iteration)
+            {
+                // A full scan goes through a transaction, the rows left out of it are the deleted ones.
+                auto scan { generator.nextScan() };
+                nlohmann::json scanQuery { {"table", table} };
+                scanQuery["data"] = std::move(scan.rows);
+                {
+                    DBSyncTxn dbSyncTxn { dbSync.handle(), tables, 0, 0, callbackData };
+                    measure("sync_txn_row", rows, [&]()
+                    {
+                        dbSyncTxn.syncTxnRow(scanQuery);
+                    });
+                    measure("get_deleted_rows", scan.deleted.size(), [&]()
+                    {
+                        dbSyncTxn.getDeletedRows(callbackData);
+                    });
+                }
+
+                // The events of a real time scan only carry the changes.
+                scan = generator.nextScan();
+                nlohmann::json changesQuery { {"table", table} };
+                changesQuery["data"] = std::move(scan.changed);
+                measure("sync_row", changesQuery["data"].size(), [&]()
+                {
+                    dbSync.syncRow(changesQuery, callbackData);
+                });
+
+                if (!scan.deleted.empty())
+                {
+                    nlohmann::json deleteQuery { {"table", table} };
+                    deleteQuery["query"]["data"] = std::move(scan.deleted);
+                    measure("delete_rows", deleteQuery["query"]["data"].size(), [&]()
+                    {
+                        dbSync.deleteRows(deleteQuery);
+                    });
+                }
+
+                measure("select_rows", rows, [&]()
+                {
+                    dbSync.selectRows(selectAll, callbackData);
+                });
+
+                measure("select_cursor", rows, [&]()
+                {
+                    DBSyncCursor cursor { dbSync.handle(), selectAll, fetchSize };
+                    std::vector<DbSync::RowValues> fetched;
+
+                    while (cursor.next(fetched) > 0)
+                    {
+                        events += fetched.size();
+                    }
+                });
+
+                measure("integrity_select", rows, [&]()
+                {
+                    std::hash<std::string> hasher;
+                    size_t checksum { 0ull };
+                    dbSync.selectRows(integritySelect,
+                                      [&hasher, &checksum](ReturnTypeCallback /*result_type*/, const nlohmann::json & json)
+                    {
+                        checksum = checksum * 31 + hasher(json.value("checksum", ""));
+                    });
+                });
+
+                if (checksumIndex)
+                {
+                    measure("integrity_index", rows, [&]()
+                    {
+                        dbSync.getRangeChecksum(table);
+                    });
+                }
+            }
+
+            for (auto it = phases.begin(); it != phases.end(); ++it)
+            {
+                auto& result { it.value() };
+                const auto ms { result.at("ms").get<double>() };
+                const auto phaseRows { result.at("rows").get<uint64_t>() };
+                const auto runs { it.key() == "populate" ? 1ull : iterations };
+                result["rows_per_s"] = ms > 0 ? static_cast<double>(phaseRows) * 1000 / ms : 0.0;
+                result["ms"] = ms / runs;
+                result["rows"] = phaseRows / runs;
+                result["statements"] = result.at("statements").get<uint64_t>() / runs;
+            }
+
+            jsonResult["phases"] = phases;
+            jsonResult["workload"] = body.at("workload");
+            jsonResult["engine"] = engine == DbEngineType::MEMORY ? "memory" : "sqlite";
+            jsonResult["rows"] = rows;
+            jsonResult["change_rate"] = body.value("change_rate", 0.1);
+            jsonResult["iterations"] = iterations;
+            jsonResult["events"] = events;
+            jsonResult["peak_rss_kb"] = peakRss();
+            std::cout << "workloadBenchmark: " << jsonResult.dump() << std::endl;
+        }
+        catch (const nlohmann::detail::exception& ex)
+        {
+            jsonResult = ex.id;
+        }
+        catch (const DbSync::dbsync_error& ex)
+        {
+            jsonResult = ex.id();
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "workloadBenchmark: " << ex.what() << std::endl;
+            jsonResult = -1;
+        }
+
+        std::stringstream oFileName;
+        oFileName << "action_" << ctx->currentId << ".json";
+        std::ofstream outputFile{ ctx->outputPath + "/" + oFileName.str() };
+        const nlohmann::json jsonOutput = { {"workloadBenchmark", jsonResult } };
+        outputFile << jsonOutput.dump() << std::endl;
+    }
+
+    private:
+        static uint64_t peakRss()
+        {
+#ifndef _WIN32
+            rusage usage {};
+            // Kilobytes on Linux.
+            return 0 == getrusage(RUSAGE_SELF, &usage) ? static_cast<uint64_t>(usage.ru_maxrss) : 0ull;
+#else
+            return 0ull;
+#endif
+        }
+};
@@ -105,6 +105,14 @@ class FactoryAction
             {
                 return std::make_unique<SelectRowsActionCPP>();
             }
+            else if (0 == actionCode.compare("syncRowBenchmark"))
+            {
+                return std::make_unique<SyncRowBenchmarkActionCPP>();
+            }
+            else if (0 == actionCode.compare("workloadBenchmark"))
+            {
+                return std::make_unique<WorkloadBenchmarkActionCPP>();
+            }
             else
             {
                 throw std::runtime_error { "Invalid action: " + actionCode };
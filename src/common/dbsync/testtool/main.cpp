@@ -41,6 +41,11 @@ int main(int argc, const char* argv[])
         const std::string persistance{ jsonConfigFile.at("persistance").get_ref<const std::string&>() };
         const std::string sqlStmt{ jsonConfigFile.at("sql_statement").get_ref<const std::string&>() };
 
+        const auto engineType
+        {
+            (dbType.compare("1") == 0) ? DbEngineType::SQLITE3 : (dbType.compare("2") == 0) ? DbEngineType::MEMORY : DbEngineType::UNDEFINED
+        };
+
         dbsync_initialize(loggerFunction);
 
         DBSYNC_HANDLE handle {0};
@@ -48,7 +53,7 @@ int main(int argc, const char* argv[])
         if (persistance.compare("1") == 0)
         {
             handle = dbsync_create_persistent((hostType.compare("0") == 0) ? HostType::MANAGER : HostType::AGENT,
-                                              (dbType.compare("1") == 0) ? DbEngineType::SQLITE3 : DbEngineType::UNDEFINED,
+                                              engineType,
                                               dbName.c_str(),
                                               sqlStmt.c_str(),
                                               nullptr);
@@ -57,7 +62,7 @@ int main(int argc, const char* argv[])
         else
         {
             handle = dbsync_create((hostType.compare("0") == 0) ? HostType::MANAGER : HostType::AGENT,
-                                   (dbType.compare("1") == 0) ? DbEngineType::SQLITE3 : DbEngineType::UNDEFINED,
+                                   engineType,
                                    dbName.c_str(),
                                    sqlStmt.c_str());
         }
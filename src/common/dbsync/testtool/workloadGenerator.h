@@ -0,0 +1,251 @@
+/*
+ * Wazuh DBSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _WORKLOAD_GENERATOR_H
+#define _WORKLOAD_GENERATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+constexpr auto INVENTORY_WORKLOAD_SQL_STATEMENT
+{
+    R"(CREATE TABLE packages(
+    name TEXT,
+    version TEXT,
+    install_time TEXT,
+    location TEXT,
+    architecture TEXT,
+    description TEXT,
+    size INTEGER,
+    format TEXT,
+    checksum TEXT,
+    PRIMARY KEY (name,version,architecture,format,location)) WITHOUT ROWID;)"
+};
+
+constexpr auto FIM_WORKLOAD_SQL_STATEMENT
+{
+    R"(CREATE TABLE file_entry(
+    path TEXT,
+    size BIGINT,
+    perm TEXT,
+    uid INTEGER,
+    gid INTEGER,
+    inode BIGINT,
+    mtime BIGINT,
+    hash_sha256 TEXT,
+    checksum TEXT,
+    PRIMARY KEY (path)) WITHOUT ROWID;)"
+};
+
+struct WorkloadScan final
+{
+    // Snapshot of every row after the scan.
+    nlohmann::json rows;
+    // Modified and new rows of the scan.
+    nlohmann::json changed;
+    // Primary keys of the rows removed by the scan.
+    nlohmann::json deleted;
+};
+
+/**
+ * @brief Synthetic rows of an inventory-like (packages) or FIM-like (file_entry) table.
+ * @details The table keeps \p rows rows. Each scan changes \p changeRate of them: half of the changes modify
+ *          existing rows and the other half replace the oldest rows by new ones, as updated and reinstalled
+ *          packages or modified and rotated files do. The rows only depend on the scan number, so every run
+ *          and every engine see the same data.
+ */
+class WorkloadGenerator final
+{
+    public:
+        WorkloadGenerator(const std::string& workload,
+                          const size_t       rows,
+                          const double       changeRate)
+            : m_fim { workload == "fim" }
+            , m_versions(rows, 0ull)
+            , m_first { 0ull }
+            , m_scan { 0ull }
+            , m_changes { static_cast<size_t>(static_cast<double>(rows) * changeRate) }
+        {
+            if (!m_fim && workload != "inventory")
+            {
+                throw std::runtime_error { "Invalid workload: " + workload };
+            }
+
+            if (changeRate < 0 || changeRate > 1)
+            {
+                throw std::runtime_error { "Invalid change rate: " + std::to_string(changeRate) };
+            }
+        }
+
+        const char* table() const
+        {
+            return m_fim ? "file_entry" : "packages";
+        }
+
+        const char* sqlStatement() const
+        {
+            return m_fim ? FIM_WORKLOAD_SQL_STATEMENT : INVENTORY_WORKLOAD_SQL_STATEMENT;
+        }
+
+        std::vector<std::string> primaryKeys() const
+        {
+            return m_fim ? std::vector<std::string> { "path" } :
+                   std::vector<std::string> { "name", "version", "architecture", "format", "location" };
+        }
+
+        /**
+         * @brief Current rows, the ones of the initial scan before any call to nextScan.
+         */
+        nlohmann::json snapshot() const
+        {
+            auto ret = nlohmann::json::array();
+
+            for (size_t i = 0; i < m_versions.size(); ++i)
+            {
+                ret.push_back(row(m_first + i, m_versions[i]));
+            }
+
+            return ret;
+        }
+
+        WorkloadScan nextScan()
+        {
+            WorkloadScan ret { nlohmann::json::array(), nlohmann::json::array(), nlohmann::json::array() };
+            const auto rows { m_versions.size() };
+            const auto replaced { std::min(m_changes / 2, rows) };
+            const auto modified { m_changes - replaced };
+
+            ++m_scan;
+
+            for (size_t i = 0; i < replaced; ++i)
+            {
+                ret.deleted.push_back(key(m_first));
+                m_versions.pop_front();
+                m_versions.push_back(m_scan);
+                ++m_first;
+            }
+
+            // The modified rows are spread over the table and move on every scan.
+            for (size_t i = 0; i < modified && rows > replaced; ++i)
+            {
+                m_versions[(i * (rows - replaced) / modified + m_scan) % (rows - replaced)] = m_scan;
+            }
+
+            for (size_t i = 0; i < rows; ++i)
+            {
+                const auto& current = ret.rows.emplace_back(row(m_first + i, m_versions[i]));
+
+                if (m_versions[i] == m_scan)
+                {
+                    ret.changed.push_back(current);
+                }
+            }
+
+            return ret;
+        }
+
+    private:
+        static uint64_t mix(uint64_t value)
+        {
+            // splitmix64, enough to spread the synthetic hashes.
+            value += 0x9e3779b97f4a7c15ull;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+
+        static std::string hexDigest(const uint64_t id,
+                                     const uint64_t version,
+                                     const size_t   length)
+        {
+            std::stringstream ss;
+            auto value { mix(id) ^ version };
+
+            while (ss.tellp() < static_cast<std::streamoff>(length))
+            {
+                value = mix(value);
+                ss << std::hex << std::setw(16) << std::setfill('0') << value;
+            }
+
+            return ss.str().substr(0, length);
+        }
+
+        static std::string path(const uint64_t id)
+        {
+            return "/usr/share/workload/dir" + std::to_string(id / 1000) + "/file" + std::to_string(id);
+        }
+
+        static std::string name(const uint64_t id)
+        {
+            return "package" + std::to_string(id);
+        }
+
+        nlohmann::json key(const uint64_t id) const
+        {
+            nlohmann::json ret;
+
+            if (m_fim)
+            {
+                ret["path"] = path(id);
+            }
+            else
+            {
+                ret["name"] = name(id);
+                ret["version"] = "1.0." + std::to_string(id % 10);
+                ret["architecture"] = "amd64";
+                ret["format"] = "deb";
+                ret["location"] = "/var/lib/dpkg/status";
+            }
+
+            return ret;
+        }
+
+        nlohmann::json row(const uint64_t id,
+                           const uint64_t version) const
+        {
+            auto ret = key(id);
+
+            if (m_fim)
+            {
+                ret["size"] = mix(id) % 1048576 + version;
+                ret["perm"] = "rw-r--r--";
+                ret["uid"] = 0;
+                ret["gid"] = 0;
+                ret["inode"] = id + 1;
+                ret["mtime"] = 1700000000 + version;
+                ret["hash_sha256"] = hexDigest(id, version, 64);
+            }
+            else
+            {
+                ret["install_time"] = "2026/01/01 00:00:" + std::to_string(version % 60);
+                ret["description"] = "Synthetic package " + std::to_string(id) + " revision " + std::to_string(version);
+                ret["size"] = mix(id) % 65536 + version;
+            }
+
+            ret["checksum"] = hexDigest(id, version, 40);
+            return ret;
+        }
+
+        const bool m_fim;
+        std::deque<uint64_t> m_versions;
+        uint64_t m_first;
+        uint64_t m_scan;
+        const size_t m_changes;
+};
+
+#endif // _WORKLOAD_GENERATOR_H
@@ -38,12 +38,32 @@ void LogCritical_C(const char* file, int line, const char* func, const char* mes
 
 #ifdef __cplusplus
 
-#define LogTrace(message, ...) spdlog::trace("[TRACE] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
-#define LogDebug(message, ...) spdlog::debug("[DEBUG] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
-#define LogInfo(message, ...)  spdlog::info("[INFO] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
-#define LogWarn(message, ...)  spdlog::warn("[WARN] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
-#define LogError(message, ...) spdlog::error("[ERROR] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
-#define LogCritical(message, ...) spdlog::critical("[CRITICAL] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)
+// The level is checked before the arguments are evaluated, so disabled messages don't build their arguments
+#define LogTrace(message, ...)                                                                                         \
+    (spdlog::should_log(spdlog::level::trace)                                                                          \
+         ? spdlog::trace("[TRACE] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__) \
+         : void())
+#define LogDebug(message, ...)                                                                                         \
+    (spdlog::should_log(spdlog::level::debug)                                                                          \
+         ? spdlog::debug("[DEBUG] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__) \
+         : void())
+#define LogInfo(message, ...)                                                                                          \
+    (spdlog::should_log(spdlog::level::info)                                                                           \
+         ? spdlog::info("[INFO] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)   \
+         : void())
+#define LogWarn(message, ...)                                                                                          \
+    (spdlog::should_log(spdlog::level::warn)                                                                           \
+         ? spdlog::warn("[WARN] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)   \
+         : void())
+#define LogError(message, ...)                                                                                         \
+    (spdlog::should_log(spdlog::level::err)                                                                            \
+         ? spdlog::error("[ERROR] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__) \
+         : void())
+#define LogCritical(message, ...)                                                                                      \
+    (spdlog::should_log(spdlog::level::critical)                                                                       \
+         ? spdlog::critical(                                                                                           \
+               "[CRITICAL] [{}:{}] [{}] " message, LOG_FILE_NAME, __LINE__, __func__ __VA_OPT__(, ) __VA_ARGS__)       \
+         : void())
 
 namespace
 {
@@ -0,0 +1,289 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/program_options.hpp>
+#include "lockFreeQueue.h"
+#include "threadSafeQueue.h"
+
+namespace program_options = boost::program_options;
+
+static const auto OPT_HELP {"help"};
+static const auto OPT_ITEMS {"items"};
+static const auto OPT_PRODUCERS {"producers"};
+static const auto OPT_CONSUMERS {"consumers"};
+static const auto OPT_CAPACITY {"capacity"};
+static const auto OPT_BATCH {"batch"};
+static const auto OPT_ITERATIONS {"iterations"};
+
+struct BenchmarkOptions final
+{
+    size_t items;
+    size_t consumers;
+    size_t capacity;
+    size_t batch;
+    size_t iterations;
+};
+
+// Producer and consumer bodies of a queue, the consumer returns the number of items it popped, 0 once canceled
+struct QueueOperations final
+{
+    std::function<void(const std::vector<int64_t>&)> produce;
+    std::function<size_t(std::vector<int64_t>&)> consume;
+    std::function<void()> cancel;
+};
+
+static std::vector<int64_t> producerItems(const size_t items)
+{
+    std::vector<int64_t> ret(items);
+
+    for (size_t i = 0; i < items; ++i)
+    {
+        ret[i] = static_cast<int64_t>(i + 1);
+    }
+
+    return ret;
+}
+
+static double runOnce(const QueueOperations& operations, const size_t producers, const BenchmarkOptions& options)
+{
+    const auto items {producerItems(options.items)};
+    const auto total {producers * options.items};
+    std::atomic<size_t> consumed {0};
+    std::atomic<int64_t> sum {0};
+    std::vector<std::thread> threads;
+
+    const auto start {std::chrono::steady_clock::now()};
+
+    for (size_t i = 0; i < options.consumers; ++i)
+    {
+        threads.emplace_back([&]()
+        {
+            std::vector<int64_t> values;
+            values.reserve(options.batch);
+            size_t popped {0};
+
+            while ((popped = operations.consume(values)) > 0)
+            {
+                int64_t partial {0};
+
+                for (const auto value : values)
+                {
+                    partial += value;
+                }
+
+                values.clear();
+                sum += partial;
+
+                if (consumed.fetch_add(popped) + popped == total)
+                {
+                    operations.cancel();
+                }
+            }
+        });
+    }
+
+    for (size_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&operations, &items]()
+        {
+            operations.produce(items);
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto elapsed {std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()};
+    const auto expected {static_cast<int64_t>(producers) * static_cast<int64_t>(options.items * (options.items + 1) / 2)};
+
+    if (consumed != total || sum != expected)
+    {
+        std::cerr << "Lost items: " << consumed << "/" << total << std::endl;
+    }
+
+    return elapsed;
+}
+
+static void runBenchmark(const std::string& name,
+                         const std::function<QueueOperations()>& factory,
+                         const size_t producers,
+                         const BenchmarkOptions& options)
+{
+    std::vector<double> elapsed;
+
+    for (size_t i = 0; i < options.iterations; ++i)
+    {
+        const auto operations {factory()};
+        elapsed.push_back(runOnce(operations, producers, options));
+    }
+
+    std::sort(elapsed.begin(), elapsed.end());
+    const auto median {elapsed[elapsed.size() / 2]};
+    const auto items {static_cast<double>(producers * options.items)};
+    std::cout << std::fixed << std::setprecision(2)
+              << std::left << std::setw(18) << name
+              << " producers: " << std::setw(4) << producers
+              << " p50: " << std::setw(10) << median << "ms"
+              << " max: " << std::setw(10) << elapsed.back() << "ms"
+              << " Mitems/s: " << (median > 0 ? items / median / 1000 : 0)
+              << std::endl;
+}
+
+static QueueOperations safeQueue(const BenchmarkOptions& options)
+{
+    auto queue {std::make_shared<Utils::SafeQueue<int64_t>>()};
+    return QueueOperations
+    {
+        [queue](const std::vector<int64_t>& items)
+        {
+            for (const auto item : items)
+            {
+                queue->push(item);
+            }
+        },
+        [queue, batch = options.batch](std::vector<int64_t>& values)
+        {
+            int64_t value {};
+
+            // Only waits for the first item, as the batch pop of the lock-free queue does
+            while (values.size() < batch && queue->pop(value, values.empty()))
+            {
+                values.push_back(value);
+            }
+
+            return values.size();
+        },
+        [queue]()
+        {
+            queue->cancel();
+        }
+    };
+}
+
+static QueueOperations lockFreeQueue(const BenchmarkOptions& options)
+{
+    auto queue {std::make_shared<Utils::LockFreeQueue<int64_t>>(options.capacity)};
+    return QueueOperations
+    {
+        [queue](const std::vector<int64_t>& items)
+        {
+            for (const auto item : items)
+            {
+                queue->push(item);
+            }
+        },
+        [queue, batch = options.batch](std::vector<int64_t>& values)
+        {
+            return queue->popBulk(values, batch);
+        },
+        [queue]()
+        {
+            queue->cancel();
+        }
+    };
+}
+
+static QueueOperations lockFreeQueueBulk(const BenchmarkOptions& options)
+{
+    auto queue {std::make_shared<Utils::LockFreeQueue<int64_t>>(options.capacity)};
+    return QueueOperations
+    {
+        [queue, batch = options.batch](const std::vector<int64_t>& items)
+        {
+            for (size_t i = 0; i < items.size(); i += batch)
+            {
+                const auto last {std::min(items.size(), i + batch)};
+                queue->pushBulk(std::vector<int64_t>(items.begin() + static_cast<std::ptrdiff_t>(i),
+                                                     items.begin() + static_cast<std::ptrdiff_t>(last)));
+            }
+        },
+        [queue, batch = options.batch](std::vector<int64_t>& values)
+        {
+            return queue->popBulk(values, batch);
+        },
+        [queue]()
+        {
+            queue->cancel();
+        }
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options {};
+    std::string producers;
+    program_options::options_description description {"Compares the mutex based SafeQueue with the lock-free "
+                                                      "bounded queue.\n\nOptions"};
+    description.add_options()
+    (OPT_HELP, "Show this help message")
+    (OPT_ITEMS, program_options::value<size_t>(&options.items)->default_value(200000), "Items pushed by each producer")
+    (OPT_PRODUCERS, program_options::value<std::string>(&producers)->default_value("1,4,16"), "Comma separated producer counts")
+    (OPT_CONSUMERS, program_options::value<size_t>(&options.consumers)->default_value(1), "Consumer threads")
+    (OPT_CAPACITY, program_options::value<size_t>(&options.capacity)->default_value(4096), "Capacity of the lock-free queue")
+    (OPT_BATCH, program_options::value<size_t>(&options.batch)->default_value(64), "Items per bulk push and pop")
+    (OPT_ITERATIONS, program_options::value<size_t>(&options.iterations)->default_value(5), "Runs per queue");
+
+    std::vector<size_t> producerCounts;
+
+    try
+    {
+        program_options::variables_map variables;
+        program_options::store(program_options::parse_command_line(argc, argv, description), variables);
+
+        if (variables.count(OPT_HELP))
+        {
+            std::cout << description << std::endl;
+            return 0;
+        }
+
+        program_options::notify(variables);
+
+        std::stringstream stream {producers};
+        std::string count;
+
+        while (std::getline(stream, count, ','))
+        {
+            producerCounts.push_back(std::stoul(count));
+        }
+
+        if (options.items == 0 || options.consumers == 0 || options.batch == 0 || options.iterations == 0 ||
+            producerCounts.empty() ||
+            std::find(producerCounts.begin(), producerCounts.end(), 0) != producerCounts.end())
+        {
+            throw std::invalid_argument {"invalid value"};
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n" << description << std::endl;
+        return 1;
+    }
+
+    for (const auto count : producerCounts)
+    {
+        runBenchmark("SafeQueue", std::bind(safeQueue, options), count, options);
+        runBenchmark("LockFreeQueue", std::bind(lockFreeQueue, options), count, options);
+        runBenchmark("LockFreeQueue bulk", std::bind(lockFreeQueueBulk, options), count, options);
+    }
+
+    return 0;
+}
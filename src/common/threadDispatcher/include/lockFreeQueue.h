@@ -0,0 +1,370 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+    constexpr size_t LOCK_FREE_QUEUE_CACHE_LINE {64};
+    // Checks of the queue before parking, a short wait is cheaper than the futex round trip.
+    constexpr size_t LOCK_FREE_QUEUE_SPIN {16};
+
+    /**
+     * @brief Bounded multi-producer multi-consumer queue.
+     * @details Ring of cells with a sequence number each (Dmitry Vyukov's bounded MPMC queue), so producers and
+     *          consumers only contend on the CAS of their own position. Blocked threads park on atomic waits
+     *          (futexes on Linux), and the pushes and pops only touch them when a thread is parked on the other
+     *          side, which happens when the queue is empty (or full).
+     *
+     * @tparam T Stored type, it must be default constructible.
+     * @tparam U Type returned by the pops.
+     */
+    template<typename T, typename U>
+    class TLockFreeQueue
+    {
+    public:
+        explicit TLockFreeQueue(const size_t capacity)
+            : m_cells(roundCapacity(capacity))
+            , m_mask {m_cells.size() - 1}
+        {
+            for (size_t i = 0; i < m_cells.size(); ++i)
+            {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        TLockFreeQueue& operator=(const TLockFreeQueue&) = delete;
+        TLockFreeQueue(const TLockFreeQueue&) = delete;
+        ~TLockFreeQueue()
+        {
+            cancel();
+        }
+
+        bool tryPush(const T& value)
+        {
+            if (m_canceled.load(std::memory_order_relaxed) || !enqueue(value))
+            {
+                return false;
+            }
+
+            wakeConsumers();
+            return true;
+        }
+
+        /**
+         * @brief Pushes \p value, waiting for a free cell while the queue is full.
+         * @return false if the queue was canceled.
+         */
+        bool push(const T& value)
+        {
+            while (!tryPush(value))
+            {
+                if (!park(m_pushWaiters, m_pushEpoch, [this]() { return drained(); }))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Pushes \p values in order, waking the consumers once.
+         * @return Number of values pushed, it is less than requested when the queue is full and \p wait is false
+         * or when the queue is canceled.
+         */
+        size_t pushBulk(const std::vector<T>& values, const bool wait = true)
+        {
+            size_t ret {0};
+
+            while (ret < values.size() && !m_canceled.load(std::memory_order_relaxed))
+            {
+                if (enqueue(values[ret]))
+                {
+                    ++ret;
+                }
+                else
+                {
+                    // Let the consumers drain what is already queued before parking.
+                    wake(m_popWaiters, m_popEpoch, true);
+
+                    if (!wait || !park(m_pushWaiters, m_pushEpoch, [this]() { return drained(); }))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (ret > 0)
+            {
+                wake(m_popWaiters, m_popEpoch, true);
+            }
+
+            return ret;
+        }
+
+        bool pop(U& value, const bool wait = true)
+        {
+            while (!m_canceled.load(std::memory_order_relaxed))
+            {
+                if (dequeue(value))
+                {
+                    // Pass the wakeup on when more values are pending, the pushes that made them available may
+                    // have woken a single consumer for all of them.
+                    if (!empty())
+                    {
+                        wakeConsumers();
+                    }
+
+                    wakeProducers();
+                    return true;
+                }
+
+                if (!wait || !park(m_popWaiters, m_popEpoch, [this]() { return !empty(); }))
+                {
+                    break;
+                }
+            }
+
+            return false;
+        }
+
+        std::shared_ptr<U> pop(const bool wait = true)
+        {
+            U value;
+            return pop(value, wait) ? std::make_shared<U>(std::move(value)) : nullptr;
+        }
+
+        /**
+         * @brief Appends up to \p elementsQuantity values to \p values, only waiting for the first one.
+         * @return Number of values popped.
+         */
+        size_t popBulk(std::vector<U>& values, const size_t elementsQuantity, const bool wait = true)
+        {
+            size_t ret {0};
+            U value;
+
+            while (ret < elementsQuantity && pop(value, wait && 0 == ret))
+            {
+                values.push_back(std::move(value));
+                ++ret;
+            }
+
+            if (ret > 0)
+            {
+                wakeProducers();
+            }
+
+            return ret;
+        }
+
+        bool empty() const
+        {
+            return 0 == size();
+        }
+
+        size_t size() const
+        {
+            const auto dequeuePos {m_dequeuePos.load(std::memory_order_acquire)};
+            const auto enqueuePos {m_enqueuePos.load(std::memory_order_acquire)};
+            return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+        }
+
+        size_t capacity() const
+        {
+            return m_cells.size();
+        }
+
+        void cancel()
+        {
+            m_canceled = true;
+            m_popEpoch.fetch_add(1);
+            m_popEpoch.notify_all();
+            m_pushEpoch.fetch_add(1);
+            m_pushEpoch.notify_all();
+        }
+
+        bool cancelled() const
+        {
+            return m_canceled;
+        }
+
+    private:
+        struct alignas(LOCK_FREE_QUEUE_CACHE_LINE) Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static size_t roundCapacity(const size_t capacity)
+        {
+            size_t ret {2};
+
+            while (ret < capacity)
+            {
+                ret <<= 1;
+            }
+
+            return ret;
+        }
+
+        bool enqueue(const T& value)
+        {
+            auto pos {m_enqueuePos.load(std::memory_order_relaxed)};
+
+            while (true)
+            {
+                auto& cell {m_cells[pos & m_mask]};
+                const auto sequence {cell.sequence.load(std::memory_order_acquire)};
+                const auto diff {static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos)};
+
+                if (0 == diff)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.data = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool dequeue(U& value)
+        {
+            auto pos {m_dequeuePos.load(std::memory_order_relaxed)};
+
+            while (true)
+            {
+                auto& cell {m_cells[pos & m_mask]};
+                const auto sequence {cell.sequence.load(std::memory_order_acquire)};
+                const auto diff {static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1)};
+
+                if (0 == diff)
+                {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        value = std::move(cell.data);
+                        cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Producers waiting on a full queue are woken once it is half empty, so they do not wake up on every pop.
+        bool drained() const
+        {
+            return size() <= capacity() / 2;
+        }
+
+        // Consumers only park on an empty queue, so each pushed value wakes one of them while any is parked.
+        void wakeConsumers()
+        {
+            wake(m_popWaiters, m_popEpoch, false);
+        }
+
+        void wakeProducers()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_pushWaiters.load(std::memory_order_relaxed) > 0 && drained())
+            {
+                m_pushEpoch.fetch_add(1);
+                m_pushEpoch.notify_all();
+            }
+        }
+
+        // The waiter registers itself before checking the queue again and the waker checks for waiters after
+        // publishing its cell, the fences order both sides so a wakeup cannot be lost.
+        template<typename Ready>
+        bool park(std::atomic<uint32_t>& waiters, std::atomic<uint32_t>& epoch, Ready ready)
+        {
+            for (size_t i = 0; i < LOCK_FREE_QUEUE_SPIN; ++i)
+            {
+                if (ready() || m_canceled.load(std::memory_order_relaxed))
+                {
+                    return !m_canceled;
+                }
+
+                std::this_thread::yield();
+            }
+
+            const auto current {epoch.load()};
+            waiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!ready() && !m_canceled)
+            {
+                epoch.wait(current);
+            }
+
+            waiters.fetch_sub(1);
+            return !m_canceled;
+        }
+
+        static void wake(std::atomic<uint32_t>& waiters, std::atomic<uint32_t>& epoch, const bool all)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (waiters.load(std::memory_order_relaxed) > 0)
+            {
+                epoch.fetch_add(1);
+
+                if (all)
+                {
+                    epoch.notify_all();
+                }
+                else
+                {
+                    epoch.notify_one();
+                }
+            }
+        }
+
+        std::vector<Cell> m_cells;
+        const size_t m_mask;
+        alignas(LOCK_FREE_QUEUE_CACHE_LINE) std::atomic<size_t> m_enqueuePos {0};
+        alignas(LOCK_FREE_QUEUE_CACHE_LINE) std::atomic<size_t> m_dequeuePos {0};
+        alignas(LOCK_FREE_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_popEpoch {0};
+        std::atomic<uint32_t> m_popWaiters {0};
+        alignas(LOCK_FREE_QUEUE_CACHE_LINE) std::atomic<uint32_t> m_pushEpoch {0};
+        std::atomic<uint32_t> m_pushWaiters {0};
+        std::atomic<bool> m_canceled {false};
+    };
+
+    template<typename T>
+    using LockFreeQueue = TLockFreeQueue<T, T>;
+} // namespace Utils
+
+#endif // LOCK_FREE_QUEUE_H
@@ -11,14 +11,17 @@
 
 #ifndef THREAD_DISPATCHER_H
 #define THREAD_DISPATCHER_H
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <thread>
-#include <atomic>
-#include <future>
 #include <functional>
 #include <iostream>
 #include "threadSafeQueue.h"
-#include "promiseFactory.h"
+#include "threadExecutor.h"
 #include "commonDefs.h"
 
 namespace Utils
@@ -60,6 +63,18 @@ namespace Utils
     //  void cancel();
     // };
 
+    // Number of messages a dispatcher processes before yielding its executor thread to other tasks.
+    constexpr auto DISPATCH_BATCH_SIZE
+    {
+        64u
+    };
+
+    /**
+     * @brief Dispatches the messages to the shared ThreadExecutor.
+     * @details The dispatcher does not own any thread, it keeps its pending messages and schedules up to
+     *          numberOfThreads drain tasks on the executor. With one thread the messages are processed one at a
+     *          time in the order they were pushed.
+     */
     template
     <
         typename Type,
@@ -69,17 +84,9 @@ namespace Utils
     {
         public:
             AsyncDispatcher(Functor functor, const unsigned int numberOfThreads = std::thread::hardware_concurrency(), const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
-                : m_functor{ functor }
-                , m_running{ true }
-                , m_numberOfThreads{ numberOfThreads ? numberOfThreads : 1 }
-                , m_maxQueueSize { maxQueueSize }
+                : m_executor{ ThreadExecutor::instance() }
+                , m_state{ std::make_shared<State>(functor, numberOfThreads ? numberOfThreads : 1, maxQueueSize) }
             {
-                m_threads.reserve(m_numberOfThreads);
-
-                for (unsigned int i = 0; i < m_numberOfThreads; ++i)
-                {
-                    m_threads.push_back(std::thread{ &AsyncDispatcher<Type, Functor>::dispatch, this });
-                }
             }
             AsyncDispatcher& operator=(const AsyncDispatcher&) = delete;
             AsyncDispatcher(AsyncDispatcher& other) = delete;
@@ -90,94 +97,165 @@ namespace Utils
 
             void push(const Type& value)
             {
-                if (m_running)
+                bool schedule { false };
                 {
-                    if (UNLIMITED_QUEUE_SIZE == m_maxQueueSize || m_queue.size() < m_maxQueueSize)
+                    std::lock_guard<std::mutex> lock{ m_state->mutex };
+
+                    if (m_state->running)
                     {
-                        m_queue.push
-                        (
-                            [value, this]()
+                        if (UNLIMITED_QUEUE_SIZE == m_state->maxQueueSize || m_state->queue.size() < m_state->maxQueueSize)
                         {
-                            this->m_functor(value);
+                            m_state->queue.push_back(value);
+                            schedule = reserveTask(*m_state);
                         }
-                        );
                     }
                 }
+
+                if (schedule)
+                {
+                    scheduleTask(m_executor, m_state);
+                }
             }
 
             void rundown()
             {
-                if (m_running)
+                std::unique_lock<std::mutex> lock{ m_state->mutex };
+
+                // The pending messages are processed on the calling thread when there is a free slot, so a
+                // rundown does not depend on the executor threads, which may all be waiting on other dispatchers.
+                while (m_state->running && (!m_state->queue.empty() || m_state->active > 0))
                 {
-                    auto promise { PromiseFactory<PROMISE_TYPE>::getPromiseObject() };
-                    m_queue.push
-                    (
-                        [&promise]()
+                    if (!m_state->queue.empty() && (m_state->scheduled > 0 || m_state->active < m_state->numberOfThreads))
                     {
-                        promise->set_value();
+                        if (m_state->scheduled > 0)
+                        {
+                            --m_state->scheduled;
+                        }
+
+                        drain(*m_state, lock, std::numeric_limits<size_t>::max());
+                    }
+                    else
+                    {
+                        m_state->condition.wait(lock);
                     }
-                    );
-                    promise->wait();
-                    cancel();
                 }
+
+                lock.unlock();
+                cancel();
             }
             void cancel()
             {
-                m_running = false;
-                m_queue.cancel();
-                joinThreads();
+                std::unique_lock<std::mutex> lock{ m_state->mutex };
+                m_state->running = false;
+                m_state->queue.clear();
+                m_state->condition.wait(lock, [this]()
+                {
+                    return 0 == m_state->active;
+                });
             }
 
             bool cancelled() const
             {
-                return !m_running;
+                std::lock_guard<std::mutex> lock{ m_state->mutex };
+                return !m_state->running;
             }
             unsigned int numberOfThreads() const
             {
-                return m_numberOfThreads;
+                return m_state->numberOfThreads;
             }
             size_t size() const
             {
-                return m_queue.size();
+                std::lock_guard<std::mutex> lock{ m_state->mutex };
+                return m_state->queue.size();
             }
 
         private:
-            void dispatch()
+            // Shared with the scheduled tasks, which may run after the dispatcher is gone.
+            struct State final
             {
-                try
+                State(Functor stateFunctor, const unsigned int threads, const size_t maxSize)
+                    : functor{ stateFunctor }
+                    , numberOfThreads{ threads }
+                    , maxQueueSize{ maxSize }
                 {
-                    while (m_running)
+                }
+
+                Functor functor;
+                mutable std::mutex mutex;
+                std::condition_variable condition;
+                std::deque<Type> queue;
+                unsigned int scheduled{ 0 };
+                unsigned int active{ 0 };
+                bool running{ true };
+                const unsigned int numberOfThreads;
+                const size_t maxQueueSize;
+            };
+
+            static bool reserveTask(State& state)
+            {
+                if (state.scheduled + state.active < state.numberOfThreads)
+                {
+                    ++state.scheduled;
+                    return true;
+                }
+
+                return false;
+            }
+
+            static void scheduleTask(ThreadExecutor& executor, const std::shared_ptr<State>& state)
+            {
+                executor.submit([&executor, state]()
+                {
+                    bool schedule { false };
                     {
-                        std::function<void()> fnc;
+                        std::unique_lock<std::mutex> lock{ state->mutex };
 
-                        if (m_queue.pop(fnc))
+                        // The slot may have been taken over by a rundown.
+                        if (0 == state->scheduled)
                         {
-                            fnc();
+                            return;
                         }
+
+                        --state->scheduled;
+                        drain(*state, lock, DISPATCH_BATCH_SIZE);
+                        schedule = state->running && !state->queue.empty() && reserveTask(*state);
                     }
-                }
-                catch (const std::exception& ex)
-                {
-                    std::cerr << "Dispatch handler error, " << ex.what() << std::endl;
-                }
+
+                    if (schedule)
+                    {
+                        scheduleTask(executor, state);
+                    }
+                });
             }
-            void joinThreads()
+
+            static void drain(State& state, std::unique_lock<std::mutex>& lock, const size_t maxMessages)
             {
-                for (auto& thread : m_threads)
+                ++state.active;
+
+                for (size_t i = 0; i < maxMessages && state.running && !state.queue.empty(); ++i)
                 {
-                    if (thread.joinable())
+                    auto value { std::move(state.queue.front()) };
+                    state.queue.pop_front();
+                    lock.unlock();
+
+                    try
+                    {
+                        state.functor(value);
+                    }
+                    catch (const std::exception& ex)
                     {
-                        thread.join();
+                        std::cerr << "Dispatch handler error, " << ex.what() << std::endl;
                     }
+
+                    lock.lock();
                 }
+
+                --state.active;
+                state.condition.notify_all();
             }
 
-            Functor m_functor;
-            SafeQueue<std::function<void()>> m_queue;
-            std::vector<std::thread> m_threads;
-            std::atomic_bool m_running;
-            const unsigned int m_numberOfThreads;
-            const size_t m_maxQueueSize;
+            ThreadExecutor& m_executor;
+            std::shared_ptr<State> m_state;
     };
 
     template <typename Input, typename Functor>
@@ -0,0 +1,276 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef THREAD_EXECUTOR_H
+#define THREAD_EXECUTOR_H
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+    struct ThreadExecutorStats final
+    {
+        unsigned int numberOfThreads;
+        size_t queueDepth;
+        size_t injectedDepth;
+        std::vector<size_t> workerDepths;
+        uint64_t executed;
+        uint64_t stolen;
+    };
+
+    /**
+     * @brief Process-wide work stealing executor.
+     * @details Every worker thread owns a task deque and the tasks submitted from outside of the workers go to a
+     *          global injection queue. An idle worker takes its own tasks first, then the injected ones and then
+     *          steals from the other workers, so the threads are shared by all the dispatchers of the process
+     *          instead of being created for each of them.
+     */
+    class ThreadExecutor final
+    {
+        public:
+            static ThreadExecutor& instance()
+            {
+                static ThreadExecutor s_instance;
+                return s_instance;
+            }
+
+            ThreadExecutor(const ThreadExecutor&) = delete;
+            ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+
+            ~ThreadExecutor()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                    m_running = false;
+                }
+                m_condition.notify_all();
+
+                for (auto& thread : m_threads)
+                {
+                    if (thread.joinable())
+                    {
+                        thread.join();
+                    }
+                }
+            }
+
+            /**
+             * @brief Queues \p task to be run by a worker.
+             * @details Tasks submitted from a worker go to its own deque, so the work spawned by a task stays on
+             *          the same thread unless an idle worker steals it.
+             */
+            void submit(std::function<void()> task)
+            {
+                if (s_current == this)
+                {
+                    auto& worker { *m_workers[s_workerIndex] };
+                    std::lock_guard<std::mutex> lock{ worker.mutex };
+                    worker.tasks.push_back(std::move(task));
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> lock{ m_injectionMutex };
+                    m_injection.push_back(std::move(task));
+                }
+
+                ++m_pending;
+
+                if (m_sleeping > 0)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                    }
+                    m_condition.notify_one();
+                }
+            }
+
+            unsigned int numberOfThreads() const
+            {
+                return static_cast<unsigned int>(m_threads.size());
+            }
+
+            size_t queueDepth() const
+            {
+                return m_pending;
+            }
+
+            ThreadExecutorStats stats() const
+            {
+                ThreadExecutorStats ret
+                {
+                    numberOfThreads(), queueDepth(), 0, {}, 0, 0
+                };
+
+                {
+                    std::lock_guard<std::mutex> lock{ m_injectionMutex };
+                    ret.injectedDepth = m_injection.size();
+                }
+
+                for (const auto& worker : m_workers)
+                {
+                    std::lock_guard<std::mutex> lock{ worker->mutex };
+                    ret.workerDepths.push_back(worker->tasks.size());
+                    ret.executed += worker->executed;
+                    ret.stolen += worker->stolen;
+                }
+
+                return ret;
+            }
+
+        private:
+            struct Worker final
+            {
+                mutable std::mutex mutex;
+                std::deque<std::function<void()>> tasks;
+                std::atomic<uint64_t> executed{ 0 };
+                std::atomic<uint64_t> stolen{ 0 };
+            };
+
+            explicit ThreadExecutor(const unsigned int numberOfThreads = std::thread::hardware_concurrency())
+                : m_running{ true }
+                , m_pending{ 0 }
+                , m_sleeping{ 0 }
+            {
+                const auto threads { numberOfThreads ? numberOfThreads : 1 };
+                m_workers.reserve(threads);
+                m_threads.reserve(threads);
+
+                for (unsigned int i = 0; i < threads; ++i)
+                {
+                    m_workers.push_back(std::make_unique<Worker>());
+                }
+
+                for (unsigned int i = 0; i < threads; ++i)
+                {
+                    m_threads.push_back(std::thread{ &ThreadExecutor::work, this, i });
+                }
+            }
+
+            bool popOwn(const size_t index, std::function<void()>& task)
+            {
+                auto& worker { *m_workers[index] };
+                std::lock_guard<std::mutex> lock{ worker.mutex };
+
+                if (worker.tasks.empty())
+                {
+                    return false;
+                }
+
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+                return true;
+            }
+
+            bool popInjected(std::function<void()>& task)
+            {
+                std::lock_guard<std::mutex> lock{ m_injectionMutex };
+
+                if (m_injection.empty())
+                {
+                    return false;
+                }
+
+                task = std::move(m_injection.front());
+                m_injection.pop_front();
+                return true;
+            }
+
+            bool steal(const size_t index, std::function<void()>& task)
+            {
+                // Thieves take from the back, away from the owner, starting by the next worker.
+                for (size_t i = 1; i < m_workers.size(); ++i)
+                {
+                    auto& victim { *m_workers[(index + i) % m_workers.size()] };
+                    std::lock_guard<std::mutex> lock{ victim.mutex };
+
+                    if (!victim.tasks.empty())
+                    {
+                        task = std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                        ++m_workers[index]->stolen;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            void work(const size_t index)
+            {
+                s_current = this;
+                s_workerIndex = index;
+
+                while (true)
+                {
+                    std::function<void()> task;
+
+                    if (popOwn(index, task) || popInjected(task) || steal(index, task))
+                    {
+                        --m_pending;
+
+                        try
+                        {
+                            task();
+                        }
+                        // LCOV_EXCL_START
+                        catch (const std::exception& ex)
+                        {
+                            std::cerr << "Executor task error, " << ex.what() << std::endl;
+                        }
+                        // LCOV_EXCL_STOP
+
+                        ++m_workers[index]->executed;
+                    }
+                    else
+                    {
+                        std::unique_lock<std::mutex> lock{ m_sleepMutex };
+                        ++m_sleeping;
+                        m_condition.wait(lock, [this]()
+                        {
+                            return m_pending > 0 || !m_running;
+                        });
+                        --m_sleeping;
+
+                        if (!m_running && 0 == m_pending)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                s_current = nullptr;
+            }
+
+            std::vector<std::unique_ptr<Worker>> m_workers;
+            std::vector<std::thread> m_threads;
+            mutable std::mutex m_injectionMutex;
+            std::deque<std::function<void()>> m_injection;
+            std::mutex m_sleepMutex;
+            std::condition_variable m_condition;
+            bool m_running;
+            std::atomic<size_t> m_pending;
+            std::atomic<unsigned int> m_sleeping;
+            static thread_local ThreadExecutor* s_current;
+            static thread_local size_t s_workerIndex;
+    };
+
+    inline thread_local ThreadExecutor* ThreadExecutor::s_current { nullptr };
+    inline thread_local size_t ThreadExecutor::s_workerIndex { 0 };
+}//namespace Utils
+#endif //THREAD_EXECUTOR_H
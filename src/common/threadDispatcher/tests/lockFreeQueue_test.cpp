@@ -0,0 +1,270 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 19, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include "lockFreeQueue_test.h"
+#include "lockFreeQueue.h"
+
+void LockFreeQueueTest::SetUp() {};
+
+void LockFreeQueueTest::TearDown() {};
+
+using namespace Utils;
+TEST_F(LockFreeQueueTest, Ctor)
+{
+    LockFreeQueue<int> queue{5};
+    int ret_val{};
+    EXPECT_EQ(8ul, queue.capacity());
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.cancelled());
+    EXPECT_FALSE(queue.pop(ret_val, false));//non wait pop;
+    auto spValue{queue.pop(false)};
+    EXPECT_FALSE(spValue);
+}
+
+TEST_F(LockFreeQueueTest, NonBlockingPushAndPop)
+{
+    LockFreeQueue<int> queue{4};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+
+    EXPECT_FALSE(queue.tryPush(4));//full queue;
+    EXPECT_EQ(4ul, queue.size());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int ret_val{};
+        EXPECT_TRUE(queue.pop(ret_val, false));
+        EXPECT_EQ(i, ret_val);
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.tryPush(5));
+    auto spValue{queue.pop(false)};
+    ASSERT_TRUE(spValue);
+    EXPECT_EQ(5, *spValue);
+}
+
+TEST_F(LockFreeQueueTest, BlockingPop)
+{
+    LockFreeQueue<int> queue{4};
+    std::thread t1
+    {
+        [&queue]()
+        {
+            int ret_val{};
+            EXPECT_TRUE(queue.pop(ret_val));
+            EXPECT_EQ(0, ret_val);
+        }
+    };
+    queue.push(0);
+    t1.join();
+}
+
+TEST_F(LockFreeQueueTest, BlockingPushOnFullQueue)
+{
+    LockFreeQueue<int> queue{2};
+    EXPECT_TRUE(queue.push(0));
+    EXPECT_TRUE(queue.push(1));
+    std::thread t1
+    {
+        [&queue]()
+        {
+            EXPECT_TRUE(queue.push(2));
+        }
+    };
+    int ret_val{};
+    EXPECT_TRUE(queue.pop(ret_val));
+    EXPECT_EQ(0, ret_val);
+    t1.join();
+    EXPECT_TRUE(queue.pop(ret_val));
+    EXPECT_EQ(1, ret_val);
+    EXPECT_TRUE(queue.pop(ret_val));
+    EXPECT_EQ(2, ret_val);
+}
+
+TEST_F(LockFreeQueueTest, PushAndPopBulk)
+{
+    LockFreeQueue<int> queue{8};
+    std::vector<int> values(10);
+    std::iota(values.begin(), values.end(), 0);
+
+    EXPECT_EQ(8ul, queue.pushBulk(values, false));//only fits the capacity;
+
+    std::vector<int> popped;
+    EXPECT_EQ(5ul, queue.popBulk(popped, 5));
+    EXPECT_EQ(3ul, queue.popBulk(popped, 5));
+    EXPECT_EQ(0ul, queue.popBulk(popped, 5, false));
+    ASSERT_EQ(8ul, popped.size());
+
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(i, popped[i]);
+    }
+}
+
+TEST_F(LockFreeQueueTest, BlockingPushBulk)
+{
+    constexpr auto NUMBER_OF_ITEMS { 1000 };
+    LockFreeQueue<int> queue{16};
+    std::vector<int> values(NUMBER_OF_ITEMS);
+    std::iota(values.begin(), values.end(), 0);
+    std::thread t1
+    {
+        [&queue, &values]()
+        {
+            EXPECT_EQ(values.size(), queue.pushBulk(values));
+        }
+    };
+    std::vector<int> popped;
+
+    while (popped.size() < values.size())
+    {
+        queue.popBulk(popped, 32);
+    }
+
+    t1.join();
+    EXPECT_EQ(values, popped);
+}
+
+TEST_F(LockFreeQueueTest, MultipleProducersAndConsumers)
+{
+    constexpr auto NUMBER_OF_THREADS { 4 };
+    constexpr auto ITEMS_PER_PRODUCER { 10000 };
+    LockFreeQueue<int64_t> queue{64};
+    std::atomic<int64_t> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+        threads.emplace_back([&queue]()
+        {
+            for (int64_t value = 1; value <= ITEMS_PER_PRODUCER; ++value)
+            {
+                queue.push(value);
+            }
+        });
+        threads.emplace_back([&queue, &sum, &consumed]()
+        {
+            int64_t value{};
+
+            while (queue.pop(value))
+            {
+                sum += value;
+
+                if (NUMBER_OF_THREADS * ITEMS_PER_PRODUCER == ++consumed)
+                {
+                    queue.cancel();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(NUMBER_OF_THREADS * ITEMS_PER_PRODUCER, consumed);
+    EXPECT_EQ(static_cast<int64_t>(NUMBER_OF_THREADS) * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2, sum);
+}
+
+TEST_F(LockFreeQueueTest, ParkedConsumersEachPopOnce)
+{
+    constexpr auto NUMBER_OF_CONSUMERS { 4 };
+    constexpr auto ROUNDS { 50 };
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        LockFreeQueue<int> queue{64};
+        std::atomic<int> consumed{0};
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < NUMBER_OF_CONSUMERS; ++i)
+        {
+            threads.emplace_back([&queue, &consumed]()
+            {
+                int value{};
+
+                if (queue.pop(value))
+                {
+                    ++consumed;
+                }
+            });
+        }
+
+        // Let the consumers park on the empty queue, then push one value per consumer from several producers.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        for (int i = 0; i < NUMBER_OF_CONSUMERS; ++i)
+        {
+            threads.emplace_back([&queue, i]()
+            {
+                queue.push(i);
+            });
+        }
+
+        const auto deadline { std::chrono::steady_clock::now() + std::chrono::seconds(5) };
+
+        while (NUMBER_OF_CONSUMERS != consumed && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        EXPECT_EQ(NUMBER_OF_CONSUMERS, consumed);
+        EXPECT_TRUE(queue.empty());
+
+        // Releases the consumers that would be left parked on a lost wakeup.
+        queue.cancel();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+TEST_F(LockFreeQueueTest, CancelBlockingCalls)
+{
+    LockFreeQueue<int> queue{2};
+    queue.push(0);
+    queue.push(1);
+    std::thread t1
+    {
+        [&queue]()
+        {
+            EXPECT_FALSE(queue.push(2));
+            EXPECT_TRUE(queue.cancelled());
+        }
+    };
+    LockFreeQueue<int> emptyQueue{2};
+    std::thread t2
+    {
+        [&emptyQueue]()
+        {
+            int ret_val{};
+            EXPECT_FALSE(emptyQueue.pop(ret_val));
+            EXPECT_TRUE(emptyQueue.cancelled());
+        }
+    };
+    queue.cancel();
+    emptyQueue.cancel();
+    t1.join();
+    t2.join();
+    int ret_val{};
+    EXPECT_FALSE(queue.pop(ret_val, false));
+}
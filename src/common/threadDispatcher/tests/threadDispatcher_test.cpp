@@ -121,3 +121,138 @@ TEST_F(ThreadDispatcherTest, AsyncDispatcherQueue)
     dispatcher.rundown();
 }
 
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherSingleThreadKeepsOrder)
+{
+    constexpr auto NUMBER_OF_ITEMS { 1000 };
+    std::vector<int> values;
+
+    AsyncDispatcher<int, std::function<void(int)>> dispatcher
+    {
+        [&values](int value)
+        {
+            values.push_back(value);
+        }
+        , 1
+    };
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        dispatcher.push(i);
+    }
+
+    dispatcher.rundown();
+    ASSERT_EQ(static_cast<size_t>(NUMBER_OF_ITEMS), values.size());
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        EXPECT_EQ(i, values[i]);
+    }
+}
+
+TEST_F(ThreadDispatcherTest, AsyncDispatchersShareExecutor)
+{
+    constexpr auto NUMBER_OF_DISPATCHERS { 64 };
+    constexpr auto NUMBER_OF_ITEMS { 100 };
+    auto& executor { ThreadExecutor::instance() };
+    const auto executedBefore { executor.stats().executed };
+    std::atomic<int> calls { 0 };
+    std::vector<std::unique_ptr<AsyncDispatcher<int, std::function<void(int)>>>> dispatchers;
+
+    for (int i = 0; i < NUMBER_OF_DISPATCHERS; ++i)
+    {
+        dispatchers.push_back(std::make_unique<AsyncDispatcher<int, std::function<void(int)>>>([&calls](int)
+        {
+            ++calls;
+        }));
+    }
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        for (auto& dispatcher : dispatchers)
+        {
+            dispatcher->push(i);
+        }
+    }
+
+    for (auto& dispatcher : dispatchers)
+    {
+        dispatcher->rundown();
+    }
+
+    EXPECT_EQ(NUMBER_OF_DISPATCHERS * NUMBER_OF_ITEMS, calls);
+    EXPECT_EQ(std::max(std::thread::hardware_concurrency(), 1u), executor.numberOfThreads());
+    EXPECT_LE(executedBefore, executor.stats().executed);
+}
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherRundownOnBusyExecutor)
+{
+    auto& executor { ThreadExecutor::instance() };
+    std::mutex mutex;
+    std::condition_variable condition;
+    unsigned int blocked { 0 };
+    bool release { false };
+
+    for (unsigned int i = 0; i < executor.numberOfThreads(); ++i)
+    {
+        executor.submit([&]()
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            ++blocked;
+            condition.notify_all();
+            condition.wait(lock, [&release]()
+            {
+                return release;
+            });
+            --blocked;
+            condition.notify_all();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        condition.wait(lock, [&]()
+        {
+            return executor.numberOfThreads() == blocked;
+        });
+    }
+
+    constexpr auto NUMBER_OF_QUEUED { 3u };
+
+    for (unsigned int i = 0; i < NUMBER_OF_QUEUED; ++i)
+    {
+        executor.submit([]() {});
+    }
+
+    const auto stats { executor.stats() };
+    EXPECT_EQ(NUMBER_OF_QUEUED, stats.queueDepth);
+    EXPECT_EQ(NUMBER_OF_QUEUED, stats.injectedDepth);
+    EXPECT_EQ(executor.numberOfThreads(), stats.workerDepths.size());
+
+    // Every executor thread is busy, the rundown processes the messages on this thread.
+    std::vector<int> values;
+    AsyncDispatcher<int, std::function<void(int)>> dispatcher
+    {
+        [&values](int value)
+        {
+            values.push_back(value);
+        }
+        , 1
+    };
+
+    for (int i = 0; i < 10; ++i)
+    {
+        dispatcher.push(i);
+    }
+
+    dispatcher.rundown();
+    EXPECT_EQ(10ul, values.size());
+
+    std::unique_lock<std::mutex> lock{ mutex };
+    release = true;
+    condition.notify_all();
+    condition.wait(lock, [&blocked]()
+    {
+        return 0 == blocked;
+    });
+}
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <ctime>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <stack>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <commonDefs.h>
 #include <dbsync.hpp>
@@ -23,6 +30,13 @@
 class Inventory
 {
 public:
+    struct ScanMetrics
+    {
+        std::chrono::milliseconds lastDuration {0};  // Duration of the last scan
+        std::chrono::milliseconds totalDuration {0}; // Accumulated duration of all scans
+        uint64_t scans {0};                          // Number of scans
+    };
+
     static Inventory& Instance()
     {
         static Inventory s_instance;
@@ -42,11 +56,11 @@ public:
     void SetPushMessageFunction(const std::function<int(Message)>& pushMessage);
 
     void Init(const std::shared_ptr<ISysInfo>& spInfo,
-              const std::function<void(const std::string&)>& reportDiffFunction,
+              const std::function<void(nlohmann::json&)>& reportDiffFunction,
               const std::string& dbPath,
               const std::string& normalizerConfigPath,
               const std::string& normalizerType);
-    virtual void SendDeltaEvent(const std::string& data);
+    virtual void SendDeltaEvent(nlohmann::json& event);
 
     const std::string& AgentUUID() const
     {
@@ -58,7 +72,24 @@ public:
         m_agentUUID = agentUUID;
     }
 
+    std::map<std::string, ScanMetrics> GetScanMetrics() const;
+
 private:
+    struct ScanCategory
+    {
+        std::string name;                               // Category name, same as its table
+        std::function<void()> scan;                     // Scan function
+        std::chrono::milliseconds interval;             // Time between scans
+        std::chrono::steady_clock::time_point nextScan; // Time of the next scan
+    };
+
+    struct ChurnEntry
+    {
+        std::string table;                              // Table of the row
+        nlohmann::json item;                            // Created row, with the changes received since
+        std::chrono::steady_clock::time_point deadline; // Time at which the creation is reported
+    };
+
     Inventory();
     ~Inventory() = default;
     Inventory(const Inventory&) = delete;
@@ -94,14 +125,24 @@ private:
                      const bool isFirstScan);
 
     void TryCatchTask(const std::function<void()>& task) const;
+    void RunScan(const std::string& category, const std::function<void()>& scan);
     void ScanHardware();
     void ScanSystem();
     void ScanNetwork();
     void ScanPackages();
+    void SyncUnchangedPackages(DBSyncTxn& txn, const std::set<std::string>& changedFormats);
     void ScanHotfixes();
     void ScanPorts();
     void ScanProcesses();
-    void Scan();
+    void ProcessEventsLoop();
+    void NetworkEventsLoop();
+    void SyncProcesses(const std::set<int32_t>& changed, const std::set<int32_t>& exited);
+    bool CoalesceChurn(ReturnTypeCallback result, const nlohmann::json& item, const std::string& table);
+    void FlushChurn(const bool all);
+    void ReportChurn();
+    void ChurnLoop();
+    std::vector<ScanCategory> GetScanCategories();
+    void Scan(const std::vector<const ScanCategory*>& categories);
     void SyncLoop();
     void ShowConfig();
     cJSON* Dump() const;
@@ -110,55 +151,63 @@ private:
     std::string GetPrimaryKeys(const nlohmann::json& data, const std::string& table);
     std::string CalculateHashId(const nlohmann::json& data, const std::string& table);
     nlohmann::json AddPreviousFields(nlohmann::json& current, const nlohmann::json& previous);
-    nlohmann::json
-    GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data);
+    nlohmann::json GenerateStatelessEvent(const std::string& operation,
+                                          const std::string& type,
+                                          const nlohmann::json& data,
+                                          const std::string& scanTime);
+    std::string ScanTime() const;
 
     void WriteMetadata(const std::string& key, const std::string& value);
     std::string ReadMetadata(const std::string& key);
     void DeleteMetadata(const std::string& key);
     void CleanMetadata();
 
-    void SetJsonField(nlohmann::json& target,
-                      const nlohmann::json& source,
-                      const std::string& keyPath,
-                      const std::string& jsonKey,
-                      const std::optional<std::string>& defaultValue,
-                      bool createFields);
-    void SetJsonFieldArray(nlohmann::json& target,
-                           const nlohmann::json& source,
-                           const std::string& destPath,
-                           const std::string& sourceKey,
-                           bool createFields);
 
     const std::string m_moduleName {"inventory"};
     std::string m_agentUUID {""}; // Agent UUID
     std::shared_ptr<ISysInfo> m_spInfo;
-    std::function<void(const std::string&)> m_reportDiffFunction;
+    std::function<void(nlohmann::json&)> m_reportDiffFunction;
     bool m_enabled;              // Main switch
     std::string m_dbFilePath;    // Database path
     std::time_t m_intervalValue; // Scan interval
+    std::map<std::string, std::time_t> m_categoryIntervals; // Per category scan intervals
     bool m_scanOnStart;          // Scan always on start
     bool m_hardware;             // Hardware inventory
     bool m_system;               // System inventory
     bool m_networks;             // Networks inventory
+    bool m_networksEvents;       // Rescan networks when the kernel reports changes
     bool m_packages;             // Installed packages inventory
     bool m_ports;                // Opened ports inventory
     bool m_portsAll;             // Scan only listening ports or all
     bool m_processes;            // Running processes inventory
+    bool m_processesEvents;      // Track process events between processes scans
     bool m_hotfixes;             // Windows hotfixes installed
+    unsigned int m_scanThreads;  // Categories scanned concurrently
+    std::chrono::milliseconds m_churnWindow; // Time a process or port must live to be reported, 0 reports all
     std::atomic<bool> m_stopping;
-    bool m_notify;
+    std::atomic<bool> m_notify;
     std::unique_ptr<DBSync> m_spDBSync;
     std::condition_variable m_cv;
-    std::mutex m_mutex;
+    std::mutex m_mutex;          // Serializes the writes to the shared DBSync handle, transactions included
+    std::mutex m_processesMutex; // Serializes processes scans and process events
+    std::mutex m_networksMutex;  // Serializes scheduled and event driven networks scans
     std::unique_ptr<InvNormalizer> m_spNormalizer;
     std::string m_scanTime;
+    mutable std::mutex m_scanTimeMutex; // Scan time is read by the event threads while a scan sets it
     std::function<int(Message)> m_pushMessage;
     bool m_hardwareFirstScan;  // Hardware first scan flag
     bool m_systemFirstScan;    // System first scan flag
-    bool m_networksFirstScan;  // Networks first scan flag
+    std::atomic<bool> m_networksFirstScan; // Networks first scan flag
     bool m_packagesFirstScan;  // Installed packages first scan flag
     bool m_portsFirstScan;     // Opened ports first scan flag
-    bool m_processesFirstScan; // Running processes first scan flag
+    std::atomic<bool> m_processesFirstScan; // Running processes first scan flag
     bool m_hotfixesFirstScan;  // Windows hotfixes installed first scan flag
+    nlohmann::json m_packagesFingerprints; // Package sources fingerprints of the last complete scan
+    mutable std::mutex m_metricsMutex;
+    std::map<std::string, ScanMetrics> m_scanMetrics; // Scan metrics by category
+    std::mutex m_churnMutex; // Orders the held creations with the other processes and ports events
+    std::condition_variable m_churnCv; // Wakes the churn flush timer up when stopping
+    std::unordered_map<std::string, ChurnEntry> m_churnPending; // Unreported creations by table and primary key
+    std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> m_churnDeadlines; // By deadline
+    std::map<std::string, uint64_t> m_churnSuppressed; // Suppressed rows by table since the last report
 };
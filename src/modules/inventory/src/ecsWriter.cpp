@@ -0,0 +1,114 @@
+#include "ecsWriter.hpp"
+#include <sharedDefs.h>
+
+#include <algorithm>
+
+static bool IsEmptyValue(const nlohmann::json& value)
+{
+    return value.is_string() && value.get_ref<const std::string&>() == EMPTY_VALUE;
+}
+
+EcsWriter::EcsWriter(const EcsField* fields, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto* nodes = &m_root;
+        std::string_view path = fields[i].path;
+
+        while (!path.empty())
+        {
+            path.remove_prefix(1);
+            const auto end = std::min(path.find('/'), path.size());
+            const auto key = path.substr(0, end);
+            path.remove_prefix(end);
+
+            auto it = std::find_if(nodes->begin(), nodes->end(), [&key](const Node& node) { return node.key == key; });
+
+            if (it == nodes->end())
+            {
+                it = nodes->insert(nodes->end(), Node {std::string(key), {}, EcsFieldType::VALUE, {}});
+            }
+
+            if (path.empty())
+            {
+                it->column = fields[i].column;
+                it->type = fields[i].type;
+            }
+
+            nodes = &it->children;
+        }
+    }
+
+    Sort(m_root);
+}
+
+void EcsWriter::Sort(std::vector<Node>& nodes)
+{
+    // Same order as the objects of the document, so the keys are always appended at the end
+    std::sort(nodes.begin(), nodes.end(), [](const Node& lhs, const Node& rhs) { return lhs.key < rhs.key; });
+
+    for (auto& node : nodes)
+    {
+        Sort(node.children);
+    }
+}
+
+nlohmann::json EcsWriter::Write(const nlohmann::json& source, bool createFields) const
+{
+    nlohmann::json::object_t document;
+    WriteObject(m_root, source, createFields, document);
+    return document.empty() ? nlohmann::json {} : nlohmann::json(std::move(document));
+}
+
+void EcsWriter::WriteObject(const std::vector<Node>& nodes,
+                            const nlohmann::json& source,
+                            bool createFields,
+                            nlohmann::json::object_t& target)
+{
+    for (const auto& node : nodes)
+    {
+        if (!node.children.empty())
+        {
+            nlohmann::json::object_t child;
+            WriteObject(node.children, source, createFields, child);
+
+            if (!child.empty())
+            {
+                target.emplace_hint(target.end(), node.key, std::move(child));
+            }
+            continue;
+        }
+
+        if (node.type == EcsFieldType::NULL_VALUE)
+        {
+            if (createFields)
+            {
+                target.emplace_hint(target.end(), node.key, nullptr);
+            }
+            continue;
+        }
+
+        const auto it = source.find(node.column);
+        const auto present = it != source.end();
+
+        if (!createFields && !present)
+        {
+            continue;
+        }
+
+        if (node.type == EcsFieldType::ARRAY)
+        {
+            auto array = nlohmann::json::array();
+
+            if (present && !it->empty() && !it->is_null() && !IsEmptyValue(*it))
+            {
+                array.push_back(*it);
+            }
+            target.emplace_hint(target.end(), node.key, std::move(array));
+        }
+        else
+        {
+            target.emplace_hint(target.end(), node.key, present && !IsEmptyValue(*it) ? *it : nlohmann::json(nullptr));
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief How a column is written into the ECS document
+enum class EcsFieldType
+{
+    VALUE,     ///< The column value, null when missing or empty
+    ARRAY,     ///< An array holding the column value, empty when missing or empty
+    NULL_VALUE ///< Always null, the column is ignored
+};
+
+/// @brief Maps a table column to an ECS path
+struct EcsField
+{
+    std::string_view column;
+    std::string_view path;
+    EcsFieldType type;
+};
+
+/// @brief Writes the ECS document of a table row
+///
+/// The paths of the mapping are split once into a tree sorted by key, so each row is written in a single pass over
+/// the tree, appending every key at the end of its object without parsing any path.
+class EcsWriter
+{
+public:
+    /// @brief Constructor
+    /// @param fields Mapping of the table
+    template<size_t N>
+    explicit EcsWriter(const std::array<EcsField, N>& fields)
+        : EcsWriter(fields.data(), N)
+    {
+    }
+
+    /// @brief Constructor
+    /// @param fields Mapping of the table
+    /// @param count Number of fields
+    EcsWriter(const EcsField* fields, size_t count);
+
+    /// @brief Writes the ECS document of a row
+    /// @param source Row of the table
+    /// @param createFields Whether the columns missing in the row are written too
+    /// @return The document, null if no field was written
+    nlohmann::json Write(const nlohmann::json& source, bool createFields) const;
+
+private:
+    struct Node
+    {
+        std::string key;
+        std::string column;
+        EcsFieldType type;
+        std::vector<Node> children;
+    };
+
+    static void Sort(std::vector<Node>& nodes);
+    static void WriteObject(const std::vector<Node>& nodes,
+                            const nlohmann::json& source,
+                            bool createFields,
+                            nlohmann::json::object_t& target);
+
+    std::vector<Node> m_root;
+};
@@ -26,7 +26,7 @@ void Inventory::Start()
     {
         Inventory::Instance().Init(
             std::make_shared<SysInfo>(),
-            [this](const std::string& diff) { this->SendDeltaEvent(diff); },
+            [this](nlohmann::json& diff) { this->SendDeltaEvent(diff); },
             m_dbFilePath,
             INVENTORY_NORM_CONFIG_DISK_PATH,
             INVENTORY_NORM_TYPE);
@@ -55,6 +55,17 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
         INVENTORY_DB_DISK_NAME;
     m_intervalValue = configurationParser->GetConfig<std::time_t>("inventory", "interval")
                           .value_or(config::inventory::DEFAULT_INTERVAL);
+
+    m_categoryIntervals.clear();
+    for (const auto& category : {"hardware", "system", "networks", "packages", "ports", "processes", "hotfixes"})
+    {
+        const auto interval = configurationParser->GetConfig<std::time_t>("inventory", "intervals", category);
+        if (interval.has_value())
+        {
+            m_categoryIntervals[category] = interval.value();
+        }
+    }
+
     m_scanOnStart = configurationParser->GetConfig<bool>("inventory", "scan_on_start")
                         .value_or(config::inventory::DEFAULT_SCAN_ON_START);
     m_hardware =
@@ -62,6 +73,8 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
     m_system = configurationParser->GetConfig<bool>("inventory", "system").value_or(config::inventory::DEFAULT_OS);
     m_networks =
         configurationParser->GetConfig<bool>("inventory", "networks").value_or(config::inventory::DEFAULT_NETWORK);
+    m_networksEvents = configurationParser->GetConfig<bool>("inventory", "networks_events")
+                           .value_or(config::inventory::DEFAULT_NETWORKS_EVENTS);
     m_packages =
         configurationParser->GetConfig<bool>("inventory", "packages").value_or(config::inventory::DEFAULT_PACKAGES);
     m_ports = configurationParser->GetConfig<bool>("inventory", "ports").value_or(config::inventory::DEFAULT_PORTS);
@@ -69,8 +82,14 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
         configurationParser->GetConfig<bool>("inventory", "ports_all").value_or(config::inventory::DEFAULT_PORTS_ALL);
     m_processes =
         configurationParser->GetConfig<bool>("inventory", "processes").value_or(config::inventory::DEFAULT_PROCESSES);
+    m_processesEvents = configurationParser->GetConfig<bool>("inventory", "processes_events")
+                            .value_or(config::inventory::DEFAULT_PROCESSES_EVENTS);
     m_hotfixes =
         configurationParser->GetConfig<bool>("inventory", "hotfixes").value_or(config::inventory::DEFAULT_HOTFIXES);
+    m_scanThreads = static_cast<unsigned int>(configurationParser->GetConfig<size_t>("inventory", "scan_threads")
+                                                  .value_or(config::inventory::DEFAULT_SCAN_THREADS));
+    m_churnWindow = std::chrono::milliseconds {configurationParser->GetConfig<std::time_t>("inventory", "churn_window")
+                                                   .value_or(config::inventory::DEFAULT_CHURN_WINDOW)};
 }
 
 void Inventory::Stop()
@@ -101,47 +120,36 @@ void Inventory::SetPushMessageFunction(const std::function<int(Message)>& pushMe
     m_pushMessage = pushMessage;
 }
 
-void Inventory::SendDeltaEvent(const std::string& data)
+void Inventory::SendDeltaEvent(nlohmann::json& event)
 {
-
-    const auto jsonData = nlohmann::json::parse(data);
-
-    const Message statefulMessage {MessageType::STATEFUL,
-                                   jsonData["metadata"]["operation"] == "delete" ? "{}"_json : jsonData["data"],
-                                   Name(),
-                                   jsonData["metadata"]["collector"],
-                                   jsonData["metadata"].dump()};
-
-    if (!m_pushMessage(statefulMessage))
+    auto& metadata = event["metadata"];
+    const std::string collector = metadata["collector"];
+    const auto isDelete = metadata["operation"] == "delete";
+
+    LogTrace("Stateful event: {}, metadata {}", event["data"].dump(), metadata.dump());
+
+    // The event is handed over by the caller, so its data is moved into the messages instead of copied
+    if (!m_pushMessage(Message {MessageType::STATEFUL,
+                                isDelete ? "{}"_json : std::move(event["data"]),
+                                Name(),
+                                collector,
+                                metadata.dump()}))
     {
-        LogWarn("Stateful event can't be pushed into the message queue: {}", jsonData["data"].dump());
-    }
-    else
-    {
-        LogTrace("Stateful event queued: {}, metadata {}", jsonData["data"].dump(), jsonData["metadata"].dump());
+        LogWarn("Stateful event can't be pushed into the message queue: {} {}", collector, metadata["id"].dump());
     }
 
-    if (jsonData.contains("stateless") && !jsonData["stateless"].empty())
+    if (event.contains("stateless") && !event["stateless"].empty())
     {
+        const auto id = metadata["id"].dump();
+        metadata.erase("id");
+        metadata.erase("operation");
 
-        auto metadataAux = jsonData["metadata"];
-        metadataAux.erase("id");
-        metadataAux.erase("operation");
-
-        const Message statelessMessage {MessageType::STATELESS,
-                                        jsonData["stateless"],
-                                        Name(),
-                                        jsonData["metadata"]["collector"],
-                                        metadataAux.dump()};
+        LogTrace("Stateless event: {}, metadata {}", event["stateless"].dump(), metadata.dump());
 
-        if (!m_pushMessage(statelessMessage))
+        if (!m_pushMessage(Message {
+                MessageType::STATELESS, std::move(event["stateless"]), Name(), collector, metadata.dump()}))
         {
-            LogWarn("Stateless event can't be pushed into the message queue: {}", jsonData["stateless"].dump());
-        }
-        else
-        {
-            LogTrace(
-                "Stateless event queued: {}, metadata {}", jsonData["stateless"].dump(), jsonData["metadata"].dump());
+            LogWarn("Stateless event can't be pushed into the message queue: {} {}", collector, id);
         }
     }
 }
@@ -176,10 +184,25 @@ cJSON* Inventory::Dump() const
     else
         cJSON_AddStringToObject(invJson, "scan-on-start", "no");
     cJSON_AddNumberToObject(invJson, "interval", static_cast<double>(m_intervalValue));
+    if (!m_categoryIntervals.empty())
+    {
+        cJSON* intervalsJson = cJSON_CreateObject();
+        for (const auto& [category, interval] : m_categoryIntervals)
+        {
+            cJSON_AddNumberToObject(intervalsJson, category.c_str(), static_cast<double>(interval));
+        }
+        cJSON_AddItemToObject(invJson, "intervals", intervalsJson);
+    }
+    cJSON_AddNumberToObject(invJson, "scan_threads", static_cast<double>(m_scanThreads));
+    cJSON_AddNumberToObject(invJson, "churn_window", static_cast<double>(m_churnWindow.count()));
     if (m_networks)
         cJSON_AddStringToObject(invJson, "networks", "yes");
     else
         cJSON_AddStringToObject(invJson, "networks", "no");
+    if (m_networksEvents)
+        cJSON_AddStringToObject(invJson, "networks_events", "yes");
+    else
+        cJSON_AddStringToObject(invJson, "networks_events", "no");
     if (m_system)
         cJSON_AddStringToObject(invJson, "system", "yes");
     else
@@ -204,6 +227,10 @@ cJSON* Inventory::Dump() const
         cJSON_AddStringToObject(invJson, "processes", "yes");
     else
         cJSON_AddStringToObject(invJson, "processes", "no");
+    if (m_processesEvents)
+        cJSON_AddStringToObject(invJson, "processes_events", "yes");
+    else
+        cJSON_AddStringToObject(invJson, "processes_events", "no");
 #ifdef WIN32
     if (m_hotfixes)
         cJSON_AddStringToObject(invJson, "hotfixes", "yes");
@@ -1,4 +1,5 @@
 #include "commonDefs.h"
+#include "ecsWriter.hpp"
 #include "statelessEvent.hpp"
 #include <config.h>
 #include <defs.h>
@@ -8,12 +9,23 @@
 #include <nlohmann/json.hpp>
 #include <sharedDefs.h>
 #include <stringHelper.h>
+#include <threadDispatcher.h>
 #include <timeHelper.h>
 
+#include <algorithm>
+#include <array>
+#include <tuple>
+
 constexpr std::time_t INVENTORY_DEFAULT_INTERVAL {3600000};
 constexpr size_t MAX_ID_SIZE = 512;
 
 constexpr auto QUEUE_SIZE {4096};
+constexpr std::chrono::milliseconds PROCESS_EVENTS_WAIT {1000};
+constexpr std::chrono::milliseconds NETWORK_EVENTS_WAIT {1000};
+constexpr std::chrono::milliseconds NETWORK_EVENTS_SETTLE {500};
+constexpr std::chrono::milliseconds NETWORK_EVENTS_MAX_DELAY {5000};
+constexpr std::chrono::milliseconds CHURN_FLUSH_PERIOD {1000};
+constexpr std::chrono::minutes CHURN_REPORT_INTERVAL {1};
 
 static const std::map<ReturnTypeCallback, std::string> OPERATION_MAP {
     // LCOV_EXCL_START
@@ -132,6 +144,99 @@ constexpr auto METADATA_SQL_STATEMENT {
     value TEXT,
     PRIMARY KEY (key)) WITHOUT ROWID;)"};
 
+constexpr std::array HARDWARE_ECS_FIELDS {
+    EcsField {"board_serial", "/observer/serial_number", EcsFieldType::VALUE},
+    EcsField {"cpu_name", "/host/cpu/name", EcsFieldType::VALUE},
+    EcsField {"cpu_cores", "/host/cpu/cores", EcsFieldType::VALUE},
+    EcsField {"cpu_mhz", "/host/cpu/speed", EcsFieldType::VALUE},
+    EcsField {"ram_total", "/host/memory/total", EcsFieldType::VALUE},
+    EcsField {"ram_free", "/host/memory/free", EcsFieldType::VALUE},
+    EcsField {"ram_usage", "/host/memory/used/percentage", EcsFieldType::VALUE},
+};
+
+constexpr std::array SYSTEM_ECS_FIELDS {
+    EcsField {"architecture", "/host/architecture", EcsFieldType::VALUE},
+    EcsField {"hostname", "/host/hostname", EcsFieldType::VALUE},
+    EcsField {"os_build", "/host/os/kernel", EcsFieldType::VALUE},
+    EcsField {"os_codename", "/host/os/full", EcsFieldType::VALUE},
+    EcsField {"os_name", "/host/os/name", EcsFieldType::VALUE},
+    EcsField {"os_platform", "/host/os/platform", EcsFieldType::VALUE},
+    EcsField {"os_version", "/host/os/version", EcsFieldType::VALUE},
+    EcsField {"sysname", "/host/os/type", EcsFieldType::VALUE},
+};
+
+constexpr std::array PACKAGES_ECS_FIELDS {
+    EcsField {"architecture", "/package/architecture", EcsFieldType::VALUE},
+    EcsField {"description", "/package/description", EcsFieldType::VALUE},
+    EcsField {"install_time", "/package/installed", EcsFieldType::VALUE},
+    EcsField {"name", "/package/name", EcsFieldType::VALUE},
+    EcsField {"location", "/package/path", EcsFieldType::VALUE},
+    EcsField {"size", "/package/size", EcsFieldType::VALUE},
+    EcsField {"format", "/package/type", EcsFieldType::VALUE},
+    EcsField {"version", "/package/version", EcsFieldType::VALUE},
+};
+
+constexpr std::array PROCESSES_ECS_FIELDS {
+    EcsField {"pid", "/process/pid", EcsFieldType::VALUE},
+    EcsField {"name", "/process/name", EcsFieldType::VALUE},
+    EcsField {"ppid", "/process/parent/pid", EcsFieldType::VALUE},
+    EcsField {"cmd", "/process/command_line", EcsFieldType::VALUE},
+    EcsField {"argvs", "/process/args", EcsFieldType::VALUE},
+    EcsField {"euser", "/process/user/id", EcsFieldType::VALUE},
+    EcsField {"ruser", "/process/real_user/id", EcsFieldType::VALUE},
+    EcsField {"suser", "/process/saved_user/id", EcsFieldType::VALUE},
+    EcsField {"egroup", "/process/group/id", EcsFieldType::VALUE},
+    EcsField {"rgroup", "/process/real_group/id", EcsFieldType::VALUE},
+    EcsField {"sgroup", "/process/saved_group/id", EcsFieldType::VALUE},
+    EcsField {"start_time", "/process/start", EcsFieldType::VALUE},
+    EcsField {"tgid", "/process/thread/id", EcsFieldType::VALUE},
+    EcsField {"tty", "/process/tty/char_device/major", EcsFieldType::VALUE},
+};
+
+constexpr std::array HOTFIXES_ECS_FIELDS {
+    EcsField {"hotfix", "/package/hotfix/name", EcsFieldType::VALUE},
+};
+
+constexpr std::array PORTS_ECS_FIELDS {
+    EcsField {"protocol", "/network/protocol", EcsFieldType::VALUE},
+    EcsField {"local_ip", "/source/ip", EcsFieldType::ARRAY},
+    EcsField {"local_port", "/source/port", EcsFieldType::VALUE},
+    EcsField {"remote_ip", "/destination/ip", EcsFieldType::ARRAY},
+    EcsField {"remote_port", "/destination/port", EcsFieldType::VALUE},
+    EcsField {"tx_queue", "/host/network/egress/queue", EcsFieldType::VALUE},
+    EcsField {"rx_queue", "/host/network/ingress/queue", EcsFieldType::VALUE},
+    EcsField {"inode", "/file/inode", EcsFieldType::VALUE},
+    EcsField {"state", "/interface/state", EcsFieldType::VALUE},
+    EcsField {"pid", "/process/pid", EcsFieldType::VALUE},
+    EcsField {"process", "/process/name", EcsFieldType::VALUE},
+};
+
+constexpr std::array NETWORKS_ECS_FIELDS {
+    EcsField {"address", "/host/ip", EcsFieldType::ARRAY},
+    EcsField {"mac", "/host/mac", EcsFieldType::VALUE},
+    EcsField {"tx_bytes", "/host/network/egress/bytes", EcsFieldType::VALUE},
+    EcsField {"tx_packets", "/host/network/egress/packets", EcsFieldType::VALUE},
+    EcsField {"rx_bytes", "/host/network/ingress/bytes", EcsFieldType::VALUE},
+    EcsField {"rx_packets", "/host/network/ingress/packets", EcsFieldType::VALUE},
+    EcsField {"tx_dropped", "/host/network/egress/drops", EcsFieldType::VALUE},
+    EcsField {"tx_errors", "/host/network/egress/errors", EcsFieldType::VALUE},
+    EcsField {"rx_dropped", "/host/network/ingress/drops", EcsFieldType::VALUE},
+    EcsField {"rx_errors", "/host/network/ingress/errors", EcsFieldType::VALUE},
+    EcsField {"mtu", "/interface/mtu", EcsFieldType::VALUE},
+    EcsField {"state", "/interface/state", EcsFieldType::VALUE},
+    EcsField {"iface_type", "/interface/type", EcsFieldType::VALUE},
+    EcsField {"netmask", "/network/netmask", EcsFieldType::ARRAY},
+    EcsField {"gateway", "/network/gateway", EcsFieldType::ARRAY},
+    EcsField {"broadcast", "/network/broadcast", EcsFieldType::ARRAY},
+    EcsField {"dhcp", "/network/dhcp", EcsFieldType::VALUE},
+    EcsField {"proto_type", "/network/type", EcsFieldType::VALUE},
+    EcsField {"metric", "/network/metric", EcsFieldType::VALUE},
+    // TODO this field should include http or https, it's related to an application not to a interface
+    EcsField {"", "/network/protocol", EcsFieldType::NULL_VALUE},
+    EcsField {"adapter", "/observer/ingress/interface/alias", EcsFieldType::VALUE},
+    EcsField {"iface", "/observer/ingress/interface/name", EcsFieldType::VALUE},
+};
+
 constexpr auto NETWORKS_TABLE {"networks"};
 constexpr auto PACKAGES_TABLE {"packages"};
 constexpr auto HOTFIXES_TABLE {"hotfixes"};
@@ -284,16 +389,132 @@ void Inventory::NotifyChange(ReturnTypeCallback result,
         return;
     }
 
+    // Short-lived processes and ports are held back so their creation and deletion can cancel each other
+    const auto coalesce {m_churnWindow.count() > 0 && !isFirstScan &&
+                         (table == PROCESSES_TABLE || table == PORTS_TABLE)};
+    std::unique_lock<std::mutex> lock {m_churnMutex, std::defer_lock};
+
+    if (coalesce)
+    {
+        lock.lock();
+    }
+
+    const auto notify {[&](const nlohmann::json& item)
+                       {
+                           if (!coalesce || !CoalesceChurn(result, item, table))
+                           {
+                               ProcessEvent(result, item, table, isFirstScan);
+                           }
+                       }};
+
     if (data.is_array())
     {
         for (const auto& item : data)
         {
-            ProcessEvent(result, item, table, isFirstScan);
+            notify(item);
         }
     }
     else
     {
-        ProcessEvent(result, data, table, isFirstScan);
+        notify(data);
+    }
+}
+
+bool Inventory::CoalesceChurn(ReturnTypeCallback result, const nlohmann::json& item, const std::string& table)
+{
+    if (result != INSERTED && result != MODIFIED && result != DELETED)
+    {
+        return false;
+    }
+
+    const auto key {table + ":" + GetPrimaryKeys(result == MODIFIED ? item.at("new") : item, table)};
+
+    if (result == INSERTED)
+    {
+        const auto deadline {std::chrono::steady_clock::now() + m_churnWindow};
+        m_churnPending[key] = {table, item, deadline};
+        m_churnDeadlines.emplace_back(deadline, key);
+        return true;
+    }
+
+    const auto it {m_churnPending.find(key)};
+
+    if (it == m_churnPending.end())
+    {
+        return false;
+    }
+
+    if (result == MODIFIED)
+    {
+        // Still unreported, so its creation will carry the latest data
+        it->second.item = item.at("new");
+    }
+    else
+    {
+        m_churnPending.erase(it);
+        ++m_churnSuppressed[table];
+    }
+
+    return true;
+}
+
+void Inventory::FlushChurn(const bool all)
+{
+    std::lock_guard<std::mutex> lock {m_churnMutex};
+    const auto now {std::chrono::steady_clock::now()};
+
+    while (!m_churnDeadlines.empty() && (all || m_churnDeadlines.front().first <= now))
+    {
+        const auto it {m_churnPending.find(m_churnDeadlines.front().second)};
+        m_churnDeadlines.pop_front();
+
+        // A row created again after its deletion has a later deadline of its own
+        if (it != m_churnPending.end() && (all || it->second.deadline <= now))
+        {
+            ProcessEvent(INSERTED, it->second.item, it->second.table, false);
+            m_churnPending.erase(it);
+        }
+    }
+}
+
+void Inventory::ReportChurn()
+{
+    std::lock_guard<std::mutex> lock {m_churnMutex};
+
+    for (const auto& [table, count] : m_churnSuppressed)
+    {
+        LogInfo("Suppressed {} {} that lived less than {} ms.", count, table, m_churnWindow.count());
+    }
+
+    m_churnSuppressed.clear();
+}
+
+void Inventory::ChurnLoop()
+{
+    LogInfo("Holding back processes and ports for {} ms before reporting them.", m_churnWindow.count());
+    const auto period {std::min(m_churnWindow, CHURN_FLUSH_PERIOD)};
+    auto nextReport {std::chrono::steady_clock::now() + CHURN_REPORT_INTERVAL};
+
+    while (!m_stopping)
+    {
+        {
+            // Not m_mutex, which a whole scan holds and would delay the flush
+            std::unique_lock<std::mutex> lock {m_churnMutex};
+            m_churnCv.wait_for(lock, period, [&]() { return m_stopping.load(); });
+        }
+
+        if (m_stopping)
+        {
+            break;
+        }
+
+        FlushChurn(false);
+
+        if (std::chrono::steady_clock::now() >= nextReport)
+        {
+            ReportChurn();
+            nextReport += CHURN_REPORT_INTERVAL;
+        }
     }
 }
 
@@ -333,11 +554,14 @@ void Inventory::NotifyEvent(ReturnTypeCallback result,
                             const std::string& table,
                             const bool isFirstScan)
 {
+    // Held creations are reported from the churn thread, a scan may start meanwhile
+    const auto scanTime {ScanTime()};
+
     if (!isFirstScan)
     {
         nlohmann::json oldData = (result == MODIFIED) ? EcsData(item["old"], table, false) : nlohmann::json {};
 
-        nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), table, msg["data"]);
+        nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), table, msg["data"], scanTime);
         nlohmann::json eventWithChanges = msg["data"];
 
         if (!oldData.empty())
@@ -349,10 +573,9 @@ void Inventory::NotifyEvent(ReturnTypeCallback result,
         msg["stateless"] = stateless;
     }
 
-    msg["data"]["@timestamp"] = m_scanTime;
+    msg["data"]["@timestamp"] = scanTime;
 
-    const auto msgToSend = msg.dump();
-    m_reportDiffFunction(msgToSend);
+    m_reportDiffFunction(msg);
 }
 
 void Inventory::UpdateChanges(const std::string& table, const nlohmann::json& values, const bool isFirstScan)
@@ -394,6 +617,28 @@ void Inventory::TryCatchTask(const std::function<void()>& task) const
     }
 }
 
+void Inventory::RunScan(const std::string& category, const std::function<void()>& scan)
+{
+    const auto start {std::chrono::steady_clock::now()};
+    TryCatchTask(scan);
+    const auto duration {
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)};
+
+    LogDebug("Scan of {} took {} ms", category, duration.count());
+
+    std::lock_guard<std::mutex> lock {m_metricsMutex};
+    auto& metrics {m_scanMetrics[category]};
+    metrics.lastDuration = duration;
+    metrics.totalDuration += duration;
+    ++metrics.scans;
+}
+
+std::map<std::string, Inventory::ScanMetrics> Inventory::GetScanMetrics() const
+{
+    std::lock_guard<std::mutex> lock {m_metricsMutex};
+    return m_scanMetrics;
+}
+
 Inventory::Inventory()
     : m_enabled {true}
     , m_dbFilePath {std::string(config::DEFAULT_DATA_PATH) + "/" + INVENTORY_DB_DISK_NAME}
@@ -402,11 +647,15 @@ Inventory::Inventory()
     , m_hardware {true}
     , m_system {true}
     , m_networks {true}
+    , m_networksEvents {config::inventory::DEFAULT_NETWORKS_EVENTS}
     , m_packages {true}
     , m_ports {true}
     , m_portsAll {true}
     , m_processes {true}
+    , m_processesEvents {config::inventory::DEFAULT_PROCESSES_EVENTS}
     , m_hotfixes {true}
+    , m_scanThreads {config::inventory::DEFAULT_SCAN_THREADS}
+    , m_churnWindow {config::inventory::DEFAULT_CHURN_WINDOW}
     , m_stopping {true}
     , m_notify {true}
     , m_hardwareFirstScan {true}
@@ -435,7 +684,7 @@ std::string Inventory::GetCreateStatement() const
 }
 
 void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
-                     const std::function<void(const std::string&)>& reportDiffFunction,
+                     const std::function<void(nlohmann::json&)>& reportDiffFunction,
                      const std::string& dbPath,
                      const std::string& normalizerConfigPath,
                      const std::string& normalizerType)
@@ -448,6 +697,13 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
         m_stopping = false;
         m_spDBSync = std::make_unique<DBSync>(
             HostType::AGENT, DbEngineType::SQLITE3, dbPath, GetCreateStatement(), DbManagement::PERSISTENT);
+
+        // Most rows of a scan are unchanged, so they are told apart by their hash without reading the stored ones
+        for (const auto& [table, key] : TABLE_TO_KEY_MAP)
+        {
+            m_spDBSync->enableTableRowHash(table);
+        }
+
         m_spNormalizer = std::make_unique<InvNormalizer>(normalizerConfigPath, normalizerType);
     }
 
@@ -458,6 +714,7 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
     m_portsFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PORTS_TABLE)).empty() ? false : true;
     m_processesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PROCESSES_TABLE)).empty() ? false : true;
     m_hotfixesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(HOTFIXES_TABLE)).empty() ? false : true;
+    m_packagesFingerprints = nlohmann::json::object();
 
     if (m_hardwareFirstScan && !m_hardware)
     {
@@ -508,138 +765,49 @@ void Inventory::Destroy()
 {
     m_stopping = true;
     m_cv.notify_all();
+    m_churnCv.notify_all();
 }
 
 nlohmann::json Inventory::EcsHardwareData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/observer/serial_number", "board_serial", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/name", "cpu_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/cores", "cpu_cores", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/speed", "cpu_mhz", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/total", "ram_total", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/free", "ram_free", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/used/percentage", "ram_usage", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {HARDWARE_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsSystemData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/host/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/hostname", "hostname", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/kernel", "os_build", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/full", "os_codename", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/name", "os_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/platform", "os_platform", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/version", "os_version", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/type", "sysname", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {SYSTEM_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsPackageData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/description", "description", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/installed", "install_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/path", "location", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/size", "size", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/type", "format", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/version", "version", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {PACKAGES_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsProcessesData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/parent/pid", "ppid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/command_line", "cmd", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/args", "argvs", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/user/id", "euser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_user/id", "ruser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_user/id", "suser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/group/id", "egroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_group/id", "rgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_group/id", "sgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/start", "start_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/thread/id", "tgid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/tty/char_device/major", "tty", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {PROCESSES_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsHotfixesData(const nlohmann::json& originalData, bool createFields)
 {
-
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/hotfix/name", "hotfix", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {HOTFIXES_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsPortData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/network/protocol", "protocol", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/source/ip", "local_ip", createFields);
-    SetJsonField(ret, originalData, "/source/port", "local_port", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/destination/ip", "remote_ip", createFields);
-    SetJsonField(ret, originalData, "/destination/port", "remote_port", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/queue", "tx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/queue", "rx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/file/inode", "inode", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "process", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {PORTS_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 nlohmann::json Inventory::EcsNetworkData(const nlohmann::json& originalData, bool createFields)
 {
-    nlohmann::json ret;
-
-    SetJsonFieldArray(ret, originalData, "/host/ip", "address", createFields);
-    SetJsonField(ret, originalData, "/host/mac", "mac", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/bytes", "tx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/packets", "tx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/bytes", "rx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/packets", "rx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/drops", "tx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/errors", "tx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/drops", "rx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/errors", "rx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/mtu", "mtu", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/type", "iface_type", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/network/netmask", "netmask", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/gateway", "gateway", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/broadcast", "broadcast", createFields);
-    SetJsonField(ret, originalData, "/network/dhcp", "dhcp", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/type", "proto_type", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/metric", "metric", std::nullopt, createFields);
-    /* TODO this field should include http or https, it's related to an application not to a interface */
-    if (createFields)
-    {
-        ret["network"]["protocol"] = nullptr;
-    }
-    SetJsonField(ret, originalData, "/observer/ingress/interface/alias", "adapter", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/observer/ingress/interface/name", "iface", std::nullopt, createFields);
-
-    return ret;
+    static const EcsWriter writer {NETWORKS_ECS_FIELDS};
+    return writer.Write(originalData, createFields);
 }
 
 void Inventory::ScanHardware()
@@ -758,6 +926,7 @@ void Inventory::ScanNetwork()
     if (m_networks)
     {
         LogTrace("Starting network scan");
+        std::lock_guard<std::mutex> lock {m_networksMutex};
         const auto networkData(GetNetworkData());
 
         if (!networkData.is_null())
@@ -785,38 +954,99 @@ void Inventory::ScanPackages()
     if (m_packages)
     {
         LogTrace("Starting packages scan");
+
+        // Package sources are fingerprinted from file metadata before they are read, so a change made
+        // during the scan is picked up by the next one. Without a previous fingerprint every source is read.
+        const auto fingerprints = m_spInfo->packagesFingerprints();
+        const bool fullScan {fingerprints.empty() || m_packagesFingerprints.empty()};
+        std::set<std::string> changedFormats;
+
+        if (!fullScan)
+        {
+            for (const auto& [format, fingerprint] : fingerprints.items())
+            {
+                if (!m_packagesFingerprints.contains(format) || m_packagesFingerprints.at(format) != fingerprint)
+                {
+                    changedFormats.insert(format);
+                }
+            }
+
+            for (const auto& [format, fingerprint] : m_packagesFingerprints.items())
+            {
+                if (!fingerprints.contains(format))
+                {
+                    changedFormats.insert(format);
+                }
+            }
+
+            if (changedFormats.empty())
+            {
+                LogDebug("Package sources unchanged, skipping packages scan");
+                return;
+            }
+        }
+
         const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
                              {
                                  NotifyChange(result, data, PACKAGES_TABLE, !m_packagesFirstScan);
                              }};
+        // The packages are read and normalized before taking the lock, so the other categories keep writing
+        std::vector<nlohmann::json> packages;
+        const auto collectPackage {[this, &packages](nlohmann::json& rawData)
+                                   {
+                                       if (m_stopping)
+                                       {
+                                           return;
+                                       }
+
+                                       m_spNormalizer->Normalize("packages", rawData);
+                                       m_spNormalizer->RemoveExcluded("packages", rawData);
+
+                                       if (!rawData.empty())
+                                       {
+                                           packages.push_back(std::move(rawData));
+                                       }
+                                   }};
+
+        if (fullScan)
+        {
+            m_spInfo->packages(collectPackage);
+        }
+        else
+        {
+            m_spInfo->packages(changedFormats, collectPackage);
+        }
 
-        std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PACKAGES_TABLE}, 0, QUEUE_SIZE, callback};
-        m_spInfo->packages(
-            [this, &txn](nlohmann::json& rawData)
+        {
+            std::unique_lock<std::mutex> lock {m_mutex};
+            DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PACKAGES_TABLE}, 0, QUEUE_SIZE, callback};
+
+            if (!fullScan)
             {
-                if (m_stopping)
-                {
-                    return;
-                }
+                SyncUnchangedPackages(txn, changedFormats);
+            }
 
+            for (auto& package : packages)
+            {
                 nlohmann::json input;
-
                 input["table"] = PACKAGES_TABLE;
-                m_spNormalizer->Normalize("packages", rawData);
-                m_spNormalizer->RemoveExcluded("packages", rawData);
+                input["data"] = nlohmann::json::array({std::move(package)});
 
-                if (!rawData.empty())
+                if (m_packagesFirstScan)
                 {
-                    input["data"] = nlohmann::json::array({rawData});
-                    if (m_packagesFirstScan)
-                    {
-                        input["options"]["return_old_data"] = true;
-                    }
-                    txn.syncTxnRow(input);
+                    input["options"]["return_old_data"] = true;
                 }
-            });
-        txn.getDeletedRows(callback);
+
+                txn.syncTxnRow(input);
+            }
+
+            txn.getDeletedRows(callback);
+        }
+
+        if (!m_stopping)
+        {
+            m_packagesFingerprints = fingerprints;
+        }
 
         if (!m_packagesFirstScan && !m_stopping)
         {
@@ -828,6 +1058,28 @@ void Inventory::ScanPackages()
     }
 }
 
+void Inventory::SyncUnchangedPackages(DBSyncTxn& txn, const std::set<std::string>& changedFormats)
+{
+    // The stored rows of the sources not scanned are marked as synced in the transaction, so they aren't
+    // deleted nor compared. The formats are bound, not concatenated into the condition.
+    std::string placeholders;
+    nlohmann::json values = nlohmann::json::array();
+
+    for (const auto& format : changedFormats)
+    {
+        placeholders += placeholders.empty() ? "?" : ",?";
+        values.push_back(format);
+    }
+
+    LogDebug("Scanning changed package sources: {}", values.dump());
+
+    nlohmann::json input;
+    input["table"] = PACKAGES_TABLE;
+    input["query"]["where_filter_opt"] = "format NOT IN (" + placeholders + ")";
+    input["query"]["values"] = std::move(values);
+    txn.keepTxnRows(input);
+}
+
 void Inventory::ScanHotfixes()
 {
     if (m_hotfixes)
@@ -932,23 +1184,32 @@ void Inventory::ScanProcesses()
     if (m_processes)
     {
         LogTrace("Starting processes scan");
+        std::lock_guard<std::mutex> processesLock {m_processesMutex};
         const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
                              {
                                  NotifyChange(result, data, PROCESSES_TABLE, !m_processesFirstScan);
                              }};
-        std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PROCESSES_TABLE}, 0, QUEUE_SIZE, callback};
+
+        // The processes are read before taking the lock, so the other categories keep writing
+        std::vector<nlohmann::json> processes;
         m_spInfo->processes(std::function<void(nlohmann::json&)>(
-            [this, &txn](nlohmann::json& rawData)
+            [this, &processes](nlohmann::json& rawData)
             {
-                if (m_stopping)
+                if (!m_stopping)
                 {
-                    return;
+                    processes.push_back(std::move(rawData));
                 }
+            }));
 
+        {
+            std::unique_lock<std::mutex> lock {m_mutex};
+            DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PROCESSES_TABLE}, 0, QUEUE_SIZE, callback};
+
+            for (auto& process : processes)
+            {
                 nlohmann::json input;
                 input["table"] = PROCESSES_TABLE;
-                input["data"] = nlohmann::json::array({rawData});
+                input["data"] = nlohmann::json::array({std::move(process)});
 
                 if (m_processesFirstScan)
                 {
@@ -956,8 +1217,10 @@ void Inventory::ScanProcesses()
                 }
 
                 txn.syncTxnRow(input);
-            }));
-        txn.getDeletedRows(callback);
+            }
+
+            txn.getDeletedRows(callback);
+        }
 
         if (!m_processesFirstScan && !m_stopping)
         {
@@ -969,18 +1232,225 @@ void Inventory::ScanProcesses()
     }
 }
 
-void Inventory::Scan()
+void Inventory::ProcessEventsLoop()
+{
+    std::unique_ptr<IProcessEventsListener> listener;
+
+    try
+    {
+        listener = m_spInfo->processEventsListener();
+    }
+    catch (const std::exception& ex)
+    {
+        LogWarn("Process events are not available, processes are only scanned periodically: {}", ex.what());
+        return;
+    }
+
+    if (!listener)
+    {
+        LogDebug("Process events are not supported, processes are only scanned periodically");
+        return;
+    }
+
+    LogInfo("Tracking process events.");
+    std::set<int32_t> changed;
+    std::set<int32_t> exited;
+
+    while (!m_stopping)
+    {
+        try
+        {
+            const auto complete {listener->wait(PROCESS_EVENTS_WAIT, changed, exited)};
+
+            if (m_stopping)
+            {
+                break;
+            }
+
+            if (!complete)
+            {
+                // Some events were dropped, only a full scan can tell what changed
+                LogDebug("Process events lost, scanning all processes");
+                ScanProcesses();
+            }
+            else if (m_processesFirstScan && (!changed.empty() || !exited.empty()))
+            {
+                // Before the first scan the table is empty and the scan itself reports every process
+                SyncProcesses(changed, exited);
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            LogError("Process events tracking stopped: {}", ex.what());
+            break;
+        }
+
+        changed.clear();
+        exited.clear();
+    }
+}
+
+void Inventory::SyncProcesses(const std::set<int32_t>& changed, const std::set<int32_t>& exited)
+{
+    std::lock_guard<std::mutex> processesLock {m_processesMutex};
+    LogTrace("Syncing process events: {} changed, {} exited", changed.size(), exited.size());
+
+    const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
+                         {
+                             NotifyChange(result, data, PROCESSES_TABLE, false);
+                         }};
+
+    // The changed processes are read before taking the lock, as the scans do
+    std::vector<nlohmann::json> processes;
+
+    if (!changed.empty())
+    {
+        m_spInfo->processes(changed,
+                            [&processes](nlohmann::json& rawData) { processes.push_back(std::move(rawData)); });
+    }
+
+    std::unique_lock<std::mutex> lock {m_mutex};
+
+    if (!exited.empty())
+    {
+        auto deleteQuery {DeleteQuery::builder().table(PROCESSES_TABLE).rowFilter("")};
+
+        for (const auto pid : exited)
+        {
+            deleteQuery.data({{"pid", std::to_string(pid)}});
+        }
+
+        // Only the stored processes are reported, with their stored values
+        m_spDBSync->deleteRows(deleteQuery.build().query(), callback);
+    }
+
+    for (auto& process : processes)
+    {
+        nlohmann::json input;
+        input["table"] = PROCESSES_TABLE;
+        input["data"] = nlohmann::json::array({std::move(process)});
+        input["options"]["return_old_data"] = true;
+
+        m_spDBSync->syncRow(input, callback);
+    }
+}
+
+void Inventory::NetworkEventsLoop()
+{
+    std::unique_ptr<INetworkEventsListener> listener;
+
+    try
+    {
+        listener = m_spInfo->networkEventsListener();
+    }
+    catch (const std::exception& ex)
+    {
+        LogWarn("Network events are not available, networks are only scanned periodically: {}", ex.what());
+        return;
+    }
+
+    if (!listener)
+    {
+        LogDebug("Network events are not supported, networks are only scanned periodically");
+        return;
+    }
+
+    LogInfo("Tracking network events.");
+
+    while (!m_stopping)
+    {
+        try
+        {
+            if (!listener->wait(NETWORK_EVENTS_WAIT))
+            {
+                continue;
+            }
+
+            // Interfaces come and go in bursts when containers start or stop, a single scan covers the whole burst
+            const auto deadline {std::chrono::steady_clock::now() + NETWORK_EVENTS_MAX_DELAY};
+
+            while (!m_stopping && std::chrono::steady_clock::now() < deadline && listener->wait(NETWORK_EVENTS_SETTLE))
+            {
+            }
+
+            // Before the first scan the table is empty and the scan itself reports every interface
+            if (!m_stopping && m_networksFirstScan)
+            {
+                LogDebug("Network changes reported, scanning networks");
+                ScanNetwork();
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            LogError("Network events tracking stopped: {}", ex.what());
+            break;
+        }
+    }
+}
+
+std::vector<Inventory::ScanCategory> Inventory::GetScanCategories()
+{
+    // The slowest categories go first so they do not end up waiting for a free worker
+    const std::vector<std::tuple<bool, std::string, std::function<void()>>> categories {
+        {m_packages, PACKAGES_TABLE, [this]() { ScanPackages(); }},
+        {m_processes, PROCESSES_TABLE, [this]() { ScanProcesses(); }},
+        {m_hotfixes, HOTFIXES_TABLE, [this]() { ScanHotfixes(); }},
+        {m_ports, PORTS_TABLE, [this]() { ScanPorts(); }},
+        {m_networks, NETWORKS_TABLE, [this]() { ScanNetwork(); }},
+        {m_hardware, HARDWARE_TABLE, [this]() { ScanHardware(); }},
+        {m_system, SYSTEM_TABLE, [this]() { ScanSystem(); }}};
+
+    const auto now {std::chrono::steady_clock::now()};
+    std::vector<ScanCategory> ret;
+
+    for (const auto& [enabled, name, scan] : categories)
+    {
+        if (enabled)
+        {
+            const auto it {m_categoryIntervals.find(name)};
+            const std::chrono::milliseconds interval {it != m_categoryIntervals.end() ? it->second
+                                                                                      : m_intervalValue};
+            ret.push_back({name, scan, interval, m_scanOnStart ? now : now + interval});
+        }
+    }
+
+    return ret;
+}
+
+void Inventory::Scan(const std::vector<const ScanCategory*>& categories)
 {
     LogInfo("Starting evaluation.");
-    m_scanTime = Utils::getCurrentISO8601();
 
-    TryCatchTask([&]() { ScanHardware(); });
-    TryCatchTask([&]() { ScanSystem(); });
-    TryCatchTask([&]() { ScanPackages(); });
-    TryCatchTask([&]() { ScanProcesses(); });
-    TryCatchTask([&]() { ScanHotfixes(); });
-    TryCatchTask([&]() { ScanPorts(); });
-    TryCatchTask([&]() { ScanNetwork(); });
+    {
+        std::lock_guard<std::mutex> lock {m_scanTimeMutex};
+        m_scanTime = Utils::getCurrentISO8601();
+    }
+
+    // Categories collect their data concurrently. Their DBSync transactions share the handle, so they are still run
+    // one at a time
+    const auto threads {std::min(m_scanThreads, static_cast<unsigned int>(categories.size()))};
+
+    if (threads <= 1)
+    {
+        for (const auto category : categories)
+        {
+            RunScan(category->name, category->scan);
+        }
+    }
+    else
+    {
+        using ScanTask = std::function<void()>;
+        Utils::AsyncDispatcher<ScanTask, std::function<void(const ScanTask&)>> dispatcher {
+            [](const ScanTask& task) { task(); }, threads};
+
+        for (const auto category : categories)
+        {
+            dispatcher.push([this, category]() { RunScan(category->name, category->scan); });
+        }
+
+        // Returns once every category has been scanned
+        dispatcher.rundown();
+    }
 
     m_notify = true;
     LogInfo("Evaluation finished.");
@@ -990,25 +1460,112 @@ void Inventory::SyncLoop()
 {
     LogInfo("Module started.");
 
-    if (m_scanOnStart && !m_stopping)
+    auto categories {GetScanCategories()};
+
+    // Processes scans become a safety net for the changes reported by the kernel in between
+    std::thread processEvents;
+
+    if (m_processes && m_processesEvents)
     {
-        Scan();
+        processEvents = std::thread {[this]() { ProcessEventsLoop(); }};
     }
 
-    while (!m_stopping)
+    // Networks scans are also run as soon as the kernel reports a change
+    std::thread networkEvents;
+
+    if (m_networks && m_networksEvents)
+    {
+        networkEvents = std::thread {[this]() { NetworkEventsLoop(); }};
+    }
+
+    // Creations of processes and ports are reported once they outlive the churn window
+    std::thread churn;
+
+    if (m_churnWindow.count() > 0 && (m_processes || m_ports))
+    {
+        churn = std::thread {[this]() { ChurnLoop(); }};
+    }
+
+    if (categories.empty())
+    {
+        std::unique_lock<std::mutex> lock {m_mutex};
+        m_cv.wait(lock, [&]() { return m_stopping.load(); });
+    }
+
+    while (!m_stopping && !categories.empty())
     {
+        // Sleep until the next category is due instead of waking up for all of them
+        const auto nextScan {std::min_element(categories.begin(),
+                                              categories.end(),
+                                              [](const auto& lhs, const auto& rhs)
+                                              { return lhs.nextScan < rhs.nextScan; })
+                                 ->nextScan};
         {
             std::unique_lock<std::mutex> lock {m_mutex};
-            m_cv.wait_for(lock, std::chrono::milliseconds {m_intervalValue}, [&]() { return m_stopping.load(); });
+            m_cv.wait_until(lock, nextScan, [&]() { return m_stopping.load(); });
+        }
+
+        if (m_stopping)
+        {
+            break;
+        }
+
+        const auto now {std::chrono::steady_clock::now()};
+        std::vector<const ScanCategory*> due;
+
+        for (const auto& category : categories)
+        {
+            if (category.nextScan <= now)
+            {
+                due.push_back(&category);
+            }
+        }
+
+        Scan(due);
+
+        // Keep each category on its own cadence, skipping the slots missed while scanning
+        const auto end {std::chrono::steady_clock::now()};
+
+        for (auto& category : categories)
+        {
+            if (category.nextScan <= now)
+            {
+                category.nextScan += category.interval;
+
+                if (category.nextScan <= end)
+                {
+                    category.nextScan = end + category.interval;
+                }
+            }
         }
-        Scan();
     }
+
+    if (processEvents.joinable())
+    {
+        processEvents.join();
+    }
+
+    if (networkEvents.joinable())
+    {
+        networkEvents.join();
+    }
+
+    if (churn.joinable())
+    {
+        churn.join();
+    }
+
+    // The held rows are already in the database, a later scan would never report them
+    FlushChurn(true);
+    ReportChurn();
+
     std::unique_lock<std::mutex> lock {m_mutex};
     m_spDBSync.reset(nullptr);
 }
 
 void Inventory::WriteMetadata(const std::string& key, const std::string& value)
 {
+    std::unique_lock<std::mutex> lock {m_mutex};
     auto insertQuery {InsertQuery::builder().table(MD_TABLE).data({{"key", key}, {"value", value}}).build()};
     m_spDBSync->insertData(insertQuery.query());
 }
@@ -1111,54 +1668,18 @@ nlohmann::json Inventory::AddPreviousFields(nlohmann::json& current, const nlohm
     return modifiedKeys;
 }
 
-nlohmann::json
-Inventory::GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data)
-{
-    auto event = CreateStatelessEvent(type, operation, m_scanTime, data);
-    return event ? event->generate() : nlohmann::json {};
-}
-
-void Inventory::SetJsonField(nlohmann::json& target,
-                             const nlohmann::json& source,
-                             const std::string& keyPath,
-                             const std::string& jsonKey,
-                             const std::optional<std::string>& defaultValue,
-                             bool createFields)
+std::string Inventory::ScanTime() const
 {
-    if (createFields || source.contains(jsonKey))
-    {
-        nlohmann::json::json_pointer pointer(keyPath);
-        if (source.contains(jsonKey) && source[jsonKey] != EMPTY_VALUE)
-        {
-            target[pointer] = source[jsonKey];
-        }
-        else if (defaultValue.has_value())
-        {
-            target[pointer] = *defaultValue;
-        }
-        else
-        {
-            target[pointer] = nullptr;
-        }
-    }
+    std::lock_guard<std::mutex> lock {m_scanTimeMutex};
+    return m_scanTime;
 }
 
-void Inventory::SetJsonFieldArray(nlohmann::json& target,
-                                  const nlohmann::json& source,
-                                  const std::string& destPath,
-                                  const std::string& sourceKey,
-                                  bool createFields)
+nlohmann::json
+Inventory::GenerateStatelessEvent(const std::string& operation,
+                                  const std::string& type,
+                                  const nlohmann::json& data,
+                                  const std::string& scanTime)
 {
-    if (createFields || source.contains(sourceKey))
-    {
-        nlohmann::json::json_pointer destPointer(destPath);
-        target[destPointer.parent_pointer()][destPointer.back()] = nlohmann::json::array();
-        nlohmann::json& destArray = target[destPointer];
-
-        if (source.contains(sourceKey) && !source[sourceKey].empty() && !source[sourceKey].is_null() &&
-            source[sourceKey] != EMPTY_VALUE)
-        {
-            destArray.push_back(source[sourceKey]);
-        }
-    }
+    auto event = CreateStatelessEvent(type, operation, scanTime, data);
+    return event ? event->generate() : nlohmann::json {};
 }
@@ -0,0 +1,43 @@
+#include "../src/ecsWriter.hpp"
+#include <gtest/gtest.h>
+
+constexpr std::array TEST_ECS_FIELDS {
+    EcsField {"name", "/package/name", EcsFieldType::VALUE},
+    EcsField {"address", "/host/ip", EcsFieldType::ARRAY},
+    EcsField {"size", "/package/size", EcsFieldType::VALUE},
+    EcsField {"", "/network/protocol", EcsFieldType::NULL_VALUE},
+    EcsField {"arch", "/package/architecture", EcsFieldType::VALUE},
+};
+
+TEST(EcsWriterTest, WritesEveryField)
+{
+    const EcsWriter writer {TEST_ECS_FIELDS};
+    const auto source = R"({"name":"nginx","address":"10.0.0.1","size":1024,"arch":""})"_json;
+
+    EXPECT_EQ(
+        writer.Write(source, true),
+        R"({"host":{"ip":["10.0.0.1"]},"network":{"protocol":null},"package":{"architecture":null,"name":"nginx","size":1024}})"_json);
+}
+
+TEST(EcsWriterTest, CreatesMissingFields)
+{
+    const EcsWriter writer {TEST_ECS_FIELDS};
+
+    EXPECT_EQ(
+        writer.Write(R"({"name":"nginx"})"_json, true),
+        R"({"host":{"ip":[]},"network":{"protocol":null},"package":{"architecture":null,"name":"nginx","size":null}})"_json);
+}
+
+TEST(EcsWriterTest, SkipsMissingFields)
+{
+    const EcsWriter writer {TEST_ECS_FIELDS};
+
+    EXPECT_EQ(writer.Write(R"({"size":1024,"address":""})"_json, false), R"({"host":{"ip":[]},"package":{"size":1024}})"_json);
+}
+
+TEST(EcsWriterTest, NothingToWrite)
+{
+    const EcsWriter writer {TEST_ECS_FIELDS};
+
+    EXPECT_TRUE(writer.Write(R"({"other":1})"_json, false).is_null());
+}
@@ -29,14 +29,14 @@ TEST_F(InventoryTest, SendUpdateEvent_Stateful)
                 return 1;
             });
 
-    auto inputData = R"({
+    auto inputData = nlohmann::json::parse(R"({
         "metadata": {
             "collector": "hardware",
             "operation": "update",
             "id": "123"
         },
         "data": {"key": "value"}
-    })";
+    })");
 
     inventory.SendDeltaEvent(inputData);
 }
@@ -58,14 +58,14 @@ TEST_F(InventoryTest, SendDeleteEvent_Stateful)
                 return 1;
             });
 
-    auto inputData = R"({
+    auto inputData = nlohmann::json::parse(R"({
         "metadata": {
             "collector": "hardware",
             "operation": "delete",
             "id": "123"
         },
         "data": {"key": "value"}
-    })";
+    })");
 
     inventory.SendDeltaEvent(inputData);
 }
@@ -94,7 +94,7 @@ TEST_F(InventoryTest, SendUpdateEvent_WithStateless)
                 return 1;
             });
 
-    auto inputData = R"({
+    auto inputData = nlohmann::json::parse(R"({
         "metadata": {
             "collector": "hardware",
             "operation": "update",
@@ -102,7 +102,7 @@ TEST_F(InventoryTest, SendUpdateEvent_WithStateless)
         },
         "data": {"key": "value"},
         "stateless": {"alert": "high"}
-    })";
+    })");
 
     inventory.SendDeltaEvent(inputData);
 }
@@ -114,14 +114,14 @@ TEST_F(InventoryTest, PushMessageFails_LogsWarning)
 
     EXPECT_CALL(mockPushMessage, Call(::testing::_)).WillOnce([](const Message&) { return 0; });
 
-    auto inputData = R"({
+    auto inputData = nlohmann::json::parse(R"({
         "metadata": {
             "collector": "hardware",
             "operation": "update",
             "id": "123"
         },
         "data": {"key": "value"}
-    })";
+    })");
 
     inventory.SendDeltaEvent(inputData);
 }
@@ -5,16 +5,101 @@
 
 constexpr auto INVENTORY_DB_PATH {"TEMP.db"};
 constexpr int SLEEP_DURATION_SECONDS = 3;
+constexpr auto WAIT_TIMEOUT {std::chrono::seconds {10}};
+constexpr auto WAIT_POLL {std::chrono::milliseconds {10}};
 
-void ReportFunction(const std::string& payload);
+void ReportFunction(nlohmann::json& payload);
 
-void InventoryImpTest::SetUp() {};
+void InventoryImpTest::SetUp()
+{
+    std::lock_guard<std::mutex> lock {m_mutex};
+    m_deltas.clear();
+};
 
 void InventoryImpTest::TearDown()
 {
     std::remove(INVENTORY_DB_PATH);
 };
 
+bool InventoryImpTest::RunInventory(const std::shared_ptr<ISysInfo>& spInfo,
+                                    const std::string& config,
+                                    const std::function<bool()>& done)
+{
+    std::function<void(nlohmann::json&)> report {[this](nlohmann::json& data)
+                                                 {
+                                                     auto delta = data;
+                                                     delta["data"].erase("@timestamp");
+                                                     delta["metadata"].erase("id");
+                                                     delta.erase("stateless");
+                                                     {
+                                                         std::lock_guard<std::mutex> lock {m_mutex};
+                                                         m_deltas.push_back(std::move(delta));
+                                                     }
+                                                     m_cv.notify_all();
+                                                 }};
+
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(config);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfo, &report]()
+                   {
+                       Inventory::Instance().Init(spInfo, report, INVENTORY_DB_PATH, "", "");
+                       Inventory::Instance().SetAgentUUID("1234");
+                   }};
+
+    const auto met {WaitFor(done)};
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    return met;
+}
+
+bool InventoryImpTest::WaitFor(const std::function<bool()>& condition)
+{
+    const auto deadline {std::chrono::steady_clock::now() + WAIT_TIMEOUT};
+
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        // The condition may read the deltas, so it's checked without the lock
+        std::unique_lock<std::mutex> lock {m_mutex};
+        m_cv.wait_for(lock, WAIT_POLL);
+    }
+
+    return true;
+}
+
+std::vector<std::string> InventoryImpTest::Deltas(const std::string& collector)
+{
+    std::lock_guard<std::mutex> lock {m_mutex};
+    std::vector<std::string> deltas;
+
+    for (const auto& delta : m_deltas)
+    {
+        if (collector.empty() || delta["metadata"]["collector"] == collector)
+        {
+            deltas.push_back(delta.dump());
+        }
+    }
+
+    return deltas;
+}
+
+uint64_t InventoryImpTest::Scans(const std::string& category)
+{
+    const auto metrics {Inventory::Instance().GetScanMetrics()};
+    const auto it {metrics.find(category)};
+    return metrics.end() != it ? it->second.scans : 0;
+}
+
 using ::testing::Return;
 
 class SysInfoWrapper : public ISysInfo
@@ -37,6 +122,23 @@ public:
     MOCK_METHOD(void, processes, (std::function<void(nlohmann::json&)>), (override));
     MOCK_METHOD(nlohmann::json, ports, (), (override));
     MOCK_METHOD(nlohmann::json, hotfixes, (), (override));
+    MOCK_METHOD(nlohmann::json, packagesFingerprints, (), (override));
+    MOCK_METHOD(void, packages, (const std::set<std::string>&, std::function<void(nlohmann::json&)>), (override));
+    MOCK_METHOD(void, processes, (const std::set<int32_t>&, std::function<void(nlohmann::json&)>), (override));
+    MOCK_METHOD(std::unique_ptr<IProcessEventsListener>, processEventsListener, (), (override));
+    MOCK_METHOD(std::unique_ptr<INetworkEventsListener>, networkEventsListener, (), (override));
+};
+
+class ProcessEventsListenerMock : public IProcessEventsListener
+{
+public:
+    MOCK_METHOD(bool, wait, (std::chrono::milliseconds, std::set<int32_t>&, std::set<int32_t>&), (override));
+};
+
+class NetworkEventsListenerMock : public INetworkEventsListener
+{
+public:
+    MOCK_METHOD(bool, wait, (std::chrono::milliseconds), (override));
 };
 
 class CallbackMock
@@ -53,7 +155,7 @@ public:
     MOCK_METHOD(void, callbackMock, (const std::string&), ());
 };
 
-void ReportFunction(const std::string& /*payload*/)
+void ReportFunction(nlohmann::json& /*payload*/)
 {
     // std::cout << payload << std::endl;
 }
@@ -90,14 +192,14 @@ TEST_F(InventoryImpTest, defaultCtor)
             R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"down","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")));
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -271,14 +373,14 @@ TEST_F(InventoryImpTest, noHardware)
     EXPECT_CALL(*spInfoWrapper, hardware()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult2 {
         R"({"data":{"host":{"architecture":"x86_64","hostname":"UBUNTU","os":{"full":null,"kernel":"7601","name":"Microsoft Windows 7","platform":null,"type":null,"version":"6.1.7601"}}},"metadata":{"collector":"system","module":"inventory","operation":"create"}})"};
@@ -359,14 +461,14 @@ TEST_F(InventoryImpTest, noOs)
     EXPECT_CALL(*spInfoWrapper, os()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -447,14 +549,14 @@ TEST_F(InventoryImpTest, noNetwork)
     EXPECT_CALL(*spInfoWrapper, networks()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -534,14 +636,14 @@ TEST_F(InventoryImpTest, noPackages)
     EXPECT_CALL(*spInfoWrapper, packages()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -622,14 +724,14 @@ TEST_F(InventoryImpTest, noPorts)
     EXPECT_CALL(*spInfoWrapper, ports()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -712,14 +814,14 @@ TEST_F(InventoryImpTest, noPortsAll)
             R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"down","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")));
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -806,14 +908,14 @@ TEST_F(InventoryImpTest, noProcesses)
     EXPECT_CALL(*spInfoWrapper, processes(testing::_)).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -895,14 +997,14 @@ TEST_F(InventoryImpTest, noHotfixes)
     EXPECT_CALL(*spInfoWrapper, hotfixes()).Times(0);
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -1086,14 +1188,14 @@ TEST_F(InventoryImpTest, portAllEnable)
     ])")));
 
     CallbackMock wrapper;
-    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
-                                                          {
-                                                              auto delta = nlohmann::json::parse(data);
-                                                              delta["data"].erase("@timestamp");
-                                                              delta["metadata"].erase("id");
-                                                              delta.erase("stateless");
-                                                              wrapper.callbackMock(delta.dump());
-                                                          }};
+    std::function<void(nlohmann::json&)> callbackData {[&wrapper](nlohmann::json& data)
+                                                       {
+                                                           auto delta = data;
+                                                           delta["data"].erase("@timestamp");
+                                                           delta["metadata"].erase("id");
+                                                           delta.erase("stateless");
+                                                           wrapper.callbackMock(delta.dump());
+                                                       }};
     const auto expectedResult1 {
         R"({"data":{"destination":{"ip":["0.0.0.0"],"port":0},"file":{"inode":43481},"host":{"network":{"egress":{"queue":0},"ingress":{"queue":0}}},"interface":{"state":null},"network":{"protocol":"udp"},"process":{"name":null,"pid":0},"source":{"ip":["0.0.0.0"],"port":47748}},"metadata":{"collector":"ports","module":"inventory","operation":"create"}})"};
 
@@ -1216,14 +1318,14 @@ TEST_F(InventoryImpTest, portAllDisable)
     ])")));
 
     CallbackMock wrapper;
-    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
-                                                          {
-                                                              auto delta = nlohmann::json::parse(data);
-                                                              delta["data"].erase("@timestamp");
-                                                              delta["metadata"].erase("id");
-                                                              delta.erase("stateless");
-                                                              wrapper.callbackMock(delta.dump());
-                                                          }};
+    std::function<void(nlohmann::json&)> callbackData {[&wrapper](nlohmann::json& data)
+                                                       {
+                                                           auto delta = data;
+                                                           delta["data"].erase("@timestamp");
+                                                           delta["metadata"].erase("id");
+                                                           delta.erase("stateless");
+                                                           wrapper.callbackMock(delta.dump());
+                                                       }};
     const auto expectedResult1 {
         R"({"data":{"destination":{"ip":["0.0.0.0"],"port":0},"file":{"inode":43481},"host":{"network":{"egress":{"queue":0},"ingress":{"queue":0}}},"interface":{"state":null},"network":{"protocol":"udp"},"process":{"name":null,"pid":0},"source":{"ip":["0.0.0.0"],"port":47748}},"metadata":{"collector":"ports","module":"inventory","operation":"create"}})"};
 
@@ -1282,14 +1384,14 @@ TEST_F(InventoryImpTest, PackagesDuplicated)
                 R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":411,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json)));
 
     CallbackMock wrapper;
-    std::function<void(const std::string&)> callbackData {[&wrapper](const std::string& data)
-                                                          {
-                                                              auto delta = nlohmann::json::parse(data);
-                                                              delta["data"].erase("@timestamp");
-                                                              delta["metadata"].erase("id");
-                                                              delta.erase("stateless");
-                                                              wrapper.callbackMock(delta.dump());
-                                                          }};
+    std::function<void(nlohmann::json&)> callbackData {[&wrapper](nlohmann::json& data)
+                                                       {
+                                                           auto delta = data;
+                                                           delta["data"].erase("@timestamp");
+                                                           delta["metadata"].erase("id");
+                                                           delta.erase("stateless");
+                                                           wrapper.callbackMock(delta.dump());
+                                                       }};
 
     const auto expectedResult1 {
         R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":411,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
@@ -1337,13 +1439,13 @@ TEST_F(InventoryImpTest, hashId)
             R"({"architecture":"x86_64","scan_time":"2020/12/28 21:49:50", "hostname":"UBUNTU","os_build":"7601","os_major":"6","os_minor":"1","os_name":"Microsoft Windows 7","os_release":"sp1","os_version":"6.1.7601"})")));
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta.erase("stateless");
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta.erase("stateless");
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult2 {
         R"({"data":{"host":{"architecture":"x86_64","hostname":"UBUNTU","os":{"full":null,"kernel":"7601","name":"Microsoft Windows 7","platform":null,"type":null,"version":"6.1.7601"}}},"metadata":{"collector":"system","id":"6bd3291be0d2314de0329e8ac36be434a085eb32","module":"inventory","operation":"create"}})"};
@@ -1393,17 +1495,17 @@ TEST_F(InventoryImpTest, statelessMessage)
             R"({"board_serial":"Intel Corporation","scan_time":"2020/12/28 21:49:50", "cpu_mhz":2904,"cpu_cores":2,"cpu_name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz", "ram_free":1000000,"ram_total":4972208,"ram_usage":80})")));
 
     CallbackMock wrapperDelta;
-    std::function<void(const std::string&)> callbackDataDelta {[&wrapperDelta](const std::string& data)
-                                                               {
-                                                                   auto delta = nlohmann::json::parse(data);
-                                                                   delta["data"].erase("@timestamp");
-                                                                   delta["metadata"].erase("id");
-                                                                   if (delta.contains("stateless"))
-                                                                   {
-                                                                       delta["stateless"]["event"].erase("created");
-                                                                   }
-                                                                   wrapperDelta.callbackMock(delta.dump());
-                                                               }};
+    std::function<void(nlohmann::json&)> callbackDataDelta {[&wrapperDelta](nlohmann::json& data)
+                                                            {
+                                                                auto delta = data;
+                                                                delta["data"].erase("@timestamp");
+                                                                delta["metadata"].erase("id");
+                                                                if (delta.contains("stateless"))
+                                                                {
+                                                                    delta["stateless"]["event"].erase("created");
+                                                                }
+                                                                wrapperDelta.callbackMock(delta.dump());
+                                                            }};
 
     const auto expectedResult1 {
         R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
@@ -1445,6 +1547,458 @@ TEST_F(InventoryImpTest, statelessMessage)
     }
 }
 
+TEST_F(InventoryImpTest, scanMetrics)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, hardware())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"board_serial":"Intel Corporation","scan_time":"2020/12/28 21:49:50", "cpu_mhz":2904,"cpu_cores":2,"cpu_name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz", "ram_free":2257872,"ram_total":4972208,"ram_usage":54})")));
+    EXPECT_CALL(*spInfoWrapper, os())
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"architecture":"x86_64","scan_time":"2020/12/28 21:49:50", "hostname":"UBUNTU","os_build":"7601","os_major":"6","os_minor":"1","os_name":"Microsoft Windows 7","os_release":"sp1","os_version":"6.1.7601"})")));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_)).Times(0);
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            scan_threads: 2
+            hardware: true
+            system: true
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+
+    // Metrics are kept for the lifetime of the module, so compare against the previous values
+    auto before {Inventory::Instance().GetScanMetrics()};
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper,
+                             inventoryConfig,
+                             [&before]()
+                             {
+                                 return Scans("hardware") > before["hardware"].scans &&
+                                        Scans("system") > before["system"].scans;
+                             }));
+
+    const auto after {Inventory::Instance().GetScanMetrics()};
+
+    ASSERT_TRUE(after.contains("hardware"));
+    ASSERT_TRUE(after.contains("system"));
+    EXPECT_GT(after.at("hardware").scans, before["hardware"].scans);
+    EXPECT_GT(after.at("system").scans, before["system"].scans);
+    EXPECT_GE(after.at("hardware").totalDuration, after.at("hardware").lastDuration);
+    EXPECT_EQ(after.contains("packages") ? after.at("packages").scans : 0, before["packages"].scans);
+}
+
+TEST_F(InventoryImpTest, concurrentCollection)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    using Clock = std::chrono::steady_clock;
+    std::mutex mutex;
+    std::map<std::string, std::pair<Clock::time_point, Clock::time_point>> collections;
+
+    // Each collection lasts long enough for the other one to start if they run at the same time
+    const auto collect {[&mutex, &collections](const std::string& category,
+                                               const std::function<void(nlohmann::json&)>& callback,
+                                               nlohmann::json data)
+                        {
+                            const auto start {Clock::now()};
+                            std::this_thread::sleep_for(std::chrono::milliseconds {300});
+                            callback(data);
+                            std::lock_guard<std::mutex> lock {mutex};
+                            collections[category] = {start, Clock::now()};
+                        }};
+
+    EXPECT_CALL(*spInfoWrapper, packagesFingerprints()).WillRepeatedly(Return(nlohmann::json::object()));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(1)
+        .WillOnce(
+            [&collect](std::function<void(nlohmann::json&)> callback)
+            {
+                collect(
+                    "packages",
+                    callback,
+                    R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":411,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json);
+            });
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(1)
+        .WillOnce(
+            [&collect](std::function<void(nlohmann::json&)> callback)
+            {
+                collect(
+                    "processes",
+                    callback,
+                    R"({"name":"systemd","pid":"1","ppid":0,"euser":"root","egroup":"root","start_time":9302261,"tgid":1,"tty":0})"_json);
+            });
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            scan_threads: 4
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: true
+            processes_events: false
+            hotfixes: false
+    )";
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper,
+                             inventoryConfig,
+                             [this]() { return !Deltas("packages").empty() && !Deltas("processes").empty(); }));
+
+    // The collections overlap, only the transactions are applied one at a time
+    ASSERT_EQ(2u, collections.size());
+    EXPECT_LT(collections["packages"].first, collections["processes"].second);
+    EXPECT_LT(collections["processes"].first, collections["packages"].second);
+}
+
+TEST_F(InventoryImpTest, categoryIntervals)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, hardware())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(nlohmann::json::parse(
+            R"({"board_serial":"Intel Corporation","scan_time":"2020/12/28 21:49:50", "cpu_mhz":2904,"cpu_cores":2,"cpu_name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz", "ram_free":2257872,"ram_total":4972208,"ram_usage":54})")))
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"board_serial":"Intel Corporation","scan_time":"2020/12/28 21:49:50", "cpu_mhz":2904,"cpu_cores":2,"cpu_name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz", "ram_free":1128936,"ram_total":4972208,"ram_usage":77})")));
+    EXPECT_CALL(*spInfoWrapper, os())
+        .Times(1)
+        .WillRepeatedly(Return(nlohmann::json::parse(
+            R"({"architecture":"x86_64","scan_time":"2020/12/28 21:49:50", "hostname":"UBUNTU","os_build":"7601","os_major":"6","os_minor":"1","os_name":"Microsoft Windows 7","os_release":"sp1","os_version":"6.1.7601"})")));
+    EXPECT_CALL(*spInfoWrapper, hotfixes()).Times(0);
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            intervals:
+                hardware: 100ms
+                hotfixes: 100ms
+            scan_on_start: true
+            hardware: true
+            system: true
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+
+    // The hardware is scanned on its own interval, the system only on start and the disabled hotfixes never
+    const auto hardwareScans {Scans("hardware")};
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper,
+                             inventoryConfig,
+                             [this, hardwareScans]()
+                             {
+                                 return Scans("hardware") >= hardwareScans + 3 && !Deltas("system").empty();
+                             }));
+
+    const auto expectedHardware1 {
+        R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":2257872,"total":4972208,"used":{"percentage":54}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"create"}})"};
+    const auto expectedHardware2 {
+        R"({"data":{"host":{"cpu":{"cores":2,"name":"Intel(R) Core(TM) i5-9400 CPU @ 2.90GHz","speed":2904},"memory":{"free":1128936,"total":4972208,"used":{"percentage":77}}},"observer":{"serial_number":"Intel Corporation"}},"metadata":{"collector":"hardware","module":"inventory","operation":"update"}})"};
+    const auto expectedSystem {
+        R"({"data":{"host":{"architecture":"x86_64","hostname":"UBUNTU","os":{"full":null,"kernel":"7601","name":"Microsoft Windows 7","platform":null,"type":null,"version":"6.1.7601"}}},"metadata":{"collector":"system","module":"inventory","operation":"create"}})"};
+
+    // The later hardware scans find no changes and report nothing
+    EXPECT_THAT(Deltas("hardware"), ::testing::ElementsAre(expectedHardware1, expectedHardware2));
+    EXPECT_THAT(Deltas("system"), ::testing::ElementsAre(expectedSystem));
+    EXPECT_THAT(Deltas("hotfixes"), ::testing::IsEmpty());
+}
+
+TEST_F(InventoryImpTest, packagesFingerprints)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, packagesFingerprints())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(R"({"deb":"status:1","npm":"node_modules:1"})"_json))
+        .WillOnce(Return(R"({"deb":"status:1","npm":"node_modules:1"})"_json))
+        .WillRepeatedly(Return(R"({"deb":"status:1","npm":"node_modules:2"})"_json));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .Times(1)
+        .WillOnce(::testing::DoAll(
+            ::testing::InvokeArgument<0>(
+                R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":411,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json),
+            ::testing::InvokeArgument<0>(
+                R"({"architecture":"","name":"npm","size":0,"version":"10.8.1","format":"npm","location":"/usr/lib/node_modules/npm/package.json"})"_json)));
+    EXPECT_CALL(*spInfoWrapper, packages(std::set<std::string> {"npm"}, testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<1>(
+            R"({"architecture":"","name":"npm","size":0,"version":"10.9.0","format":"npm","location":"/usr/lib/node_modules/npm/package.json"})"_json));
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            intervals:
+                packages: 100ms
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+
+    // One more scan after the npm source changes, so a deb package deleted late would be seen
+    const auto packagesScans {Scans("packages")};
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper,
+                             inventoryConfig,
+                             [this, packagesScans]()
+                             { return Deltas().size() >= 4 && Scans("packages") >= packagesScans + 4; }));
+
+    // The deb package is kept while only the npm source is scanned again
+    const auto expectedResult1 {
+        R"({"data":{"package":{"architecture":"amd64","description":null,"installed":null,"name":"xserver-xorg","path":" ","size":411,"type":"deb","version":"1:7.7+19ubuntu14"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"package":{"architecture":null,"description":null,"installed":null,"name":"npm","path":"/usr/lib/node_modules/npm/package.json","size":0,"type":"npm","version":"10.8.1"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult3 {
+        R"({"data":{"package":{"architecture":null,"description":null,"installed":null,"name":"npm","path":"/usr/lib/node_modules/npm/package.json","size":0,"type":"npm","version":"10.9.0"}},"metadata":{"collector":"packages","module":"inventory","operation":"create"}})"};
+    const auto expectedResult4 {
+        R"({"data":{"package":{"architecture":null,"description":null,"installed":null,"name":"npm","path":"/usr/lib/node_modules/npm/package.json","size":0,"type":"npm","version":"10.8.1"}},"metadata":{"collector":"packages","module":"inventory","operation":"delete"}})"};
+
+    EXPECT_THAT(Deltas(),
+                ::testing::UnorderedElementsAre(expectedResult1, expectedResult2, expectedResult3, expectedResult4));
+}
+
+TEST_F(InventoryImpTest, processEvents)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    const auto processesScans {Scans("processes")};
+
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(1)
+        .WillOnce(::testing::DoAll(
+            ::testing::InvokeArgument<0>(
+                R"({"name":"systemd","pid":"1","ppid":0,"euser":"root","egroup":"root","start_time":9302261,"tgid":1,"tty":0})"_json),
+            ::testing::InvokeArgument<0>(
+                R"({"name":"bash","pid":"200","ppid":1,"euser":"root","egroup":"root","start_time":9302262,"tgid":200,"tty":0})"_json)));
+    EXPECT_CALL(*spInfoWrapper, processes(std::set<int32_t> {300}, testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<1>(
+            R"({"name":"sleep","pid":"300","ppid":1,"euser":"root","egroup":"root","start_time":9302263,"tgid":300,"tty":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, processEventsListener())
+        .WillOnce(
+            [this, processesScans]()
+            {
+                auto listener {std::make_unique<ProcessEventsListenerMock>()};
+                EXPECT_CALL(*listener, wait(testing::_, testing::_, testing::_))
+                    .WillOnce(
+                        [this, processesScans](
+                            std::chrono::milliseconds, std::set<int32_t>& changed, std::set<int32_t>& exited)
+                        {
+                            // The events are only synced once the first scan has filled the table
+                            WaitFor([processesScans]() { return Scans("processes") > processesScans; });
+                            changed.insert(300);
+                            exited.insert(200);
+                            return true;
+                        })
+                    .WillRepeatedly(
+                        [](std::chrono::milliseconds, std::set<int32_t>&, std::set<int32_t>&)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds {50});
+                            return true;
+                        });
+                return listener;
+            });
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: true
+            processes_events: true
+            hotfixes: false
+    )";
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper, inventoryConfig, [this]() { return Deltas().size() >= 4; }));
+
+    // The first scan reports every process, then only the processes in the events are synced
+    const auto expectedResult1 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"systemd","parent":{"pid":0},"pid":"1","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302261,"thread":{"id":1},"tty":{"char_device":{"major":0}},"user":{"id":"root"}}},"metadata":{"collector":"processes","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"bash","parent":{"pid":1},"pid":"200","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302262,"thread":{"id":200},"tty":{"char_device":{"major":0}},"user":{"id":"root"}}},"metadata":{"collector":"processes","module":"inventory","operation":"create"}})"};
+    const auto expectedResult3 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"bash","parent":{"pid":1},"pid":"200","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302262,"thread":{"id":200},"tty":{"char_device":{"major":0}},"user":{"id":"root"}}},"metadata":{"collector":"processes","module":"inventory","operation":"delete"}})"};
+    const auto expectedResult4 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"sleep","parent":{"pid":1},"pid":"300","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302263,"thread":{"id":300},"tty":{"char_device":{"major":0}},"user":{"id":"root"}}},"metadata":{"collector":"processes","module":"inventory","operation":"create"}})"};
+
+    EXPECT_THAT(Deltas(),
+                ::testing::UnorderedElementsAre(expectedResult1, expectedResult2, expectedResult3, expectedResult4));
+}
+
+TEST_F(InventoryImpTest, processChurn)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    const auto processesScans {Scans("processes")};
+
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<0>(
+            R"({"name":"systemd","pid":"1","ppid":0,"euser":"root","egroup":"root","start_time":9302261,"tgid":1,"tty":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, processes(std::set<int32_t> {300, 400}, testing::_))
+        .Times(1)
+        .WillOnce(::testing::DoAll(
+            ::testing::InvokeArgument<1>(
+                R"({"name":"cc1plus","pid":"300","ppid":1,"euser":"root","egroup":"root","start_time":9302263,"tgid":300,"tty":0})"_json),
+            ::testing::InvokeArgument<1>(
+                R"({"name":"make","pid":"400","ppid":1,"euser":"root","egroup":"root","start_time":9302264,"tgid":400,"tty":0})"_json)));
+    EXPECT_CALL(*spInfoWrapper, processes(std::set<int32_t> {400}, testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<1>(
+            R"({"name":"make","pid":"400","ppid":1,"euser":"build","egroup":"root","start_time":9302264,"tgid":400,"tty":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, processEventsListener())
+        .WillOnce(
+            [this, processesScans]()
+            {
+                auto listener {std::make_unique<ProcessEventsListenerMock>()};
+                EXPECT_CALL(*listener, wait(testing::_, testing::_, testing::_))
+                    .WillOnce(
+                        [this, processesScans](
+                            std::chrono::milliseconds, std::set<int32_t>& changed, std::set<int32_t>&)
+                        {
+                            // The events are only synced once the first scan has filled the table
+                            WaitFor([processesScans]() { return Scans("processes") > processesScans; });
+                            changed.insert({300, 400});
+                            return true;
+                        })
+                    .WillOnce(
+                        [](std::chrono::milliseconds, std::set<int32_t>& changed, std::set<int32_t>& exited)
+                        {
+                            changed.insert(400);
+                            exited.insert(300);
+                            return true;
+                        })
+                    .WillRepeatedly(
+                        [](std::chrono::milliseconds, std::set<int32_t>&, std::set<int32_t>&)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds {50});
+                            return true;
+                        });
+                return listener;
+            });
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: true
+            processes_events: true
+            churn_window: 300ms
+            hotfixes: false
+    )";
+
+    EXPECT_TRUE(RunInventory(spInfoWrapper, inventoryConfig, [this]() { return Deltas().size() >= 2; }));
+
+    // The process that exits within the window is never reported, the other one is created with its latest data
+    const auto expectedResult1 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"systemd","parent":{"pid":0},"pid":"1","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302261,"thread":{"id":1},"tty":{"char_device":{"major":0}},"user":{"id":"root"}}},"metadata":{"collector":"processes","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"process":{"args":null,"command_line":null,"group":{"id":"root"},"name":"make","parent":{"pid":1},"pid":"400","real_group":{"id":null},"real_user":{"id":null},"saved_group":{"id":null},"saved_user":{"id":null},"start":9302264,"thread":{"id":400},"tty":{"char_device":{"major":0}},"user":{"id":"build"}}},"metadata":{"collector":"processes","module":"inventory","operation":"create"}})"};
+
+    EXPECT_THAT(Deltas(), ::testing::ElementsAre(expectedResult1, expectedResult2));
+}
+
+TEST_F(InventoryImpTest, networkEvents)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+    const auto networksScans {Scans("networks")};
+    std::atomic<int> idleWaits {0};
+
+    EXPECT_CALL(*spInfoWrapper, networks())
+        .Times(2)
+        .WillOnce(Return(nlohmann::json::parse(
+            R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"down","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")))
+        .WillOnce(Return(nlohmann::json::parse(
+            R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"up","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")));
+    EXPECT_CALL(*spInfoWrapper, networkEventsListener())
+        .WillOnce(
+            [this, networksScans, &idleWaits]()
+            {
+                auto listener {std::make_unique<NetworkEventsListenerMock>()};
+                EXPECT_CALL(*listener, wait(testing::_))
+                    .WillOnce(
+                        [this, networksScans](std::chrono::milliseconds)
+                        {
+                            // The events are only scanned once the first scan has filled the table
+                            WaitFor([networksScans]() { return Scans("networks") > networksScans; });
+                            return true;
+                        })
+                    .WillOnce(Return(true))
+                    .WillRepeatedly(
+                        [&idleWaits](std::chrono::milliseconds)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds {50});
+                            ++idleWaits;
+                            return false;
+                        });
+                return listener;
+            });
+
+    std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: true
+            networks_events: true
+            packages: false
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+
+    // A few idle waits after the burst, so a second scan for it would have been done
+    EXPECT_TRUE(RunInventory(spInfoWrapper,
+                             inventoryConfig,
+                             [this, &idleWaits]() { return Deltas().size() >= 2 && idleWaits >= 3; }));
+
+    // The burst of two events triggers a single scan, which reports the state change
+    const auto expectedResult1 {
+        R"({"data":{"host":{"ip":["172.17.0.1"],"mac":"02:42:1c:26:13:65","network":{"egress":{"bytes":0,"drops":0,"errors":0,"packets":0},"ingress":{"bytes":0,"drops":0,"errors":0,"packets":0}}},"interface":{"mtu":1500,"state":"down","type":"ethernet"},"network":{"broadcast":["172.17.255.255"],"dhcp":"unknown","gateway":[],"metric":"0","netmask":["255.255.0.0"],"protocol":null,"type":"ipv4"},"observer":{"ingress":{"interface":{"alias":null,"name":"docker0"}}}},"metadata":{"collector":"networks","module":"inventory","operation":"create"}})"};
+    const auto expectedResult2 {
+        R"({"data":{"host":{"ip":["172.17.0.1"],"mac":"02:42:1c:26:13:65","network":{"egress":{"bytes":0,"drops":0,"errors":0,"packets":0},"ingress":{"bytes":0,"drops":0,"errors":0,"packets":0}}},"interface":{"mtu":1500,"state":"up","type":"ethernet"},"network":{"broadcast":["172.17.255.255"],"dhcp":"unknown","gateway":[],"metric":"0","netmask":["255.255.0.0"],"protocol":null,"type":"ipv4"},"observer":{"ingress":{"interface":{"alias":null,"name":"docker0"}}}},"metadata":{"collector":"networks","module":"inventory","operation":"update"}})"};
+
+    EXPECT_THAT(Deltas(), ::testing::ElementsAre(expectedResult1, expectedResult2));
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
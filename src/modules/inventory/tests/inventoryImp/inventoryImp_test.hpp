@@ -2,6 +2,19 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ISysInfo;
+
 class InventoryImpTest : public ::testing::Test
 {
 protected:
@@ -10,4 +23,33 @@ protected:
 
     void SetUp() override;
     void TearDown() override;
+
+    /// @brief Runs the module until the condition is met, recording the deltas it reports
+    /// @param spInfo System information scanned by the module
+    /// @param config YAML configuration of the module
+    /// @param done Condition to stop the module
+    /// @return true if the condition was met before the timeout
+    bool RunInventory(const std::shared_ptr<ISysInfo>& spInfo,
+                      const std::string& config,
+                      const std::function<bool()>& done);
+
+    /// @brief Waits until the condition is met, checking it on every delta and periodically
+    /// @param condition Condition to wait for
+    /// @return true if the condition was met before the timeout
+    bool WaitFor(const std::function<bool()>& condition);
+
+    /// @brief Gets the deltas reported so far, without the fields that change on every run
+    /// @param collector Collector of the deltas, empty for all of them
+    /// @return Deltas in the order they were reported
+    std::vector<std::string> Deltas(const std::string& collector = "");
+
+    /// @brief Gets the number of scans of a category, kept for the lifetime of the module
+    /// @param category Category name
+    /// @return Number of scans
+    static uint64_t Scans(const std::string& category);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<nlohmann::json> m_deltas;
 };
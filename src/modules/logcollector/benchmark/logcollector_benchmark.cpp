@@ -0,0 +1,464 @@
+#include <configuration_parser.hpp>
+#include <logcollector.hpp>
+#include <logger.hpp>
+#include <message.hpp>
+#include <multitype_queue.hpp>
+
+#include "file_reader.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace program_options = boost::program_options;
+
+/// Command-line options
+static const auto OPT_HELP {"help"};
+static const auto OPT_LINES {"lines"};
+static const auto OPT_LINE_SIZE {"line-size"};
+static const auto OPT_RATE {"rate"};
+static const auto OPT_FILES {"files"};
+static const auto OPT_SINK {"sink"};
+static const auto OPT_READ_INTERVAL {"read-interval"};
+static const auto OPT_TIMEOUT {"timeout"};
+static const auto OPT_WORKDIR {"workdir"};
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Lines starting with this mark are only used to detect that the files are being read
+    constexpr char WARMUP_MARK = 'W';
+
+    /// @brief Width of the sequence and timestamp fields of a generated line
+    constexpr size_t FIELD_WIDTH = 20;
+
+    /// @brief Size of the sequence and timestamp fields of a generated line, separator included
+    constexpr size_t HEADER_SIZE = (FIELD_WIDTH * 2) + 1;
+
+    /// @brief Smallest line that holds the header, a separator and the newline
+    constexpr size_t MIN_LINE_SIZE = HEADER_SIZE + 2;
+
+    /// @brief Interval between progress checks of the main thread
+    constexpr auto POLL_INTERVAL = std::chrono::milliseconds(10);
+
+    /// @brief Messages removed from the queue on each drain iteration
+    constexpr int QUEUE_DRAIN_BATCH = 1000;
+
+    /// @brief Benchmark parameters
+    struct Parameters
+    {
+        size_t lines = 0;
+        size_t lineSize = 0;
+        size_t rate = 0;
+        size_t files = 0;
+        std::time_t readInterval = 0;
+        std::chrono::seconds timeout {0};
+        std::filesystem::path workdir;
+    };
+
+    /// @brief Benchmark results
+    struct Results
+    {
+        size_t received = 0;
+        double elapsed = 0;
+        double cpu = 0;
+        std::vector<int64_t> latencies;
+    };
+
+    int64_t NowNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    double ThreadCpuSeconds(std::thread& thread)
+    {
+        clockid_t clockId {};
+        timespec ts {};
+
+        if (pthread_getcpuclockid(thread.native_handle(), &clockId) != 0 || clock_gettime(clockId, &ts) != 0)
+        {
+            return 0;
+        }
+
+        constexpr double NS_PER_SECOND = 1e9;
+        return static_cast<double>(ts.tv_sec) + (static_cast<double>(ts.tv_nsec) / NS_PER_SECOND);
+    }
+
+    /// @brief Logcollector that can be instantiated outside the module manager
+    class BenchmarkLogcollector : public logcollector::Logcollector
+    {
+    public:
+        BenchmarkLogcollector() = default;
+        ~BenchmarkLogcollector() override = default;
+    };
+
+    /// @brief Receives the messages pushed by the logcollector and measures them
+    ///
+    /// Runs on the logcollector thread, so only the counters read by the main
+    /// thread need to be atomic.
+    class Probe
+    {
+    public:
+        Probe(size_t files, size_t lines)
+            : m_ready(files)
+        {
+            m_latencies.reserve(lines);
+        }
+
+        /// @brief Accounts a message once it has been enqueued
+        void Record(const Message& message)
+        {
+            const auto& log = message.data["event"]["original"].get_ref<const std::string&>();
+
+            if (!log.empty() && log.front() == WARMUP_MARK)
+            {
+                const auto file = std::stoul(log.substr(1));
+                if (file < m_ready.size())
+                {
+                    m_ready[file].store(true);
+                }
+                return;
+            }
+
+            const auto written = std::stoll(log.substr(FIELD_WIDTH + 1, FIELD_WIDTH));
+            m_latencies.push_back(NowNanoseconds() - written);
+            m_received.fetch_add(1, std::memory_order_release);
+        }
+
+        /// @brief Checks if every file has delivered its warmup line
+        bool Ready() const
+        {
+            return std::all_of(m_ready.begin(), m_ready.end(), [](const auto& ready) { return ready.load(); });
+        }
+
+        /// @brief Number of measured messages
+        size_t Received() const
+        {
+            return m_received.load(std::memory_order_acquire);
+        }
+
+        /// @brief Latencies in nanoseconds, only safe once the logcollector is stopped
+        std::vector<int64_t>& Latencies()
+        {
+            return m_latencies;
+        }
+
+    private:
+        std::vector<std::atomic<bool>> m_ready;
+        std::atomic<size_t> m_received = 0;
+        std::vector<int64_t> m_latencies;
+    };
+
+    /// @brief Appends generated lines to a set of files
+    class Writer
+    {
+    public:
+        Writer(const std::filesystem::path& directory, size_t files)
+        {
+            for (size_t i = 0; i < files; ++i)
+            {
+                const auto path = directory / ("bench_" + std::to_string(i) + ".log");
+                const auto fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+
+                if (fd < 0)
+                {
+                    throw std::runtime_error("Cannot create " + path.string());
+                }
+                m_fds.push_back(fd);
+            }
+        }
+
+        ~Writer()
+        {
+            for (const auto fd : m_fds)
+            {
+                close(fd);
+            }
+        }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        /// @brief Writes a warmup line to every file
+        void Warmup()
+        {
+            for (size_t i = 0; i < m_fds.size(); ++i)
+            {
+                Append(i, WARMUP_MARK + std::to_string(i) + "\n");
+            }
+        }
+
+        /// @brief Writes the measured lines, round robin across the files
+        ///
+        /// Each line carries its sequence number and the time it was appended.
+        /// Lines are paced to the requested rate, 0 meaning as fast as possible.
+        void Run(size_t lines, size_t lineSize, size_t rate)
+        {
+            std::string line(lineSize, 'x');
+            line.back() = '\n';
+            const auto start = Clock::now();
+
+            for (size_t seq = 0; seq < lines; ++seq)
+            {
+                if (rate > 0)
+                {
+                    std::this_thread::sleep_until(start + std::chrono::nanoseconds(seq * std::nano::den / rate));
+                }
+
+                std::snprintf(line.data(),
+                              HEADER_SIZE + 1,
+                              "%0*zu %0*lld",
+                              static_cast<int>(FIELD_WIDTH),
+                              seq,
+                              static_cast<int>(FIELD_WIDTH),
+                              static_cast<long long>(NowNanoseconds()));
+                line[HEADER_SIZE] = ' ';
+                Append(seq % m_fds.size(), line);
+            }
+        }
+
+    private:
+        void Append(size_t file, const std::string& data)
+        {
+            if (write(m_fds[file], data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+            {
+                throw std::runtime_error("Cannot write benchmark file");
+            }
+        }
+
+        std::vector<int> m_fds;
+    };
+
+    /// @brief Drains the queue in the background, as the communicator would
+    class QueueDrainer
+    {
+    public:
+        explicit QueueDrainer(MultiTypeQueue& queue)
+            : m_thread(
+                  [&queue](std::stop_token stopToken)
+                  {
+                      while (!stopToken.stop_requested())
+                      {
+                          if (queue.popN(MessageType::STATELESS, QUEUE_DRAIN_BATCH) == 0)
+                          {
+                              std::this_thread::sleep_for(POLL_INTERVAL);
+                          }
+                      }
+                  })
+        {
+        }
+
+    private:
+        std::jthread m_thread;
+    };
+
+    Results Run(const Parameters& params, const std::function<int(Message)>& enqueue)
+    {
+        Writer writer(params.workdir, params.files);
+        Probe probe(params.files, params.lines);
+        BenchmarkLogcollector logcollector;
+
+        logcollector.SetPushMessageFunction(
+            [&](Message message)
+            {
+                const auto result = enqueue(message);
+                probe.Record(message);
+                return result;
+            });
+
+        const auto pattern = (params.workdir / "bench_*.log").string();
+        logcollector.AddReader(std::make_shared<logcollector::FileReader>(
+            logcollector, pattern, params.readInterval, config::logcollector::DEFAULT_RELOAD_INTERVAL));
+
+        std::thread collectorThread([&logcollector]() { logcollector.Start(); });
+
+        // The reader starts at the end of the files, so lines written before it
+        // opens them would be missed. Keep writing warmup lines until all of them
+        // have been seen.
+        const auto deadline = Clock::now() + params.timeout;
+        while (!probe.Ready() && Clock::now() < deadline)
+        {
+            writer.Warmup();
+            std::this_thread::sleep_for(std::chrono::milliseconds(params.readInterval) + POLL_INTERVAL);
+        }
+
+        Results results;
+        const auto cpuStart = ThreadCpuSeconds(collectorThread);
+        const auto start = Clock::now();
+
+        if (probe.Ready())
+        {
+            writer.Run(params.lines, params.lineSize, params.rate);
+
+            while (probe.Received() < params.lines && Clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(POLL_INTERVAL);
+            }
+        }
+        else
+        {
+            std::cerr << "Timeout waiting for the reader to open the files\n";
+        }
+
+        results.elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        results.cpu = ThreadCpuSeconds(collectorThread) - cpuStart;
+
+        logcollector.Stop();
+        collectorThread.join();
+
+        results.received = probe.Received();
+        results.latencies = std::move(probe.Latencies());
+        return results;
+    }
+
+    double Percentile(std::vector<int64_t>& values, double percentile)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+
+        const auto index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+
+        constexpr double NS_PER_US = 1e3;
+        return static_cast<double>(values[index]) / NS_PER_US;
+    }
+
+    void Report(const std::string& sink, const Parameters& params, Results& results)
+    {
+        constexpr double MILLION = 1e6;
+        constexpr double P50 = 0.50;
+        constexpr double P99 = 0.99;
+
+        const auto elapsed = std::max(results.elapsed, std::numeric_limits<double>::epsilon());
+        const auto received = static_cast<double>(results.received);
+
+        std::cout << std::fixed << std::setprecision(2) << "sink=" << sink << " files=" << params.files
+                  << " lines=" << params.lines << " line_size=" << params.lineSize
+                  << " rate=" << (params.rate > 0 ? std::to_string(params.rate) : "unlimited") << '\n'
+                  << "  received:    " << results.received << " (" << (params.lines - results.received)
+                  << " missing)\n"
+                  << "  elapsed:     " << results.elapsed << " s\n"
+                  << "  throughput:  " << received / elapsed << " events/s, "
+                  << received * static_cast<double>(params.lineSize) / elapsed / MILLION << " MB/s\n"
+                  << "  cpu:         " << results.cpu << " s, "
+                  << (received > 0 ? results.cpu * MILLION / received : 0) << " s per million lines\n"
+                  << "  latency:     p50 " << Percentile(results.latencies, P50) << " us, p99 "
+                  << Percentile(results.latencies, P99) << " us\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        program_options::options_description cmdParser("Logcollector end-to-end throughput benchmark");
+        cmdParser.add_options()(OPT_HELP, "Display this help menu")(
+            OPT_LINES, program_options::value<size_t>()->default_value(1000000), "Number of lines to write")(
+            OPT_LINE_SIZE,
+            program_options::value<size_t>()->default_value(256),
+            "Line size in bytes, including the newline")(
+            OPT_RATE,
+            program_options::value<size_t>()->default_value(0),
+            "Lines written per second, 0 to write as fast as possible")(
+            OPT_FILES, program_options::value<size_t>()->default_value(1), "Number of files to spread the lines over")(
+            OPT_SINK,
+            program_options::value<std::string>()->default_value("both"),
+            "Destination of the messages: memory, queue or both")(
+            OPT_READ_INTERVAL,
+            program_options::value<std::time_t>()->default_value(config::logcollector::DEFAULT_FILE_WAIT),
+            "Logcollector read interval in milliseconds")(
+            OPT_TIMEOUT, program_options::value<size_t>()->default_value(300), "Maximum duration of a run in seconds")(
+            OPT_WORKDIR,
+            program_options::value<std::string>(),
+            "Directory for the generated files and the queue database (default: a temporary directory)");
+
+        program_options::variables_map options;
+        program_options::store(program_options::parse_command_line(argc, argv, cmdParser), options);
+        program_options::notify(options);
+
+        if (options.count(OPT_HELP) > 0)
+        {
+            std::cout << cmdParser << '\n';
+            return 0;
+        }
+
+        // Keep the per-file module logs out of the report
+        spdlog::set_level(spdlog::level::warn);
+
+        Parameters params;
+        params.lines = options[OPT_LINES].as<size_t>();
+        params.lineSize = std::clamp<size_t>(
+            options[OPT_LINE_SIZE].as<size_t>(), MIN_LINE_SIZE, config::logcollector::BUFFER_SIZE - 1);
+        params.rate = options[OPT_RATE].as<size_t>();
+        params.files = std::max<size_t>(options[OPT_FILES].as<size_t>(), 1);
+        params.readInterval = std::max<std::time_t>(options[OPT_READ_INTERVAL].as<std::time_t>(), 1);
+        params.timeout = std::chrono::seconds(options[OPT_TIMEOUT].as<size_t>());
+
+        const auto sink = options[OPT_SINK].as<std::string>();
+        if (sink != "memory" && sink != "queue" && sink != "both")
+        {
+            std::cerr << "Invalid sink: " << sink << '\n';
+            return 1;
+        }
+
+        const bool ownWorkdir = options.count(OPT_WORKDIR) == 0;
+        params.workdir = ownWorkdir ? std::filesystem::temp_directory_path() /
+                                          ("logcollector_benchmark_" + std::to_string(getpid()))
+                                    : std::filesystem::path(options[OPT_WORKDIR].as<std::string>());
+        std::filesystem::create_directories(params.workdir);
+
+        if (sink == "memory" || sink == "both")
+        {
+            auto results = Run(params, [](const Message&) { return 1; });
+            Report("memory", params, results);
+        }
+
+        if (sink == "queue" || sink == "both")
+        {
+            const auto queueDir = params.workdir / "queue";
+            std::filesystem::create_directories(queueDir);
+
+            auto configurationParser = std::make_shared<configuration::ConfigurationParser>(
+                "agent:\n  path.data: " + queueDir.string() + "\n  queue_size: " +
+                std::to_string(config::agent::QUEUE_DEFAULT_SIZE) + "\n");
+            MultiTypeQueue queue(configurationParser);
+            QueueDrainer drainer(queue);
+
+            auto results = Run(params, [&queue](const Message& message) { return queue.push(message, true); });
+            Report("queue", params, results);
+        }
+
+        if (ownWorkdir)
+        {
+            std::filesystem::remove_all(params.workdir);
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        LogCritical("An error occurred: {}.", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <list>
+#include <string>
+
+namespace logcollector
+{
+
+    /// @brief Directory watcher class
+    ///
+    /// This class receives change notifications for a single directory and
+    /// reports the new entries whose name matches a wildcard pattern. It lets a
+    /// file reader maintain its file list incrementally instead of expanding the
+    /// whole pattern on every reload. Notifications are only available on Linux
+    /// (inotify); on other platforms the watcher is never active.
+    class DirectoryWatcher
+    {
+    public:
+        /// @brief Constructor
+        /// @param directory Directory to watch
+        /// @param pattern Wildcard pattern for the entry names, without directory
+        DirectoryWatcher(std::string directory, std::string pattern);
+
+        /// @brief Destructor
+        ~DirectoryWatcher();
+
+        DirectoryWatcher(const DirectoryWatcher&) = delete;
+        DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+        /// @brief Checks if notifications are being received
+        /// @return True if the directory is being watched, false otherwise
+        bool Active() const;
+
+        /// @brief Collects the new matching entries since the last call
+        ///
+        /// Non-blocking. Appends the full path of every regular entry created in
+        /// or moved into the directory that matches the pattern.
+        ///
+        /// @param paths List where the new paths are appended
+        /// @return False if notifications were lost (queue overflow or watch
+        /// removed) and a full rescan is needed, true otherwise
+        bool Poll(std::list<std::string>& paths);
+
+    private:
+        /// @brief Stops watching the directory
+        void Close();
+
+        /// @brief Watched directory
+        std::string m_directory;
+
+        /// @brief Entry name pattern
+        std::string m_pattern;
+
+        /// @brief Notification descriptor, -1 if not active
+        int m_fd = -1;
+    };
+
+} // namespace logcollector
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 
 #include <config.h>
+#include <directory_watcher.hpp>
 #include <logcollector.hpp>
 #include <reader.hpp>
 
@@ -14,6 +20,35 @@ const std::string FILE_READER_TYPE = "file";
 namespace logcollector
 {
 
+    /// @brief File identity
+    ///
+    /// Identifies a file regardless of the path used to reach it (device and
+    /// inode on Unix, volume serial number and file index on Windows).
+    struct FileId
+    {
+        /// @brief Device or volume identifier
+        uint64_t device = 0;
+
+        /// @brief Inode or file index
+        uint64_t inode = 0;
+
+        bool operator==(const FileId& other) const = default;
+    };
+
+    /// @brief Hash function for FileId
+    struct FileIdHash
+    {
+        size_t operator()(const FileId& id) const noexcept
+        {
+            return std::hash<uint64_t> {}(id.inode) ^ (std::hash<uint64_t> {}(id.device) << 1);
+        }
+    };
+
+    /// @brief Gets the identity of a file
+    /// @param path File path
+    /// @return File identity, or std::nullopt if the file cannot be accessed
+    std::optional<FileId> GetFileId(const std::string& path);
+
     /// @brief Local file class
     ///
     /// This class represents an individual local file that can be read by
@@ -55,10 +90,20 @@ namespace logcollector
             return m_filename;
         }
 
+        /// @brief Gets the identity of the opened file
+        /// @return File identity, or std::nullopt if unknown
+        inline const std::optional<FileId>& Identity() const
+        {
+            return m_fileId;
+        }
+
     private:
         /// @brief File name
         std::string m_filename;
 
+        /// @brief Identity of the opened file
+        std::optional<FileId> m_fileId;
+
         /// @brief Shared pointer to the input stream
         std::shared_ptr<std::istream> m_stream;
 
@@ -80,7 +125,12 @@ namespace logcollector
         /// @param pattern File pattern
         /// @param fileWait File wait time in milliseconds
         /// @param reloadInterval Reload interval in milliseconds
-        FileReader(Logcollector& logcollector, std::string pattern, std::time_t fileWait, std::time_t reloadInterval);
+        /// @param rescanInterval Full reload interval in milliseconds when the directory is watched
+        FileReader(Logcollector& logcollector,
+                   std::string pattern,
+                   std::time_t fileWait,
+                   std::time_t reloadInterval,
+                   std::time_t rescanInterval = config::logcollector::DEFAULT_RESCAN_INTERVAL);
 
         /// @brief Runs the file reader
         /// @return Awaitable result
@@ -102,11 +152,26 @@ namespace logcollector
         /// @return Awaitable result
         Awaitable ReadLocalfile(Localfile* lf);
 
+        /// @brief Starts watching the directory of the file pattern
+        ///
+        /// Only possible when the directory part of the pattern has no
+        /// wildcards and the platform supports change notifications.
+        ///
+        /// @return True if the directory is being watched, false otherwise
+        bool WatchDirectory();
+
+        /// @brief Adds the files reported by the directory watcher
+        ///
+        /// @param callback Callback function
+        /// @return False if notifications were lost and a full reload is needed
+        bool PollDirectory(const std::function<void(Localfile&)>& callback);
+
     private:
         /// @brief Adds localfiles to the list
         ///
         /// Merges the new files with the existing files. For each new file, it
-        /// calls the callback function.
+        /// calls the callback function. Files already being read through a
+        /// different path (same identity) are skipped.
         ///
         /// @param paths List of file paths
         /// @param callback Callback function
@@ -117,18 +182,35 @@ namespace logcollector
         /// @post The file is destroyed and may not be used anymore
         void RemoveLocalfile(const std::string& filename);
 
+        /// @brief Updates the identity index after a local file is reopened
+        /// @param filename File name
+        /// @param previousId Identity of the file before reopening it
+        void ReindexLocalfile(const std::string& filename, const std::optional<FileId>& previousId);
+
         /// @brief File pattern
         std::string m_filePattern;
 
         /// @brief List of local files
         std::list<Localfile> m_localfiles;
 
+        /// @brief Index of local files by path
+        std::unordered_map<std::string, std::list<Localfile>::iterator> m_pathIndex;
+
+        /// @brief Index of local files by file identity
+        std::unordered_map<FileId, std::list<Localfile>::iterator, FileIdHash> m_fileIdIndex;
+
+        /// @brief Watcher for the directory of the file pattern
+        std::unique_ptr<DirectoryWatcher> m_watcher;
+
         /// @brief File reading interval in milliseconds
         std::time_t m_fileWait;
 
         /// @brief Reload (wildcard expand) interval in milliseconds
         std::time_t m_reloadInterval;
 
+        /// @brief Full reload interval in milliseconds when the directory is watched
+        std::time_t m_rescanInterval;
+
         /// @brief File pattern
         const std::string m_collectorType = FILE_READER_TYPE;
     };
@@ -4,6 +4,7 @@
 #include <logger.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <string>
 
 using namespace logcollector;
@@ -11,27 +12,53 @@ using namespace logcollector;
 FileReader::FileReader(Logcollector& logcollector,
                        std::string pattern,
                        std::time_t fileWait,
-                       std::time_t reloadInterval)
+                       std::time_t reloadInterval,
+                       std::time_t rescanInterval)
     : IReader(logcollector)
     , m_filePattern(std::move(pattern))
     , m_localfiles()
     , m_fileWait(fileWait)
     , m_reloadInterval(reloadInterval)
+    , m_rescanInterval(rescanInterval)
 {
 }
 
 Awaitable FileReader::Run()
 {
+    auto callback = [&](Localfile& lf)
+    {
+        lf.SeekEnd();
+        m_logcollector.EnqueueTask(ReadLocalfile(&lf));
+    };
+
     while (m_keepRunning.load())
     {
-        Reload(
-            [&](Localfile& lf)
-            {
-                lf.SeekEnd();
-                m_logcollector.EnqueueTask(ReadLocalfile(&lf));
-            });
+        // The watch goes first, so a file created during the reload is still notified. The
+        // files seen by both are only added once.
+        const auto watching = WatchDirectory();
 
-        co_await m_logcollector.Wait(std::chrono::milliseconds(m_reloadInterval));
+        Reload(callback);
+
+        if (!watching)
+        {
+            co_await m_logcollector.Wait(std::chrono::milliseconds(m_reloadInterval));
+            continue;
+        }
+
+        // New files are picked up from directory notifications. The full reload
+        // only runs as a safety net, or when notifications have been lost.
+        const auto rescanTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_rescanInterval);
+
+        while (m_keepRunning.load() && std::chrono::steady_clock::now() < rescanTime)
+        {
+            co_await m_logcollector.Wait(std::chrono::milliseconds(m_fileWait));
+
+            if (!PollDirectory(callback))
+            {
+                LogDebug("Directory notifications lost for pattern: {}", m_filePattern);
+                break;
+            }
+        }
     }
 }
 
@@ -46,23 +73,36 @@ Awaitable FileReader::ReadLocalfile(Localfile* lf)
     {
         auto log = lf->NextLog();
 
-        while (!log.empty())
+        while (!log.empty() && m_keepRunning.load())
         {
-            m_logcollector.SendMessage(lf->Filename(), log, m_collectorType);
+            auto delay = TrySendMessage(lf->Filename(), log, m_collectorType);
+
+            if (delay.count() > 0)
+            {
+                // Over the rate limit: stop reading until there is room for this line
+                co_await m_logcollector.Wait(delay);
+                continue;
+            }
+
             log = lf->NextLog();
         }
 
+        FlushDropSummary();
+
         try
         {
             if (lf->Rotated())
             {
                 LogInfo("File '{}' rotated, reloading", lf->Filename());
+                auto previousId = lf->Identity();
                 lf->Reopen();
+                ReindexLocalfile(lf->Filename(), previousId);
             }
         }
         catch (OpenError&)
         {
             LogInfo("File inaccesible: {}", lf->Filename());
+            RemoveLocalfile(lf->Filename());
             co_return;
         }
 
@@ -72,22 +112,136 @@ Awaitable FileReader::ReadLocalfile(Localfile* lf)
     RemoveLocalfile(lf->Filename());
 }
 
+bool FileReader::WatchDirectory()
+{
+    if (m_watcher && m_watcher->Active())
+    {
+        return true;
+    }
+
+    m_watcher.reset();
+
+    const auto separator = m_filePattern.find_last_of("/\\");
+
+    if (separator == std::string::npos || m_filePattern.find_first_of("*?[") < separator)
+    {
+        return false;
+    }
+
+    auto directory = separator == 0 ? m_filePattern.substr(0, 1) : m_filePattern.substr(0, separator);
+    auto watcher = std::make_unique<DirectoryWatcher>(std::move(directory), m_filePattern.substr(separator + 1));
+
+    if (watcher->Active())
+    {
+        LogDebug("Watching directory for pattern: {}", m_filePattern);
+        m_watcher = std::move(watcher);
+        return true;
+    }
+
+    return false;
+}
+
+bool FileReader::PollDirectory(const std::function<void(Localfile&)>& callback)
+{
+    if (!m_watcher)
+    {
+        return false;
+    }
+
+    std::list<std::string> paths;
+    const auto complete = m_watcher->Poll(paths);
+
+    AddLocalfiles(paths, callback);
+    return complete;
+}
+
 void FileReader::AddLocalfiles(const std::list<std::string>& paths, const std::function<void(Localfile&)>& callback)
 {
     for (auto& path : paths)
     {
-        if (none_of(m_localfiles.begin(), m_localfiles.end(), [&path](Localfile& lf) { return lf.Filename() == path; }))
+        if (m_pathIndex.contains(path))
+        {
+            continue;
+        }
+
+        if (auto fileId = GetFileId(path))
+        {
+            if (auto it = m_fileIdIndex.find(*fileId); it != m_fileIdIndex.end())
+            {
+                LogDebug("File '{}' is already being read as '{}'", path, it->second->Filename());
+                continue;
+            }
+        }
+
+        try
         {
             m_localfiles.emplace_back(path);
-            LogInfo("Reading log file: {}", m_localfiles.back().Filename());
-            callback(m_localfiles.back());
         }
+        catch (OpenError& err)
+        {
+            LogDebug("{}", err.what());
+            continue;
+        }
+
+        auto lf = std::prev(m_localfiles.end());
+        m_pathIndex.emplace(path, lf);
+
+        if (lf->Identity())
+        {
+            m_fileIdIndex.emplace(*lf->Identity(), lf);
+        }
+
+        LogInfo("Reading log file: {}", lf->Filename());
+        callback(*lf);
     }
 }
 
 void FileReader::RemoveLocalfile(const std::string& filename)
 {
-    m_localfiles.remove_if([&filename](Localfile& lf) { return lf.Filename() == filename; });
+    auto it = m_pathIndex.find(filename);
+
+    if (it == m_pathIndex.end())
+    {
+        return;
+    }
+
+    auto lf = it->second;
+
+    if (lf->Identity())
+    {
+        if (auto idIt = m_fileIdIndex.find(*lf->Identity()); idIt != m_fileIdIndex.end() && idIt->second == lf)
+        {
+            m_fileIdIndex.erase(idIt);
+        }
+    }
+
+    m_pathIndex.erase(it);
+    m_localfiles.erase(lf);
+}
+
+void FileReader::ReindexLocalfile(const std::string& filename, const std::optional<FileId>& previousId)
+{
+    auto it = m_pathIndex.find(filename);
+
+    if (it == m_pathIndex.end() || it->second->Identity() == previousId)
+    {
+        return;
+    }
+
+    auto lf = it->second;
+
+    if (previousId)
+    {
+        if (auto idIt = m_fileIdIndex.find(*previousId); idIt != m_fileIdIndex.end() && idIt->second == lf)
+        {
+            m_fileIdIndex.erase(idIt);
+        }
+    }
+
+    if (lf->Identity())
+    {
+        m_fileIdIndex.insert_or_assign(*lf->Identity(), lf);
+    }
 }
 
 Localfile::Localfile(std::string filename)
@@ -99,6 +253,8 @@ Localfile::Localfile(std::string filename)
     {
         throw OpenError(m_filename);
     }
+
+    m_fileId = GetFileId(m_filename);
 }
 
 Localfile::Localfile(std::shared_ptr<std::istream> stream)
@@ -151,6 +307,8 @@ void Localfile::Reopen()
     {
         throw OpenError(m_filename);
     }
+
+    m_fileId = GetFileId(m_filename);
 }
 
 OpenError::OpenError(const std::string& filename)
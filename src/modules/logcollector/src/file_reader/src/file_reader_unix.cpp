@@ -1,13 +1,138 @@
 #include "file_reader.hpp"
 
+#include <fnmatch.h>
 #include <glob.h>
 #include <logcollector.hpp>
 #include <logger.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <span>
 
 using namespace logcollector;
 
+std::optional<FileId> logcollector::GetFileId(const std::string& path)
+{
+    struct stat st {};
+
+    if (stat(path.c_str(), &st) != 0)
+    {
+        return std::nullopt;
+    }
+
+    return FileId {static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino)};
+}
+
+DirectoryWatcher::DirectoryWatcher(std::string directory, std::string pattern)
+    : m_directory(std::move(directory))
+    , m_pattern(std::move(pattern))
+{
+#ifdef __linux__
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (m_fd < 0)
+    {
+        LogWarn("Cannot initialize directory notifications: {}", std::strerror(errno));
+        return;
+    }
+
+    if (inotify_add_watch(m_fd, m_directory.c_str(), IN_CREATE | IN_MOVED_TO | IN_ONLYDIR) < 0)
+    {
+        LogDebug("Cannot watch directory '{}': {}", m_directory, std::strerror(errno));
+        Close();
+    }
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    Close();
+}
+
+bool DirectoryWatcher::Active() const
+{
+    return m_fd >= 0;
+}
+
+bool DirectoryWatcher::Poll(std::list<std::string>& paths)
+{
+    if (!Active())
+    {
+        return false;
+    }
+
+    bool complete = true;
+
+#ifdef __linux__
+    constexpr size_t EVENT_BUFFER_SIZE = 16384;
+    alignas(struct inotify_event) std::array<char, EVENT_BUFFER_SIZE> buffer {};
+
+    while (true)
+    {
+        auto length = read(m_fd, buffer.data(), buffer.size());
+
+        if (length <= 0)
+        {
+            if (length < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                LogWarn("Cannot read directory notifications for '{}': {}", m_directory, std::strerror(errno));
+                Close();
+                complete = false;
+            }
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+            if (event->mask & (IN_Q_OVERFLOW | IN_IGNORED))
+            {
+                complete = false;
+
+                if (event->mask & IN_IGNORED)
+                {
+                    // The directory is gone, the next reload will try to watch it again
+                    Close();
+                }
+                continue;
+            }
+
+            if (event->len == 0 || (event->mask & IN_ISDIR) || fnmatch(m_pattern.c_str(), event->name, FNM_PERIOD) != 0)
+            {
+                continue;
+            }
+
+            paths.emplace_back(m_directory + (m_directory.back() == '/' ? "" : "/") + event->name);
+        }
+
+        if (!Active())
+        {
+            break;
+        }
+    }
+#endif
+
+    return complete;
+}
+
+void DirectoryWatcher::Close()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
 void FileReader::Reload(const std::function<void(Localfile&)>& callback)
 {
     glob_t globResult;
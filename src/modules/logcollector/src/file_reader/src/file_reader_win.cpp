@@ -9,6 +9,55 @@
 
 using namespace logcollector;
 
+std::optional<FileId> logcollector::GetFileId(const std::string& path)
+{
+    HANDLE hFile = CreateFile(path.c_str(),
+                              0,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_FLAG_BACKUP_SEMANTICS,
+                              nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return std::nullopt;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    const auto ret = GetFileInformationByHandle(hFile, &info);
+    CloseHandle(hFile);
+
+    if (!ret)
+    {
+        return std::nullopt;
+    }
+
+    return FileId {static_cast<uint64_t>(info.dwVolumeSerialNumber),
+                   (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow};
+}
+
+// Directory notifications are not implemented on Windows, file readers rely on periodic reloads
+DirectoryWatcher::DirectoryWatcher(std::string directory, std::string pattern)
+    : m_directory(std::move(directory))
+    , m_pattern(std::move(pattern))
+{
+}
+
+DirectoryWatcher::~DirectoryWatcher() = default;
+
+bool DirectoryWatcher::Active() const
+{
+    return false;
+}
+
+bool DirectoryWatcher::Poll(std::list<std::string>&)
+{
+    return false;
+}
+
+void DirectoryWatcher::Close() {}
+
 void FileReader::Reload(const std::function<void(Localfile&)>& callback)
 {
     WIN32_FIND_DATA findFileData;
@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
 
 // Forward declaration for sd_journal
@@ -58,6 +59,126 @@ using FilterGroup = std::vector<JournalFilter>;
 /// @brief Set of filter groups combined with OR logic
 using FilterSet = std::vector<FilterGroup>;
 
+/// @brief Transparent hash allowing std::string_view lookups in std::string keyed containers
+struct StringViewHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const noexcept
+    {
+        return std::hash<std::string_view> {}(value);
+    }
+};
+
+/// @brief Immutable, pre-compiled form of a JournalFilter
+///
+/// The '|' separated value list is split once at construction. Exact values are kept in a hashed set
+/// and substring values in a flat list, so matching never allocates.
+class CompiledJournalFilter
+{
+public:
+    /// @brief Compiles a filter
+    /// @param filter Filter to compile
+    explicit CompiledJournalFilter(const JournalFilter& filter)
+        : m_field(filter.field)
+        , m_exactMatch(filter.exact_match)
+    {
+        for (const auto& value : filter.GetValueViews())
+        {
+            if (m_exactMatch)
+            {
+                m_values.emplace(value);
+            }
+            else
+            {
+                m_substrings.emplace_back(value);
+            }
+        }
+    }
+
+    /// @brief Gets the name of the field this filter applies to
+    /// @return Field name
+    const std::string& Field() const
+    {
+        return m_field;
+    }
+
+    /// @brief Indicates whether the filter performs exact matching
+    /// @return true for exact matching, false for substring matching
+    bool IsExact() const
+    {
+        return m_exactMatch;
+    }
+
+    /// @brief Checks if a field value matches any of the filter values
+    /// @param fieldValue The value to check against filter values
+    /// @return true if matches, false otherwise
+    bool Matches(std::string_view fieldValue) const
+    {
+        if (m_exactMatch)
+        {
+            return m_values.find(fieldValue) != m_values.end();
+        }
+
+        return std::any_of(m_substrings.begin(),
+                           m_substrings.end(),
+                           [fieldValue](const auto& val) { return fieldValue.find(val) != std::string_view::npos; });
+    }
+
+private:
+    std::string m_field;                                                       ///< Field name to filter on
+    bool m_exactMatch;                                                         ///< Exact or substring matching
+    std::unordered_set<std::string, StringViewHash, std::equal_to<>> m_values; ///< Exact values
+    std::vector<std::string> m_substrings;                                     ///< Substring values
+};
+
+/// @brief Immutable matcher built once from a FilterGroup (AND logic between filters)
+class FilterGroupMatcher
+{
+public:
+    /// @brief Compiles a filter group
+    /// @param group Group of filters to compile
+    explicit FilterGroupMatcher(const FilterGroup& group)
+    {
+        m_filters.reserve(group.size());
+        for (const auto& filter : group)
+        {
+            m_filters.emplace_back(filter);
+        }
+    }
+
+    /// @brief Checks the group against an entry
+    /// @param fetch Callable taking a field name and returning std::optional<std::string_view> with its value
+    /// @param onMissing Callable invoked with the field name when a field is not present in the entry
+    /// @return true if all filters match, false otherwise
+    template<typename FieldFetcher, typename MissingHandler>
+    bool Matches(const FieldFetcher& fetch, const MissingHandler& onMissing) const
+    {
+        return std::all_of(m_filters.begin(),
+                           m_filters.end(),
+                           [&fetch, &onMissing](const auto& filter)
+                           {
+                               const std::optional<std::string_view> value = fetch(filter.Field());
+                               if (!value)
+                               {
+                                   onMissing(filter.Field());
+                                   return false;
+                               }
+                               return filter.Matches(*value);
+                           });
+    }
+
+    /// @brief Gets the compiled filters
+    /// @return Compiled filters
+    const std::vector<CompiledJournalFilter>& Filters() const
+    {
+        return m_filters;
+    }
+
+private:
+    std::vector<CompiledJournalFilter> m_filters; ///< Compiled filters
+};
+
 /// @brief Exception class for journal-related errors
 class JournalLogException : public std::runtime_error
 {
@@ -112,11 +233,21 @@ public:
     /// @throw JournalLogException if field not found
     virtual std::string GetData(const std::string& field) const;
 
+    /// @brief Retrieves field data from current journal entry without copying it
+    /// @param field Field name to retrieve
+    /// @return View of the field value, or std::nullopt if the field is not present.
+    /// The view is only valid until the journal is moved to another entry.
+    virtual std::optional<std::string_view> GetDataView(const std::string& field) const;
+
     /// @brief Gets timestamp of current journal entry
     /// @return Timestamp in microseconds since epoch
     virtual uint64_t GetTimestamp() const;
 
     /// @brief Adds a group of filters with AND logic between them
+    ///
+    /// The group is compiled once into a FilterGroupMatcher, and its exact matches are pushed down to
+    /// the journal so non-matching entries are skipped by systemd itself.
+    ///
     /// @param group Group of filters to add
     /// @param ignoreIfMissing Whether to ignore missing fields
     virtual void AddFilterGroup(const FilterGroup& group, bool ignoreIfMissing);
@@ -125,8 +256,15 @@ public:
     /// @param filters Set of filter groups to apply
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return Optional containing filtered message if found
+    /// @note The filters are compiled on every call, prefer the overload using the groups added with
+    /// AddFilterGroup
     virtual std::optional<FilteredMessage> GetNextFilteredMessage(const FilterSet& filters, bool ignoreIfMissing);
 
+    /// @brief Gets next message that matches the filter groups added with AddFilterGroup
+    /// @param ignoreIfMissing Whether to ignore missing fields
+    /// @return Optional containing filtered message if found
+    virtual std::optional<FilteredMessage> GetNextFilteredMessage(bool ignoreIfMissing);
+
     /// @brief Clears all active filters
     void FlushFilters();
 
@@ -149,10 +287,11 @@ public:
     virtual bool CursorValid(const std::string& cursor) const;
 
 private:
-    struct sd_journal* m_journal;    ///< Pointer to journal structure
-    uint64_t m_currentTimestamp {0}; ///< Current entry timestamp
-    bool m_hasActiveFilters {false}; ///< Whether filters are currently active
-    FilterSet m_filters;             ///< Currently active filters
+    struct sd_journal* m_journal;               ///< Pointer to journal structure
+    uint64_t m_currentTimestamp {0};            ///< Current entry timestamp
+    bool m_hasActiveFilters {false};            ///< Whether filters are currently active
+    bool m_pushDownEnabled {true};              ///< Whether exact matches can be pushed down to the journal
+    std::vector<FilterGroupMatcher> m_matchers; ///< Compiled active filter groups
 
     /// @brief Gets current epoch time in microseconds
     static uint64_t GetEpochTime();
@@ -162,22 +301,28 @@ private:
     /// @param operation Operation description for error message
     void ThrowIfError(int result, const std::string& operation) const;
 
-    /// @brief Applies filter set with OR logic between groups
-    /// @param filters Set of filter groups to apply
+    /// @brief Applies compiled filter groups with OR logic between groups
+    /// @param matchers Compiled filter groups to apply
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return true if any group matches, false otherwise
-    bool ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing);
+    bool ApplyMatchers(const std::vector<FilterGroupMatcher>& matchers, bool ignoreIfMissing) const;
 
-    /// @brief Applies filter group with AND logic between filters
-    /// @param group Group of filters to add
+    /// @brief Applies a compiled filter group with AND logic between filters
+    /// @param matcher Compiled filter group to apply
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return true if all filters match, false otherwise
-    bool ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const;
+    bool ApplyMatcher(const FilterGroupMatcher& matcher, bool ignoreIfMissing) const;
 
     /// @brief Processes current journal entry
-    /// @param filters Set of filter groups to apply
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @param message Filtered message structure to fill
-    /// @return true if entry matches any filter, false otherwise
-    bool ProcessJournalEntry(const FilterSet& filters, bool ignoreIfMissing, FilteredMessage& message) const;
+    /// @return true if entry could be processed, false otherwise
+    bool ProcessJournalEntry(bool ignoreIfMissing, FilteredMessage& message) const;
+
+    /// @brief Gets next entry that matches the given compiled filter groups
+    /// @param matchers Compiled filter groups to apply
+    /// @param ignoreIfMissing Whether to ignore missing fields
+    /// @return Optional containing filtered message if found
+    std::optional<FilteredMessage> NextMatching(const std::vector<FilterGroupMatcher>& matchers,
+                                                bool ignoreIfMissing);
 };
@@ -4,7 +4,9 @@
 #include <logcollector.hpp>
 #include <reader.hpp>
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <regex>
 
 namespace logcollector
@@ -22,7 +24,30 @@ namespace logcollector
         /// @param filters Group of filters to apply (AND logic between them)
         /// @param ignoreIfMissing Whether to ignore missing fields
         /// @param fileWait Time to wait between reads in milliseconds
-        JournaldReader(Logcollector& logcollector, FilterGroup filters, bool ignoreIfMissing, std::time_t fileWait);
+        /// @param cursorDir Directory where the last processed cursor is persisted. Empty disables persistence.
+        /// @param maxAge Maximum age in milliseconds of the entries read when resuming from a cursor. 0 disables it.
+        JournaldReader(Logcollector& logcollector,
+                       FilterGroup filters,
+                       bool ignoreIfMissing,
+                       std::time_t fileWait,
+                       const std::filesystem::path& cursorDir = {},
+                       std::time_t maxAge = 0);
+
+        /// @brief Constructs a new journal reader, allowing dependency injection for the journal
+        /// @param journal Journal interface used to read the entries
+        /// @param logcollector Reference to logcollector instance
+        /// @param filters Group of filters to apply (AND logic between them)
+        /// @param ignoreIfMissing Whether to ignore missing fields
+        /// @param fileWait Time to wait between reads in milliseconds
+        /// @param cursorDir Directory where the last processed cursor is persisted. Empty disables persistence.
+        /// @param maxAge Maximum age in milliseconds of the entries read when resuming from a cursor. 0 disables it.
+        JournaldReader(std::unique_ptr<JournalLog> journal,
+                       Logcollector& logcollector,
+                       FilterGroup filters,
+                       bool ignoreIfMissing,
+                       std::time_t fileWait,
+                       const std::filesystem::path& cursorDir = {},
+                       std::time_t maxAge = 0);
 
         /// @brief Runs the journal reader
         /// @return Awaitable for asynchronous operation
@@ -35,12 +60,43 @@ namespace logcollector
         /// @return String describing current filters
         std::string GetFilterDescription() const;
 
+        /// @brief Gets the file where the last processed cursor is persisted
+        /// @return Cursor file path, empty if persistence is disabled
+        const std::filesystem::path& GetCursorFile() const;
+
     private:
-        FilterGroup m_filters;                           ///< Active filters
-        bool m_ignoreIfMissing;                          ///< Whether to ignore missing fields
-        std::unique_ptr<JournalLog> m_journal;           ///< Journal interface
-        std::chrono::milliseconds m_waitTime;            ///< Wait time between reads
-        static constexpr size_t MAX_LINE_LENGTH = 16384; ///< Maximum message length
+        /// @brief Positions the journal where reading must start
+        ///
+        /// Resumes right after the persisted cursor if there is one, honoring the maximum age. Otherwise
+        /// seeks the tail of the journal.
+        ///
+        /// @return true if resumed from a persisted cursor, false otherwise
+        bool SeekStart();
+
+        /// @brief Reads matching entries and sends them to the logcollector
+        /// @param maxEntries Maximum number of entries to read, 0 for no limit
+        /// @param verbose Whether to log every entry
+        /// @return Number of entries sent
+        size_t ReadEntries(size_t maxEntries, bool verbose);
+
+        /// @brief Loads the persisted cursor
+        /// @return The cursor, or std::nullopt if not available
+        std::optional<std::string> LoadCursor() const;
+
+        /// @brief Persists the cursor of the current journal entry
+        void SaveCursor() const;
+
+        FilterGroup m_filters;                                       ///< Active filters
+        bool m_ignoreIfMissing;                                      ///< Whether to ignore missing fields
+        std::unique_ptr<JournalLog> m_journal;                       ///< Journal interface
+        std::chrono::milliseconds m_waitTime;                        ///< Wait time between reads
+        std::chrono::milliseconds m_maxAge;                          ///< Maximum age of entries read when resuming
+        std::string m_filterDescription;                             ///< Cached filter description
+        std::filesystem::path m_cursorFile;                          ///< File to persist the cursor to
+        bool m_catchingUp {false};                                   ///< Whether the reader is catching up a backlog
+        std::optional<JournalLog::FilteredMessage> m_pendingMessage; ///< Entry held back by the rate limit
+        std::chrono::milliseconds m_throttleDelay {0};               ///< Time to wait for the rate limit
+        static constexpr size_t MAX_LINE_LENGTH = 16384;             ///< Maximum message length
     };
 
 } // namespace logcollector
@@ -71,21 +71,37 @@ bool JournalLog::SeekTimestamp(uint64_t timestamp)
 }
 
 std::string JournalLog::GetData(const std::string& field) const
+{
+    auto value = GetDataView(field);
+    if (!value)
+    {
+        throw JournalLogException("Field not present in current journal entry");
+    }
+
+    return std::string(*value);
+}
+
+std::optional<std::string_view> JournalLog::GetDataView(const std::string& field) const
 {
     const void* data = nullptr;
     size_t length = 0;
     int ret = sd_journal_get_data(m_journal, field.c_str(), &data, &length);
     if (ret == -ENOENT)
     {
-        throw JournalLogException("Field not present in current journal entry");
+        return std::nullopt;
     }
     ThrowIfError(ret, "get data");
 
-    const char* str = static_cast<const char*>(data);
-    std::string_view full_str(str, length);
-    size_t prefix_len = field.length() + 1;
+    // Data is returned as "FIELD=value", pointing into the journal's mmap'd storage
+    std::string_view fullData(static_cast<const char*>(data), length);
+    size_t prefixLength = field.length() + 1;
+
+    if (fullData.length() < prefixLength)
+    {
+        return std::string_view {};
+    }
 
-    return std::string(full_str.substr(prefix_len));
+    return fullData.substr(prefixLength);
 }
 
 uint64_t JournalLog::GetTimestamp() const
@@ -239,33 +255,47 @@ void JournalLog::AddFilterGroup(const FilterGroup& group, bool ignoreIfMissing)
         throw JournalLogException("Invalid filter configuration");
     }
 
-    for (const auto& filter : group)
+    FilterGroupMatcher matcher(group);
+
+    // Only exact matches can be expressed as journal matches. Matches on the same field are OR'ed by
+    // systemd and matches on different fields are AND'ed, which is the semantics of a filter group.
+    // Substring filters are left to the compiled matcher.
+    const bool pushDown = std::ranges::all_of(matcher.Filters(), &CompiledJournalFilter::IsExact);
+
+    if (pushDown && m_pushDownEnabled)
     {
-        for (const auto& value : filter.GetValueViews())
+        if (!m_matchers.empty())
         {
-            std::string match = filter.field + (filter.exact_match ? "=" : "~") + std::string(value);
-            LogDebug("Adding journal match: {}", match);
+            ThrowIfError(sd_journal_add_disjunction(m_journal), "add filter group disjunction");
+        }
 
-            int ret = sd_journal_add_match(m_journal, match.c_str(), 0);
-            if (ret < 0)
+        for (const auto& filter : group)
+        {
+            for (const auto& value : filter.GetValueViews())
             {
-                if (!ignoreIfMissing)
+                std::string match = filter.field + "=" + std::string(value);
+                LogDebug("Adding journal match: {}", match);
+
+                int ret = sd_journal_add_match(m_journal, match.c_str(), 0);
+                if (ret < 0)
                 {
-                    ThrowIfError(ret, "add filter match");
+                    if (!ignoreIfMissing)
+                    {
+                        ThrowIfError(ret, "add filter match");
+                    }
+                    LogWarn("Failed to add journal match {}: {}", match, strerror(-ret));
                 }
-                LogWarn("Failed to add journal match {}: {}", match, strerror(-ret));
-                continue;
             }
         }
-
-        // Add OR condition between values of the same field
-        if (filter.GetValueViews().size() > 1)
-        {
-            ThrowIfError(sd_journal_add_disjunction(m_journal), "add filter disjunction for field values");
-        }
+    }
+    else if (!pushDown)
+    {
+        // A group that cannot be pushed down needs to see every entry
+        sd_journal_flush_matches(m_journal);
+        m_pushDownEnabled = false;
     }
 
-    ThrowIfError(sd_journal_add_conjunction(m_journal), "add filter conjunction");
+    m_matchers.push_back(std::move(matcher));
     m_hasActiveFilters = true;
     LogInfo("Filter group added successfully");
 }
@@ -275,52 +305,48 @@ void JournalLog::FlushFilters()
     if (m_hasActiveFilters)
     {
         sd_journal_flush_matches(m_journal);
+        m_matchers.clear();
         m_hasActiveFilters = false;
+        m_pushDownEnabled = true;
     }
 }
 
-bool JournalLog::ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const
+bool JournalLog::ApplyMatcher(const FilterGroupMatcher& matcher, bool ignoreIfMissing) const
 {
-    return std::all_of(group.begin(),
-                       group.end(),
-                       [this, ignoreIfMissing](const auto& filter)
-                       {
-                           try
-                           {
-                               std::string fieldValue = GetData(filter.field);
-                               return filter.Matches(fieldValue);
-                           }
-                           catch (const JournalLogException&)
+    return matcher.Matches([this](const std::string& field) { return GetDataView(field); },
+                           [ignoreIfMissing](const std::string& field)
                            {
                                if (!ignoreIfMissing)
                                {
-                                   LogTrace("Field {} not present in entry, skipping...", filter.field);
+                                   LogTrace("Field {} not present in entry, skipping...", field);
                                }
-                               return false;
-                           }
-                       });
+                           });
 }
 
-bool JournalLog::ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing)
+bool JournalLog::ApplyMatchers(const std::vector<FilterGroupMatcher>& matchers, bool ignoreIfMissing) const
 {
-    return std::any_of(filters.begin(),
-                       filters.end(),
-                       [this, ignoreIfMissing](const auto& group) { return ApplyFilterGroup(group, ignoreIfMissing); });
+    return std::any_of(matchers.begin(),
+                       matchers.end(),
+                       [this, ignoreIfMissing](const auto& matcher) { return ApplyMatcher(matcher, ignoreIfMissing); });
 }
 
-bool JournalLog::ProcessJournalEntry(const FilterSet&, bool ignoreIfMissing, FilteredMessage& message) const
+bool JournalLog::ProcessJournalEntry(bool ignoreIfMissing, FilteredMessage& message) const
 {
     try
     {
-        message.message = GetData("MESSAGE");
-        try
-        {
-            message.fieldValue = GetData("_SYSTEMD_UNIT");
-        }
-        catch (const JournalLogException&)
+        auto text = GetDataView("MESSAGE");
+        if (!text)
         {
-            message.fieldValue = "unknown";
+            if (!ignoreIfMissing)
+            {
+                LogError("Failed to process journal entry: MESSAGE field not present");
+            }
+            return false;
         }
+        message.message.assign(text->data(), text->size());
+
+        auto unit = GetDataView("_SYSTEMD_UNIT");
+        message.fieldValue = unit ? std::string(*unit) : "unknown";
         return true;
     }
     catch (const JournalLogException& e)
@@ -333,6 +359,21 @@ bool JournalLog::ProcessJournalEntry(const FilterSet&, bool ignoreIfMissing, Fil
     }
 }
 
+std::optional<JournalLog::FilteredMessage>
+JournalLog::NextMatching(const std::vector<FilterGroupMatcher>& matchers, bool ignoreIfMissing)
+{
+    while (Next())
+    {
+        FilteredMessage message;
+        if (ApplyMatchers(matchers, ignoreIfMissing) && ProcessJournalEntry(ignoreIfMissing, message))
+        {
+            return message;
+        }
+        UpdateTimestamp();
+    }
+    return std::nullopt;
+}
+
 std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(const FilterSet& filters,
                                                                               bool ignoreIfMissing)
 {
@@ -343,14 +384,23 @@ std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(co
         return std::nullopt;
     }
 
-    while (Next())
+    std::vector<FilterGroupMatcher> matchers;
+    matchers.reserve(filters.size());
+    for (const auto& group : filters)
     {
-        FilteredMessage message;
-        if (ApplyFilterSet(filters, ignoreIfMissing) && ProcessJournalEntry(filters, ignoreIfMissing, message))
-        {
-            return message;
-        }
-        UpdateTimestamp();
+        matchers.emplace_back(group);
     }
-    return std::nullopt;
+
+    return NextMatching(matchers, ignoreIfMissing);
+}
+
+std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(bool ignoreIfMissing)
+{
+    if (!m_hasActiveFilters)
+    {
+        LogWarn("No active filters when trying to get filtered message");
+        return std::nullopt;
+    }
+
+    return NextMatching(m_matchers, ignoreIfMissing);
 }
@@ -1,30 +1,70 @@
 #include "journald_reader.hpp"
 
+#include <config.h>
 #include <logger.hpp>
+
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 
 namespace
 {
     const std::string COLLECTOR_TYPE = "journald";
-}
+
+    /// @brief Computes a hash that is stable across runs and platforms (FNV-1a)
+    uint64_t StableHash(std::string_view data)
+    {
+        constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+        constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (const auto c : data)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    uint64_t EpochMicroseconds()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch())
+                                         .count());
+    }
+} // namespace
 
 namespace logcollector
 {
     JournaldReader::JournaldReader(Logcollector& logcollector,
                                    FilterGroup filters,
                                    bool ignoreIfMissing,
-                                   std::time_t fileWait)
+                                   std::time_t fileWait,
+                                   const std::filesystem::path& cursorDir,
+                                   std::time_t maxAge)
+        : JournaldReader(std::make_unique<JournalLog>(),
+                         logcollector,
+                         std::move(filters),
+                         ignoreIfMissing,
+                         fileWait,
+                         cursorDir,
+                         maxAge)
+    {
+    }
+
+    JournaldReader::JournaldReader(std::unique_ptr<JournalLog> journal,
+                                   Logcollector& logcollector,
+                                   FilterGroup filters,
+                                   bool ignoreIfMissing,
+                                   std::time_t fileWait,
+                                   const std::filesystem::path& cursorDir,
+                                   std::time_t maxAge)
         : IReader(logcollector)
         , m_filters(std::move(filters))
         , m_ignoreIfMissing(ignoreIfMissing)
-        , m_journal(std::make_unique<JournalLog>())
+        , m_journal(std::move(journal))
         , m_waitTime(std::chrono::milliseconds(fileWait))
-    {
-
-        LogInfo("Creating JournaldReader with {} filters", m_filters.size());
-    }
-
-    std::string JournaldReader::GetFilterDescription() const
+        , m_maxAge(std::chrono::milliseconds(maxAge))
     {
         std::ostringstream desc;
         desc << m_filters.size() << " conditions: ";
@@ -32,20 +72,40 @@ namespace logcollector
         {
             desc << "[" << filter.field << (filter.exact_match ? "=" : "~") << filter.value << "] ";
         }
-        return desc.str();
+        m_filterDescription = desc.str();
+
+        if (!cursorDir.empty())
+        {
+            std::ostringstream name;
+            name << "journald_" << std::hex << std::setw(16) << std::setfill('0') << StableHash(m_filterDescription)
+                 << ".cursor";
+            m_cursorFile = cursorDir / name.str();
+        }
+
+        LogInfo("Creating JournaldReader with {} filters", m_filters.size());
+    }
+
+    std::string JournaldReader::GetFilterDescription() const
+    {
+        return m_filterDescription;
+    }
+
+    const std::filesystem::path& JournaldReader::GetCursorFile() const
+    {
+        return m_cursorFile;
     }
 
     Awaitable JournaldReader::Run()
     {
         try
         {
-            LogInfo("Initializing journald reader with {}", GetFilterDescription());
+            LogInfo("Initializing journald reader with {}", m_filterDescription);
             m_journal->Open();
             m_journal->AddFilterGroup(m_filters, m_ignoreIfMissing);
 
             try
             {
-                m_journal->SeekTail();
+                m_catchingUp = SeekStart();
             }
             catch (const JournalLogException& e)
             {
@@ -55,36 +115,55 @@ namespace logcollector
 
             LogInfo("Journald reader started successfully");
 
+            size_t caughtUp = 0;
+
             while (m_keepRunning.load())
             {
                 bool shouldWait = true;
                 try
                 {
-                    LogTrace("Checking for new journal entries...");
-                    FilterSet filterSet {m_filters};
-                    while (auto filteredMessage = m_journal->GetNextFilteredMessage(filterSet, m_ignoreIfMissing))
+                    if (m_catchingUp)
                     {
-                        shouldWait = false;
-                        auto& message = filteredMessage->message;
-                        LogDebug("Found matching message for {}", GetFilterDescription());
+                        const size_t batchSize = config::logcollector::JOURNALD_CATCHUP_BATCH_SIZE;
+                        const auto sent = ReadEntries(batchSize, false);
+                        caughtUp += sent;
 
-                        if (message.length() > MAX_LINE_LENGTH)
+                        if (sent < batchSize && !m_pendingMessage)
                         {
-                            LogDebug("Truncating message of length {}", message.length());
-                            message.resize(MAX_LINE_LENGTH);
+                            LogInfo("Journald reader caught up after {} entries for {}",
+                                    caughtUp,
+                                    m_filterDescription);
+                            m_catchingUp = false;
                         }
-                        m_logcollector.SendMessage(filteredMessage->fieldValue, message, COLLECTOR_TYPE);
+                        shouldWait = false;
+                    }
+                    else
+                    {
+                        LogTrace("Checking for new journal entries...");
+                        shouldWait = ReadEntries(0, true) == 0;
                     }
                 }
                 catch (const JournalLogException& e)
                 {
                     LogError("Journal reading error: {}", e.what());
+                    m_catchingUp = false;
+                    shouldWait = true;
                 }
 
-                if (shouldWait)
+                if (m_throttleDelay.count() > 0)
                 {
+                    co_await m_logcollector.Wait(m_throttleDelay);
+                }
+                else if (shouldWait)
+                {
+                    FlushDropSummary();
                     co_await m_logcollector.Wait(m_waitTime);
                 }
+                else if (m_catchingUp)
+                {
+                    // Yield between batches so other readers keep making progress
+                    co_await m_logcollector.Wait(std::chrono::milliseconds(0));
+                }
             }
         }
         catch (const JournalLogException& e)
@@ -99,4 +178,159 @@ namespace logcollector
         m_keepRunning.store(false);
         LogInfo("Journald stopped.");
     }
+
+    bool JournaldReader::SeekStart()
+    {
+        auto cursor = LoadCursor();
+
+        if (!cursor || !m_journal->SeekCursor(*cursor))
+        {
+            m_journal->SeekTail();
+            return false;
+        }
+
+        // SeekCursor leaves the journal on the persisted entry, which has already been processed. If that
+        // entry no longer exists (vacuumed), we are on the next one and must step back to not skip it.
+        if (!m_journal->CursorValid(*cursor))
+        {
+            m_journal->Previous();
+        }
+
+        if (m_maxAge.count() > 0)
+        {
+            const auto maxAge = static_cast<uint64_t>(std::chrono::microseconds(m_maxAge).count());
+            const auto now = EpochMicroseconds();
+            const auto cutoff = now > maxAge ? now - maxAge : 0;
+
+            if (m_journal->GetTimestamp() < cutoff)
+            {
+                LogWarn("Journald backlog for {} is older than the maximum age, skipping to {}",
+                        m_filterDescription,
+                        cutoff);
+                m_journal->SeekTimestamp(cutoff);
+            }
+        }
+
+        LogInfo("Journald reader resuming from persisted cursor for {}", m_filterDescription);
+        return true;
+    }
+
+    size_t JournaldReader::ReadEntries(size_t maxEntries, bool verbose)
+    {
+        size_t sent = 0;
+
+        m_throttleDelay = std::chrono::milliseconds::zero();
+
+        while (maxEntries == 0 || sent < maxEntries)
+        {
+            auto filteredMessage = std::exchange(m_pendingMessage, std::nullopt);
+
+            if (!filteredMessage)
+            {
+                filteredMessage = m_journal->GetNextFilteredMessage(m_ignoreIfMissing);
+                if (!filteredMessage)
+                {
+                    break;
+                }
+
+                auto& message = filteredMessage->message;
+                if (verbose)
+                {
+                    LogDebug("Found matching message for {}", m_filterDescription);
+                }
+
+                if (message.length() > MAX_LINE_LENGTH)
+                {
+                    if (verbose)
+                    {
+                        LogDebug("Truncating message of length {}", message.length());
+                    }
+                    message.resize(MAX_LINE_LENGTH);
+                }
+            }
+
+            m_throttleDelay = TrySendMessage(filteredMessage->fieldValue, filteredMessage->message, COLLECTOR_TYPE);
+
+            if (m_throttleDelay.count() > 0)
+            {
+                // Over the rate limit: keep the entry until there is room for it
+                m_pendingMessage = std::move(filteredMessage);
+                break;
+            }
+            ++sent;
+        }
+
+        // Persist once per batch instead of once per entry. The journal is on the held back entry if
+        // there is one, so persisting now could lose it.
+        if (sent > 0 && !m_pendingMessage)
+        {
+            SaveCursor();
+        }
+
+        return sent;
+    }
+
+    std::optional<std::string> JournaldReader::LoadCursor() const
+    {
+        if (m_cursorFile.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::ifstream file(m_cursorFile);
+        std::string cursor;
+
+        if (!file || !std::getline(file, cursor) || cursor.empty())
+        {
+            return std::nullopt;
+        }
+
+        return cursor;
+    }
+
+    void JournaldReader::SaveCursor() const
+    {
+        if (m_cursorFile.empty())
+        {
+            return;
+        }
+
+        std::string cursor;
+        try
+        {
+            cursor = m_journal->GetCursor();
+        }
+        catch (const JournalLogException& e)
+        {
+            LogTrace("Cannot get journal cursor: {}", e.what());
+            return;
+        }
+
+        if (cursor.empty())
+        {
+            return;
+        }
+
+        // Write to a temporary file and rename it so a crash never leaves a truncated cursor behind
+        std::error_code ec;
+        std::filesystem::create_directories(m_cursorFile.parent_path(), ec);
+
+        auto tmpFile = m_cursorFile;
+        tmpFile += ".tmp";
+
+        {
+            std::ofstream file(tmpFile, std::ios::trunc);
+            if (!(file << cursor << '\n'))
+            {
+                LogWarn("Cannot write journald cursor file: {}", tmpFile.string());
+                return;
+            }
+        }
+
+        std::filesystem::rename(tmpFile, m_cursorFile, ec);
+        if (ec)
+        {
+            LogWarn("Cannot persist journald cursor file {}: {}", m_cursorFile.string(), ec.message());
+        }
+    }
 } // namespace logcollector
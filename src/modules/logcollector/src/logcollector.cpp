@@ -13,6 +13,7 @@
 #include <sstream>
 
 #include "file_reader.hpp"
+#include "rate_limiter.hpp"
 
 using namespace logcollector;
 
@@ -84,12 +85,19 @@ void Logcollector::SetupFileReader(const std::shared_ptr<const configuration::Co
     auto reloadInterval = configurationParser->GetConfig<std::time_t>("logcollector", "reload_interval")
                               .value_or(config::logcollector::DEFAULT_RELOAD_INTERVAL);
 
+    auto rescanInterval = configurationParser->GetConfig<std::time_t>("logcollector", "rescan_interval")
+                              .value_or(config::logcollector::DEFAULT_RESCAN_INTERVAL);
+
     auto localfiles = configurationParser->GetConfig<std::vector<std::string>>("logcollector", "localfiles")
                           .value_or(std::vector<std::string>({config::logcollector::DEFAULT_LOCALFILES}));
 
+    auto rateLimit = GetRateLimitSettings(*configurationParser);
+
     for (auto& lf : localfiles)
     {
-        AddReader(std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval));
+        auto reader = std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval, rescanInterval);
+        reader->SetRateLimit(rateLimit);
+        AddReader(reader);
     }
 }
 
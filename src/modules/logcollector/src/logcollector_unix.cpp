@@ -1,6 +1,8 @@
 #include <journald_reader.hpp>
 #include <logcollector.hpp>
+#include <rate_limiter.hpp>
 
+#include <filesystem>
 #include <memory>
 
 namespace logcollector
@@ -15,6 +17,15 @@ namespace logcollector
         auto fileWait = configurationParser->GetConfig<std::time_t>("logcollector", "read_interval")
                             .value_or(config::logcollector::DEFAULT_FILE_WAIT);
 
+        auto maxAge = configurationParser->GetConfig<std::time_t>("logcollector", "journald_max_age")
+                          .value_or(config::logcollector::DEFAULT_JOURNALD_MAX_AGE);
+
+        auto dataPath =
+            configurationParser->GetConfig<std::string>("agent", "path.data").value_or(config::DEFAULT_DATA_PATH);
+        const auto cursorDir = std::filesystem::path(dataPath) / "logcollector";
+
+        const auto rateLimit = GetRateLimitSettings(*configurationParser);
+
         for (const auto& config : journaldConfigs)
         {
             if (!config.IsMap())
@@ -34,8 +45,10 @@ namespace logcollector
                 if (!filters.empty())
                 {
                     // Create a reader with all conditions
-                    AddReader(std::make_shared<JournaldReader>(
-                        *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                    auto reader = std::make_shared<JournaldReader>(
+                        *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait, cursorDir, maxAge);
+                    reader->SetRateLimit(GetRateLimitSettings(config, rateLimit));
+                    AddReader(reader);
                 }
             }
             else
@@ -45,8 +58,10 @@ namespace logcollector
                                       config["value"].as<std::string>(),
                                       config["exact_match"].as<bool>(true)}};
 
-                AddReader(std::make_shared<JournaldReader>(
-                    *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                auto reader = std::make_shared<JournaldReader>(
+                    *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait, cursorDir, maxAge);
+                reader->SetRateLimit(GetRateLimitSettings(config, rateLimit));
+                AddReader(reader);
             }
         }
     }
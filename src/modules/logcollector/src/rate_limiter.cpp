@@ -0,0 +1,167 @@
+#include "rate_limiter.hpp"
+
+#include <configuration_parser.hpp>
+#include <logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+using namespace logcollector;
+
+namespace
+{
+    RateLimiter::Action ParseAction(const std::string& action, RateLimiter::Action defaultAction)
+    {
+        if (action == "drop")
+        {
+            return RateLimiter::Action::DROP;
+        }
+
+        if (action == "pause")
+        {
+            return RateLimiter::Action::PAUSE;
+        }
+
+        LogWarn("Invalid rate limit action '{}', default value used.", action);
+        return defaultAction;
+    }
+} // namespace
+
+RateLimiter::RateLimiter()
+    : RateLimiter(Settings {})
+{
+}
+
+RateLimiter::RateLimiter(Settings settings, std::function<Clock::time_point()> now)
+    : m_settings(settings)
+    , m_now(std::move(now))
+    , m_events {std::max(settings.eventsPerSecond, 0.0), std::max(settings.eventsPerSecond, 0.0)}
+    , m_bytes {std::max(settings.bytesPerSecond, 0.0), std::max(settings.bytesPerSecond, 0.0)}
+    , m_lastRefill(m_now())
+    , m_lastSummary(m_lastRefill)
+{
+}
+
+bool RateLimiter::Enabled() const
+{
+    return m_events.rate > 0 || m_bytes.rate > 0;
+}
+
+RateLimiter::Verdict RateLimiter::Admit(size_t bytes, std::chrono::milliseconds& delay)
+{
+    if (!Enabled())
+    {
+        return Verdict::ACCEPT;
+    }
+
+    Refill();
+
+    const auto size = static_cast<double>(bytes);
+    const auto bytesNeeded = std::min(size, m_bytes.rate);
+    double wait = 0;
+
+    if (m_events.rate > 0 && m_events.tokens < 1)
+    {
+        wait = std::max(wait, (1 - m_events.tokens) / m_events.rate);
+    }
+
+    if (m_bytes.rate > 0 && m_bytes.tokens < bytesNeeded)
+    {
+        wait = std::max(wait, (bytesNeeded - m_bytes.tokens) / m_bytes.rate);
+    }
+
+    if (wait <= 0)
+    {
+        m_events.tokens -= m_events.rate > 0 ? 1 : 0;
+        m_bytes.tokens -= m_bytes.rate > 0 ? size : 0;
+        return Verdict::ACCEPT;
+    }
+
+    if (m_settings.action == Action::DROP)
+    {
+        ++m_dropped.events;
+        m_dropped.bytes += bytes;
+        return Verdict::DROP;
+    }
+
+    constexpr double MS_PER_SECOND = 1000;
+    delay = std::chrono::milliseconds(std::max<int64_t>(1, static_cast<int64_t>(std::ceil(wait * MS_PER_SECOND))));
+    return Verdict::WAIT;
+}
+
+std::optional<RateLimiter::Summary> RateLimiter::TakeSummary()
+{
+    if (m_dropped.events == 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto now = m_now();
+
+    if (now - m_lastSummary < m_settings.summaryInterval)
+    {
+        return std::nullopt;
+    }
+
+    m_lastSummary = now;
+    return std::exchange(m_dropped, Summary {});
+}
+
+void RateLimiter::Refill()
+{
+    const auto now = m_now();
+    const auto elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_lastRefill = now;
+
+    if (elapsed <= 0)
+    {
+        return;
+    }
+
+    m_events.tokens = std::min(m_events.rate, m_events.tokens + (elapsed * m_events.rate));
+    m_bytes.tokens = std::min(m_bytes.rate, m_bytes.tokens + (elapsed * m_bytes.rate));
+}
+
+RateLimiter::Settings
+logcollector::GetRateLimitSettings(const configuration::ConfigurationParser& configurationParser)
+{
+    RateLimiter::Settings settings;
+
+    settings.eventsPerSecond =
+        configurationParser.GetConfig<double>("logcollector", "max_events_per_second").value_or(0);
+    settings.bytesPerSecond = configurationParser.GetConfig<double>("logcollector", "max_bytes_per_second").value_or(0);
+    settings.action = ParseAction(
+        configurationParser.GetConfig<std::string>("logcollector", "rate_limit_action").value_or("pause"),
+        RateLimiter::Action::PAUSE);
+
+    return settings;
+}
+
+RateLimiter::Settings logcollector::GetRateLimitSettings(const YAML::Node& node, RateLimiter::Settings defaults)
+{
+    try
+    {
+        if (node["max_events_per_second"])
+        {
+            defaults.eventsPerSecond = node["max_events_per_second"].as<double>();
+        }
+
+        if (node["max_bytes_per_second"])
+        {
+            defaults.bytesPerSecond = node["max_bytes_per_second"].as<double>();
+        }
+
+        if (node["rate_limit_action"])
+        {
+            defaults.action = ParseAction(node["rate_limit_action"].as<std::string>(), defaults.action);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LogWarn("Invalid rate limit setting, default value used. {}", e.what());
+    }
+
+    return defaults;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <config.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace configuration
+{
+    class ConfigurationParser;
+}
+
+namespace YAML
+{
+    class Node;
+}
+
+namespace logcollector
+{
+
+    /// @brief Token bucket rate limiter
+    ///
+    /// Limits the events per second and bytes per second produced by a reader.
+    /// Each limit is a token bucket that holds up to one second worth of
+    /// tokens, so short bursts are allowed while the average rate is enforced.
+    class RateLimiter
+    {
+    public:
+        /// @brief Clock used by the limiter
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief What to do with events over the limit
+        enum class Action
+        {
+            PAUSE, ///< Stop reading until the limit allows it (backpressure)
+            DROP   ///< Discard the event and account it in the next summary
+        };
+
+        /// @brief Decision for an event
+        enum class Verdict
+        {
+            ACCEPT, ///< The event can be sent
+            DROP,   ///< The event must be discarded
+            WAIT    ///< The event must be retried later
+        };
+
+        /// @brief Rate limit settings
+        struct Settings
+        {
+            /// @brief Maximum events per second, 0 for no limit
+            double eventsPerSecond = 0;
+
+            /// @brief Maximum bytes per second, 0 for no limit
+            double bytesPerSecond = 0;
+
+            /// @brief Action for events over the limit
+            Action action = Action::PAUSE;
+
+            /// @brief Interval between summaries of dropped events
+            std::chrono::milliseconds summaryInterval {config::logcollector::RATE_LIMIT_SUMMARY_INTERVAL};
+        };
+
+        /// @brief Counts of events dropped since the previous summary
+        struct Summary
+        {
+            /// @brief Number of dropped events
+            uint64_t events = 0;
+
+            /// @brief Number of dropped bytes
+            uint64_t bytes = 0;
+        };
+
+        /// @brief Constructor for a limiter without limits
+        RateLimiter();
+
+        /// @brief Constructor
+        /// @param settings Rate limit settings
+        /// @param now Time source
+        explicit RateLimiter(Settings settings, std::function<Clock::time_point()> now = Clock::now);
+
+        /// @brief Checks if any limit is configured
+        /// @return True if the limiter is enabled, false otherwise
+        bool Enabled() const;
+
+        /// @brief Decides whether an event can be sent
+        ///
+        /// Consumes tokens if the event is accepted, and accounts it if it is
+        /// dropped. An event larger than the bytes bucket is accepted once the
+        /// bucket is full, so oversized lines cannot stall a reader.
+        ///
+        /// @param bytes Size of the event
+        /// @param delay Set to the time to wait before retrying on Verdict::WAIT
+        /// @return Decision for the event
+        Verdict Admit(size_t bytes, std::chrono::milliseconds& delay);
+
+        /// @brief Gets the summary of dropped events if it is due
+        ///
+        /// Resets the counters when a summary is returned.
+        ///
+        /// @return Summary if events were dropped and the summary interval has
+        /// elapsed, std::nullopt otherwise
+        std::optional<Summary> TakeSummary();
+
+    private:
+        /// @brief Single token bucket
+        struct Bucket
+        {
+            /// @brief Refill rate in tokens per second, 0 for no limit
+            double rate = 0;
+
+            /// @brief Available tokens
+            double tokens = 0;
+        };
+
+        /// @brief Refills the buckets with the time elapsed since the last call
+        void Refill();
+
+        /// @brief Settings
+        Settings m_settings;
+
+        /// @brief Time source
+        std::function<Clock::time_point()> m_now;
+
+        /// @brief Events bucket
+        Bucket m_events;
+
+        /// @brief Bytes bucket
+        Bucket m_bytes;
+
+        /// @brief Last refill time
+        Clock::time_point m_lastRefill;
+
+        /// @brief Last summary time
+        Clock::time_point m_lastSummary;
+
+        /// @brief Events dropped since the previous summary
+        Summary m_dropped;
+    };
+
+    /// @brief Reads the rate limit settings of the logcollector section
+    /// @param configurationParser Configuration parser
+    /// @return Rate limit settings
+    RateLimiter::Settings GetRateLimitSettings(const configuration::ConfigurationParser& configurationParser);
+
+    /// @brief Applies the rate limit options of a reader block over the defaults
+    /// @param node Reader configuration block
+    /// @param defaults Default settings
+    /// @return Rate limit settings
+    RateLimiter::Settings GetRateLimitSettings(const YAML::Node& node, RateLimiter::Settings defaults);
+
+} // namespace logcollector
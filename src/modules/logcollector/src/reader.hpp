@@ -4,8 +4,12 @@
 
 #include <boost/asio/awaitable.hpp>
 #include <logcollector.hpp>
+#include <logger.hpp>
+#include <rate_limiter.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <string>
 
 namespace logcollector
 {
@@ -32,12 +36,100 @@ namespace logcollector
         /// @brief Stops the log reader
         virtual void Stop() = 0;
 
+        /// @brief Sets the rate limit of the reader
+        /// @param settings Rate limit settings
+        /// @pre The reader must not be running
+        void SetRateLimit(const RateLimiter::Settings& settings)
+        {
+            m_rateLimiter = RateLimiter(settings);
+        }
+
     protected:
+        /// @brief Sends a log to the logcollector honoring the rate limit
+        ///
+        /// Over the limit, the log is either dropped (and accounted for the
+        /// next drop summary) or not sent at all, in which case the caller must
+        /// wait for the returned delay and try again.
+        ///
+        /// @param location Location of the log
+        /// @param log Log to send
+        /// @param collectorType Type of collector
+        /// @return Zero if the log was sent or dropped, otherwise the time to
+        /// wait before retrying
+        std::chrono::milliseconds TrySendMessage(const std::string& location,
+                                                 const std::string& log,
+                                                 const std::string& collectorType)
+        {
+            if (!m_rateLimiter.Enabled())
+            {
+                m_logcollector.SendMessage(location, log, collectorType);
+                return std::chrono::milliseconds::zero();
+            }
+
+            auto delay = std::chrono::milliseconds::zero();
+            auto verdict = m_rateLimiter.Admit(log.size(), delay);
+
+            if (verdict == RateLimiter::Verdict::WAIT)
+            {
+                return delay;
+            }
+
+            if (verdict == RateLimiter::Verdict::ACCEPT)
+            {
+                m_logcollector.SendMessage(location, log, collectorType);
+            }
+            else
+            {
+                m_dropLocation = location;
+                m_dropCollectorType = collectorType;
+            }
+
+            SendDropSummary(location, collectorType);
+            return std::chrono::milliseconds::zero();
+        }
+
+        /// @brief Sends the summary of dropped logs if it is due
+        /// @param location Location of the logs
+        /// @param collectorType Type of collector
+        void SendDropSummary(const std::string& location, const std::string& collectorType)
+        {
+            if (auto summary = m_rateLimiter.TakeSummary())
+            {
+                LogWarn("Rate limit exceeded for '{}': {} events ({} bytes) dropped",
+                        location,
+                        summary->events,
+                        summary->bytes);
+                m_logcollector.SendMessage(location,
+                                           "Rate limit exceeded: " + std::to_string(summary->events) +
+                                               " events (" + std::to_string(summary->bytes) + " bytes) dropped",
+                                           collectorType);
+            }
+        }
+
+        /// @brief Sends the summary of dropped logs if it is due, from the idle path of the reader
+        ///
+        /// The summary is otherwise only sent along with new logs, so it would be held
+        /// back if the traffic stops after a burst of drops.
+        void FlushDropSummary()
+        {
+            if (!m_dropLocation.empty())
+            {
+                SendDropSummary(m_dropLocation, m_dropCollectorType);
+            }
+        }
+
         /// @brief Indicates if the log reader should keep running
         std::atomic<bool> m_keepRunning = true;
 
         /// @brief Logcollector instance
         Logcollector& m_logcollector;
+
+        /// @brief Rate limiter
+        RateLimiter m_rateLimiter;
+
+        /// @brief Location and collector type of the last dropped log
+        std::string m_dropLocation;
+        std::string m_dropCollectorType;
     };
 
 } // namespace logcollector
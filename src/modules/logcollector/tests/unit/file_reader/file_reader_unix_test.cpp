@@ -104,3 +104,68 @@ TEST(FileReader, Reload)
     auto d = TempFile("/tmp/fileD.log");
     reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
 }
+
+TEST(FileReader, ReloadSkipsSameFile)
+{
+    spdlog::default_logger()->sinks().clear();
+    MockCallback mockCallback;
+
+    EXPECT_CALL(mockCallback, Call("/tmp/sameA.log")).Times(1);
+
+    auto a = TempFile("/tmp/sameA.log");
+    std::filesystem::create_symlink("/tmp/sameA.log", "/tmp/sameB.log");
+
+    FileReader reader(Logcollector::Instance(), "/tmp/same*.log", 500, 60000); // NOLINT
+    reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
+    reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
+
+    std::filesystem::remove("/tmp/sameB.log");
+}
+
+#ifdef __linux__
+TEST(FileReader, PollDirectory)
+{
+    spdlog::default_logger()->sinks().clear();
+    MockCallback mockCallback;
+
+    const std::filesystem::path dir = "/tmp/file_reader_watch";
+    std::filesystem::create_directories(dir);
+
+    EXPECT_CALL(mockCallback, Call("/tmp/file_reader_watch/fileA.log")).Times(1);
+    EXPECT_CALL(mockCallback, Call("/tmp/file_reader_watch/fileB.log")).Times(1);
+
+    auto a = TempFile("/tmp/file_reader_watch/fileA.log");
+
+    FileReader reader(Logcollector::Instance(), "/tmp/file_reader_watch/*.log", 500, 60000); // NOLINT
+    reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
+    ASSERT_TRUE(reader.WatchDirectory());
+
+    auto b = TempFile("/tmp/file_reader_watch/fileB.log");
+    auto c = TempFile("/tmp/file_reader_watch/fileC.txt");
+    EXPECT_TRUE(reader.PollDirectory([&](Localfile& lf) { mockCallback.Call(lf.Filename()); }));
+    EXPECT_TRUE(reader.PollDirectory([&](Localfile& lf) { mockCallback.Call(lf.Filename()); }));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(FileReader, WatchBeforeReload)
+{
+    spdlog::default_logger()->sinks().clear();
+    MockCallback mockCallback;
+
+    const std::filesystem::path dir = "/tmp/file_reader_race";
+    std::filesystem::create_directories(dir);
+
+    EXPECT_CALL(mockCallback, Call("/tmp/file_reader_race/fileA.log")).Times(1);
+
+    FileReader reader(Logcollector::Instance(), "/tmp/file_reader_race/*.log", 500, 60000); // NOLINT
+    ASSERT_TRUE(reader.WatchDirectory());
+
+    // Created between the watch and the reload: both see it, but it is only added once.
+    auto a = TempFile("/tmp/file_reader_race/fileA.log");
+    reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
+    EXPECT_TRUE(reader.PollDirectory([&](Localfile& lf) { mockCallback.Call(lf.Filename()); }));
+
+    std::filesystem::remove_all(dir);
+}
+#endif
@@ -3,6 +3,8 @@
 
 #include <journal_log.hpp>
 
+#include <map>
+
 using namespace testing;
 
 class JournalLogTests : public ::testing::Test
@@ -118,3 +120,56 @@ TEST_F(JournalLogTests, ErrorHandling)
     FilterGroup invalidGroup {{"", "value", true}};
     EXPECT_THROW(journal->AddFilterGroup(invalidGroup, false), JournalLogException);
 }
+
+TEST(CompiledJournalFilterTests, FilterMatching)
+{
+    struct TestCase
+    {
+        JournalFilter filter;
+        std::string input;
+        bool expectedMatch;
+    };
+
+    std::vector<TestCase> testCases = {{{"UNIT", "test.service", true}, "test.service", true},
+                                       {{"UNIT", "test.service", true}, "test.service2", false},
+                                       {{"UNIT", "test", false}, "test.service", true},
+                                       {{"UNIT", "service1|service2", true}, "service1", true},
+                                       {{"UNIT", "service1|service2", true}, "service2", true},
+                                       {{"UNIT", "service1|service2", true}, "service3", false},
+                                       {{"UNIT", "sys|jour", false}, "system", true},
+                                       {{"UNIT", "sys|jour", false}, "kernel", false}};
+
+    for (const auto& tc : testCases)
+    {
+        const CompiledJournalFilter compiled(tc.filter);
+        EXPECT_EQ(compiled.Matches(tc.input), tc.expectedMatch)
+            << "Filter: " << tc.filter.value << ", Input: " << tc.input;
+        EXPECT_EQ(compiled.Matches(tc.input), tc.filter.Matches(tc.input));
+    }
+}
+
+TEST(FilterGroupMatcherTests, AllFiltersMustMatch)
+{
+    const FilterGroupMatcher matcher({{"UNIT", "a.service|b.service", true}, {"MESSAGE", "error", false}});
+    std::map<std::string, std::string> entry {{"UNIT", "b.service"}, {"MESSAGE", "an error happened"}};
+    std::vector<std::string> missing;
+
+    auto fetch = [&entry](const std::string& field) -> std::optional<std::string_view>
+    {
+        auto it = entry.find(field);
+        return it != entry.end() ? std::optional<std::string_view>(it->second) : std::nullopt;
+    };
+    auto onMissing = [&missing](const std::string& field)
+    {
+        missing.push_back(field);
+    };
+
+    EXPECT_TRUE(matcher.Matches(fetch, onMissing));
+
+    entry["MESSAGE"] = "all good";
+    EXPECT_FALSE(matcher.Matches(fetch, onMissing));
+
+    entry.erase("UNIT");
+    EXPECT_FALSE(matcher.Matches(fetch, onMissing));
+    EXPECT_THAT(missing, ElementsAre("UNIT"));
+}
@@ -5,9 +5,30 @@
 #include <journald_reader.hpp>
 #include <logcollector_mock.hpp>
 
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 using namespace logcollector;
 using namespace testing;
 
+class MockJournalLog : public JournalLog
+{
+public:
+    MOCK_METHOD(void, Open, (), (override));
+    MOCK_METHOD(bool, Previous, (), (override));
+    MOCK_METHOD(bool, SeekTail, (), (override));
+    MOCK_METHOD(bool, SeekTimestamp, (uint64_t timestamp), (override));
+    MOCK_METHOD(uint64_t, GetTimestamp, (), (const, override));
+    MOCK_METHOD(void, AddFilterGroup, (const FilterGroup& group, bool ignoreIfMissing), (override));
+    MOCK_METHOD(std::optional<FilteredMessage>, GetNextFilteredMessage, (bool ignoreIfMissing), (override));
+    MOCK_METHOD(std::string, GetCursor, (), (const, override));
+    MOCK_METHOD(bool, SeekCursor, (const std::string& cursor), (override));
+    MOCK_METHOD(bool, CursorValid, (const std::string& cursor), (const, override));
+};
+
 class JournaldReaderTests : public ::testing::Test
 {
 protected:
@@ -28,6 +49,86 @@ protected:
     }
 };
 
+class JournaldReaderCursorTests : public JournaldReaderTests
+{
+protected:
+    const std::filesystem::path cursorDir {std::filesystem::temp_directory_path() / "journald_reader_test"};
+    MockJournalLog* journal {nullptr};
+    size_t sentMessages {0};
+    size_t providedMessages {0};
+
+    void SetUp() override
+    {
+        JournaldReaderTests::SetUp();
+        std::filesystem::remove_all(cursorDir);
+        logcollector.SetPushMessageFunction(
+            [this](::Message) -> int // NOLINT(performance-unnecessary-value-param)
+            {
+                ++sentMessages;
+                return 0;
+            });
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(cursorDir);
+    }
+
+    std::unique_ptr<JournaldReader> CreateReader(std::time_t maxAge = 0)
+    {
+        auto journalMock = std::make_unique<NiceMock<MockJournalLog>>();
+        journal = journalMock.get();
+        return std::make_unique<JournaldReader>(
+            std::move(journalMock), logcollector, testFilters, ignoreIfMissing, fileWait, cursorDir, maxAge);
+    }
+
+    static void WriteCursor(const JournaldReader& reader, const std::string& cursor)
+    {
+        std::filesystem::create_directories(reader.GetCursorFile().parent_path());
+        std::ofstream(reader.GetCursorFile()) << cursor << '\n';
+    }
+
+    static std::string ReadCursor(const JournaldReader& reader)
+    {
+        std::string cursor;
+        std::ifstream file(reader.GetCursorFile());
+        std::getline(file, cursor);
+        return cursor;
+    }
+
+    /// @brief Returns \p count messages and then reports the end of the journal
+    void ProvideMessages(size_t count)
+    {
+        EXPECT_CALL(*journal, GetNextFilteredMessage(_))
+            .WillRepeatedly(Invoke(
+                [this, count](bool) -> std::optional<JournalLog::FilteredMessage>
+                {
+                    if (providedMessages == count)
+                    {
+                        return std::nullopt;
+                    }
+                    ++providedMessages;
+                    return JournalLog::FilteredMessage {"test.service", "message " + std::to_string(providedMessages)};
+                }));
+    }
+
+    /// @brief Runs the reader until it waits for new entries the first time
+    static void RunUntilIdle(JournaldReader& reader, LogcollectorMock& logcollectorMock, std::time_t idleWait)
+    {
+        ON_CALL(logcollectorMock, Wait(std::chrono::milliseconds(idleWait)))
+            .WillByDefault(Invoke(
+                [&reader](std::chrono::milliseconds) -> boost::asio::awaitable<void>
+                {
+                    reader.Stop();
+                    co_return;
+                }));
+
+        boost::asio::io_context ioContext;
+        boost::asio::co_spawn(ioContext, reader.Run(), boost::asio::detached);
+        ioContext.run();
+    }
+};
+
 TEST_F(JournaldReaderTests, BasicOperations)
 {
     auto reader = CreateReader();
@@ -73,3 +174,159 @@ TEST_F(JournaldReaderTests, MessageTruncation)
     auto runTask = reader.Run();
     reader.Stop();
 }
+
+TEST_F(JournaldReaderTests, CursorFile)
+{
+    auto reader = CreateReader();
+    EXPECT_TRUE(reader.GetCursorFile().empty());
+
+    const std::filesystem::path cursorDir = "/tmp/logcollector";
+    JournaldReader persistent(logcollector, testFilters, ignoreIfMissing, fileWait, cursorDir);
+    JournaldReader same(logcollector, testFilters, ignoreIfMissing, fileWait, cursorDir);
+    JournaldReader other(logcollector, {{"UNIT", "other.service", true}}, ignoreIfMissing, fileWait, cursorDir);
+
+    EXPECT_EQ(persistent.GetCursorFile().parent_path(), cursorDir);
+    EXPECT_EQ(persistent.GetCursorFile().extension(), ".cursor");
+    EXPECT_EQ(persistent.GetCursorFile(), same.GetCursorFile());
+    EXPECT_NE(persistent.GetCursorFile(), other.GetCursorFile());
+}
+
+TEST_F(JournaldReaderCursorTests, StartAtTailWithoutCursor)
+{
+    auto reader = CreateReader();
+
+    EXPECT_CALL(*journal, SeekCursor(_)).Times(0);
+    EXPECT_CALL(*journal, SeekTail()).Times(1);
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+}
+
+TEST_F(JournaldReaderCursorTests, ResumeFromCursor)
+{
+    auto reader = CreateReader();
+    WriteCursor(*reader, "s=saved");
+
+    EXPECT_CALL(*journal, SeekCursor("s=saved")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, CursorValid("s=saved")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, SeekTail()).Times(0);
+    EXPECT_CALL(*journal, Previous()).Times(0);
+    EXPECT_CALL(*journal, SeekTimestamp(_)).Times(0);
+    EXPECT_CALL(*journal, GetCursor()).WillOnce(Return("s=last"));
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+    ProvideMessages(2);
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+
+    EXPECT_EQ(sentMessages, 2);
+    EXPECT_EQ(ReadCursor(*reader), "s=last");
+}
+
+TEST_F(JournaldReaderCursorTests, VacuumedCursor)
+{
+    auto reader = CreateReader();
+    WriteCursor(*reader, "s=vacuumed");
+
+    // The persisted entry is gone, so the journal is already on the next one: step back to not skip it
+    EXPECT_CALL(*journal, SeekCursor("s=vacuumed")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, CursorValid("s=vacuumed")).WillOnce(Return(false));
+    EXPECT_CALL(*journal, Previous()).Times(1);
+    EXPECT_CALL(*journal, SeekTail()).Times(0);
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+}
+
+TEST_F(JournaldReaderCursorTests, UnknownCursorStartsAtTail)
+{
+    auto reader = CreateReader();
+    WriteCursor(*reader, "s=unknown");
+
+    EXPECT_CALL(*journal, SeekCursor("s=unknown")).WillOnce(Return(false));
+    EXPECT_CALL(*journal, SeekTail()).Times(1);
+    EXPECT_CALL(*journal, Previous()).Times(0);
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+}
+
+TEST_F(JournaldReaderCursorTests, CatchUpBatching)
+{
+    constexpr size_t BATCH_SIZE = config::logcollector::JOURNALD_CATCHUP_BATCH_SIZE;
+    constexpr size_t BACKLOG = 2 * BATCH_SIZE + 3;
+
+    auto reader = CreateReader();
+    WriteCursor(*reader, "s=saved");
+
+    EXPECT_CALL(*journal, SeekCursor("s=saved")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, CursorValid("s=saved")).WillOnce(Return(true));
+    ProvideMessages(BACKLOG);
+
+    // Two full batches and the remaining entries: the cursor is persisted once per batch, not per entry
+    EXPECT_CALL(*journal, GetCursor())
+        .WillOnce(Return("s=batch1"))
+        .WillOnce(Return("s=batch2"))
+        .WillOnce(Return("s=batch3"));
+
+    // The reader yields between full batches without waiting, and only waits once it has caught up
+    EXPECT_CALL(logcollector, Wait(std::chrono::milliseconds(0))).Times(2);
+    EXPECT_CALL(logcollector, Wait(std::chrono::milliseconds(fileWait))).Times(1);
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+
+    EXPECT_EQ(sentMessages, BACKLOG);
+    EXPECT_EQ(ReadCursor(*reader), "s=batch3");
+}
+
+TEST_F(JournaldReaderCursorTests, MaxAgeCutoff)
+{
+    constexpr std::time_t MAX_AGE_MS = 3600 * 1000;
+    constexpr uint64_t MAX_AGE_US = static_cast<uint64_t>(MAX_AGE_MS) * 1000;
+
+    const auto nowUs = []
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+                .count());
+    };
+
+    auto reader = CreateReader(MAX_AGE_MS);
+    WriteCursor(*reader, "s=old");
+
+    const auto before = nowUs();
+
+    EXPECT_CALL(*journal, SeekCursor("s=old")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, CursorValid("s=old")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, GetTimestamp()).WillOnce(Return(before - 2 * MAX_AGE_US));
+    EXPECT_CALL(*journal, SeekTimestamp(_))
+        .WillOnce(Invoke(
+            [&](uint64_t cutoff)
+            {
+                EXPECT_GE(cutoff, before - MAX_AGE_US);
+                EXPECT_LE(cutoff, nowUs() - MAX_AGE_US);
+                return true;
+            }));
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+}
+
+TEST_F(JournaldReaderCursorTests, MaxAgeKeepsRecentBacklog)
+{
+    constexpr std::time_t MAX_AGE_MS = 3600 * 1000;
+
+    auto reader = CreateReader(MAX_AGE_MS);
+    WriteCursor(*reader, "s=recent");
+
+    const auto now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    EXPECT_CALL(*journal, SeekCursor("s=recent")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, CursorValid("s=recent")).WillOnce(Return(true));
+    EXPECT_CALL(*journal, GetTimestamp()).WillOnce(Return(now));
+    EXPECT_CALL(*journal, SeekTimestamp(_)).Times(0);
+    EXPECT_CALL(logcollector, Wait(_)).Times(AnyNumber());
+
+    RunUntilIdle(*reader, logcollector, fileWait);
+}
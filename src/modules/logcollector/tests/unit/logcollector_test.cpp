@@ -4,6 +4,7 @@
 #include <file_reader.hpp>
 #include <gtest/gtest.h>
 #include <regex>
+#include <thread>
 
 using namespace configuration;
 using namespace logcollector;
@@ -103,6 +104,53 @@ TEST(Logcollector, SendMessageApp)
     ASSERT_EQ(capturedMessage.metaData, METADATA);
 }
 
+class DropReader : public IReader
+{
+public:
+    using IReader::IReader;
+    using IReader::FlushDropSummary;
+    using IReader::TrySendMessage;
+
+    Awaitable Run() override
+    {
+        co_return;
+    }
+
+    void Stop() override {}
+};
+
+TEST(Logcollector, FlushDropSummaryWithoutTraffic)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+    std::vector<std::string> sent;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    EXPECT_CALL(mock, Call(::testing::_))
+        .Times(2)
+        .WillRepeatedly(::testing::Invoke(
+            [&sent](Message message)
+            {
+                sent.push_back(message.data["event"]["original"]);
+                return 0;
+            }));
+
+    DropReader reader(logcollector);
+    reader.SetRateLimit({.eventsPerSecond = 1, .action = RateLimiter::Action::DROP, .summaryInterval = std::chrono::milliseconds(20)}); // NOLINT
+
+    EXPECT_EQ(reader.TrySendMessage("/test/location", "first", "file").count(), 0);
+    EXPECT_EQ(reader.TrySendMessage("/test/location", "second", "file").count(), 0);
+    ASSERT_EQ(sent.size(), 1);
+
+    // The traffic stops after the drop, the summary is sent from the idle path once due.
+    std::this_thread::sleep_for(std::chrono::milliseconds(30)); // NOLINT
+    reader.FlushDropSummary();
+
+    ASSERT_EQ(sent.size(), 2);
+    EXPECT_EQ(sent[1], "Rate limit exceeded: 1 events (6 bytes) dropped");
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
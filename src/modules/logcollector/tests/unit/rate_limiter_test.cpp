@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <rate_limiter.hpp>
+
+using namespace logcollector;
+using namespace std::chrono_literals;
+
+class RateLimiterTest : public ::testing::Test
+{
+protected:
+    RateLimiter::Clock::time_point m_now {};
+
+    RateLimiter CreateLimiter(RateLimiter::Settings settings)
+    {
+        return RateLimiter(settings, [this] { return m_now; });
+    }
+};
+
+TEST_F(RateLimiterTest, DisabledByDefault)
+{
+    RateLimiter limiter;
+    auto delay = 0ms;
+
+    EXPECT_FALSE(limiter.Enabled());
+
+    for (int i = 0; i < 1000; ++i) // NOLINT
+    {
+        EXPECT_EQ(limiter.Admit(1000, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+    }
+}
+
+TEST_F(RateLimiterTest, PauseOverEventLimit)
+{
+    auto limiter = CreateLimiter({.eventsPerSecond = 10}); // NOLINT
+    auto delay = 0ms;
+
+    for (int i = 0; i < 10; ++i) // NOLINT
+    {
+        EXPECT_EQ(limiter.Admit(1, delay), RateLimiter::Verdict::ACCEPT);
+    }
+
+    EXPECT_EQ(limiter.Admit(1, delay), RateLimiter::Verdict::WAIT);
+    EXPECT_EQ(delay, 100ms);
+
+    m_now += 100ms;
+    EXPECT_EQ(limiter.Admit(1, delay), RateLimiter::Verdict::ACCEPT);
+}
+
+TEST_F(RateLimiterTest, PauseOverByteLimit)
+{
+    auto limiter = CreateLimiter({.bytesPerSecond = 1000}); // NOLINT
+    auto delay = 0ms;
+
+    EXPECT_EQ(limiter.Admit(800, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+    EXPECT_EQ(limiter.Admit(400, delay), RateLimiter::Verdict::WAIT);   // NOLINT
+    EXPECT_EQ(delay, 200ms);
+
+    m_now += 200ms;
+    EXPECT_EQ(limiter.Admit(400, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+}
+
+TEST_F(RateLimiterTest, OversizedEventAcceptedWithFullBucket)
+{
+    auto limiter = CreateLimiter({.bytesPerSecond = 100}); // NOLINT
+    auto delay = 0ms;
+
+    EXPECT_EQ(limiter.Admit(1000, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+    EXPECT_EQ(limiter.Admit(1, delay), RateLimiter::Verdict::WAIT);
+
+    m_now += 10s;
+    EXPECT_EQ(limiter.Admit(1000, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+}
+
+TEST_F(RateLimiterTest, DropAndSummarise)
+{
+    auto limiter = CreateLimiter({.eventsPerSecond = 1, .action = RateLimiter::Action::DROP, .summaryInterval = 60s});
+    auto delay = 0ms;
+
+    EXPECT_EQ(limiter.Admit(10, delay), RateLimiter::Verdict::ACCEPT); // NOLINT
+    EXPECT_EQ(limiter.Admit(10, delay), RateLimiter::Verdict::DROP);   // NOLINT
+    EXPECT_EQ(limiter.Admit(20, delay), RateLimiter::Verdict::DROP);   // NOLINT
+    EXPECT_FALSE(limiter.TakeSummary());
+
+    m_now += 60s;
+    auto summary = limiter.TakeSummary();
+    ASSERT_TRUE(summary);
+    EXPECT_EQ(summary->events, 2);
+    EXPECT_EQ(summary->bytes, 30);
+
+    m_now += 60s;
+    EXPECT_FALSE(limiter.TakeSummary());
+}